@@ -12,6 +12,8 @@ RZ_LIB_VERSION(rz_analysis);
 
 static RzAnalysisPlugin *analysis_static_plugins[] = { RZ_ANALYSIS_STATIC_PLUGINS };
 
+RZ_IPI void rz_analysis_xrefs_fini(RzAnalysis *analysis);
+
 RZ_API void rz_analysis_set_limits(RzAnalysis *analysis, ut64 from, ut64 to) {
 	free(analysis->limit);
 	analysis->limit = RZ_NEW0(RzAnalysisRange);
@@ -125,6 +127,47 @@ RZ_API RzAnalysis *rz_analysis_new(void) {
 	return analysis;
 }
 
+/**
+ * \brief Creates a new RzAnalysis which can only be used to decode instructions.
+ *
+ * The returned instance uses the same plugin, cpu, bits, endianness, os and options
+ * of \p analysis, but owns its own plugin data, thus it can be used by a worker
+ * thread to call rz_analysis_op() while \p analysis is used by another thread.
+ * No IO, flag or core bindings are set, thus hints and per-address arch/bits
+ * changes are not available.
+ *
+ * \param analysis The RzAnalysis to copy the configuration from
+ * \return On success returns a valid pointer, otherwise NULL
+ */
+RZ_API RZ_OWN RzAnalysis *rz_analysis_new_decoder(RZ_NONNULL RzAnalysis *analysis) {
+	rz_return_val_if_fail(analysis && analysis->cur, NULL);
+	RzAnalysis *decoder = rz_analysis_new();
+	if (!decoder) {
+		return NULL;
+	}
+	free(decoder->cpu);
+	decoder->cpu = analysis->cpu ? strdup(analysis->cpu) : NULL;
+	free(decoder->os);
+	decoder->os = analysis->os ? strdup(analysis->os) : NULL;
+	decoder->bits = analysis->bits;
+	decoder->big_endian = analysis->big_endian;
+	decoder->reg->big_endian = analysis->big_endian;
+	decoder->pcalign = analysis->pcalign;
+	decoder->gp = analysis->gp;
+	decoder->opt = analysis->opt;
+
+	// the plugin may not be a static one, thus it is not searched by name.
+	decoder->cur = analysis->cur;
+	if (decoder->cur->init && !decoder->cur->init(&decoder->plugin_data)) {
+		RZ_LOG_ERROR("analysis plugin '%s' failed to initialize.\n", decoder->cur->name);
+		decoder->cur = NULL;
+		rz_analysis_free(decoder);
+		return NULL;
+	}
+	rz_analysis_set_reg_profile(decoder);
+	return decoder;
+}
+
 RZ_API void plugin_fini(RzAnalysis *analysis) {
 	RzAnalysisPlugin *p = analysis->cur;
 	if (p && p->fini && !p->fini(analysis->plugin_data)) {
@@ -159,8 +202,7 @@ RZ_API RzAnalysis *rz_analysis_free(RzAnalysis *a) {
 	rz_platform_target_free(a->arch_target);
 	rz_platform_target_index_free(a->platform_target);
 	rz_reg_free(a->reg);
-	ht_up_free(a->ht_xrefs_from);
-	ht_up_free(a->ht_xrefs_to);
+	rz_analysis_xrefs_fini(a);
 	ht_up_free(a->type_links);
 	rz_list_free(a->leaddrs);
 	rz_type_db_free(a->typedb);
@@ -482,6 +524,22 @@ RZ_API int rz_analysis_archinfo(RzAnalysis *analysis, RzAnalysisInfoType query)
 	return value;
 }
 
+/**
+ * \brief Gets the counters of the decode cache of the current plugin
+ *
+ * \param hits     Number of ops decoded from the cache
+ * \param lookups  Number of ops looked up in the cache
+ * \return false if the plugin has no decode cache
+ */
+RZ_API bool rz_analysis_decode_cache_stats(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RZ_OUT ut64 *hits, RZ_NONNULL RZ_OUT ut64 *lookups) {
+	rz_return_val_if_fail(analysis && hits && lookups, false);
+	*hits = *lookups = 0;
+	if (!analysis->cur || !analysis->cur->decode_cache_stats) {
+		return false;
+	}
+	return analysis->cur->decode_cache_stats(analysis, hits, lookups);
+}
+
 static bool sdb_noret_addr_set(Sdb *db, ut64 addr, bool v, ut32 cas) {
 	char key[128];
 	rz_strf(key, "addr.%" PFMT64x ".noreturn", addr);
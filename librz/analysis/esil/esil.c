@@ -6,6 +6,7 @@
 #include <rz_types.h>
 #include <rz_util.h>
 #include <rz_bind.h>
+#include "esil_private.h"
 
 #define FLG(x) RZ_ANALYSIS_ESIL_FLAG_##x
 #define cpuflag(x, y) \
@@ -50,12 +51,32 @@ static bool isnum(RzAnalysisEsil *esil, const char *str, ut64 *num) {
 	return false;
 }
 
+/* rz_reg_get() which skips the lookup when name was pushed by a compiled expression */
+static RzRegItem *esil_reg_get(RzAnalysisEsil *esil, const char *name) {
+	const RzAnalysisEsilLiteral *lit = esil_literal_get(esil, name);
+	return lit ? lit->item : rz_reg_get(esil->analysis->reg, name, -1);
+}
+
 static bool ispackedreg(RzAnalysisEsil *esil, const char *str) {
-	RzRegItem *ri = rz_reg_get(esil->analysis->reg, str, -1);
+	RzRegItem *ri = esil_reg_get(esil, str);
 	return ri ? ri->packed_size > 0 : false;
 }
 
+/* true when the registers are read straight from RzReg, thus a literal can be read via its RzRegItem */
+static inline bool reg_read_is_internal(RzAnalysisEsil *esil) {
+	return !esil->cb.hook_reg_read && esil->cb.reg_read == esil_internal_reg_read;
+}
+
 static bool isregornum(RzAnalysisEsil *esil, const char *str, ut64 *num) {
+	const RzAnalysisEsilLiteral *lit = esil_literal_get(esil, str);
+	if (lit && num && reg_read_is_internal(esil)) {
+		if (lit->item) {
+			*num = rz_reg_get_value(esil->analysis->reg, lit->item);
+			return true;
+		}
+		*num = lit->isnum ? lit->num : 0;
+		return lit->isnum;
+	}
 	if (!rz_analysis_esil_reg_read(esil, str, num, NULL)) {
 		if (!isnum(esil, str, num)) {
 			return false;
@@ -95,6 +116,11 @@ RZ_API RzAnalysisEsil *rz_analysis_esil_new(int stacksize, int iotrap, unsigned
 		free(esil);
 		return NULL;
 	}
+	if (!(esil->stack_literals = RZ_NEWS0(const RzAnalysisEsilLiteral *, stacksize))) {
+		free(esil->stack);
+		free(esil);
+		return NULL;
+	}
 	esil->verbose = false;
 	esil->stacksize = stacksize;
 	esil->parse_goto_count = RZ_ANALYSIS_ESIL_GOTO_LIMIT;
@@ -121,6 +147,8 @@ RZ_API bool rz_analysis_esil_set_op(RzAnalysisEsil *esil, const char *op, RzAnal
 			free(eop);
 			return false;
 		}
+		// the compiled expressions may push this word
+		rz_analysis_esil_code_cache_clear(esil);
 	}
 	eop->push = push;
 	eop->pop = pop;
@@ -175,6 +203,8 @@ RZ_API void rz_analysis_esil_free(RzAnalysisEsil *esil) {
 	esil->stats = NULL;
 	rz_analysis_esil_stack_free(esil);
 	free(esil->stack);
+	esil_code_cache_fini(esil);
+	free(esil->stack_literals);
 	if (esil->analysis && esil->analysis->cur && esil->analysis->cur->esil_fini) {
 		esil->analysis->cur->esil_fini(esil);
 	}
@@ -193,7 +223,7 @@ RZ_API void rz_analysis_esil_free(RzAnalysisEsil *esil) {
 
 static ut8 esil_internal_sizeof_reg(RzAnalysisEsil *esil, const char *r) {
 	rz_return_val_if_fail(esil && esil->analysis && esil->analysis->reg && r, 0);
-	RzRegItem *ri = rz_reg_get(esil->analysis->reg, r, -1);
+	RzRegItem *ri = esil_reg_get(esil, r);
 	return ri ? ri->size : 0;
 }
 
@@ -328,8 +358,8 @@ RZ_API int rz_analysis_esil_mem_write(RzAnalysisEsil *esil, ut64 addr, const ut8
 	return ret;
 }
 
-static int internal_esil_reg_read(RzAnalysisEsil *esil, const char *regname, ut64 *num, int *size) {
-	RzRegItem *reg = rz_reg_get(esil->analysis->reg, regname, -1);
+RZ_IPI int esil_internal_reg_read(RzAnalysisEsil *esil, const char *regname, ut64 *num, int *size) {
+	RzRegItem *reg = esil_reg_get(esil, regname);
 	if (reg) {
 		if (size) {
 			*size = reg->size;
@@ -344,7 +374,7 @@ static int internal_esil_reg_read(RzAnalysisEsil *esil, const char *regname, ut6
 
 static int internal_esil_reg_write(RzAnalysisEsil *esil, const char *regname, ut64 num) {
 	if (esil && esil->analysis) {
-		RzRegItem *reg = rz_reg_get(esil->analysis->reg, regname, -1);
+		RzRegItem *reg = esil_reg_get(esil, regname);
 		if (reg) {
 			rz_reg_set_value(esil->analysis->reg, reg, num);
 			return true;
@@ -356,7 +386,7 @@ static int internal_esil_reg_write(RzAnalysisEsil *esil, const char *regname, ut
 static int internal_esil_reg_write_no_null(RzAnalysisEsil *esil, const char *regname, ut64 num) {
 	rz_return_val_if_fail(esil && esil->analysis && esil->analysis->reg, false);
 
-	RzRegItem *reg = rz_reg_get(esil->analysis->reg, regname, -1);
+	RzRegItem *reg = esil_reg_get(esil, regname);
 	const char *pc = rz_reg_get_name(esil->analysis->reg, RZ_REG_NAME_PC);
 	const char *sp = rz_reg_get_name(esil->analysis->reg, RZ_REG_NAME_SP);
 	const char *bp = rz_reg_get_name(esil->analysis->reg, RZ_REG_NAME_BP);
@@ -390,6 +420,9 @@ RZ_API bool rz_analysis_esil_push(RzAnalysisEsil *esil, const char *str) {
 	if (!str || !esil || !*str || esil->stackptr > (esil->stacksize - 1)) {
 		return false;
 	}
+	if (esil->stack_literals) {
+		esil->stack_literals[esil->stackptr] = NULL;
+	}
 	esil->stack[esil->stackptr++] = strdup(str);
 	return true;
 }
@@ -421,7 +454,7 @@ RZ_API int rz_analysis_esil_get_parm_type(RzAnalysisEsil *esil, const char *str)
 	}
 	return RZ_ANALYSIS_ESIL_PARM_NUM;
 not_a_number:
-	if (rz_reg_get(esil->analysis->reg, str, -1)) {
+	if (esil_reg_get(esil, str)) {
 		return RZ_ANALYSIS_ESIL_PARM_REG;
 	}
 	return RZ_ANALYSIS_ESIL_PARM_INVALID;
@@ -431,10 +464,18 @@ RZ_API int rz_analysis_esil_get_parm_size(RzAnalysisEsil *esil, const char *str,
 	if (!str || !*str) {
 		return false;
 	}
-	int parm_type = rz_analysis_esil_get_parm_type(esil, str);
 	if (!num || !esil) {
 		return false;
 	}
+	const RzAnalysisEsilLiteral *lit = esil_literal_get(esil, str);
+	if (lit && (lit->parm_num || (lit->item && reg_read_is_internal(esil)))) {
+		*num = lit->parm_num ? lit->num : rz_reg_get_value(esil->analysis->reg, lit->item);
+		if (size) {
+			*size = lit->parm_num ? esil->analysis->bits : lit->item->size;
+		}
+		return true;
+	}
+	int parm_type = rz_analysis_esil_get_parm_type(esil, str);
 	switch (parm_type) {
 	case RZ_ANALYSIS_ESIL_PARM_NUM:
 		*num = rz_num_get(NULL, str);
@@ -976,9 +1017,9 @@ static bool esil_cmp(RzAnalysisEsil *esil) {
 			esil->old = num;
 			esil->cur = num - num2;
 			ret = true;
-			if (rz_reg_get(esil->analysis->reg, dst, -1)) {
+			if (esil_reg_get(esil, dst)) {
 				esil->lastsz = esil_internal_sizeof_reg(esil, dst);
-			} else if (rz_reg_get(esil->analysis->reg, src, -1)) {
+			} else if (esil_reg_get(esil, src)) {
 				esil->lastsz = esil_internal_sizeof_reg(esil, src);
 			} else {
 				// default size is set to 64 as internally operands are ut64
@@ -2687,9 +2728,9 @@ static bool esil_smaller(RzAnalysisEsil *esil) { // 'dst < src' => 'src,dst,<'
 			esil->old = num;
 			esil->cur = num - num2;
 			ret = true;
-			if (rz_reg_get(esil->analysis->reg, dst, -1)) {
+			if (esil_reg_get(esil, dst)) {
 				esil->lastsz = esil_internal_sizeof_reg(esil, dst);
-			} else if (rz_reg_get(esil->analysis->reg, src, -1)) {
+			} else if (esil_reg_get(esil, src)) {
 				esil->lastsz = esil_internal_sizeof_reg(esil, src);
 			} else {
 				// default size is set to 64 as internally operands are ut64
@@ -2713,9 +2754,9 @@ static bool esil_bigger(RzAnalysisEsil *esil) { // 'dst > src' => 'src,dst,>'
 			esil->old = num;
 			esil->cur = num - num2;
 			ret = true;
-			if (rz_reg_get(esil->analysis->reg, dst, -1)) {
+			if (esil_reg_get(esil, dst)) {
 				esil->lastsz = esil_internal_sizeof_reg(esil, dst);
-			} else if (rz_reg_get(esil->analysis->reg, src, -1)) {
+			} else if (esil_reg_get(esil, src)) {
 				esil->lastsz = esil_internal_sizeof_reg(esil, src);
 			} else {
 				// default size is set to 64 as internally operands are ut64
@@ -2739,9 +2780,9 @@ static bool esil_smaller_equal(RzAnalysisEsil *esil) { // 'dst <= src' => 'src,d
 			esil->old = num;
 			esil->cur = num - num2;
 			ret = true;
-			if (rz_reg_get(esil->analysis->reg, dst, -1)) {
+			if (esil_reg_get(esil, dst)) {
 				esil->lastsz = esil_internal_sizeof_reg(esil, dst);
-			} else if (rz_reg_get(esil->analysis->reg, src, -1)) {
+			} else if (esil_reg_get(esil, src)) {
 				esil->lastsz = esil_internal_sizeof_reg(esil, src);
 			} else {
 				// default size is set to 64 as internally operands are ut64
@@ -2765,9 +2806,9 @@ static bool esil_bigger_equal(RzAnalysisEsil *esil) { // 'dst >= src' => 'src,ds
 			esil->old = num;
 			esil->cur = num - num2;
 			ret = true;
-			if (rz_reg_get(esil->analysis->reg, dst, -1)) {
+			if (esil_reg_get(esil, dst)) {
 				esil->lastsz = esil_internal_sizeof_reg(esil, dst);
-			} else if (rz_reg_get(esil->analysis->reg, src, -1)) {
+			} else if (esil_reg_get(esil, src)) {
 				esil->lastsz = esil_internal_sizeof_reg(esil, src);
 			} else {
 				// default size is set to 64 as internally operands are ut64
@@ -2953,7 +2994,7 @@ static int evalWord(RzAnalysisEsil *esil, const char *ostr, const char **str) {
 	return 3;
 }
 
-static bool __stepOut(RzAnalysisEsil *esil, const char *cmd) {
+RZ_IPI bool esil_step_out(RzAnalysisEsil *esil, const char *cmd) {
 	static bool inCmdStep = false;
 	if (cmd && esil && esil->cmd && !inCmdStep) {
 		inCmdStep = true;
@@ -2974,8 +3015,8 @@ RZ_API bool rz_analysis_esil_parse(RzAnalysisEsil *esil, const char *str) {
 	const char *ostr = str;
 	rz_return_val_if_fail(esil && RZ_STR_ISNOTEMPTY(str), 0);
 
-	if (__stepOut(esil, esil->cmd_step)) {
-		(void)__stepOut(esil, esil->cmd_step_out);
+	if (esil_step_out(esil, esil->cmd_step)) {
+		(void)esil_step_out(esil, esil->cmd_step_out);
 		return true;
 	}
 	const char *hashbang = strstr(str, "#!");
@@ -3005,7 +3046,7 @@ repeat:
 		}
 		if (wordi > 62) {
 			ESIL_LOG("Invalid esil string\n");
-			__stepOut(esil, esil->cmd_step_out);
+			esil_step_out(esil, esil->cmd_step_out);
 			return -1;
 		}
 		dorunword = 0;
@@ -3020,7 +3061,7 @@ repeat:
 		if (dorunword) {
 			if (*word) {
 				if (!runword(esil, word)) {
-					__stepOut(esil, esil->cmd_step_out);
+					esil_step_out(esil, esil->cmd_step_out);
 					return 0;
 				}
 				word[wordi] = ',';
@@ -3028,12 +3069,12 @@ repeat:
 				switch (evalWord(esil, ostr, &str)) {
 				case 0: goto loop;
 				case 1:
-					__stepOut(esil, esil->cmd_step_out);
+					esil_step_out(esil, esil->cmd_step_out);
 					return 0;
 				case 2: continue;
 				}
 				if (dorunword == 1) {
-					__stepOut(esil, esil->cmd_step_out);
+					esil_step_out(esil, esil->cmd_step_out);
 					return 0;
 				}
 			}
@@ -3049,18 +3090,18 @@ repeat:
 	word[wordi] = 0;
 	if (*word) {
 		if (!runword(esil, word)) {
-			__stepOut(esil, esil->cmd_step_out);
+			esil_step_out(esil, esil->cmd_step_out);
 			return 0;
 		}
 		switch (evalWord(esil, ostr, &str)) {
 		case 0: goto loop;
 		case 1:
-			__stepOut(esil, esil->cmd_step_out);
+			esil_step_out(esil, esil->cmd_step_out);
 			return 0;
 		case 2: goto repeat;
 		}
 	}
-	__stepOut(esil, esil->cmd_step_out);
+	esil_step_out(esil, esil->cmd_step_out);
 	return 1;
 }
 
@@ -3275,7 +3316,7 @@ RZ_API bool rz_analysis_esil_setup(RzAnalysisEsil *esil, RzAnalysis *analysis, i
 	esil->trap = 0;
 	esil->trap_code = 0;
 	// esil->user = NULL;
-	esil->cb.reg_read = internal_esil_reg_read;
+	esil->cb.reg_read = esil_internal_reg_read;
 	esil->cb.mem_read = internal_esil_mem_read;
 
 	if (nonull) {
@@ -0,0 +1,439 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include "esil_private.h"
+
+/**
+ * \file esil_code.c
+ * \brief Esil expressions compiled once and cached per instruction address.
+ *
+ * rz_analysis_esil_parse() splits the expression in words, looks up each word in
+ * the operations table and resolves the operands by name on every execution.
+ * A compiled expression is an array of words whose operation is already looked up
+ * and whose operands are already resolved to a register or to a number. The "?{"
+ * and "}{" words know where their block ends, so a skipped block is jumped over
+ * instead of being walked word by word.
+ * When an operand is pushed, the stack slot remembers its literal, so the
+ * operations popping it (through isregornum() or rz_analysis_esil_get_parm())
+ * do not resolve the name again.
+ *
+ * The compiled expressions are cached in RzAnalysisEsil.code_cache by address and
+ * are always checked against the expression to run, thus the cache never changes
+ * the result: the entries are dropped on IO writes only to release them early.
+ */
+
+#define ESIL_CODE_CACHE_MAX 0x10000
+#define ESIL_WORD_MAX       62 ///< same limit of rz_analysis_esil_parse()
+#define ESIL_LITERAL_SLOTS  4 ///< stack slots above the top searched for the literal of a popped string
+#define ESIL_OP_SIZE_MAX    64 ///< bytes before a write whose instructions are invalidated
+
+#define ESIL_LOG(fmtstr, ...) \
+	if (esil->verbose) { \
+		RZ_LOG_WARN(fmtstr, ##__VA_ARGS__); \
+	}
+
+typedef enum {
+	ESIL_WORD_PUSH,
+	ESIL_WORD_OP,
+	ESIL_WORD_IF, ///< "?{", the only operation which runs while skipping
+	ESIL_WORD_ELSE, ///< "}{"
+	ESIL_WORD_ENDIF, ///< "}"
+} EsilWordType;
+
+typedef struct esil_word_t {
+	EsilWordType type;
+	RzAnalysisEsilOp *op;
+	RzAnalysisEsilLiteral lit;
+	ut32 next; ///< offset of the next word in the expression
+	ut32 jump; ///< for "?{" and "}{", index of the word after the skipped block, 0 when unbalanced
+} EsilWord;
+
+typedef struct esil_code_t {
+	char *expr; ///< source expression
+	char *strs; ///< NUL-terminated words
+	EsilWord *words; ///< NULL when the expression cannot be compiled
+	size_t n_words;
+	bool todo; ///< the expression starts with "TODO"
+} EsilCode;
+
+static void esil_code_free(EsilCode *code) {
+	if (!code) {
+		return;
+	}
+	free(code->expr);
+	free(code->strs);
+	free(code->words);
+	free(code);
+}
+
+static void esil_code_kv_free(HtUPKv *kv) {
+	esil_code_free(kv->value);
+}
+
+static void esil_word_resolve(RzAnalysisEsil *esil, RzAnalysisEsilLiteral *lit) {
+	RzReg *reg = esil->analysis->reg;
+	lit->reg = reg;
+	lit->reg_gen = reg->profile_gen;
+	lit->item = rz_reg_get(reg, lit->str, -1);
+	lit->isnum = IS_DIGIT(*lit->str);
+	lit->parm_num = rz_analysis_esil_get_parm_type(esil, lit->str) == RZ_ANALYSIS_ESIL_PARM_NUM;
+	lit->num = lit->isnum || lit->parm_num ? rz_num_get(NULL, lit->str) : 0;
+}
+
+/**
+ * Sets the jump of every "?{" to the word after its "}{" or "}" and the jump of
+ * every "}{" to the word after its "}". The words of unbalanced blocks keep 0.
+ */
+static void esil_code_link_blocks(EsilWord *words, size_t n_words) {
+	ut32 *open = RZ_NEWS(ut32, n_words);
+	if (!open) {
+		return;
+	}
+	size_t depth = 0;
+	for (size_t i = 0; i < n_words; i++) {
+		switch (words[i].type) {
+		case ESIL_WORD_IF:
+			open[depth++] = i;
+			break;
+		case ESIL_WORD_ELSE:
+			if (depth && words[open[depth - 1]].type == ESIL_WORD_IF) {
+				words[open[depth - 1]].jump = i + 1;
+				open[depth - 1] = i;
+			}
+			break;
+		case ESIL_WORD_ENDIF:
+			if (depth) {
+				words[open[--depth]].jump = i + 1;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	free(open);
+}
+
+/**
+ * Splits \p expr in words and resolves them; the words are left NULL when the
+ * expression uses a syntax which only rz_analysis_esil_parse() can run:
+ * ';' separators, "#!" commands, empty or too long words.
+ */
+static EsilCode *esil_code_new(RzAnalysisEsil *esil, const char *expr) {
+	EsilCode *code = RZ_NEW0(EsilCode);
+	if (!code || !(code->expr = strdup(expr))) {
+		esil_code_free(code);
+		return NULL;
+	}
+	code->todo = !strncmp(expr, "TODO", 4);
+	if (strchr(expr, ';') || strstr(expr, "#!")) {
+		return code;
+	}
+	size_t n_words = 1;
+	for (const char *p = expr; *p; p++) {
+		n_words += *p == ',';
+	}
+	code->strs = strdup(expr);
+	EsilWord *words = RZ_NEWS0(EsilWord, n_words);
+	if (!code->strs || !words) {
+		free(words);
+		return code;
+	}
+	char *word = code->strs;
+	for (size_t i = 0; i < n_words; i++) {
+		char *end = strchr(word, ',');
+		if (end) {
+			*end = 0;
+		}
+		size_t len = strlen(word);
+		if (!len || len > ESIL_WORD_MAX) {
+			free(words);
+			return code;
+		}
+		EsilWord *w = &words[i];
+		w->lit.str = word;
+		w->next = (word - code->strs) + len + (end ? 1 : 0);
+		if (!strcmp(word, "}{")) {
+			w->type = ESIL_WORD_ELSE;
+		} else if (!strcmp(word, "}")) {
+			w->type = ESIL_WORD_ENDIF;
+		} else if ((w->op = ht_pp_find(esil->ops, word, NULL))) {
+			w->type = !strcmp(word, "?{") ? ESIL_WORD_IF : ESIL_WORD_OP;
+		} else {
+			w->type = ESIL_WORD_PUSH;
+			esil_word_resolve(esil, &w->lit);
+		}
+		word = end ? end + 1 : word + len;
+	}
+	esil_code_link_blocks(words, n_words);
+	code->words = words;
+	code->n_words = n_words;
+	return code;
+}
+
+/**
+ * Forgets the literals of the stack slots, which can point to the words of a freed expression.
+ */
+static void esil_literals_reset(RzAnalysisEsil *esil) {
+	if (esil->stack_literals) {
+		memset(esil->stack_literals, 0, sizeof(*esil->stack_literals) * esil->stacksize);
+	}
+}
+
+/**
+ * \brief Returns the literal \p str was pushed from, when it was just popped from the stack.
+ *
+ * The literal is returned only if its text is the same of \p str and it was
+ * resolved with the current register profile.
+ */
+RZ_IPI const RzAnalysisEsilLiteral *esil_literal_get(RzAnalysisEsil *esil, const char *str) {
+	if (!esil->stack_literals || !str || !esil->analysis) {
+		return NULL;
+	}
+	int end = RZ_MIN(esil->stackptr + ESIL_LITERAL_SLOTS, esil->stacksize);
+	for (int i = RZ_MAX(esil->stackptr, 0); i < end; i++) {
+		const RzAnalysisEsilLiteral *lit = esil->stack_literals[i];
+		if (lit && !strcmp(lit->str, str)) {
+			RzReg *reg = esil->analysis->reg;
+			return lit->reg == reg && lit->reg_gen == reg->profile_gen ? lit : NULL;
+		}
+	}
+	return NULL;
+}
+
+static bool esil_code_runword(RzAnalysisEsil *esil, const EsilWord *w) {
+	esil->parse_goto_count--;
+	if (esil->parse_goto_count < 1) {
+		ESIL_LOG("ESIL infinite loop detected\n");
+		esil->trap = 1; // INTERNAL ERROR
+		esil->parse_stop = 1; // INTERNAL ERROR
+		return false;
+	}
+	switch (w->type) {
+	case ESIL_WORD_ELSE:
+		if (esil->skip == 1) {
+			esil->skip = 0;
+		} else if (esil->skip == 0) {
+			esil->skip = 1;
+		}
+		return true;
+	case ESIL_WORD_ENDIF:
+		if (esil->skip) {
+			esil->skip--;
+		}
+		return true;
+	case ESIL_WORD_PUSH:
+		if (esil->skip) {
+			return true;
+		}
+		if (!rz_analysis_esil_push(esil, w->lit.str)) {
+			ESIL_LOG("ESIL stack is full\n");
+			esil->trap = 1;
+			esil->trap_code = 1;
+			return true;
+		}
+		esil->stack_literals[esil->stackptr - 1] = &w->lit;
+		return true;
+	case ESIL_WORD_OP:
+		if (esil->skip) {
+			return true;
+		}
+		break;
+	case ESIL_WORD_IF:
+		break;
+	}
+	if (esil->cb.hook_command && esil->cb.hook_command(esil, w->lit.str)) {
+		return true;
+	}
+	rz_strbuf_set(&esil->current_opstr, w->lit.str);
+	const bool ret = w->op->code(esil);
+	rz_strbuf_fini(&esil->current_opstr);
+	if (!ret) {
+		ESIL_LOG("%s returned 0\n", w->lit.str);
+	}
+	return ret;
+}
+
+/**
+ * Runs \p code like rz_analysis_esil_parse() runs its expression.
+ */
+static bool esil_code_run(RzAnalysisEsil *esil, const EsilCode *code) {
+	if (esil_step_out(esil, esil->cmd_step)) {
+		(void)esil_step_out(esil, esil->cmd_step_out);
+		return true;
+	}
+	esil->trap = 0;
+	if (code->todo && esil->cmd && esil->cmd_todo) {
+		esil->cmd(esil, esil->cmd_todo, esil->address, 0);
+	}
+	bool ret = true;
+loop:
+	esil->repeat = 0;
+	esil->skip = 0;
+	esil->parse_goto = -1;
+	esil->parse_stop = 0;
+	esil->parse_goto_count = esil->analysis ? esil->analysis->esil_goto_limit : RZ_ANALYSIS_ESIL_GOTO_LIMIT;
+	for (size_t i = 0; i < code->n_words;) {
+		const EsilWord *w = &code->words[i++];
+		const int skip = esil->skip;
+		if (!esil_code_runword(esil, w)) {
+			ret = false;
+			break;
+		}
+		if (esil->repeat) {
+			goto loop;
+		}
+		if (esil->parse_goto != -1) {
+			if (esil->parse_goto < 0 || esil->parse_goto >= code->n_words) {
+				ESIL_LOG("Cannot find word %d\n", esil->parse_goto);
+				ret = false;
+				break;
+			}
+			i = esil->parse_goto;
+			esil->parse_goto = -1;
+			continue;
+		}
+		if (esil->parse_stop) {
+			if (esil->parse_stop == 2) {
+				RZ_LOG_DEBUG("[esil at 0x%08" PFMT64x "] TODO: %s\n", esil->address, code->expr + w->next);
+			}
+			ret = false;
+			break;
+		}
+		if (!skip && esil->skip == 1 && w->jump && !esil->cb.hook_command) {
+			// a block starts being skipped: jump over it, counting its words as executed
+			// like rz_analysis_esil_parse() does. The hook would see the nested "?{".
+			const int skipped = w->jump - i;
+			if (esil->parse_goto_count - skipped >= 1) {
+				esil->parse_goto_count -= skipped;
+				esil->skip = 0;
+				i = w->jump;
+			}
+		}
+	}
+	esil_step_out(esil, esil->cmd_step_out);
+	return ret;
+}
+
+static EsilCode *esil_code_get(RzAnalysisEsil *esil, ut64 addr, const char *expr) {
+	if (!esil->analysis || !esil->analysis->reg || !esil->stack_literals) {
+		return NULL;
+	}
+	if (!esil->code_cache) {
+		esil->code_cache = ht_up_new(NULL, esil_code_kv_free, NULL);
+		if (!esil->code_cache) {
+			return NULL;
+		}
+	}
+	EsilCode *code = ht_up_find(esil->code_cache, addr, NULL);
+	if (code && !strcmp(code->expr, expr)) {
+		RzReg *reg = esil->analysis->reg;
+		bool valid = true;
+		for (size_t i = 0; i < code->n_words; i++) {
+			const EsilWord *w = &code->words[i];
+			if (w->type == ESIL_WORD_PUSH) {
+				// all the words are resolved together, checking the first one is enough
+				valid = w->lit.reg == reg && w->lit.reg_gen == reg->profile_gen;
+				break;
+			}
+		}
+		if (valid) {
+			return code;
+		}
+	}
+	if (code) {
+		esil_literals_reset(esil);
+		ht_up_delete(esil->code_cache, addr);
+	} else if (esil->code_cache->count >= ESIL_CODE_CACHE_MAX) {
+		rz_analysis_esil_code_cache_clear(esil);
+		esil->code_cache = ht_up_new(NULL, esil_code_kv_free, NULL);
+		if (!esil->code_cache) {
+			return NULL;
+		}
+	}
+	code = esil_code_new(esil, expr);
+	if (!code || !ht_up_insert(esil->code_cache, addr, code)) {
+		esil_code_free(code);
+		return NULL;
+	}
+	return code;
+}
+
+/**
+ * \brief Runs the esil expression \p str of the instruction at \p addr.
+ *
+ * It behaves like rz_analysis_esil_parse(), but the expression is compiled
+ * the first time and the compiled code is reused as long as the instruction
+ * at \p addr has the same expression.
+ *
+ * \param esil The RzAnalysisEsil instance
+ * \param addr Address of the instruction \p str belongs to
+ * \param str The esil expression
+ */
+RZ_API bool rz_analysis_esil_parse_at(RZ_NONNULL RzAnalysisEsil *esil, ut64 addr, RZ_NONNULL const char *str) {
+	rz_return_val_if_fail(esil && RZ_STR_ISNOTEMPTY(str), false);
+	EsilCode *code = esil_code_get(esil, addr, str);
+	if (!code || !code->words) {
+		return rz_analysis_esil_parse(esil, str);
+	}
+	return esil_code_run(esil, code);
+}
+
+typedef struct {
+	ut64 from;
+	ut64 to;
+	RzVector /*<ut64>*/ addrs;
+} EsilCodeRange;
+
+static bool esil_code_collect_cb(void *user, const ut64 addr, const void *value) {
+	EsilCodeRange *range = user;
+	if (addr >= range->from && addr < range->to) {
+		rz_vector_push(&range->addrs, (void *)&addr);
+	}
+	return true;
+}
+
+/**
+ * \brief Drops the compiled expressions of the instructions overlapping [addr, addr + size)
+ */
+RZ_API void rz_analysis_esil_code_cache_invalidate(RZ_NONNULL RzAnalysisEsil *esil, ut64 addr, ut64 size) {
+	rz_return_if_fail(esil);
+	if (!esil->code_cache || !esil->code_cache->count || !size) {
+		return;
+	}
+	ut64 from = addr > ESIL_OP_SIZE_MAX ? addr - ESIL_OP_SIZE_MAX : 0;
+	ut64 to = UT64_ADD_OVFCHK(addr, size) ? UT64_MAX : addr + size;
+	esil_literals_reset(esil);
+	if (to - from <= esil->code_cache->count) {
+		for (ut64 at = from; at < to; at++) {
+			ht_up_delete(esil->code_cache, at);
+		}
+		return;
+	}
+	EsilCodeRange range = { .from = from, .to = to };
+	rz_vector_init(&range.addrs, sizeof(ut64), NULL, NULL);
+	ht_up_foreach(esil->code_cache, esil_code_collect_cb, &range);
+	ut64 *at;
+	rz_vector_foreach(&range.addrs, at) {
+		ht_up_delete(esil->code_cache, *at);
+	}
+	rz_vector_fini(&range.addrs);
+}
+
+/**
+ * \brief Drops all the compiled expressions
+ */
+RZ_API void rz_analysis_esil_code_cache_clear(RZ_NONNULL RzAnalysisEsil *esil) {
+	rz_return_if_fail(esil);
+	if (!esil->code_cache) {
+		return;
+	}
+	esil_literals_reset(esil);
+	ht_up_free(esil->code_cache);
+	esil->code_cache = NULL;
+}
+
+RZ_IPI void esil_code_cache_fini(RzAnalysisEsil *esil) {
+	ht_up_free(esil->code_cache);
+	esil->code_cache = NULL;
+}
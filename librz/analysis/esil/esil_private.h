@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#ifndef RZ_ANALYSIS_ESIL_PRIVATE_H
+#define RZ_ANALYSIS_ESIL_PRIVATE_H
+
+#include <rz_analysis.h>
+
+/**
+ * \brief Operand word of a compiled esil expression, resolved when compiled.
+ */
+struct rz_analysis_esil_literal_t {
+	const char *str; ///< the word itself
+	RzReg *reg; ///< RzReg the word was resolved with
+	ut32 reg_gen; ///< RzReg.profile_gen when the word was resolved
+	RzRegItem *item; ///< register named by the word, if any
+	ut64 num; ///< value of the word when it is a number
+	bool isnum; ///< the word starts with a digit
+	bool parm_num; ///< the word is a number for rz_analysis_esil_get_parm()
+};
+
+RZ_IPI bool esil_step_out(RzAnalysisEsil *esil, const char *cmd);
+RZ_IPI int esil_internal_reg_read(RzAnalysisEsil *esil, const char *regname, ut64 *num, int *size);
+RZ_IPI const RzAnalysisEsilLiteral *esil_literal_get(RzAnalysisEsil *esil, const char *str);
+RZ_IPI void esil_code_cache_fini(RzAnalysisEsil *esil);
+
+#endif
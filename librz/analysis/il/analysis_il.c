@@ -87,6 +87,39 @@ RZ_API void rz_analysis_il_config_add_label(RZ_NONNULL RzAnalysisILConfig *cfg,
  * @{
  */
 
+#define IL_CACHE_MAX     0x4000
+#define IL_CODE_SIZE     32 ///< bytes read for lifting a single instruction
+#define IL_OP_SIZE_MAX   IL_CODE_SIZE ///< bytes before a write whose instructions are invalidated
+
+/**
+ * \brief Lifted op of a single instruction, kept as long as the instruction is the same
+ */
+typedef struct {
+	RzILOpEffect *op; ///< lifted effect, never modified by the evaluation
+	RzILCompiled *code; ///< op compiled on its first reuse if RzAnalysisILVM.il_compile is set
+	bool compile_failed; ///< op can not be compiled and is always interpreted
+	RzAnalysisPlugin *plugin; ///< plugin that lifted the op
+	char *cpu; ///< RzAnalysis.cpu when lifted
+	int bits; ///< RzAnalysis.bits when lifted
+	bool big_endian; ///< RzAnalysis.big_endian when lifted
+	int size; ///< size of the instruction
+	ut8 bytes[IL_CODE_SIZE]; ///< first size bytes are the instruction
+} RzAnalysisILCacheEntry;
+
+static void il_cache_entry_free(RzAnalysisILCacheEntry *e) {
+	if (!e) {
+		return;
+	}
+	rz_il_compiled_free(e->code);
+	rz_il_op_effect_free(e->op);
+	free(e->cpu);
+	free(e);
+}
+
+static void il_cache_kv_free(HtUPKv *kv) {
+	il_cache_entry_free(kv->value);
+}
+
 static void setup_vm_from_config(RzAnalysis *analysis, RzAnalysisILVM *vm, RzAnalysisILConfig *cfg);
 static void setup_vm_init_state(RzAnalysisILVM *vm, RZ_NULLABLE RzAnalysisILInitState *is, RZ_NULLABLE RzReg *reg);
 
@@ -105,6 +138,7 @@ RZ_API RZ_OWN RzAnalysisILVM *rz_analysis_il_vm_new(RzAnalysis *a, RZ_NULLABLE R
 	if (!r) {
 		goto ruby_pool;
 	}
+	r->il_cache_max = IL_CACHE_MAX;
 	r->io_buf = rz_buf_new_with_io(&a->iob);
 	setup_vm_from_config(a, r, config);
 	if (!r->vm) {
@@ -126,6 +160,7 @@ RZ_API void rz_analysis_il_vm_free(RZ_NULLABLE RzAnalysisILVM *vm) {
 	if (!vm) {
 		return;
 	}
+	ht_up_free(vm->il_cache);
 	rz_il_vm_free(vm->vm);
 	rz_il_reg_binding_free(vm->reg_binding);
 	rz_buf_free(vm->io_buf);
@@ -228,6 +263,118 @@ RZ_API bool rz_analysis_il_vm_sync_to_reg(RzAnalysisILVM *vm, RZ_NONNULL RzReg *
 	return rz_il_vm_sync_to_reg(vm->vm, vm->reg_binding, reg);
 }
 
+static bool il_cache_has_hints(RzAnalysis *analysis, ut64 addr) {
+	const RzVector *hints = rz_analysis_addr_hints_at(analysis, addr);
+	return hints && !rz_vector_empty(hints);
+}
+
+static bool il_cache_entry_match(RzAnalysis *analysis, RzAnalysisILCacheEntry *e, ut64 addr, const ut8 *code) {
+	return e->plugin == analysis->cur && e->bits == analysis->bits && e->big_endian == analysis->big_endian &&
+		!memcmp(e->bytes, code, e->size) && !rz_str_cmp(e->cpu, analysis->cpu, -1) &&
+		!il_cache_has_hints(analysis, addr);
+}
+
+/**
+ * Get the lifted op of the instruction at \p addr made of \p code from the cache
+ */
+static RzAnalysisILCacheEntry *il_cache_get(RzAnalysis *analysis, RzAnalysisILVM *vm, ut64 addr, const ut8 *code) {
+	if (!vm->il_cache) {
+		return NULL;
+	}
+	RzAnalysisILCacheEntry *e = ht_up_find(vm->il_cache, addr, NULL);
+	if (!e) {
+		return NULL;
+	}
+	if (analysis->coreb.archbits) {
+		// the mode may be different at every address, e.g. arm/thumb
+		analysis->coreb.archbits(analysis->coreb.core, addr);
+	}
+	if (!il_cache_entry_match(analysis, e, addr, code)) {
+		ht_up_delete(vm->il_cache, addr);
+		return NULL;
+	}
+	return e;
+}
+
+/**
+ * Keep the op lifted from \p op in the cache, taking its ownership on success
+ */
+static RzAnalysisILCacheEntry *il_cache_add(RzAnalysis *analysis, RzAnalysisILVM *vm, RzAnalysisOp *op, const ut8 *code) {
+	if (!vm->il_cache_max || op->size <= 0 || op->size > IL_CODE_SIZE) {
+		return NULL;
+	}
+	if (!analysis->cur || !analysis->cur->il_cacheable) {
+		// the lifter may depend on more state than the key, e.g. arm IT blocks
+		return NULL;
+	}
+	if (il_cache_has_hints(analysis, op->addr)) {
+		// hints are applied on top of the lifted op
+		return NULL;
+	}
+	if (!vm->il_cache) {
+		vm->il_cache = ht_up_new(NULL, il_cache_kv_free, NULL);
+		if (!vm->il_cache) {
+			return NULL;
+		}
+	} else if (vm->il_cache->count >= vm->il_cache_max) {
+		ht_up_free(vm->il_cache);
+		vm->il_cache = ht_up_new(NULL, il_cache_kv_free, NULL);
+		if (!vm->il_cache) {
+			return NULL;
+		}
+	}
+	RzAnalysisILCacheEntry *e = RZ_NEW0(RzAnalysisILCacheEntry);
+	if (!e) {
+		return NULL;
+	}
+	e->plugin = analysis->cur;
+	e->cpu = analysis->cpu ? strdup(analysis->cpu) : NULL;
+	e->bits = analysis->bits;
+	e->big_endian = analysis->big_endian;
+	e->size = op->size;
+	memcpy(e->bytes, code, op->size);
+	e->op = op->il_op;
+	if (!ht_up_update(vm->il_cache, op->addr, e)) {
+		e->op = NULL;
+		il_cache_entry_free(e);
+		return NULL;
+	}
+	op->il_op = NULL;
+	return e;
+}
+
+/**
+ * \brief Drop the cached ops of the instructions overlapping [addr, addr + size)
+ *
+ * Needed when the code changes without the vm noticing, e.g. on io writes.
+ * The bytes of the instructions are checked before every reuse anyway,
+ * so this mostly releases memory early.
+ */
+RZ_API void rz_analysis_il_vm_cache_invalidate(RZ_NONNULL RzAnalysisILVM *vm, ut64 addr, ut64 size) {
+	rz_return_if_fail(vm);
+	if (!vm->il_cache || !vm->il_cache->count || !size) {
+		return;
+	}
+	ut64 from = addr > IL_OP_SIZE_MAX ? addr - IL_OP_SIZE_MAX : 0;
+	ut64 to = UT64_ADD_OVFCHK(addr, size) ? UT64_MAX : addr + size;
+	if (to - from > vm->il_cache->count) {
+		rz_analysis_il_vm_cache_clear(vm);
+		return;
+	}
+	for (ut64 at = from; at < to; at++) {
+		ht_up_delete(vm->il_cache, at);
+	}
+}
+
+/**
+ * \brief Drop all the cached ops
+ */
+RZ_API void rz_analysis_il_vm_cache_clear(RZ_NONNULL RzAnalysisILVM *vm) {
+	rz_return_if_fail(vm);
+	ht_up_free(vm->il_cache);
+	vm->il_cache = NULL;
+}
+
 /**
  * Repeatedly perform steps in the VM until the condition callback returns false
  *
@@ -250,17 +397,40 @@ RZ_API RzAnalysisILStepResult rz_analysis_il_vm_step_while(RZ_NONNULL RzAnalysis
 		rz_analysis_il_vm_sync_from_reg(vm, reg);
 	}
 
+	// recycle the nodes of the ops lifted and freed for every step
+	RzILOpPool *prev_pool = rz_il_op_pool_use(vm->vm->op_pool);
 	RzAnalysisILStepResult res = RZ_ANALYSIS_IL_STEP_RESULT_SUCCESS;
 	while (cond(vm, user)) {
 		ut64 addr = rz_bv_to_ut64(vm->vm->pc);
-		ut8 code[32] = { 0 };
+		ut8 code[IL_CODE_SIZE] = { 0 };
 		analysis->read_at(analysis, addr, code, sizeof(code));
 		RzAnalysisOp op = { 0 };
-		int r = rz_analysis_op(analysis, &op, addr, code, sizeof(code), RZ_ANALYSIS_OP_MASK_IL | RZ_ANALYSIS_OP_MASK_HINT);
-		RzILOpEffect *ilop = r < 0 ? NULL : op.il_op;
+		RzILOpEffect *ilop;
+		RzILCompiled *ilcode = NULL;
+		int size;
+		RzAnalysisILCacheEntry *e = il_cache_get(analysis, vm, addr, code);
+		if (e) {
+			vm->il_cache_hits++;
+			ilop = e->op;
+			size = e->size;
+			if (vm->il_compile && !e->code && !e->compile_failed) {
+				e->code = rz_il_compile_effect(vm->vm, e->op);
+				e->compile_failed = !e->code;
+			}
+			ilcode = vm->il_compile ? e->code : NULL;
+		} else {
+			vm->il_cache_misses++;
+			int r = rz_analysis_op(analysis, &op, addr, code, sizeof(code), RZ_ANALYSIS_OP_MASK_IL | RZ_ANALYSIS_OP_MASK_HINT);
+			ilop = r < 0 ? NULL : op.il_op;
+			size = op.size;
+			if (ilop) {
+				il_cache_add(analysis, vm, &op, code);
+			}
+		}
 
 		if (ilop) {
-			bool succ = rz_il_vm_step(vm->vm, ilop, addr + (op.size > 0 ? op.size : 1));
+			ut64 next = addr + (size > 0 ? size : 1);
+			bool succ = ilcode ? rz_il_vm_step_compiled(vm->vm, ilcode, next) : rz_il_vm_step(vm->vm, ilop, next);
 			if (!succ) {
 				res = RZ_ANALYSIS_IL_STEP_IL_RUNTIME_ERROR;
 			}
@@ -273,6 +443,7 @@ RZ_API RzAnalysisILStepResult rz_analysis_il_vm_step_while(RZ_NONNULL RzAnalysis
 			break;
 		}
 	}
+	rz_il_op_pool_use(prev_pool);
 	if (reg) {
 		rz_analysis_il_vm_sync_to_reg(vm, reg);
 	}
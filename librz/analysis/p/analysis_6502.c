@@ -1202,7 +1202,8 @@ RzAnalysisPlugin rz_analysis_plugin_6502 = {
 	.esil = true,
 	.esil_init = esil_6502_init,
 	.esil_fini = esil_6502_fini,
-	.il_config = il_config
+	.il_config = il_config,
+	.il_cacheable = true
 };
 
 #ifndef RZ_PLUGIN_INCORE
@@ -1314,6 +1314,7 @@ RzAnalysisPlugin rz_analysis_plugin_8051 = {
 	.init = &i8051_init,
 	.fini = &i8051_fini,
 	.il_config = il_config,
+	.il_cacheable = true,
 };
 
 #ifndef RZ_PLUGIN_INCORE
@@ -480,6 +480,7 @@ RzAnalysisPlugin rz_analysis_plugin_avr = {
 	.esil_init = rz_avr_esil_init,
 	.esil_fini = rz_avr_esil_fini,
 	.il_config = rz_avr_il_config,
+	.il_cacheable = true,
 	.analysis_mask = analysis_mask_avr,
 };
 
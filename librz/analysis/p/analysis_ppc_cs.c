@@ -1659,6 +1659,7 @@ RzAnalysisPlugin rz_analysis_plugin_ppc_cs = {
 	.op = &analop,
 	.get_reg_profile = &get_reg_profile,
 	.il_config = il_config,
+	.il_cacheable = true,
 };
 
 #ifndef RZ_PLUGIN_INCORE
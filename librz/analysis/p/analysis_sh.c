@@ -1200,7 +1200,8 @@ RzAnalysisPlugin rz_analysis_plugin_sh = {
 	.op = &sh_op,
 	.get_reg_profile = &sh_get_reg_profile,
 	.esil = true,
-	.il_config = rz_sh_il_config
+	.il_config = rz_sh_il_config,
+	.il_cacheable = true
 
 };
 
@@ -53,10 +53,26 @@ call = 4
 #define ARG1_AR   1
 #define ARG2_AR   2
 
+#define X86_DECODE_CACHE_SIZE 128
+#define X86_MAX_INSN_SIZE     16 ///< x86 instructions are at most 15 bytes long
+
+/**
+ * \brief Last capstone decode at an address, reused while the bytes and the mode are the same.
+ */
+typedef struct x86_decode_cache_entry_t {
+	ut64 addr;
+	int mode;
+	ut8 bytes[X86_MAX_INSN_SIZE];
+	cs_insn *insn; ///< NULL if the entry is empty
+} X86DecodeCacheEntry;
+
 typedef struct x86_cs_context_t {
 	csh handle;
 	int omode;
 	cs_insn *insn;
+	X86DecodeCacheEntry cache[X86_DECODE_CACHE_SIZE];
+	ut64 cache_lookups;
+	ut64 cache_hits;
 } X86CSContext;
 
 struct Getarg {
@@ -3150,11 +3166,50 @@ static inline int select_mode(RzAnalysis *a) {
 	}
 }
 
+/**
+ * \brief Decodes the instruction at \p addr in detail mode, or returns the cached decode of the same bytes.
+ *
+ * The same address is usually decoded many times in a row (disassembly, emulation,
+ * function analysis), so the last decode at each slot is kept until it is evicted.
+ * The returned instruction is owned by the cache.
+ */
+static cs_insn *decode_cached(X86CSContext *ctx, int mode, ut64 addr, const ut8 *buf, int len) {
+	X86DecodeCacheEntry *e = &ctx->cache[(addr ^ (addr >> 7)) & (X86_DECODE_CACHE_SIZE - 1)];
+	ctx->cache_lookups++;
+	if (e->insn && e->addr == addr && e->mode == mode && e->insn->size <= len &&
+		!memcmp(e->bytes, buf, e->insn->size)) {
+		ctx->cache_hits++;
+		return e->insn;
+	}
+	cs_insn *insn = NULL;
+	size_t n = cs_disasm(ctx->handle, buf, len, addr, 1, &insn);
+	if (n < 1) {
+		return NULL;
+	}
+	if (e->insn) {
+		cs_free(e->insn, 1);
+	}
+	e->addr = addr;
+	e->mode = mode;
+	memcpy(e->bytes, buf, insn->size);
+	e->insn = insn;
+	return insn;
+}
+
+static void decode_cache_clear(X86CSContext *ctx) {
+	for (size_t i = 0; i < X86_DECODE_CACHE_SIZE; i++) {
+		if (ctx->cache[i].insn) {
+			cs_free(ctx->cache[i].insn, 1);
+			ctx->cache[i].insn = NULL;
+		}
+	}
+}
+
 static int analop(RzAnalysis *a, RzAnalysisOp *op, ut64 addr, const ut8 *buf, int len, RzAnalysisOpMask mask) {
 	X86CSContext *ctx = (X86CSContext *)a->plugin_data;
 
 	int mode = select_mode(a);
-	int n, ret;
+	int ret;
 
 	if (ctx->handle && mode != ctx->omode) {
 		if (ctx->handle != 0) {
@@ -3173,8 +3228,8 @@ static int analop(RzAnalysis *a, RzAnalysisOp *op, ut64 addr, const ut8 *buf, in
 	op->cycles = 1; // aprox
 	cs_option(ctx->handle, CS_OPT_DETAIL, CS_OPT_ON);
 	// capstone-next
-	n = cs_disasm(ctx->handle, (const ut8 *)buf, len, addr, 1, &ctx->insn);
-	if (n < 1) {
+	ctx->insn = len > 0 ? decode_cached(ctx, mode, addr, buf, len) : NULL;
+	if (!ctx->insn) {
 		op->type = RZ_ANALYSIS_OP_TYPE_ILL;
 		if (mask & RZ_ANALYSIS_OP_MASK_DISASM) {
 			op->mnemonic = strdup("invalid");
@@ -3232,7 +3287,7 @@ static int analop(RzAnalysis *a, RzAnalysisOp *op, ut64 addr, const ut8 *buf, in
 			op->family = RZ_ANALYSIS_OP_FAMILY_PRIV;
 		}
 #endif
-		cs_free(ctx->insn, n);
+		ctx->insn = NULL;
 	}
 	// cs_close (&ctx->handle);
 	return op->size;
@@ -3258,9 +3313,18 @@ static bool x86_init(void **user) {
 	return true;
 }
 
+static bool x86_decode_cache_stats(RzAnalysis *analysis, ut64 *hits, ut64 *lookups) {
+	X86CSContext *ctx = (X86CSContext *)analysis->plugin_data;
+	*hits = ctx->cache_hits;
+	*lookups = ctx->cache_lookups;
+	return true;
+}
+
 static bool x86_fini(void *user) {
 	rz_return_val_if_fail(user, false);
 	X86CSContext *ctx = (X86CSContext *)user;
+	RZ_LOG_DEBUG("x86: decode cache hits %" PFMT64u "/%" PFMT64u "\n", ctx->cache_hits, ctx->cache_lookups);
+	decode_cache_clear(ctx);
 	cs_close(&ctx->handle);
 	free(ctx);
 	return true;
@@ -3783,6 +3847,8 @@ RzAnalysisPlugin rz_analysis_plugin_x86_cs = {
 	.esil_init = esil_x86_cs_init,
 	.esil_fini = esil_x86_cs_fini,
 	.il_config = rz_x86_il_config,
+	.il_cacheable = true,
+	.decode_cache_stats = x86_decode_cache_stats,
 	//	.esil_intr = esil_x86_cs_intr,
 };
 
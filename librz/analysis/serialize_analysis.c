@@ -1201,42 +1201,55 @@ RZ_API bool rz_serialize_analysis_function_noreturn_load(RZ_NONNULL Sdb *db, RZ_
 	return true;
 }
 
-static bool store_xref_cb(void *j, const ut64 k, const void *v) {
-	const RzAnalysisXRef *xref = v;
-	pj_o(j);
-	pj_kn(j, "to", k);
-	if (xref->type != RZ_ANALYSIS_XREF_TYPE_NULL) {
-		char type[2] = { xref->type, '\0' };
-		pj_ks(j, "type", type);
+typedef struct {
+	Sdb *db;
+	PJ *j; ///< array of the xrefs from the current address
+	ut64 from;
+} XRefsSaveCtx;
+
+static void store_xrefs_list(XRefsSaveCtx *ctx) {
+	char key[0x20];
+	pj_end(ctx->j);
+	if (snprintf(key, sizeof(key), "0x%" PFMT64x, ctx->from) >= 0) {
+		sdb_set(ctx->db, key, pj_string(ctx->j), 0);
 	}
-	pj_end(j);
-	return true;
+	pj_free(ctx->j);
+	ctx->j = NULL;
 }
 
-static bool store_xrefs_list_cb(void *db, const ut64 k, const void *v) {
-	char key[0x20];
-	if (snprintf(key, sizeof(key), "0x%" PFMT64x, k) < 0) {
-		return false;
+static bool store_xref_cb(const RzAnalysisXRef *xref, void *user) {
+	XRefsSaveCtx *ctx = user;
+	if (ctx->j && ctx->from != xref->from) {
+		store_xrefs_list(ctx);
 	}
-	PJ *j = pj_new();
-	if (!j) {
-		return false;
+	if (!ctx->j) {
+		ctx->j = pj_new();
+		if (!ctx->j) {
+			return false;
+		}
+		ctx->from = xref->from;
+		pj_a(ctx->j);
 	}
-	pj_a(j);
-	HtUP *ht = (HtUP *)v;
-	ht_up_foreach(ht, store_xref_cb, j);
-	pj_end(j);
-	sdb_set(db, key, pj_string(j), 0);
-	pj_free(j);
+	pj_o(ctx->j);
+	pj_kn(ctx->j, "to", xref->to);
+	if (xref->type != RZ_ANALYSIS_XREF_TYPE_NULL) {
+		char type[2] = { xref->type, '\0' };
+		pj_ks(ctx->j, "type", type);
+	}
+	pj_end(ctx->j);
 	return true;
 }
 
 RZ_API void rz_serialize_analysis_xrefs_save(RZ_NONNULL Sdb *db, RZ_NONNULL RzAnalysis *analysis) {
-	ht_up_foreach(analysis->ht_xrefs_from, store_xrefs_list_cb, db);
+	XRefsSaveCtx ctx = { db, NULL, 0 };
+	rz_analysis_xrefs_foreach(analysis, store_xref_cb, &ctx);
+	if (ctx.j) {
+		store_xrefs_list(&ctx);
+	}
 }
 
 static bool xrefs_load_cb(void *user, const char *k, const char *v) {
-	RzAnalysis *analysis = user;
+	RzVector *xrefs = user;
 
 	errno = 0;
 	ut64 from = strtoull(k, NULL, 0);
@@ -1284,7 +1297,8 @@ static bool xrefs_load_cb(void *user, const char *k, const char *v) {
 			}
 		}
 
-		rz_analysis_xrefs_set(analysis, from, to, type);
+		RzAnalysisXRef xref = { from, to, type };
+		rz_vector_push(xrefs, &xref);
 	}
 
 	rz_json_free(json);
@@ -1298,10 +1312,16 @@ error:
 }
 
 RZ_API bool rz_serialize_analysis_xrefs_load(RZ_NONNULL Sdb *db, RZ_NONNULL RzAnalysis *analysis, RZ_NULLABLE RzSerializeResultInfo *res) {
-	bool ret = sdb_foreach(db, xrefs_load_cb, analysis);
+	RzVector xrefs;
+	rz_vector_init(&xrefs, sizeof(RzAnalysisXRef), NULL, NULL);
+	bool ret = sdb_foreach(db, xrefs_load_cb, &xrefs);
 	if (!ret) {
 		RZ_SERIALIZE_ERR(res, "xrefs parsing failed");
+	} else {
+		// sorting all xrefs at once is much faster than adding them one by one
+		rz_analysis_xrefs_set_bulk(analysis, xrefs.a, rz_vector_len(&xrefs));
 	}
+	rz_vector_fini(&xrefs);
 	return ret;
 }
 
@@ -6,21 +6,61 @@
 
 #include <rz_analysis.h>
 #include <rz_cons.h>
-
-#if 0
-DICT
-====
-
-refs 10->20 C 16->10 J 20->10 C
-
-	xrefs 20->[10 C] 10 -> [16 J, 20 C]
-
-	10 : call 20 16 : jmp 10 20 : call 10
-#endif
+#include <math.h>
+
+/*
+ * Xrefs are stored in two orders, by (from, to) to answer "xrefs from" and by (to, from)
+ * to answer "xrefs to". Each order keeps its xrefs in sorted columns, split in a large
+ * main run and a small delta run, so lookups and range queries are binary searches and
+ * an xref takes 2 * 17 bytes instead of separately allocated structs in nested hashtables.
+ *
+ * New xrefs are appended to an unsorted pending buffer, which is sorted and merged into the
+ * delta runs as a batch when it gets full. Queries never modify the index, they merge a sorted
+ * copy of the matching pending xrefs on the fly. The delta runs are merged into the main runs
+ * once they exceed about 16 * sqrt(main size), which bounds the cost of the merges per added xref.
+ * Since adding and deleting xrefs can merge the runs, it must not be done by the callback of
+ * an rz_analysis_xrefs_foreach*() iteration, which walks the runs in place.
+ * A (from, to) pair is stored only once, setting it again updates its type in place and
+ * deleting it marks it as deleted until the next merge into the main runs.
+ */
 
 // XXX: is it possible to have multiple type for the same (from, to) pair?
 //      if it is, things need to be adjusted
 
+#define XREF_DELETED            0xff
+#define XREFS_PENDING_MAX       1024
+#define XREFS_DELTA_MIN         4096
+#define XREFS_QUERY_PENDING_MAX 32
+
+typedef enum {
+	XREFS_BY_FROM,
+	XREFS_BY_TO,
+	XREFS_ORDERS
+} XRefsOrder;
+
+typedef struct {
+	ut64 *key; ///< from for XREFS_BY_FROM, to for XREFS_BY_TO
+	ut64 *val; ///< the other address of the xref
+	ut8 *type; ///< RzAnalysisXRefType or XREF_DELETED
+	size_t count;
+	size_t capacity;
+} XRefsRun;
+
+typedef struct {
+	ut64 from;
+	ut64 to;
+	size_t seq; ///< order of insertion, the last one of the same (from, to) wins
+	RzAnalysisXRefType type;
+} PendingXRef;
+
+struct rz_analysis_xref_index_t {
+	XRefsRun main[XREFS_ORDERS];
+	XRefsRun delta[XREFS_ORDERS];
+	RzVector /*<PendingXRef>*/ pending;
+	size_t deleted; ///< xrefs marked as deleted in the main and delta runs
+	size_t seq; ///< insertion counter for the pending xrefs
+};
+
 static RzAnalysisXRef *rz_analysis_xref_new(ut64 from, ut64 to, ut64 type) {
 	RzAnalysisXRef *xref = RZ_NEW(RzAnalysisXRef);
 	if (xref) {
@@ -31,91 +71,393 @@ static RzAnalysisXRef *rz_analysis_xref_new(ut64 from, ut64 to, ut64 type) {
 	return xref;
 }
 
-static void rz_analysis_xref_free(RzAnalysisXRef *xref) {
-	free(xref);
-}
-
 RZ_API RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xref_list_new() {
 	return rz_list_newf((RzListFree)free);
 }
 
-static void xrefs_ht_free(HtUPKv *kv) {
-	ht_up_free(kv->value);
+static int ref_cmp(const RzAnalysisXRef *a, const RzAnalysisXRef *b) {
+	if (a->from < b->from) {
+		return -1;
+	}
+	if (a->from > b->from) {
+		return 1;
+	}
+	if (a->to < b->to) {
+		return -1;
+	}
+	if (a->to > b->to) {
+		return 1;
+	}
+	return 0;
 }
 
-static void xrefs_ref_free(HtUPKv *kv) {
-	rz_analysis_xref_free(kv->value);
+static void run_fini(XRefsRun *run) {
+	free(run->key);
+	free(run->val);
+	free(run->type);
+	memset(run, 0, sizeof(*run));
 }
 
-static bool appendRef(void *u, const ut64 k, const void *v) {
-	RzList *list = (RzList *)u;
-	RzAnalysisXRef *xref = (RzAnalysisXRef *)v;
-	RzAnalysisXRef *cloned = rz_analysis_xref_new(xref->from, xref->to, xref->type);
-	if (cloned) {
-		rz_list_append(list, cloned);
+static bool run_reserve(XRefsRun *run, size_t count) {
+	if (count <= run->capacity) {
 		return true;
 	}
-	return false;
+	size_t capacity = RZ_MAX(count, run->capacity + run->capacity / 2);
+	ut64 *key = realloc(run->key, capacity * sizeof(ut64));
+	if (!key) {
+		return false;
+	}
+	run->key = key;
+	ut64 *val = realloc(run->val, capacity * sizeof(ut64));
+	if (!val) {
+		return false;
+	}
+	run->val = val;
+	ut8 *type = realloc(run->type, capacity);
+	if (!type) {
+		return false;
+	}
+	run->type = type;
+	run->capacity = capacity;
+	return true;
+}
+
+static inline bool run_less(const XRefsRun *run, size_t i, ut64 key, ut64 val) {
+	return run->key[i] < key || (run->key[i] == key && run->val[i] < val);
+}
+
+static size_t run_lower_bound(const XRefsRun *run, ut64 key, ut64 val) {
+	size_t lo = 0;
+	size_t hi = run->count;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (run_less(run, mid, key, val)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+static ut8 *run_find(const XRefsRun *run, ut64 key, ut64 val) {
+	size_t i = run_lower_bound(run, key, val);
+	return i < run->count && run->key[i] == key && run->val[i] == val ? &run->type[i] : NULL;
+}
+
+static void run_compact(XRefsRun *run) {
+	size_t w = 0;
+	for (size_t i = 0; i < run->count; i++) {
+		if (run->type[i] == XREF_DELETED) {
+			continue;
+		}
+		run->key[w] = run->key[i];
+		run->val[w] = run->val[i];
+		run->type[w] = run->type[i];
+		w++;
+	}
+	run->count = w;
+}
+
+/**
+ * Merge the xrefs of \p src into \p dst, from the back so no temporary copy is needed.
+ * Both must be sorted, disjoint, and \p dst must already have room for both.
+ */
+static void run_merge(XRefsRun *dst, const XRefsRun *src) {
+	rz_return_if_fail(dst->capacity >= dst->count + src->count);
+	size_t i = dst->count;
+	size_t j = src->count;
+	size_t w = i + j;
+	while (j) {
+		w--;
+		if (i && !run_less(dst, i - 1, src->key[j - 1], src->val[j - 1])) {
+			i--;
+			dst->key[w] = dst->key[i];
+			dst->val[w] = dst->val[i];
+			dst->type[w] = dst->type[i];
+		} else {
+			j--;
+			dst->key[w] = src->key[j];
+			dst->val[w] = src->val[j];
+			dst->type[w] = src->type[j];
+		}
+	}
+	dst->count += src->count;
+}
+
+static int pending_cmp_from(const void *a, const void *b) {
+	const PendingXRef *x = a;
+	const PendingXRef *y = b;
+	if (x->from != y->from) {
+		return x->from < y->from ? -1 : 1;
+	}
+	if (x->to != y->to) {
+		return x->to < y->to ? -1 : 1;
+	}
+	return x->seq < y->seq ? -1 : (x->seq > y->seq);
 }
 
-static bool mylistrefs_cb(void *list, const ut64 k, const void *v) {
-	HtUP *ht = (HtUP *)v;
-	ht_up_foreach(ht, appendRef, list);
+static int pending_cmp_to(const void *a, const void *b) {
+	const PendingXRef *x = a;
+	const PendingXRef *y = b;
+	if (x->to != y->to) {
+		return x->to < y->to ? -1 : 1;
+	}
+	if (x->from != y->from) {
+		return x->from < y->from ? -1 : 1;
+	}
+	return x->seq < y->seq ? -1 : (x->seq > y->seq);
+}
+
+static RzAnalysisXRefIndex *xref_index_new(void) {
+	RzAnalysisXRefIndex *idx = RZ_NEW0(RzAnalysisXRefIndex);
+	if (!idx) {
+		return NULL;
+	}
+	rz_vector_init(&idx->pending, sizeof(PendingXRef), NULL, NULL);
+	return idx;
+}
+
+static void xref_index_free(RzAnalysisXRefIndex *idx) {
+	if (!idx) {
+		return;
+	}
+	for (int o = 0; o < XREFS_ORDERS; o++) {
+		run_fini(&idx->main[o]);
+		run_fini(&idx->delta[o]);
+	}
+	rz_vector_fini(&idx->pending);
+	free(idx);
+}
+
+static size_t xref_index_delta_max(RzAnalysisXRefIndex *idx) {
+	return RZ_MAX(XREFS_DELTA_MIN, (size_t)sqrt((double)idx->main[XREFS_BY_FROM].count) * 16);
+}
+
+static bool xref_index_flush_pending(RzAnalysisXRefIndex *idx) {
+	size_t count = rz_vector_len(&idx->pending);
+	if (!count) {
+		return true;
+	}
+	PendingXRef *pending = idx->pending.a;
+	qsort(pending, count, sizeof(PendingXRef), pending_cmp_from);
+	size_t unique = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (i + 1 < count && pending[i + 1].from == pending[i].from && pending[i + 1].to == pending[i].to) {
+			continue;
+		}
+		pending[unique++] = pending[i];
+	}
+	idx->pending.len = unique;
+	XRefsRun tmp = { 0 };
+	if (!run_reserve(&tmp, unique) ||
+		!run_reserve(&idx->delta[XREFS_BY_FROM], idx->delta[XREFS_BY_FROM].count + unique) ||
+		!run_reserve(&idx->delta[XREFS_BY_TO], idx->delta[XREFS_BY_TO].count + unique)) {
+		run_fini(&tmp);
+		return false;
+	}
+	for (int o = 0; o < XREFS_ORDERS; o++) {
+		if (o == XREFS_BY_TO) {
+			qsort(pending, unique, sizeof(PendingXRef), pending_cmp_to);
+		}
+		for (size_t i = 0; i < unique; i++) {
+			tmp.key[i] = o == XREFS_BY_FROM ? pending[i].from : pending[i].to;
+			tmp.val[i] = o == XREFS_BY_FROM ? pending[i].to : pending[i].from;
+			tmp.type[i] = pending[i].type;
+		}
+		tmp.count = unique;
+		run_merge(&idx->delta[o], &tmp);
+	}
+	run_fini(&tmp);
+	rz_vector_clear(&idx->pending);
 	return true;
 }
 
-static int ref_cmp(const RzAnalysisXRef *a, const RzAnalysisXRef *b) {
-	if (a->from < b->from) {
-		return -1;
+/**
+ * Merge all pending xrefs into the sorted runs, and the delta runs into the main runs
+ * if they got too large or \p force is set.
+ */
+static bool xref_index_flush(RzAnalysisXRefIndex *idx, bool force) {
+	if (!xref_index_flush_pending(idx)) {
+		return false;
 	}
-	if (a->from > b->from) {
-		return 1;
+	size_t delta_max = xref_index_delta_max(idx);
+	if (!force && idx->delta[XREFS_BY_FROM].count <= delta_max && idx->deleted <= delta_max) {
+		return true;
 	}
-	if (a->to < b->to) {
-		return -1;
+	for (int o = 0; o < XREFS_ORDERS; o++) {
+		run_compact(&idx->main[o]);
+		run_compact(&idx->delta[o]);
 	}
-	if (a->to > b->to) {
-		return 1;
+	idx->deleted = 0;
+	size_t count = idx->main[XREFS_BY_FROM].count + idx->delta[XREFS_BY_FROM].count;
+	if (!run_reserve(&idx->main[XREFS_BY_FROM], count) || !run_reserve(&idx->main[XREFS_BY_TO], count)) {
+		return false;
 	}
-	return 0;
+	for (int o = 0; o < XREFS_ORDERS; o++) {
+		run_merge(&idx->main[o], &idx->delta[o]);
+		idx->delta[o].count = 0;
+		if (idx->delta[o].capacity > 2 * xref_index_delta_max(idx)) {
+			// a bulk build went through the delta runs
+			run_fini(&idx->delta[o]);
+		}
+	}
+	return true;
 }
 
-static void sortxrefs(RzList /*<RzAnalysisXRef *>*/ *list) {
-	rz_list_sort(list, (RzListComparator)ref_cmp);
+/**
+ * Find the type of the stored xref \p key -> \p val (or \p val -> \p key) in the runs of order \p o
+ */
+static ut8 *xref_index_find(RzAnalysisXRefIndex *idx, XRefsOrder o, ut64 key, ut64 val) {
+	ut8 *type = run_find(&idx->main[o], key, val);
+	return type ? type : run_find(&idx->delta[o], key, val);
 }
 
-static void listxrefs(HtUP *m, ut64 addr, RzList /*<RzAnalysisXRef *>*/ *list) {
-	if (addr == UT64_MAX) {
-		ht_up_foreach(m, mylistrefs_cb, list);
-	} else {
-		HtUP *d = ht_up_find(m, addr, NULL);
-		if (d) {
-			ht_up_foreach(d, appendRef, list);
+static bool xref_index_set(RzAnalysisXRefIndex *idx, ut64 from, ut64 to, RzAnalysisXRefType type) {
+	ut8 *from_type = xref_index_find(idx, XREFS_BY_FROM, from, to);
+	if (from_type) {
+		ut8 *to_type = xref_index_find(idx, XREFS_BY_TO, to, from);
+		rz_return_val_if_fail(to_type, false);
+		if (*from_type == XREF_DELETED) {
+			idx->deleted--;
 		}
+		*from_type = *to_type = type;
+		return true;
 	}
+	PendingXRef *xref = rz_vector_push(&idx->pending, NULL);
+	if (!xref) {
+		return false;
+	}
+	xref->from = from;
+	xref->to = to;
+	xref->seq = idx->seq++;
+	xref->type = type;
+	return true;
 }
 
-static bool set_xref(HtUP *m, RzAnalysisXRef *xref, bool from2to) {
-	ut64 key1 = from2to ? xref->from : xref->to;
-	HtUP *ht = ht_up_find(m, key1, NULL);
-	if (!ht) {
-		// RzAnalysis::ht_xrefs_to is responsible for releasing of pointers.
-		HtUPKvFreeFunc cb = from2to ? NULL : xrefs_ref_free;
-		ht = ht_up_new(NULL, cb, NULL);
-		if (!ht) {
-			return false;
+static bool xref_index_del(RzAnalysisXRefIndex *idx, ut64 from, ut64 to) {
+	bool deleted = false;
+	ut8 *from_type = xref_index_find(idx, XREFS_BY_FROM, from, to);
+	if (from_type && *from_type != XREF_DELETED) {
+		ut8 *to_type = xref_index_find(idx, XREFS_BY_TO, to, from);
+		rz_return_val_if_fail(to_type, false);
+		*from_type = *to_type = XREF_DELETED;
+		idx->deleted++;
+		deleted = true;
+	}
+	for (size_t i = rz_vector_len(&idx->pending); i; i--) {
+		PendingXRef *xref = rz_vector_index_ptr(&idx->pending, i - 1);
+		if (xref->from == from && xref->to == to) {
+			rz_vector_remove_at(&idx->pending, i - 1, NULL);
+			deleted = true;
 		}
-		if (!ht_up_insert(m, key1, ht)) {
-			return false;
+	}
+	return deleted;
+}
+
+static size_t pending_count_in(RzAnalysisXRefIndex *idx, XRefsOrder o, ut64 lo, ut64 hi) {
+	size_t count = 0;
+	PendingXRef *xref;
+	rz_vector_foreach(&idx->pending, xref) {
+		ut64 key = o == XREFS_BY_FROM ? xref->from : xref->to;
+		count += key >= lo && key <= hi;
+	}
+	return count;
+}
+
+/**
+ * Copy the \p count pending xrefs whose address of order \p o is in [\p lo, \p hi] into \p run,
+ * sorted by that order and keeping only the last one set of each (from, to) pair, so queries can
+ * merge them on the fly without touching the index.
+ * \p run must have room for \p count xrefs.
+ */
+static bool pending_collect(RzAnalysisXRefIndex *idx, XRefsOrder o, ut64 lo, ut64 hi, size_t count, XRefsRun *run) {
+	PendingXRef stack[XREFS_QUERY_PENDING_MAX];
+	PendingXRef *found = count <= XREFS_QUERY_PENDING_MAX ? stack : malloc(count * sizeof(PendingXRef));
+	if (!found) {
+		return false;
+	}
+	size_t n = 0;
+	PendingXRef *xref;
+	rz_vector_foreach(&idx->pending, xref) {
+		ut64 key = o == XREFS_BY_FROM ? xref->from : xref->to;
+		if (key >= lo && key <= hi) {
+			found[n++] = *xref;
 		}
 	}
-	ut64 key2 = from2to ? xref->to : xref->from;
-	return ht_up_update(ht, key2, xref);
+	qsort(found, n, sizeof(PendingXRef), o == XREFS_BY_FROM ? pending_cmp_from : pending_cmp_to);
+	run->count = 0;
+	for (size_t i = 0; i < n; i++) {
+		if (i + 1 < n && found[i + 1].from == found[i].from && found[i + 1].to == found[i].to) {
+			continue;
+		}
+		run->key[run->count] = o == XREFS_BY_FROM ? found[i].from : found[i].to;
+		run->val[run->count] = o == XREFS_BY_FROM ? found[i].to : found[i].from;
+		run->type[run->count] = found[i].type;
+		run->count++;
+	}
+	if (found != stack) {
+		free(found);
+	}
+	return true;
 }
 
-// Set a cross reference from FROM to TO.
-RZ_API bool rz_analysis_xrefs_set(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type) {
-	if (!analysis || from == to) {
+/**
+ * Call \p cb for the xrefs whose address of order \p o is in [\p lo, \p hi], sorted by that order.
+ * The index is never modified, the matching pending xrefs are merged into the iteration from a copy.
+ */
+static bool xref_index_foreach(RzAnalysisXRefIndex *idx, XRefsOrder o, ut64 lo, ut64 hi, RzAnalysisXRefCb cb, void *user) {
+	ut64 pending_key[XREFS_QUERY_PENDING_MAX];
+	ut64 pending_val[XREFS_QUERY_PENDING_MAX];
+	ut8 pending_type[XREFS_QUERY_PENDING_MAX];
+	XRefsRun pending = { pending_key, pending_val, pending_type, 0, XREFS_QUERY_PENDING_MAX };
+	XRefsRun many = { 0 };
+	size_t count = pending_count_in(idx, o, lo, hi);
+	XRefsRun *collected = count > XREFS_QUERY_PENDING_MAX ? &many : &pending;
+	if (!run_reserve(collected, count) || !pending_collect(idx, o, lo, hi, count, collected)) {
+		run_fini(&many);
+		return false;
+	}
+	const XRefsRun *runs[] = { &idx->main[o], &idx->delta[o], collected };
+	size_t pos[RZ_ARRAY_SIZE(runs)];
+	for (size_t r = 0; r < RZ_ARRAY_SIZE(runs); r++) {
+		pos[r] = run_lower_bound(runs[r], lo, 0);
+	}
+	bool ret = true;
+	RzAnalysisXRef xref;
+	while (true) {
+		const XRefsRun *run = NULL;
+		size_t *k = NULL;
+		for (size_t r = 0; r < RZ_ARRAY_SIZE(runs); r++) {
+			if (pos[r] >= runs[r]->count || runs[r]->key[pos[r]] > hi) {
+				continue;
+			}
+			if (!run || run_less(runs[r], pos[r], run->key[*k], run->val[*k])) {
+				run = runs[r];
+				k = &pos[r];
+			}
+		}
+		if (!run) {
+			break;
+		}
+		size_t i = (*k)++;
+		if (run->type[i] == XREF_DELETED) {
+			continue;
+		}
+		xref.from = o == XREFS_BY_FROM ? run->key[i] : run->val[i];
+		xref.to = o == XREFS_BY_FROM ? run->val[i] : run->key[i];
+		xref.type = run->type[i];
+		if (!cb(&xref, user)) {
+			ret = false;
+			break;
+		}
+	}
+	run_fini(&many);
+	return ret;
+}
+
+static bool xref_valid(RzAnalysis *analysis, ut64 from, ut64 to) {
+	if (from == to) {
 		return false;
 	}
 	if (analysis->iob.is_valid_offset) {
@@ -126,37 +468,55 @@ RZ_API bool rz_analysis_xrefs_set(RzAnalysis *analysis, ut64 from, ut64 to, RzAn
 			return false;
 		}
 	}
-	RzAnalysisXRef *xref = rz_analysis_xref_new(from, to, type);
-	if (!xref) {
+	return true;
+}
+
+static RzAnalysisXRefType xref_type(RzAnalysisXRefType type) {
+	return type == -1 ? RZ_ANALYSIS_XREF_TYPE_CODE : type;
+}
+
+// Set a cross reference from FROM to TO.
+RZ_API bool rz_analysis_xrefs_set(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type) {
+	if (!analysis || !xref_valid(analysis, from, to)) {
 		return false;
 	}
-	if (!set_xref(analysis->ht_xrefs_from, xref, true)) {
-		// Pointer isn't added to <ht_xrefs_from> so we have to release it
-		rz_analysis_xref_free(xref);
+	if (!xref_index_set(analysis->xref_index, from, to, xref_type(type))) {
 		return false;
 	}
-	if (!set_xref(analysis->ht_xrefs_to, xref, false)) {
-		// Delete the entry in <ht_xrefs_from>
-		rz_analysis_xrefs_deln(analysis, from, to, type);
-		// Pointer isn't added to <ht_xrefs_to> so we have to release it
-		rz_analysis_xref_free(xref);
-		return false;
+	if (rz_vector_len(&analysis->xref_index->pending) >= XREFS_PENDING_MAX) {
+		xref_index_flush(analysis->xref_index, false);
 	}
 	return true;
 }
 
+/**
+ * \brief Set all \p count xrefs of \p xrefs at once
+ *
+ * Equivalent to calling rz_analysis_xrefs_set() on each of them, but they are sorted
+ * and merged into the index in a single batch, which is much faster for many xrefs.
+ *
+ * \return the number of xrefs that were set
+ */
+RZ_API size_t rz_analysis_xrefs_set_bulk(RzAnalysis *analysis, RZ_NONNULL const RzAnalysisXRef *xrefs, size_t count) {
+	rz_return_val_if_fail(analysis && (xrefs || !count), 0);
+	size_t set = 0;
+	rz_vector_reserve(&analysis->xref_index->pending, rz_vector_len(&analysis->xref_index->pending) + count);
+	for (size_t i = 0; i < count; i++) {
+		const RzAnalysisXRef *xref = &xrefs[i];
+		if (xref_valid(analysis, xref->from, xref->to) &&
+			xref_index_set(analysis->xref_index, xref->from, xref->to, xref_type(xref->type))) {
+			set++;
+		}
+	}
+	xref_index_flush(analysis->xref_index, true);
+	return set;
+}
+
 RZ_API bool rz_analysis_xrefs_deln(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type) {
 	if (!analysis) {
 		return false;
 	}
-	HtUP *ht1 = ht_up_find(analysis->ht_xrefs_from, from, NULL);
-	if (ht1) {
-		ht_up_delete(ht1, to);
-	}
-	HtUP *ht2 = ht_up_find(analysis->ht_xrefs_to, to, NULL);
-	if (ht2) {
-		ht_up_delete(ht2, from);
-	}
+	xref_index_del(analysis->xref_index, from, to);
 	return true;
 }
 
@@ -170,27 +530,71 @@ RZ_API bool rz_analysis_xref_del(RzAnalysis *analysis, ut64 from, ut64 to) {
 	return res;
 }
 
-RZ_API RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_to(RzAnalysis *analysis, ut64 addr) {
-	RzList *list = rz_analysis_xref_list_new();
-	if (!list) {
-		return NULL;
+static ut64 range_last(ut64 addr, ut64 size) {
+	return addr + size - 1 < addr ? UT64_MAX : addr + size - 1;
+}
+
+/**
+ * \brief Call \p cb on all xrefs, sorted by (from, to)
+ *
+ * \p cb gets a temporary xref. It may query xrefs, but must not add or delete them,
+ * since that may merge the iterated runs. Iteration stops when \p cb returns false.
+ * \return false if the iteration was stopped
+ */
+RZ_API bool rz_analysis_xrefs_foreach(RzAnalysis *analysis, RzAnalysisXRefCb cb, void *user) {
+	rz_return_val_if_fail(analysis && cb, false);
+	return xref_index_foreach(analysis->xref_index, XREFS_BY_FROM, 0, UT64_MAX, cb, user);
+}
+
+/**
+ * \brief Call \p cb on all xrefs from \p addr, sorted by to, see rz_analysis_xrefs_foreach()
+ */
+RZ_API bool rz_analysis_xrefs_foreach_from(RzAnalysis *analysis, ut64 addr, RzAnalysisXRefCb cb, void *user) {
+	rz_return_val_if_fail(analysis && cb, false);
+	return xref_index_foreach(analysis->xref_index, XREFS_BY_FROM, addr, addr, cb, user);
+}
+
+/**
+ * \brief Call \p cb on all xrefs to \p addr, sorted by from, see rz_analysis_xrefs_foreach()
+ */
+RZ_API bool rz_analysis_xrefs_foreach_to(RzAnalysis *analysis, ut64 addr, RzAnalysisXRefCb cb, void *user) {
+	rz_return_val_if_fail(analysis && cb, false);
+	return xref_index_foreach(analysis->xref_index, XREFS_BY_TO, addr, addr, cb, user);
+}
+
+/**
+ * \brief Call \p cb on all xrefs from [\p addr, \p addr + \p size), sorted by (from, to), see rz_analysis_xrefs_foreach()
+ */
+RZ_API bool rz_analysis_xrefs_foreach_from_in(RzAnalysis *analysis, ut64 addr, ut64 size, RzAnalysisXRefCb cb, void *user) {
+	rz_return_val_if_fail(analysis && cb, false);
+	if (!size) {
+		return true;
 	}
-	listxrefs(analysis->ht_xrefs_to, addr, list);
-	sortxrefs(list);
-	if (rz_list_empty(list)) {
-		rz_list_free(list);
-		list = NULL;
+	return xref_index_foreach(analysis->xref_index, XREFS_BY_FROM, addr, range_last(addr, size), cb, user);
+}
+
+/**
+ * \brief Call \p cb on all xrefs to [\p addr, \p addr + \p size), sorted by (to, from), see rz_analysis_xrefs_foreach()
+ */
+RZ_API bool rz_analysis_xrefs_foreach_to_in(RzAnalysis *analysis, ut64 addr, ut64 size, RzAnalysisXRefCb cb, void *user) {
+	rz_return_val_if_fail(analysis && cb, false);
+	if (!size) {
+		return true;
 	}
-	return list;
+	return xref_index_foreach(analysis->xref_index, XREFS_BY_TO, addr, range_last(addr, size), cb, user);
 }
 
-RZ_API RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_from(RzAnalysis *analysis, ut64 addr) {
+static bool append_xref_cb(const RzAnalysisXRef *xref, void *user) {
+	RzAnalysisXRef *cloned = rz_analysis_xref_new(xref->from, xref->to, xref->type);
+	return cloned && rz_list_append(user, cloned);
+}
+
+static RzList /*<RzAnalysisXRef *>*/ *xrefs_list(RzAnalysis *analysis, XRefsOrder o, ut64 lo, ut64 hi) {
 	RzList *list = rz_analysis_xref_list_new();
 	if (!list) {
 		return NULL;
 	}
-	listxrefs(analysis->ht_xrefs_from, addr, list);
-	sortxrefs(list);
+	xref_index_foreach(analysis->xref_index, o, lo, hi, append_xref_cb, list);
 	if (rz_list_empty(list)) {
 		rz_list_free(list);
 		list = NULL;
@@ -198,6 +602,14 @@ RZ_API RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_from(RzAnalysis *ana
 	return list;
 }
 
+RZ_API RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_to(RzAnalysis *analysis, ut64 addr) {
+	return xrefs_list(analysis, XREFS_BY_TO, addr, addr);
+}
+
+RZ_API RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_from(RzAnalysis *analysis, ut64 addr) {
+	return xrefs_list(analysis, XREFS_BY_FROM, addr, addr);
+}
+
 /**
  * \brief Get list of all xrefs.
  * \param analysis RzAnalysis instance
@@ -207,8 +619,7 @@ RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_list(RzAnalysis *
 	rz_return_val_if_fail(analysis, NULL);
 	RzList *list = rz_analysis_xref_list_new();
 	if (list) {
-		listxrefs(analysis->ht_xrefs_from, UT64_MAX, list);
-		sortxrefs(list);
+		xref_index_foreach(analysis->xref_index, XREFS_BY_FROM, 0, UT64_MAX, append_xref_cb, list);
 	}
 	return list;
 }
@@ -243,39 +654,60 @@ RZ_API RzAnalysisXRefType rz_analysis_xrefs_type(char ch) {
 }
 
 RZ_API bool rz_analysis_xrefs_init(RzAnalysis *analysis) {
-	ht_up_free(analysis->ht_xrefs_from);
-	analysis->ht_xrefs_from = NULL;
-	ht_up_free(analysis->ht_xrefs_to);
-	analysis->ht_xrefs_to = NULL;
+	xref_index_free(analysis->xref_index);
+	analysis->xref_index = xref_index_new();
+	return analysis->xref_index != NULL;
+}
 
-	HtUP *tmp = ht_up_new(NULL, xrefs_ht_free, NULL);
-	if (!tmp) {
-		return false;
-	}
-	analysis->ht_xrefs_from = tmp;
+RZ_IPI void rz_analysis_xrefs_fini(RzAnalysis *analysis) {
+	xref_index_free(analysis->xref_index);
+	analysis->xref_index = NULL;
+}
 
-	tmp = ht_up_new(NULL, xrefs_ht_free, NULL);
-	if (!tmp) {
-		ht_up_free(analysis->ht_xrefs_from);
-		analysis->ht_xrefs_from = NULL;
-		return false;
+/**
+ * Number of distinct (from, to) pairs in the pending xrefs, without merging them
+ */
+static size_t pending_unique(RzAnalysisXRefIndex *idx) {
+	size_t count = rz_vector_len(&idx->pending);
+	if (count < 2) {
+		return count;
 	}
-	analysis->ht_xrefs_to = tmp;
-	return true;
+	PendingXRef *sorted = rz_mem_dup(idx->pending.a, count * sizeof(PendingXRef));
+	if (!sorted) {
+		return count;
+	}
+	qsort(sorted, count, sizeof(PendingXRef), pending_cmp_from);
+	size_t unique = 1;
+	for (size_t i = 1; i < count; i++) {
+		unique += sorted[i].from != sorted[i - 1].from || sorted[i].to != sorted[i - 1].to;
+	}
+	free(sorted);
+	return unique;
 }
 
-static bool count_cb(void *user, const ut64 k, const void *v) {
-	(*(ut64 *)user) += ((HtUP *)v)->count;
-	return true;
+RZ_API ut64 rz_analysis_xrefs_count(RzAnalysis *analysis) {
+	RzAnalysisXRefIndex *idx = analysis->xref_index;
+	return idx->main[XREFS_BY_FROM].count + idx->delta[XREFS_BY_FROM].count + pending_unique(idx) - idx->deleted;
 }
 
-RZ_API ut64 rz_analysis_xrefs_count(RzAnalysis *analysis) {
-	ut64 ret = 0;
-	ht_up_foreach(analysis->ht_xrefs_to, count_cb, &ret);
-	return ret;
+/**
+ * \brief Fill \p stats with the number of xrefs and the memory used to store them
+ */
+RZ_API void rz_analysis_xrefs_stats(RzAnalysis *analysis, RZ_NONNULL RZ_OUT RzAnalysisXRefsStats *stats) {
+	rz_return_if_fail(analysis && stats);
+	RzAnalysisXRefIndex *idx = analysis->xref_index;
+	memset(stats, 0, sizeof(*stats));
+	stats->count = rz_analysis_xrefs_count(analysis);
+	stats->pending = rz_vector_len(&idx->pending);
+	stats->deleted = idx->deleted;
+	stats->bytes = sizeof(*idx) + idx->pending.capacity * idx->pending.elem_size;
+	for (int o = 0; o < XREFS_ORDERS; o++) {
+		stats->delta += o == XREFS_BY_FROM ? idx->delta[o].count : 0;
+		stats->bytes += (idx->main[o].capacity + idx->delta[o].capacity) * (2 * sizeof(ut64) + 1);
+	}
 }
 
-static RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fcn, HtUP *ht) {
+static RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fcn, XRefsOrder o) {
 	RzListIter *iter;
 	RzAnalysisBlock *bb;
 	RzList *list = rz_analysis_xref_list_new();
@@ -287,21 +719,21 @@ static RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fcn, HtUP
 
 		for (i = 0; i < bb->ninstr; i++) {
 			ut64 at = bb->addr + rz_analysis_block_get_op_offset(bb, i);
-			listxrefs(ht, at, list);
+			xref_index_foreach(fcn->analysis->xref_index, o, at, at, append_xref_cb, list);
 		}
 	}
-	sortxrefs(list);
+	rz_list_sort(list, (RzListComparator)ref_cmp);
 	return list;
 }
 
 RZ_API RzList /*<RzAnalysisXRef *>*/ *rz_analysis_function_get_xrefs_from(RzAnalysisFunction *fcn) {
 	rz_return_val_if_fail(fcn, NULL);
-	return fcn_get_refs(fcn, fcn->analysis->ht_xrefs_from);
+	return fcn_get_refs(fcn, XREFS_BY_FROM);
 }
 
 RZ_API RzList /*<RzAnalysisXRef *>*/ *rz_analysis_function_get_xrefs_to(RzAnalysisFunction *fcn) {
 	rz_return_val_if_fail(fcn, NULL);
-	return fcn_get_refs(fcn, fcn->analysis->ht_xrefs_to);
+	return fcn_get_refs(fcn, XREFS_BY_TO);
 }
 
 RZ_API const char *rz_analysis_ref_type_tostring(RzAnalysisXRefType t) {
@@ -280,6 +280,47 @@ RZ_API RzAsm *rz_asm_new(void) {
 	return a;
 }
 
+/**
+ * \brief Creates a new RzAsm which can only be used to disassemble instructions.
+ *
+ * The returned instance uses the same plugin, cpu, bits, endianness, syntax and features
+ * of \p a, but owns its own plugin data, thus it can be used by a worker thread to call
+ * rz_asm_disassemble() while \p a is used by another thread. This is safe only for plugins
+ * keeping all their state in the plugin data. The input and output filters are not copied.
+ *
+ * \param a The RzAsm to copy the configuration from
+ * \return On success returns a valid pointer, otherwise NULL
+ */
+RZ_API RZ_OWN RzAsm *rz_asm_new_decoder(RZ_NONNULL RzAsm *a) {
+	rz_return_val_if_fail(a && a->cur, NULL);
+	RzAsm *decoder = rz_asm_new();
+	if (!decoder) {
+		return NULL;
+	}
+	decoder->cpu = a->cpu ? strdup(a->cpu) : NULL;
+	decoder->features = a->features ? strdup(a->features) : NULL;
+	decoder->bits = a->bits;
+	decoder->big_endian = a->big_endian;
+	decoder->syntax = a->syntax;
+	decoder->invhex = a->invhex;
+	decoder->pcalign = a->pcalign;
+	decoder->dataalign = a->dataalign;
+	decoder->immsign = a->immsign;
+	decoder->immdisp = a->immdisp;
+	decoder->utf8 = a->utf8;
+	decoder->seggrn = a->seggrn;
+
+	// the plugin may not be a static one, thus it is not searched by name.
+	decoder->cur = a->cur;
+	if (decoder->cur->init && !decoder->cur->init(&decoder->plugin_data)) {
+		RZ_LOG_ERROR("asm plugin '%s' failed to initialize.\n", decoder->cur->name);
+		decoder->cur = NULL;
+		rz_asm_free(decoder);
+		return NULL;
+	}
+	return decoder;
+}
+
 RZ_API bool rz_asm_setup(RzAsm *a, const char *arch, int bits, int big_endian) {
 	rz_return_val_if_fail(a && arch, false);
 	bool ret = !rz_asm_use(a, arch);
@@ -589,10 +630,10 @@ RZ_API int rz_asm_disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 		if (a->invhex) {
 			if (a->bits == 16) {
 				ut16 b = rz_read_le16(buf);
-				rz_strbuf_set(&op->buf_asm, sdb_fmt(".word 0x%04x", b));
+				rz_strbuf_setf(&op->buf_asm, ".word 0x%04x", b);
 			} else {
 				ut32 b = rz_read_le32(buf);
-				rz_strbuf_set(&op->buf_asm, sdb_fmt(".dword 0x%08x", b));
+				rz_strbuf_setf(&op->buf_asm, ".dword 0x%08x", b);
 			}
 			// TODO: something for 64bits too?
 		} else {
@@ -25,6 +25,10 @@ static bool check_features(RzAsm *a, cs_insn *insn);
 static csh cd = 0;
 #include "cs_mnemonics.c"
 
+static char *mnemonics(RzAsm *a, int id, bool json) {
+	return cs_mnemonics(a, &cd, id, json);
+}
+
 static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 	const char *buf_asm = NULL;
 	static int omode = -1;
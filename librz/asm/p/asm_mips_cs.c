@@ -10,6 +10,10 @@ RZ_IPI int mips_assemble(const char *str, ut64 pc, ut8 *out);
 static csh cd = 0;
 #include "cs_mnemonics.c"
 
+static char *mnemonics(RzAsm *a, int id, bool json) {
+	return cs_mnemonics(a, &cd, id, json);
+}
+
 static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 	cs_insn *insn;
 	int mode, n, ret = -1;
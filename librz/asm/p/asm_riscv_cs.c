@@ -8,6 +8,10 @@
 static csh cd = 0;
 #include "cs_mnemonics.c"
 
+static char *mnemonics(RzAsm *a, int id, bool json) {
+	return cs_mnemonics(a, &cd, id, json);
+}
+
 static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 	cs_insn *insn;
 	int mode = (a->bits == 64) ? CS_MODE_RISCV64 : CS_MODE_RISCV32;
@@ -7,6 +7,10 @@
 static csh cd = 0;
 #include "cs_mnemonics.c"
 
+static char *mnemonics(RzAsm *a, int id, bool json) {
+	return cs_mnemonics(a, &cd, id, json);
+}
+
 #ifdef CAPSTONE_TMS320C64X_H
 #define CAPSTONE_HAS_TMS320C64X 1
 #else
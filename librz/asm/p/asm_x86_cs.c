@@ -5,14 +5,27 @@
 #include <rz_lib.h>
 #include <capstone/capstone.h>
 
-static csh cd = 0;
-static int n = 0;
+typedef struct x86_cs_context_t {
+	csh cd;
+	int omode;
+} X86CSContext;
 
-static bool the_end(void *p) {
-	if (cd) {
-		cs_close(&cd);
-		cd = 0;
+static bool x86_init(void **user) {
+	X86CSContext *ctx = RZ_NEW0(X86CSContext);
+	if (!ctx) {
+		return false;
 	}
+	*user = ctx;
+	return true;
+}
+
+static bool x86_fini(void *user) {
+	rz_return_val_if_fail(user, false);
+	X86CSContext *ctx = (X86CSContext *)user;
+	if (ctx->cd) {
+		cs_close(&ctx->cd);
+	}
+	free(ctx);
 	return true;
 }
 
@@ -23,52 +36,52 @@ static int check_features(RzAsm *a, cs_insn *insn);
 #include "asm_x86_vm.c"
 
 static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
-	static int omode = 0;
-	int mode, ret;
+	X86CSContext *ctx = (X86CSContext *)a->plugin_data;
+	int mode, ret, n;
 	ut64 off = a->pc;
 
 	mode = (a->bits == 64) ? CS_MODE_64 : (a->bits == 32) ? CS_MODE_32
 		: (a->bits == 16)                             ? CS_MODE_16
 							      : 0;
-	if (cd && mode != omode) {
-		cs_close(&cd);
-		cd = 0;
+	if (ctx->cd && mode != ctx->omode) {
+		cs_close(&ctx->cd);
+		ctx->cd = 0;
 	}
 	if (op) {
 		op->size = 0;
 	}
-	omode = mode;
-	if (cd == 0) {
-		ret = cs_open(CS_ARCH_X86, mode, &cd);
+	ctx->omode = mode;
+	if (ctx->cd == 0) {
+		ret = cs_open(CS_ARCH_X86, mode, &ctx->cd);
 		if (ret) {
 			return 0;
 		}
 	}
 	if (a->features && *a->features) {
-		cs_option(cd, CS_OPT_DETAIL, CS_OPT_ON);
+		cs_option(ctx->cd, CS_OPT_DETAIL, CS_OPT_ON);
 	} else {
-		cs_option(cd, CS_OPT_DETAIL, CS_OPT_OFF);
+		cs_option(ctx->cd, CS_OPT_DETAIL, CS_OPT_OFF);
 	}
 	// always unsigned immediates (kernel addresses)
 	// maybe rizin should have an option for this too?
 #if CS_API_MAJOR >= 4
-	cs_option(cd, CS_OPT_UNSIGNED, CS_OPT_ON);
+	cs_option(ctx->cd, CS_OPT_UNSIGNED, CS_OPT_ON);
 #endif
 	if (a->syntax == RZ_ASM_SYNTAX_MASM) {
 #if CS_API_MAJOR >= 4
-		cs_option(cd, CS_OPT_SYNTAX, CS_OPT_SYNTAX_MASM);
+		cs_option(ctx->cd, CS_OPT_SYNTAX, CS_OPT_SYNTAX_MASM);
 #endif
 	} else if (a->syntax == RZ_ASM_SYNTAX_ATT) {
-		cs_option(cd, CS_OPT_SYNTAX, CS_OPT_SYNTAX_ATT);
+		cs_option(ctx->cd, CS_OPT_SYNTAX, CS_OPT_SYNTAX_ATT);
 	} else {
-		cs_option(cd, CS_OPT_SYNTAX, CS_OPT_SYNTAX_INTEL);
+		cs_option(ctx->cd, CS_OPT_SYNTAX, CS_OPT_SYNTAX_INTEL);
 	}
 	if (!op) {
 		return true;
 	}
 	op->size = 1;
 	cs_insn *insn = NULL;
-	n = cs_disasm(cd, (const ut8 *)buf, len, off, 1, &insn);
+	n = cs_disasm(ctx->cd, (const ut8 *)buf, len, off, 1, &insn);
 	if (op) {
 		op->size = 0;
 	}
@@ -81,14 +94,17 @@ static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 	if (op->size == 0 && n > 0 && insn->size > 0) {
 		char *ptrstr;
 		op->size = insn->size;
-		char *buf_asm = sdb_fmt("%s%s%s",
+		char *buf_asm = rz_str_newf("%s%s%s",
 			insn->mnemonic, insn->op_str[0] ? " " : "",
 			insn->op_str);
-		ptrstr = strstr(buf_asm, "ptr ");
-		if (ptrstr) {
-			memmove(ptrstr, ptrstr + 4, strlen(ptrstr + 4) + 1);
+		if (buf_asm) {
+			ptrstr = strstr(buf_asm, "ptr ");
+			if (ptrstr) {
+				memmove(ptrstr, ptrstr + 4, strlen(ptrstr + 4) + 1);
+			}
+			rz_asm_op_set_asm(op, buf_asm);
+			free(buf_asm);
 		}
-		rz_asm_op_set_asm(op, buf_asm);
 	} else {
 		decompile_vm(a, op, buf, len);
 	}
@@ -106,6 +122,10 @@ static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 	return op->size;
 }
 
+static char *mnemonics(RzAsm *a, int id, bool json) {
+	return cs_mnemonics(a, &((X86CSContext *)a->plugin_data)->cd, id, json);
+}
+
 RzAsmPlugin rz_asm_plugin_x86_cs = {
 	.name = "x86",
 	.desc = "Capstone X86 disassembler",
@@ -115,7 +135,8 @@ RzAsmPlugin rz_asm_plugin_x86_cs = {
 	.arch = "x86",
 	.bits = 16 | 32 | 64,
 	.endian = RZ_SYS_ENDIAN_LITTLE,
-	.fini = the_end,
+	.init = &x86_init,
+	.fini = &x86_fini,
 	.mnemonics = mnemonics,
 	.disassemble = &disassemble,
 	.features = "vm,3dnow,aes,adx,avx,avx2,avx512,bmi,bmi2,cmov,"
@@ -140,7 +161,7 @@ static int check_features(RzAsm *a, cs_insn *insn) {
 		if (id == X86_GRP_MODE64) {
 			continue;
 		}
-		name = cs_group_name(cd, id);
+		name = cs_group_name(((X86CSContext *)a->plugin_data)->cd, id);
 		if (!name) {
 			return 1;
 		}
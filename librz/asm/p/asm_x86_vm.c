@@ -30,12 +30,14 @@
 
 void decompile_vm(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 	const char *buf_asm = "invalid";
+	char vpcext[32];
 	if (len > 3 && buf[0] == 0x0F && buf[1] == 0x3F && (VPCEXT2(buf, 0x01) || VPCEXT2(buf, 0x05) || VPCEXT2(buf, 0x07) || VPCEXT2(buf, 0x0D) || VPCEXT2(buf, 0x10))) {
 		if (a->syntax == RZ_ASM_SYNTAX_ATT) {
-			buf_asm = sdb_fmt("vpcext $0x%x, $0x%x", buf[3], buf[2]);
+			snprintf(vpcext, sizeof(vpcext), "vpcext $0x%x, $0x%x", buf[3], buf[2]);
 		} else {
-			buf_asm = sdb_fmt("vpcext %xh, %xh", buf[2], buf[3]);
+			snprintf(vpcext, sizeof(vpcext), "vpcext %xh, %xh", buf[2], buf[3]);
 		}
+		buf_asm = vpcext;
 		op->size = 4;
 	} else if (len > 4 && buf[0] == 0x0F && buf[1] == 0xC6 && buf[2] == 0x28 && buf[3] == 0x00 && buf[4] == 0x00) {
 		/* 0F C6 28 00 00 vmgetinfo */
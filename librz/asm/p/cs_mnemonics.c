@@ -1,9 +1,14 @@
 // SPDX-FileCopyrightText: 2016-2018 pancake <pancake@nopcode.org>
 // SPDX-License-Identifier: LGPL-3.0-only
 
-static char *mnemonics(RzAsm *a, int id, bool json) {
+/**
+ * Returns the name of the instruction \p id, or all of them when it is -1,
+ * from the capstone \p handle, which is opened by the disassemble callback.
+ */
+static char *cs_mnemonics(RzAsm *a, csh *handle, int id, bool json) {
 	int i;
 	a->cur->disassemble(a, NULL, NULL, -1);
+	csh cd = *handle;
 	if (id != -1) {
 		const char *name = cs_insn_name(cd, id);
 		if (json) {
@@ -278,9 +278,6 @@ RZ_IPI bool rz_bin_file_set_obj(RzBin *bin, RzBinFile *bf, RzBinObject *obj) {
 		if (!obj->info) {
 			return false;
 		}
-		if (!obj->info->lang) {
-			obj->info->lang = rz_bin_language_to_string(obj->lang);
-		}
 	}
 	return true;
 }
@@ -399,6 +396,9 @@ static inline bool add_file_hash(RzHashCfg *md, const char *name, RzList /*<RzBi
 	return true;
 }
 
+// below this size, starting the threads of the parallel digests costs more than hashing
+#define COMPUTE_HASHES_PARALLEL_MIN_SIZE (8 * 1024 * 1024)
+
 static ut64 buf_compute_hashes(const ut8 *buf, ut64 size, void *user) {
 	if (!rz_hash_cfg_update((RzHashCfg *)user, buf, size)) {
 		return 0;
@@ -445,6 +445,7 @@ RZ_API RZ_OWN RzList /*<RzBinFileHash *>*/ *rz_bin_file_compute_hashes(RzBin *bi
 		!rz_hash_cfg_configure(md, "entropy")) {
 		goto rz_bin_file_compute_hashes_bad;
 	}
+	rz_hash_cfg_set_parallel(md, buf_size >= COMPUTE_HASHES_PARALLEL_MIN_SIZE);
 	if (!rz_hash_cfg_init(md)) {
 		goto rz_bin_file_compute_hashes_bad;
 	}
@@ -524,6 +525,8 @@ RZ_IPI void rz_bin_class_free(RzBinClass *k) {
 
 RZ_API RzBinClass *rz_bin_file_add_class(RzBinFile *bf, const char *name, const char *super, int view) {
 	rz_return_val_if_fail(name && bf && bf->o, NULL);
+	// the lazily loaded classes would replace the added one
+	rz_bin_object_get_classes(bf->o);
 	RzBinClass *c = __getClass(bf, name);
 	if (c) {
 		if (super) {
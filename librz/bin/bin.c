@@ -220,6 +220,7 @@ RZ_API RzBinFile *rz_bin_reload(RzBin *bin, RzBinFile *bf, ut64 baseaddr) {
 	bool elf_load_sections = bf->o ? bf->o->opts.elf_load_sections : false;
 	bool elf_checks_sections = bf->o ? bf->o->opts.elf_checks_sections : false;
 	bool elf_checks_segments = bf->o ? bf->o->opts.elf_checks_segments : false;
+	bool lazy = bf->o ? bf->o->opts.lazy : false;
 
 	RzBinOptions opt;
 	rz_bin_options_init(&opt, bf->fd, baseaddr, bf->loadaddr, patch_relocs);
@@ -227,6 +228,7 @@ RZ_API RzBinFile *rz_bin_reload(RzBin *bin, RzBinFile *bf, ut64 baseaddr) {
 	opt.obj_opts.elf_checks_sections = elf_checks_sections;
 	opt.obj_opts.elf_checks_segments = elf_checks_segments;
 	opt.obj_opts.big_endian = big_endian;
+	opt.obj_opts.lazy = lazy;
 	opt.filename = bf->file;
 	rz_buf_seek(bf->buf, 0, RZ_BUF_SET);
 	RzBinFile *nbf = rz_bin_open_buf(bin, bf->buf, &opt);
@@ -266,8 +268,6 @@ RZ_API RzBinFile *rz_bin_open_buf(RzBin *bin, RzBuffer *buf, RzBinOptions *opt)
 		}
 	}
 	if (!bf) {
-		// Uncomment for this speedup: 20s vs 22s
-		// RzBuffer *buf = rz_buf_new_slurp (bin->file);
 		bf = rz_bin_file_new_from_buffer(bin, bin->file, buf,
 			&opt->obj_opts, opt->fd, opt->pluginname);
 		if (!bf) {
@@ -279,6 +279,39 @@ RZ_API RzBinFile *rz_bin_open_buf(RzBin *bin, RzBuffer *buf, RzBinOptions *opt)
 	return bf;
 }
 
+/**
+ * Maps in memory the file behind \p fd when it is a plain local file, so that
+ * the plugins parse it without going through the RzIO plugin for every read
+ * and can access its bytes directly via rz_buf_data().
+ *
+ * A mapped file which is truncated while it is open faults on the next access
+ * instead of failing the read, so the mapping is opt-in (bin.mmap) and is never
+ * used for descriptors opened for writing.
+ */
+static RzBuffer *bin_buf_new_local_file(RzBin *bin, int fd) {
+	RzIO *io = bin->iob.io;
+	RzIODesc *desc = bin->iob.desc_get(io, fd);
+	if (!desc || !desc->plugin || strcmp(desc->plugin->name, "default") || io->p_cache || (desc->perm & RZ_PERM_W)) {
+		// other plugins (e.g. remote or compressed files), the io.pcache
+		// writes and the writable files need to be read through RzIO
+		return NULL;
+	}
+	const char *path = desc->name;
+	if (rz_str_startswith(path, "file://")) {
+		path += strlen("file://");
+	}
+	if (!rz_file_is_regular(path)) {
+		return NULL;
+	}
+	RzBuffer *buf = rz_buf_new_mmap(path, O_RDONLY, 0);
+	if (buf && rz_buf_size(buf) != bin->iob.desc_size(desc)) {
+		// the file changed since it was opened
+		rz_buf_free(buf);
+		return NULL;
+	}
+	return buf;
+}
+
 RZ_API RzBinFile *rz_bin_open_io(RzBin *bin, RzBinOptions *opt) {
 	rz_return_val_if_fail(bin && opt && bin->iob.io, NULL);
 	rz_return_val_if_fail(opt->fd >= 0 && (st64)opt->sz >= 0, NULL);
@@ -302,6 +335,9 @@ RZ_API RzBinFile *rz_bin_open_io(RzBin *bin, RzBinOptions *opt) {
 		buf = rz_buf_new_file(fname, O_RDONLY, 0);
 		is_debugger = false;
 	}
+	if (!buf && bin->use_mmap) {
+		buf = bin_buf_new_local_file(bin, opt->fd);
+	}
 	if (!buf) {
 		buf = rz_buf_new_with_io_fd(&bin->iob, opt->fd);
 	}
@@ -740,6 +776,7 @@ RZ_API RzBin *rz_bin_new(void) {
 	bin->strpurge = NULL;
 	bin->strenc = NULL;
 	bin->want_dbginfo = true;
+	bin->use_mmap = false;
 	bin->cur = NULL;
 	bin->hash = rz_hash_new();
 	if (!bin->hash) {
@@ -882,7 +919,7 @@ RZ_API RzBuffer *rz_bin_create(RzBin *bin, const char *p,
 RZ_DEPRECATE RZ_API RZ_BORROW RzList /*<RzBinClass *>*/ *rz_bin_get_classes(RZ_NONNULL RzBin *bin) {
 	rz_return_val_if_fail(bin, NULL);
 	RzBinObject *o = rz_bin_cur_object(bin);
-	return o ? o->classes : NULL;
+	return o ? (RzList *)rz_bin_object_get_classes(o) : NULL;
 }
 
 RZ_API ut64 rz_bin_get_size(RzBin *bin) {
@@ -1347,8 +1384,12 @@ RZ_API RZ_OWN char *rz_bin_demangle(RZ_NULLABLE RzBinFile *bf, RZ_NULLABLE const
 	RzBin *bin = bf ? bf->rbin : NULL;
 	RzBinObject *o = bf ? bf->o : NULL;
 
-	if (!language && o && o->info && o->info->lang) {
-		language = o->info->lang;
+	if (!language && o) {
+		// loading the language also fills info->lang
+		rz_bin_object_get_language(o);
+		if (o->info && o->info->lang) {
+			language = o->info->lang;
+		}
 	}
 
 	RzListIter *iter;
@@ -1367,7 +1408,7 @@ RZ_API RZ_OWN char *rz_bin_demangle(RZ_NULLABLE RzBinFile *bf, RZ_NULLABLE const
 	}
 	if (o) {
 		bool found = false;
-		rz_list_foreach (o->libs, iter, lib) {
+		rz_list_foreach (rz_bin_object_get_libs(o), iter, lib) {
 			size_t len = strlen(lib);
 			if (!rz_str_ncasecmp(symbol, lib, len)) {
 				symbol += len;
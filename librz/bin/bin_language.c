@@ -113,7 +113,7 @@ RZ_API RzBinLanguage rz_bin_language_detect(RzBinFile *binfile) {
 	}
 
 	if (is_macho || is_elf) {
-		rz_list_foreach (o->imports, iter, sym) {
+		rz_list_foreach (rz_bin_object_get_imports(o), iter, sym) {
 			const char *name = sym->name;
 			if (!strcmp(name, "_NSConcreteGlobalBlock")) {
 				is_blocks = true;
@@ -122,7 +122,7 @@ RZ_API RzBinLanguage rz_bin_language_detect(RzBinFile *binfile) {
 			}
 		}
 	}
-	rz_list_foreach (o->libs, iter, lib) {
+	rz_list_foreach (rz_bin_object_get_libs(o), iter, lib) {
 		if (is_macho && strstr(lib, "swift")) {
 			info->lang = "swift";
 			return language_apply_blocks_mask(RZ_BIN_LANGUAGE_SWIFT, is_blocks);
@@ -141,7 +141,7 @@ RZ_API RzBinLanguage rz_bin_language_detect(RzBinFile *binfile) {
 		return language_apply_blocks_mask(RZ_BIN_LANGUAGE_OBJC, is_blocks);
 	}
 
-	rz_list_foreach (o->symbols, iter, sym) {
+	rz_list_foreach (rz_bin_object_get_symbols(o), iter, sym) {
 		if (!sym->name) {
 			continue;
 		}
@@ -389,13 +389,256 @@ static void rz_bin_object_rebuild_classes_ht(RzBinObject *o) {
 	}
 }
 
+/**
+ * Items of a RzBinObject which are loaded on their first access when
+ * RzBinObjectLoadOptions.lazy is set, see RzBinObject.pending.
+ */
+enum {
+	BIN_OBJECT_LAZY_FIELDS = 1 << 0,
+	BIN_OBJECT_LAZY_IMPORTS = 1 << 1,
+	BIN_OBJECT_LAZY_SYMBOLS = 1 << 2,
+	BIN_OBJECT_LAZY_LIBS = 1 << 3,
+	BIN_OBJECT_LAZY_RELOCS = 1 << 4,
+	BIN_OBJECT_LAZY_STRINGS = 1 << 5,
+	BIN_OBJECT_LAZY_LANGUAGE = 1 << 6,
+	BIN_OBJECT_LAZY_CLASSES = 1 << 7,
+	BIN_OBJECT_LAZY_MEM = 1 << 8,
+	BIN_OBJECT_LAZY_RESOURCES = 1 << 9,
+	BIN_OBJECT_LAZY_ALL = (1 << 10) - 1,
+};
+
+static void object_load_fields(RzBinFile *bf, RzBinObject *o) {
+	RzBinPlugin *p = o->plugin;
+	if (p->fields) {
+		o->fields = p->fields(bf);
+		if (o->fields) {
+			rz_warn_if_fail(o->fields->free);
+			REBASE_PADDR(o, o->fields, RzBinField);
+		}
+	}
+}
+
+static void object_load_imports(RzBinFile *bf, RzBinObject *o) {
+	RzBinPlugin *p = o->plugin;
+	if (p->imports) {
+		rz_list_free(o->imports);
+		o->imports = p->imports(bf);
+		if (o->imports) {
+			rz_warn_if_fail(o->imports->free);
+		}
+	}
+}
+
+static void object_load_symbols(RzBinFile *bf, RzBinObject *o) {
+	RzBinPlugin *p = o->plugin;
+	if (!p->symbols) {
+		return;
+	}
+	o->symbols = p->symbols(bf);
+	if (!o->symbols) {
+		return;
+	}
+	REBASE_PADDR(o, o->symbols, RzBinSymbol);
+	if (bf->rbin->filter) {
+		rz_bin_filter_symbols(bf, o->symbols);
+	}
+	o->import_name_symbols = ht_pp_new0();
+	if (o->import_name_symbols) {
+		RzBinSymbol *sym;
+		RzListIter *it;
+		rz_list_foreach (o->symbols, it, sym) {
+			if (!sym->is_imported || !sym->name || !*sym->name) {
+				continue;
+			}
+			ht_pp_insert(o->import_name_symbols, sym->name, sym);
+		}
+	}
+}
+
+static void object_load_libs(RzBinFile *bf, RzBinObject *o) {
+	RzBinPlugin *p = o->plugin;
+	if (p->libs) {
+		o->libs = p->libs(bf);
+	}
+}
+
+static void object_load_relocs(RzBinFile *bf, RzBinObject *o) {
+	RzBinPlugin *p = o->plugin;
+	if (!(bf->rbin->filter_rules & (RZ_BIN_REQ_RELOCS | RZ_BIN_REQ_IMPORTS)) || !p->relocs) {
+		return;
+	}
+	RzList *l = p->relocs(bf);
+	if (l) {
+		REBASE_PADDR(o, l, RzBinReloc);
+		o->relocs = rz_bin_reloc_storage_new(l);
+	}
+}
+
+static void object_load_strings(RzBinFile *bf, RzBinObject *o) {
+	RzBin *bin = bf->rbin;
+	RzBinPlugin *p = o->plugin;
+	if (!(bin->filter_rules & RZ_BIN_REQ_STRINGS)) {
+		return;
+	}
+	int minlen = (bin->minstrlen > 0) ? bin->minstrlen : p->minstrlen;
+	RzList *strings;
+	if (p->strings) {
+		strings = p->strings(bf);
+	} else {
+		// when a bin plugin does not provide it's own strings
+		// we always take all the strings found in the binary
+		// the method also converts the paddrs to vaddrs
+		strings = rz_bin_file_strings(bf, minlen, true);
+	}
+
+	if (bin->debase64) {
+		bin_object_decode_all_base64_strings(strings);
+	}
+	REBASE_PADDR(o, strings, RzBinString);
+
+	// RzBinStrDb becomes the owner of the RzList strings
+	o->strings = rz_bin_string_database_new(strings);
+}
+
+static void object_load_classes(RzBinFile *bf, RzBinObject *o) {
+	RzBin *bin = bf->rbin;
+	RzBinPlugin *p = o->plugin;
+	if (!(bin->filter_rules & (RZ_BIN_REQ_CLASSES | RZ_BIN_REQ_CLASSES_SOURCES))) {
+		return;
+	}
+	// classes_from_symbols() and the swift check need them
+	rz_bin_object_get_symbols(o);
+	RzBinLanguage lang = rz_bin_object_get_language(o);
+	if (p->classes) {
+		RzList *classes = p->classes(bf);
+		if (classes) {
+			// XXX we should probably merge them instead
+			rz_list_free(o->classes);
+			o->classes = classes;
+			rz_bin_object_rebuild_classes_ht(o);
+		}
+
+		if (lang == RZ_BIN_LANGUAGE_SWIFT) {
+			o->classes = classes_from_symbols(bf);
+		}
+	} else {
+		RzList *classes = classes_from_symbols(bf);
+		if (classes) {
+			o->classes = classes;
+		}
+	}
+
+	if (bin->filter) {
+		filter_classes(bf, o->classes);
+	}
+
+	// cache addr=class+method
+	if (o->classes) {
+		RzList *klasses = o->classes;
+		RzListIter *iter, *iter2;
+		RzBinClass *klass;
+		RzBinSymbol *method;
+		if (!o->addrzklassmethod) {
+			// this is slow. must be optimized, but at least its cached
+			o->addrzklassmethod = ht_up_new0();
+			rz_list_foreach (klasses, iter, klass) {
+				rz_list_foreach (klass->methods, iter2, method) {
+					ht_up_insert(o->addrzklassmethod, method->vaddr, method);
+				}
+			}
+		}
+	}
+}
+
+static void object_load_mem(RzBinFile *bf, RzBinObject *o) {
+	RzBinPlugin *p = o->plugin;
+	if (p->mem) {
+		o->mem = p->mem(bf);
+	}
+}
+
+static void object_load_language(RzBinFile *bf, RzBinObject *o) {
+	o->lang = rz_bin_language_detect(bf);
+	if (o->info && !o->info->lang) {
+		o->info->lang = rz_bin_language_to_string(o->lang);
+	}
+}
+
+static void object_load_resources(RzBinFile *bf, RzBinObject *o) {
+	RzBinPlugin *p = o->plugin;
+	if (p->resources) {
+		o->resources = p->resources(bf);
+	}
+}
+
+/**
+ * Loads the item \p lazy_item of \p o, if it was not loaded yet.
+ */
+static void object_load_lazy(RzBinObject *o, ut32 lazy_item) {
+	if (!(o->pending & lazy_item) || !o->bf) {
+		return;
+	}
+	// cleared before loading, so that loaders depending on other items do not recurse
+	o->pending &= ~lazy_item;
+	RzBinFile *bf = o->bf;
+	// plugins expect the object being loaded to be the current one of the file
+	RzBinObject *cur = bf->o;
+	bf->o = o;
+	switch (lazy_item) {
+	case BIN_OBJECT_LAZY_FIELDS:
+		object_load_fields(bf, o);
+		break;
+	case BIN_OBJECT_LAZY_IMPORTS:
+		object_load_imports(bf, o);
+		break;
+	case BIN_OBJECT_LAZY_SYMBOLS:
+		object_load_symbols(bf, o);
+		break;
+	case BIN_OBJECT_LAZY_LIBS:
+		object_load_libs(bf, o);
+		break;
+	case BIN_OBJECT_LAZY_RELOCS:
+		object_load_relocs(bf, o);
+		break;
+	case BIN_OBJECT_LAZY_STRINGS:
+		object_load_strings(bf, o);
+		break;
+	case BIN_OBJECT_LAZY_LANGUAGE:
+		object_load_language(bf, o);
+		break;
+	case BIN_OBJECT_LAZY_CLASSES:
+		object_load_classes(bf, o);
+		break;
+	case BIN_OBJECT_LAZY_MEM:
+		object_load_mem(bf, o);
+		break;
+	case BIN_OBJECT_LAZY_RESOURCES:
+		object_load_resources(bf, o);
+		break;
+	default:
+		rz_warn_if_reached();
+		break;
+	}
+	bf->o = cur;
+}
+
+/**
+ * \brief Loads all the items of \p o which were not loaded yet because of RzBinObjectLoadOptions.lazy
+ */
+RZ_API void rz_bin_object_load_lazy_items(RZ_NONNULL RzBinObject *o) {
+	rz_return_if_fail(o);
+	for (ut32 item = 1; item & BIN_OBJECT_LAZY_ALL; item <<= 1) {
+		object_load_lazy(o, item);
+	}
+}
+
 RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 	rz_return_val_if_fail(bf && o && o->plugin, false);
 
-	RzBin *bin = bf->rbin;
 	RzBinPlugin *p = o->plugin;
-	int minlen = (bf->rbin->minstrlen > 0) ? bf->rbin->minstrlen : p->minstrlen;
 	bf->o = o;
+	o->bf = bf;
+	o->pending = 0;
 
 	if (p->file_type) {
 		int type = p->file_type(bf);
@@ -437,42 +680,14 @@ RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 			REBASE_PADDR(o, o->maps, RzBinMap);
 		}
 	}
-	if (p->fields) {
-		o->fields = p->fields(bf);
-		if (o->fields) {
-			rz_warn_if_fail(o->fields->free);
-			REBASE_PADDR(o, o->fields, RzBinField);
-		}
-	}
-	if (p->imports) {
-		rz_list_free(o->imports);
-		o->imports = p->imports(bf);
-		if (o->imports) {
-			rz_warn_if_fail(o->imports->free);
-		}
-	}
-	if (p->symbols) {
-		o->symbols = p->symbols(bf);
-		if (o->symbols) {
-			REBASE_PADDR(o, o->symbols, RzBinSymbol);
-			if (bin->filter) {
-				rz_bin_filter_symbols(bf, o->symbols);
-			}
-			o->import_name_symbols = ht_pp_new0();
-			if (o->import_name_symbols) {
-				RzBinSymbol *sym;
-				RzListIter *it;
-				rz_list_foreach (o->symbols, it, sym) {
-					if (!sym->is_imported || !sym->name || !*sym->name) {
-						continue;
-					}
-					ht_pp_insert(o->import_name_symbols, sym->name, sym);
-				}
-			}
-		}
-	}
-	if (p->libs) {
-		o->libs = p->libs(bf);
+	if (o->opts.lazy) {
+		// the remaining items are loaded on their first access
+		o->pending = BIN_OBJECT_LAZY_ALL;
+	} else {
+		object_load_fields(bf, o);
+		object_load_imports(bf, o);
+		object_load_symbols(bf, o);
+		object_load_libs(bf, o);
 	}
 	if (p->sections) {
 		// XXX sections are populated by call to size
@@ -480,40 +695,16 @@ RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 			o->sections = p->sections(bf);
 		}
 		REBASE_PADDR(o, o->sections, RzBinSection);
-		if (bin->filter) {
+		if (bf->rbin->filter) {
 			rz_bin_filter_sections(bf, o->sections);
 		}
 	}
 
 	o->info = p->info ? p->info(bf) : NULL;
 
-	if (bin->filter_rules & (RZ_BIN_REQ_RELOCS | RZ_BIN_REQ_IMPORTS)) {
-		if (p->relocs) {
-			RzList *l = p->relocs(bf);
-			if (l) {
-				REBASE_PADDR(o, l, RzBinReloc);
-				o->relocs = rz_bin_reloc_storage_new(l);
-			}
-		}
-	}
-	if (bin->filter_rules & RZ_BIN_REQ_STRINGS) {
-		RzList *strings;
-		if (p->strings) {
-			strings = p->strings(bf);
-		} else {
-			// when a bin plugin does not provide it's own strings
-			// we always take all the strings found in the binary
-			// the method also converts the paddrs to vaddrs
-			strings = rz_bin_file_strings(bf, minlen, true);
-		}
-
-		if (bin->debase64) {
-			bin_object_decode_all_base64_strings(strings);
-		}
-		REBASE_PADDR(o, strings, RzBinString);
-
-		// RzBinStrDb becomes the owner of the RzList strings
-		o->strings = rz_bin_string_database_new(strings);
+	if (!o->opts.lazy) {
+		object_load_relocs(bf, o);
+		object_load_strings(bf, o);
 	}
 
 	if (o->info && RZ_STR_ISEMPTY(o->info->compiler)) {
@@ -524,48 +715,9 @@ RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 		}
 	}
 
-	o->lang = rz_bin_language_detect(bf);
-
-	if (bin->filter_rules & (RZ_BIN_REQ_CLASSES | RZ_BIN_REQ_CLASSES_SOURCES)) {
-		if (p->classes) {
-			RzList *classes = p->classes(bf);
-			if (classes) {
-				// XXX we should probably merge them instead
-				rz_list_free(o->classes);
-				o->classes = classes;
-				rz_bin_object_rebuild_classes_ht(o);
-			}
-
-			if (o->lang == RZ_BIN_LANGUAGE_SWIFT) {
-				o->classes = classes_from_symbols(bf);
-			}
-		} else {
-			RzList *classes = classes_from_symbols(bf);
-			if (classes) {
-				o->classes = classes;
-			}
-		}
-
-		if (bin->filter) {
-			filter_classes(bf, o->classes);
-		}
-
-		// cache addr=class+method
-		if (o->classes) {
-			RzList *klasses = o->classes;
-			RzListIter *iter, *iter2;
-			RzBinClass *klass;
-			RzBinSymbol *method;
-			if (!o->addrzklassmethod) {
-				// this is slow. must be optimized, but at least its cached
-				o->addrzklassmethod = ht_up_new0();
-				rz_list_foreach (klasses, iter, klass) {
-					rz_list_foreach (klass->methods, iter2, method) {
-						ht_up_insert(o->addrzklassmethod, method->vaddr, method);
-					}
-				}
-			}
-		}
+	if (!o->opts.lazy) {
+		object_load_language(bf, o);
+		object_load_classes(bf, o);
 	}
 	if (p->lines) {
 		o->lines = p->lines(bf);
@@ -577,11 +729,9 @@ RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 		}
 		o->kv = new_kv;
 	}
-	if (p->mem) {
-		o->mem = p->mem(bf);
-	}
-	if (p->resources) {
-		o->resources = p->resources(bf);
+	if (!o->opts.lazy) {
+		object_load_mem(bf, o);
+		object_load_resources(bf, o);
 	}
 	return true;
 }
@@ -589,6 +739,7 @@ RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 RZ_API RzBinRelocStorage *rz_bin_object_patch_relocs(RzBinFile *bf, RzBinObject *o) {
 	rz_return_val_if_fail(bf && o, NULL);
 
+	object_load_lazy(o, BIN_OBJECT_LAZY_RELOCS);
 	static bool first = true;
 	// rz_bin_object_set_items set o->relocs but there we don't have access
 	// to io so we need to be run from bin_relocs, free the previous reloc and get
@@ -614,6 +765,7 @@ RZ_API RzBinRelocStorage *rz_bin_object_patch_relocs(RzBinFile *bf, RzBinObject
  */
 RZ_API RzBinSymbol *rz_bin_object_get_symbol_of_import(RzBinObject *o, RzBinImport *imp) {
 	rz_return_val_if_fail(o && imp && imp->name, NULL);
+	object_load_lazy(o, BIN_OBJECT_LAZY_SYMBOLS);
 	if (!o->import_name_symbols) {
 		return NULL;
 	}
@@ -716,6 +868,7 @@ RZ_API const RzList /*<RzBinAddr *>*/ *rz_bin_object_get_entries(RZ_NONNULL RzBi
  */
 RZ_API const RzList /*<RzBinField *>*/ *rz_bin_object_get_fields(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, NULL);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_FIELDS);
 	return obj->fields;
 }
 
@@ -724,6 +877,7 @@ RZ_API const RzList /*<RzBinField *>*/ *rz_bin_object_get_fields(RZ_NONNULL RzBi
  */
 RZ_API const RzList /*<RzBinImport *>*/ *rz_bin_object_get_imports(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, NULL);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_IMPORTS);
 	return obj->imports;
 }
 
@@ -740,6 +894,7 @@ RZ_API const RzBinInfo *rz_bin_object_get_info(RZ_NONNULL RzBinObject *obj) {
  */
 RZ_API const RzList /*<char *>*/ *rz_bin_object_get_libs(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, NULL);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_LIBS);
 	return obj->libs;
 }
 
@@ -796,6 +951,7 @@ RZ_API RZ_OWN RzList /*<RzBinMap *>*/ *rz_bin_object_get_maps(RZ_NONNULL RzBinOb
  */
 RZ_API const RzList /*<RzBinClass *>*/ *rz_bin_object_get_classes(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, NULL);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_CLASSES);
 	return obj->classes;
 }
 
@@ -804,6 +960,7 @@ RZ_API const RzList /*<RzBinClass *>*/ *rz_bin_object_get_classes(RZ_NONNULL RzB
  */
 RZ_API const RzList /*<RzBinString *>*/ *rz_bin_object_get_strings(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, NULL);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_STRINGS);
 	if (!obj->strings) {
 		return NULL;
 	}
@@ -815,6 +972,7 @@ RZ_API const RzList /*<RzBinString *>*/ *rz_bin_object_get_strings(RZ_NONNULL Rz
  */
 RZ_API const RzList /*<RzBinMem *>*/ *rz_bin_object_get_mem(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, NULL);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_MEM);
 	return obj->mem;
 }
 
@@ -823,14 +981,34 @@ RZ_API const RzList /*<RzBinMem *>*/ *rz_bin_object_get_mem(RZ_NONNULL RzBinObje
  */
 RZ_API const RzList /*<RzBinSymbol *>*/ *rz_bin_object_get_symbols(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, NULL);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_SYMBOLS);
 	return obj->symbols;
 }
 
+/**
+ * \brief Get the relocations of the binary object.
+ */
+RZ_API RzBinRelocStorage *rz_bin_object_get_relocs(RZ_NONNULL RzBinObject *obj) {
+	rz_return_val_if_fail(obj, NULL);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_RELOCS);
+	return obj->relocs;
+}
+
+/**
+ * \brief Get the language the binary object was detected to be compiled from.
+ */
+RZ_API RzBinLanguage rz_bin_object_get_language(RZ_NONNULL RzBinObject *obj) {
+	rz_return_val_if_fail(obj, RZ_BIN_LANGUAGE_UNKNOWN);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_LANGUAGE);
+	return obj->lang;
+}
+
 /**
  * \brief Get a list of \p RzBinResource representing the resources in the binary object.
  */
 RZ_API const RzList /*<RzBinResource *>*/ *rz_bin_object_get_resources(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, NULL);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_RESOURCES);
 	return obj->resources;
 }
 
@@ -839,6 +1017,7 @@ RZ_API const RzList /*<RzBinResource *>*/ *rz_bin_object_get_resources(RZ_NONNUL
  */
 RZ_API bool rz_bin_object_reset_strings(RZ_NONNULL RzBin *bin, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(bin && bf && obj, false);
+	obj->pending &= ~BIN_OBJECT_LAZY_STRINGS;
 	RZ_FREE_CUSTOM(obj->strings, rz_bin_string_database_free);
 
 	RzList *strings = NULL;
@@ -867,6 +1046,7 @@ RZ_API bool rz_bin_object_reset_strings(RZ_NONNULL RzBin *bin, RZ_NONNULL RzBinF
  */
 RZ_API RZ_BORROW RzBinString *rz_bin_object_get_string_at(RZ_NONNULL RzBinObject *obj, ut64 address, bool is_va) {
 	rz_return_val_if_fail(obj, false);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_STRINGS);
 	if (!obj->strings) {
 		return NULL;
 	}
@@ -876,6 +1056,19 @@ RZ_API RZ_BORROW RzBinString *rz_bin_object_get_string_at(RZ_NONNULL RzBinObject
 	return ht_up_find(obj->strings->phys, address, NULL);
 }
 
+/**
+ * \brief Add \p bstr to the RzBinObject string database, taking its ownership on success
+ */
+RZ_API bool rz_bin_object_add_string(RZ_NONNULL RzBinObject *obj, RZ_NONNULL RZ_OWN RzBinString *bstr) {
+	rz_return_val_if_fail(obj && bstr, false);
+	// the lazily loaded strings would replace the added one
+	object_load_lazy(obj, BIN_OBJECT_LAZY_STRINGS);
+	if (!obj->strings) {
+		return false;
+	}
+	return rz_bin_string_database_add(obj->strings, bstr);
+}
+
 /**
  * \brief Return true if the binary object \p obj is big endian.
  */
@@ -889,6 +1082,7 @@ RZ_API bool rz_bin_object_is_big_endian(RZ_NONNULL RzBinObject *obj) {
  */
 RZ_API bool rz_bin_object_is_static(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, false);
+	object_load_lazy(obj, BIN_OBJECT_LAZY_LIBS);
 	if (obj->libs && rz_list_length(obj->libs) > 0) {
 		return RZ_BIN_DBG_STATIC & obj->info->dbg_info;
 	}
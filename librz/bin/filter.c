@@ -82,7 +82,7 @@ RZ_API void rz_bin_filter_sym(RzBinFile *bf, HtPP *ht, ut64 vaddr, RzBinSymbol *
 	rz_return_if_fail(ht && sym && sym->name);
 	const char *name = sym->dname ? sym->dname : sym->name;
 
-	if (bf && bf->o && bf->o->lang && !sym->dname) {
+	if (bf && bf->o && rz_bin_object_get_language(bf->o) && !sym->dname) {
 		char *dn = rz_bin_demangle(bf, NULL, name, sym->vaddr, false);
 		if (RZ_STR_ISNOTEMPTY(dn)) {
 			sym->dname = dn;
@@ -11,6 +11,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include "cons_private.h"
 
 #define COUNT_LINES 1
 #define CTX(x)      I.context->x
@@ -687,6 +688,89 @@ RZ_API RzCons *rz_cons_free(void) {
 	return NULL;
 }
 
+#define STREAM_CHUNK (64 * 1024)
+
+static bool cons_grep_active(void) {
+	return I.filter || CTX(grep).nstrings > 0 || CTX(grep).tokens_used || CTX(grep).less || CTX(grep).json;
+}
+
+/**
+ * Whether the output can be written while it is produced, see scr.stream.
+ * Only the output of the main context to a file or pipe is streamed, and not
+ * while it is captured with rz_cons_push() or needs all of it for a filter.
+ */
+static bool cons_can_stream(void) {
+	if (!I.stream || I.null || I.is_html || I.highlight || I.linesleep > 0 || CTX(noflush)) {
+		return false;
+	}
+	if (I.context != &rz_cons_context_default || (CTX(cons_stack) && !rz_stack_is_empty(CTX(cons_stack)))) {
+		return false;
+	}
+	if (cons_grep_active() && !rz_cons_grep_is_streamable()) {
+		return false;
+	}
+	return I.fdout > 1 || !rz_cons_isatty();
+}
+
+static void cons_write_tee(const char *buf, size_t len) {
+	FILE *d = rz_sys_fopen(I.teefile, "a+");
+	if (!d) {
+		eprintf("Cannot write on '%s'\n", I.teefile);
+		return;
+	}
+	if (fwrite(buf, 1, len, d) != len) {
+		eprintf("rz_cons_flush: fwrite: error (%s)\n", I.teefile);
+	}
+	fclose(d);
+}
+
+/**
+ * Write the complete lines of the buffer, filtered through the current grep,
+ * and keep only the last unfinished line in it.
+ */
+static void cons_stream(void) {
+	char *buf = CTX(buffer);
+	size_t n = CTX(buffer_len);
+	while (n && buf[n - 1] != '\n') {
+		n--;
+	}
+	if (!n) {
+		return;
+	}
+	if (cons_grep_active()) {
+		RzStrBuf ob;
+		rz_strbuf_init(&ob);
+		if (!rz_cons_grep_lines(buf, (int)n, &ob)) {
+			rz_strbuf_fini(&ob);
+			return;
+		}
+		int len;
+		const char *out = (const char *)rz_strbuf_getbin(&ob, &len);
+		__cons_write(out, len);
+		if (I.teefile && *I.teefile) {
+			cons_write_tee(out, len);
+		}
+		rz_strbuf_fini(&ob);
+	} else {
+		__cons_write(buf, (int)n);
+		if (I.teefile && *I.teefile) {
+			cons_write_tee(buf, n);
+		}
+	}
+	memmove(buf, buf + n, CTX(buffer_len) - n);
+	CTX(buffer_len) -= n;
+	buf[CTX(buffer_len)] = '\0';
+	I.lastline = buf;
+	CTX(streamed) = true;
+	ctx_rowcol_calc_reset();
+}
+
+static inline void cons_stream_check(void) {
+	if (CTX(buffer_len) >= STREAM_CHUNK && cons_can_stream()) {
+		cons_stream();
+	}
+}
+
 #define MOAR (4096 * 8)
 static bool palloc(int moar) {
 	void *temp;
@@ -816,6 +900,7 @@ RZ_API void rz_cons_reset(void) {
 	I.lastline = CTX(buffer);
 	cons_grep_reset(&CTX(grep));
 	CTX(pageable) = true;
+	CTX(streamed) = false;
 	ctx_rowcol_calc_reset();
 }
 
@@ -841,7 +926,7 @@ RZ_API int rz_cons_get_buffer_len(void) {
 
 RZ_API void rz_cons_filter(void) {
 	/* grep */
-	if (I.filter || CTX(grep).nstrings > 0 || CTX(grep).tokens_used || CTX(grep).less || CTX(grep).json) {
+	if (cons_grep_active()) {
 		(void)rz_cons_grepbuf();
 		I.filter = false;
 	}
@@ -876,6 +961,8 @@ RZ_API void rz_cons_push(void) {
 	if (CTX(buffer)) {
 		memset(CTX(buffer), 0, CTX(buffer_sz));
 	}
+	// the grep of the outer output, set up before its command with scr.stream, is restored by rz_cons_pop()
+	cons_grep_reset(&CTX(grep));
 	CTX(noflush) = true;
 }
 
@@ -971,7 +1058,11 @@ RZ_API void rz_cons_flush(void) {
 		rz_cons_reset();
 		return;
 	}
-	if (lastMatters() && !CTX(lastMode)) {
+	if (CTX(streamed)) {
+		// part of the output is already written, there is no complete copy of it
+		CTX(lastLength) = 0;
+		CTX(lastMode) = false;
+	} else if (lastMatters() && !CTX(lastMode)) {
 		// snapshot of the output
 		if (CTX(buffer_len) > CTX(lastLength)) {
 			free(CTX(lastOutput));
@@ -1023,15 +1114,7 @@ RZ_API void rz_cons_flush(void) {
 		}
 	}
 	if (tee && *tee) {
-		FILE *d = rz_sys_fopen(tee, "a+");
-		if (d) {
-			if (CTX(buffer_len) != fwrite(CTX(buffer), 1, CTX(buffer_len), d)) {
-				eprintf("rz_cons_flush: fwrite: error (%s)\n", tee);
-			}
-			fclose(d);
-		} else {
-			eprintf("Cannot write on '%s'\n", tee);
-		}
+		cons_write_tee(CTX(buffer), CTX(buffer_len));
 	}
 	rz_cons_highlight(I.highlight);
 
@@ -1199,6 +1282,7 @@ RZ_API void rz_cons_printf_list(const char *format, va_list ap) {
 				}
 			}
 			CTX(buffer_len) += written;
+			cons_stream_check();
 		}
 	} else {
 		rz_cons_strcat(format);
@@ -1249,6 +1333,8 @@ RZ_API int rz_cons_memcat(const char *str, int len) {
 	}
 	if (I.flush) {
 		rz_cons_flush();
+	} else {
+		cons_stream_check();
 	}
 	if (I.break_word && str && len > 0) {
 		if (rz_mem_mem((const ut8 *)str, len, (const ut8 *)I.break_word, I.break_word_len)) {
@@ -1264,6 +1350,7 @@ RZ_API void rz_cons_memset(char ch, int len) {
 			memset(CTX(buffer) + CTX(buffer_len), ch, len);
 			CTX(buffer_len) += len;
 			(CTX(buffer))[CTX(buffer_len)] = 0;
+			cons_stream_check();
 		}
 	}
 }
@@ -0,0 +1,10 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#ifndef CONS_PRIVATE_H
+#define CONS_PRIVATE_H
+
+RZ_IPI bool rz_cons_grep_is_streamable(void);
+RZ_IPI bool rz_cons_grep_lines(const char *buf, int len, RzStrBuf *ob);
+
+#endif
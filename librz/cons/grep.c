@@ -4,6 +4,7 @@
 
 #include <rz_cons.h>
 #include <rz_util/rz_print.h>
+#include "cons_private.h"
 #include <sdb.h>
 
 #define I(x) rz_cons_singleton()->x
@@ -480,6 +481,89 @@ static int cmp(const void *a, const void *b) {
 	return strcmp(a, b);
 }
 
+/**
+ * Append the lines of \p buf that pass the grep to \p ob.
+ * \p show keeps whether the following lines are in the selected line range.
+ * \return false if the grep failed
+ */
+static bool grep_lines(const char *buf, int len, bool *show, RzStrBuf *ob) {
+	RzCons *cons = rz_cons_singleton();
+	RzConsGrep *grep = &cons->context->grep;
+	bool is_range_line_grep_only = grep->range_line != 2 && grep->str && !*grep->str;
+	const char *in = buf;
+	int ret, l, tl;
+	while ((int)(size_t)(in - buf) < len) {
+		char *p = strchr(in, '\n');
+		if (!p) {
+			break;
+		}
+		l = p - in;
+		if ((!l && is_range_line_grep_only) || l > 0) {
+			char *tline = rz_str_ndup(in, l);
+			if (cons->grep_color) {
+				tl = l;
+			} else {
+				tl = rz_str_ansi_filter(tline, NULL, NULL, l);
+			}
+			if (tl < 0) {
+				ret = -1;
+			} else {
+				ret = rz_cons_grep_line(tline, tl);
+				if (!grep->range_line) {
+					if (grep->line == cons->lines) {
+						*show = true;
+					}
+				} else if (grep->range_line == 1) {
+					if (grep->f_line == cons->lines) {
+						*show = true;
+					}
+					if (grep->l_line == cons->lines) {
+						*show = false;
+					}
+				} else {
+					*show = true;
+				}
+			}
+			if ((!ret && is_range_line_grep_only) || ret > 0) {
+				if (*show) {
+					char *str = rz_str_ndup(tline, ret);
+					if (cons->grep_highlight) {
+						int i;
+						for (i = 0; i < grep->nstrings; i++) {
+							char *newstr = rz_str_newf(Color_INVERT "%s" Color_RESET, grep->strings[i]);
+							if (str && newstr) {
+								if (grep->icase) {
+									str = rz_str_replace_icase(str, grep->strings[i], newstr, 1, 1);
+								} else {
+									str = rz_str_replace(str, grep->strings[i], newstr, 1);
+								}
+							}
+							free(newstr);
+						}
+					}
+					if (str) {
+						rz_strbuf_append(ob, str);
+						rz_strbuf_append(ob, "\n");
+					}
+					free(str);
+				}
+				if (!grep->range_line) {
+					*show = false;
+				}
+				cons->lines++;
+			} else if (ret < 0) {
+				free(tline);
+				return false;
+			}
+			free(tline);
+			in += l + 1;
+		} else {
+			in++;
+		}
+	}
+	return true;
+}
+
 RZ_API void rz_cons_grepbuf(void) {
 	RzCons *cons = rz_cons_singleton();
 	cons->context->row = 0;
@@ -489,7 +573,7 @@ RZ_API void rz_cons_grepbuf(void) {
 	const int len = cons->context->buffer_len;
 	RzConsGrep *grep = &cons->context->grep;
 	const char *in = buf;
-	int ret, total_lines = 0, l = 0, tl = 0;
+	int total_lines = 0, l = 0;
 	bool show = false;
 	if (cons->filter) {
 		cons->context->buffer_len = 0;
@@ -639,76 +723,9 @@ RZ_API void rz_cons_grepbuf(void) {
 			grep->l_line = total_lines + grep->l_line;
 		}
 	}
-	bool is_range_line_grep_only = grep->range_line != 2 && !*grep->str;
-	in = buf;
-	while ((int)(size_t)(in - buf) < len) {
-		char *p = strchr(in, '\n');
-		if (!p) {
-			break;
-		}
-		l = p - in;
-		if ((!l && is_range_line_grep_only) || l > 0) {
-			char *tline = rz_str_ndup(in, l);
-			if (cons->grep_color) {
-				tl = l;
-			} else {
-				tl = rz_str_ansi_filter(tline, NULL, NULL, l);
-			}
-			if (tl < 0) {
-				ret = -1;
-			} else {
-				ret = rz_cons_grep_line(tline, tl);
-				if (!grep->range_line) {
-					if (grep->line == cons->lines) {
-						show = true;
-					}
-				} else if (grep->range_line == 1) {
-					if (grep->f_line == cons->lines) {
-						show = true;
-					}
-					if (grep->l_line == cons->lines) {
-						show = false;
-					}
-				} else {
-					show = true;
-				}
-			}
-			if ((!ret && is_range_line_grep_only) || ret > 0) {
-				if (show) {
-					char *str = rz_str_ndup(tline, ret);
-					if (cons->grep_highlight) {
-						int i;
-						for (i = 0; i < grep->nstrings; i++) {
-							char *newstr = rz_str_newf(Color_INVERT "%s" Color_RESET, grep->strings[i]);
-							if (str && newstr) {
-								if (grep->icase) {
-									str = rz_str_replace_icase(str, grep->strings[i], newstr, 1, 1);
-								} else {
-									str = rz_str_replace(str, grep->strings[i], newstr, 1);
-								}
-							}
-							free(newstr);
-						}
-					}
-					if (str) {
-						rz_strbuf_append(ob, str);
-						rz_strbuf_append(ob, "\n");
-					}
-					free(str);
-				}
-				if (!grep->range_line) {
-					show = false;
-				}
-				cons->lines++;
-			} else if (ret < 0) {
-				free(tline);
-				return;
-			}
-			free(tline);
-			in += l + 1;
-		} else {
-			in++;
-		}
+	if (!grep_lines(buf, len, &show, ob)) {
+		rz_strbuf_free(ob);
+		return;
 	}
 
 	cons->context->buffer_len = rz_strbuf_length(ob);
@@ -887,6 +904,28 @@ RZ_API int rz_cons_grep_line(char *buf, int len) {
 	return len;
 }
 
+/**
+ * \brief Whether the current grep can be applied to the output a few lines at a time
+ *
+ * Counting, sorting, selecting lines by index and the json/less/hud/zoom filters
+ * need the whole output at once.
+ */
+RZ_IPI bool rz_cons_grep_is_streamable(void) {
+	RzCons *cons = rz_cons_singleton();
+	RzConsGrep *grep = &cons->context->grep;
+	return !cons->filter && !grep->json && !grep->less && !grep->hud && !grep->zoom &&
+		!grep->counter && grep->sort == -1 && grep->range_line == 2;
+}
+
+/**
+ * \brief Append the complete lines in \p buf of \p len bytes that pass the current grep to \p ob
+ * \return false if the grep failed
+ */
+RZ_IPI bool rz_cons_grep_lines(const char *buf, int len, RzStrBuf *ob) {
+	bool show = true;
+	return grep_lines(buf, len, &show, ob);
+}
+
 RZ_API void rz_cons_grep(const char *grep) {
 	parse_grep_expression(grep);
 	rz_cons_grepbuf();
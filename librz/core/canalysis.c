@@ -44,7 +44,7 @@ RZ_IPI int fcn_cmpaddr(const void *_a, const void *_b) {
 
 static char *getFunctionName(RzCore *core, ut64 addr) {
 	RzBinFile *bf = rz_bin_cur(core->bin);
-	if (bf && bf->o) {
+	if (bf && bf->o && rz_bin_object_get_classes(bf->o) && bf->o->addrzklassmethod) {
 		RzBinSymbol *sym = ht_up_find(bf->o->addrzklassmethod, addr, NULL);
 		if (sym && sym->classname && sym->name) {
 			return rz_str_newf("method.%s.%s", sym->classname, sym->name);
@@ -2191,9 +2191,339 @@ static void set_new_xref(RzCore *core, ut64 xref_from, ut64 xref_to, RzAnalysisX
 	}
 }
 
+/**
+ * \brief Subset of RzAnalysisOp used to find xrefs, which can be decoded by another thread.
+ */
+typedef struct xrefs_op_t {
+	ut64 addr;
+	ut64 val;
+	ut64 ptr;
+	ut64 disp;
+	ut64 jump;
+	st64 imm[6];
+	ut32 type;
+} XRefsOp;
+
+typedef struct xrefs_search_ctx_t {
+	RzCore *core;
+	bool cfg_debug;
+	bool decode_str;
+	bool jmp_cref;
+	st64 asm_sub_varmin;
+} XRefsSearchCtx;
+
+static void xrefs_op_from_analysis_op(XRefsOp *xop, const RzAnalysisOp *op) {
+	xop->addr = op->addr;
+	xop->val = op->val;
+	xop->ptr = op->ptr;
+	xop->disp = op->disp;
+	xop->jump = op->jump;
+	xop->type = op->type;
+	for (ut8 i = 0; i < RZ_ARRAY_SIZE(xop->imm); ++i) {
+		xop->imm[i] = op->analysis_vals[i].imm;
+	}
+}
+
+static int xrefs_search_apply_op(XRefsSearchCtx *ctx, const XRefsOp *op) {
+	RzCore *core = ctx->core;
+	int count = 0;
+	// find references
+	if ((st64)op->val > ctx->asm_sub_varmin && op->val != UT64_MAX && op->val != UT32_MAX) {
+		if (is_valid_xref(core, op->val, RZ_ANALYSIS_XREF_TYPE_DATA, ctx->cfg_debug)) {
+			set_new_xref(core, op->addr, op->val, RZ_ANALYSIS_XREF_TYPE_DATA, ctx->decode_str);
+			count++;
+		}
+	}
+	for (ut8 i = 0; i < RZ_ARRAY_SIZE(op->imm); ++i) {
+		st64 aval = op->imm[i];
+		if (aval > ctx->asm_sub_varmin && aval != UT64_MAX && aval != UT32_MAX) {
+			if (is_valid_xref(core, aval, RZ_ANALYSIS_XREF_TYPE_DATA, ctx->cfg_debug)) {
+				set_new_xref(core, op->addr, aval, RZ_ANALYSIS_XREF_TYPE_DATA, ctx->decode_str);
+				count++;
+			}
+		}
+	}
+	// find references
+	if (op->ptr && op->ptr != UT64_MAX && op->ptr != UT32_MAX) {
+		if (is_valid_xref(core, op->ptr, RZ_ANALYSIS_XREF_TYPE_DATA, ctx->cfg_debug)) {
+			set_new_xref(core, op->addr, op->ptr, RZ_ANALYSIS_XREF_TYPE_DATA, ctx->decode_str);
+			count++;
+		}
+	}
+	// find references
+	if (op->addr > 512 && op->disp > 512 && op->disp && op->disp != UT64_MAX) {
+		if (is_valid_xref(core, op->disp, RZ_ANALYSIS_XREF_TYPE_DATA, ctx->cfg_debug)) {
+			set_new_xref(core, op->addr, op->disp, RZ_ANALYSIS_XREF_TYPE_DATA, ctx->decode_str);
+			count++;
+		}
+	}
+	switch (op->type) {
+	case RZ_ANALYSIS_OP_TYPE_JMP:
+		if (is_valid_xref(core, op->jump, RZ_ANALYSIS_XREF_TYPE_CODE, ctx->cfg_debug)) {
+			set_new_xref(core, op->addr, op->jump, RZ_ANALYSIS_XREF_TYPE_CODE, ctx->decode_str);
+			count++;
+		}
+		break;
+	case RZ_ANALYSIS_OP_TYPE_CJMP:
+		if (ctx->jmp_cref &&
+			is_valid_xref(core, op->jump, RZ_ANALYSIS_XREF_TYPE_CODE, ctx->cfg_debug)) {
+			set_new_xref(core, op->addr, op->jump, RZ_ANALYSIS_XREF_TYPE_CODE, ctx->decode_str);
+			count++;
+		}
+		break;
+	case RZ_ANALYSIS_OP_TYPE_CALL:
+	case RZ_ANALYSIS_OP_TYPE_CCALL:
+		if (is_valid_xref(core, op->jump, RZ_ANALYSIS_XREF_TYPE_CALL, ctx->cfg_debug)) {
+			set_new_xref(core, op->addr, op->jump, RZ_ANALYSIS_XREF_TYPE_CALL, ctx->decode_str);
+			count++;
+		}
+		break;
+	case RZ_ANALYSIS_OP_TYPE_UJMP:
+	case RZ_ANALYSIS_OP_TYPE_IJMP:
+	case RZ_ANALYSIS_OP_TYPE_RJMP:
+	case RZ_ANALYSIS_OP_TYPE_IRJMP:
+	case RZ_ANALYSIS_OP_TYPE_MJMP:
+	case RZ_ANALYSIS_OP_TYPE_UCJMP:
+		count++;
+		if (is_valid_xref(core, op->ptr, RZ_ANALYSIS_XREF_TYPE_CODE, ctx->cfg_debug)) {
+			set_new_xref(core, op->addr, op->ptr, RZ_ANALYSIS_XREF_TYPE_CODE, ctx->decode_str);
+			count++;
+		}
+		break;
+	case RZ_ANALYSIS_OP_TYPE_UCALL:
+	case RZ_ANALYSIS_OP_TYPE_ICALL:
+	case RZ_ANALYSIS_OP_TYPE_RCALL:
+	case RZ_ANALYSIS_OP_TYPE_IRCALL:
+	case RZ_ANALYSIS_OP_TYPE_UCCALL:
+		if (is_valid_xref(core, op->ptr, RZ_ANALYSIS_XREF_TYPE_CALL, ctx->cfg_debug)) {
+			set_new_xref(core, op->addr, op->ptr, RZ_ANALYSIS_XREF_TYPE_CALL, ctx->decode_str);
+			count++;
+		}
+		break;
+	default:
+		break;
+	}
+	return count;
+}
+
+/**
+ * \brief Returns true when a block of bytes can be skipped since it is all 0x00 or 0xff.
+ */
+static bool xrefs_search_is_empty_block(const ut8 *buf, int size) {
+	if (buf[0] != 0x00 && buf[0] != 0xff) {
+		return false;
+	}
+	for (int i = 1; i < size; ++i) {
+		if (buf[i] != buf[0]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Decodes the block \p buf at \p at and calls \p cb for each decoded op.
+ *
+ * Decoding restarts at each block boundary and any instruction that crosses
+ * the end of the block is discarded, thus each block is independent from the others.
+ * Worker threads must set \p check_break to false, since the console is not thread-safe.
+ */
+static void xrefs_search_decode_block(RzAnalysis *analysis, RzAnalysisOpMask mask, ut64 at, const ut8 *buf, int bsz, RzVector /*<XRefsOp>*/ *ops, bool check_break) {
+	RzAnalysisOp op = { 0 };
+	int i = 0, ret = bsz;
+	while (i < bsz && !(check_break && rz_cons_is_breaked())) {
+		ret = rz_analysis_op(analysis, &op, at + i, buf + i, bsz - i, mask);
+		ret = ret > 0 ? ret : 1;
+		i += ret;
+		if (ret <= 0 || i > bsz) {
+			break;
+		}
+		XRefsOp *xop = rz_vector_push(ops, NULL);
+		if (!xop) {
+			break;
+		}
+		xrefs_op_from_analysis_op(xop, &op);
+		rz_analysis_op_fini(&op);
+	}
+	rz_analysis_op_fini(&op);
+}
+
+#define XREFS_SEARCH_BLOCK_SIZE        8096
+#define XREFS_SEARCH_BLOCKS_PER_THREAD 16
+
+typedef struct xrefs_search_block_t {
+	ut64 at;
+	ut8 buf[XREFS_SEARCH_BLOCK_SIZE];
+	RzVector /*<XRefsOp>*/ ops;
+} XRefsSearchBlock;
+
+typedef struct xrefs_search_worker_t {
+	RzAnalysis *decoder;
+	RzIOSnapshot *snapshot;
+	RzThreadQueue *blocks;
+} XRefsSearchWorker;
+
+static void xrefs_search_worker_run(XRefsSearchWorker *worker) {
+	XRefsSearchBlock *block = NULL;
+	while ((block = rz_th_queue_pop(worker->blocks, false))) {
+		(void)rz_io_snapshot_read_at(worker->snapshot, block->at, block->buf, XREFS_SEARCH_BLOCK_SIZE);
+		if (xrefs_search_is_empty_block(block->buf, XREFS_SEARCH_BLOCK_SIZE)) {
+			continue;
+		}
+		xrefs_search_decode_block(worker->decoder, RZ_ANALYSIS_OP_MASK_BASIC, block->at, block->buf, XREFS_SEARCH_BLOCK_SIZE, &block->ops, false);
+	}
+}
+
+/**
+ * Analysis plugins whose op() keeps all its state in the plugin data and decodes each
+ * instruction independently of the previous ones, thus they can run on multiple threads
+ * with a decoder each. Many others still keep static state (e.g. the mips t9 value or
+ * the capstone handles of mips, ppc, riscv and sparc) or track the previous instructions
+ * (e.g. the arm IT blocks, the hexagon packets) and must stay sequential.
+ */
+static const char *decoder_safe_plugins[] = {
+	"x86",
+};
+
+/**
+ * \brief Returns true if the instructions can be decoded without any hint or per-address arch/bits change.
+ *
+ * The decoders used by the worker threads do not have access to the hints, the core
+ * and the IO, thus the parallel decoding is used only with the plugins which are known
+ * to be thread-safe and when the result cannot differ from the sequential one.
+ */
+RZ_IPI bool rz_core_analysis_can_use_decoders(RzCore *core) {
+	RzAnalysis *analysis = core->analysis;
+	if (!analysis->cur || !analysis->cur->op) {
+		return false;
+	}
+	bool safe = false;
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(decoder_safe_plugins); i++) {
+		if (!strcmp(analysis->cur->name, decoder_safe_plugins[i])) {
+			safe = true;
+			break;
+		}
+	}
+	if (!safe) {
+		return false;
+	} else if ((analysis->addr_hints && analysis->addr_hints->count > 0) ||
+		analysis->arch_hints || analysis->bits_hints) {
+		return false;
+	}
+	RzBinObject *o = rz_bin_cur_object(core->bin);
+	if (!o || (core->fixedarch && core->fixedbits)) {
+		return true;
+	}
+	RzListIter *it;
+	RzBinSection *s;
+	rz_list_foreach (o->sections, it, s) {
+		if ((!core->fixedarch && s->arch) || (!core->fixedbits && s->bits)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Searches for xrefs by decoding the blocks in parallel and applying the results in address order.
+ *
+ * The same threads decode all the batches of blocks of the range.
+ *
+ * \return Number of found xrefs, or -1 when the parallel search cannot be used.
+ */
+static int xrefs_search_parallel(XRefsSearchCtx *ctx, ut64 from, ut64 to, size_t n_threads) {
+	RzCore *core = ctx->core;
+	const size_t n_blocks = n_threads * XREFS_SEARCH_BLOCKS_PER_THREAD;
+	XRefsSearchWorker *workers = RZ_NEWS0(XRefsSearchWorker, n_threads);
+	XRefsSearchBlock *blocks = RZ_NEWS0(XRefsSearchBlock, n_blocks);
+	RzThreadQueue *queue = rz_th_queue_new(RZ_THREAD_QUEUE_UNLIMITED, NULL);
+	RzCoreWorkers *threads = NULL;
+	RzIOSnapshot *snapshot = NULL;
+	int count = -1;
+	if (!workers || !blocks || !queue) {
+		RZ_LOG_ERROR("cannot allocate xrefs search workers\n");
+		goto end;
+	}
+	for (size_t i = 0; i < n_threads; ++i) {
+		workers[i].decoder = rz_analysis_new_decoder(core->analysis);
+		workers[i].blocks = queue;
+		if (!workers[i].decoder) {
+			goto end;
+		}
+	}
+	for (size_t i = 0; i < n_blocks; ++i) {
+		rz_vector_init(&blocks[i].ops, sizeof(XRefsOp), NULL, NULL);
+	}
+	threads = rz_core_workers_new(n_threads, (RzCoreWorkerRun)xrefs_search_worker_run, workers, sizeof(XRefsSearchWorker));
+	if (!threads) {
+		RZ_LOG_ERROR("cannot allocate xrefs search thread pool\n");
+		goto end;
+	}
+
+	count = 0;
+	bool valid = true;
+	ut64 at = from;
+	while (valid && at < to && !rz_cons_is_breaked()) {
+		if (!snapshot || !rz_io_snapshot_is_valid(snapshot)) {
+			rz_io_snapshot_free(snapshot);
+			snapshot = rz_io_snapshot_new(core->io);
+			if (!snapshot) {
+				break;
+			}
+			for (size_t i = 0; i < n_threads; ++i) {
+				workers[i].snapshot = snapshot;
+			}
+		}
+
+		// the blocks are read by the workers via the io snapshot.
+		size_t used = 0;
+		for (; used < n_blocks && at < to; used++, at += XREFS_SEARCH_BLOCK_SIZE) {
+			if (!rz_io_is_valid_offset(core->io, at, RZ_PERM_X)) {
+				valid = false;
+				break;
+			}
+			XRefsSearchBlock *block = &blocks[used];
+			block->at = at;
+			rz_vector_clear(&block->ops);
+			rz_th_queue_push(queue, block, true);
+		}
+
+		rz_core_workers_run(threads);
+
+		for (size_t i = 0; i < used && !rz_cons_is_breaked(); ++i) {
+			XRefsOp *xop;
+			rz_vector_foreach(&blocks[i].ops, xop) {
+				count += xrefs_search_apply_op(ctx, xop);
+			}
+		}
+	}
+
+end:
+	rz_core_workers_free(threads);
+	rz_th_queue_free(queue);
+	rz_io_snapshot_free(snapshot);
+	if (blocks) {
+		for (size_t i = 0; i < n_blocks; ++i) {
+			rz_vector_fini(&blocks[i].ops);
+		}
+		free(blocks);
+	}
+	if (workers) {
+		for (size_t i = 0; i < n_threads; ++i) {
+			rz_analysis_free(workers[i].decoder);
+		}
+		free(workers);
+	}
+	return count;
+}
+
 /**
  * \brief Searches for xrefs in the range of the paramters \p 'from' and \p 'to'.
  *
+ * When `analysis.threads` is not 1, the instructions are decoded by multiple
+ * threads and the xrefs are added in address order, thus the result is the
+ * same of the sequential search.
+ *
  * \param core The Rizin core.
  * \param from Start of search interval.
  * \param to End of search interval.
@@ -2202,12 +2532,16 @@ static void set_new_xref(RzCore *core, ut64 xref_from, ut64 xref_to, RzAnalysisX
 RZ_API int rz_core_analysis_search_xrefs(RZ_NONNULL RzCore *core, ut64 from, ut64 to) {
 	rz_return_val_if_fail(core, -1);
 
-	bool cfg_debug = rz_config_get_b(core->config, "cfg.debug");
-	bool decode_str = rz_config_get_i(core->config, "analysis.strings");
+	XRefsSearchCtx ctx = {
+		.core = core,
+		.cfg_debug = rz_config_get_b(core->config, "cfg.debug"),
+		.decode_str = rz_config_get_i(core->config, "analysis.strings"),
+		.jmp_cref = rz_config_get_b(core->config, "analysis.jmp.cref"),
+		.asm_sub_varmin = rz_config_get_i(core->config, "asm.sub.varmin"),
+	};
 	ut64 at;
 	int count = 0;
-	const int bsz = 8096;
-	RzAnalysisOp op = { 0 };
+	const int bsz = XREFS_SEARCH_BLOCK_SIZE;
 
 	if (from == to) {
 		return -1;
@@ -2219,130 +2553,48 @@ RZ_API int rz_core_analysis_search_xrefs(RZ_NONNULL RzCore *core, ut64 from, ut6
 		return -1;
 	}
 
+	rz_cons_break_push(NULL, NULL);
+
+	size_t n_threads = rz_th_request_physical_cores(rz_config_get_i(core->config, "analysis.threads"));
+	if (n_threads > 1 && to - from > bsz && rz_core_analysis_can_use_decoders(core)) {
+		count = xrefs_search_parallel(&ctx, from, to, n_threads);
+		if (count >= 0) {
+			rz_cons_break_pop();
+			return count;
+		}
+		count = 0;
+	}
+
 	ut8 *buf = malloc(bsz);
+	RzVector ops;
+	rz_vector_init(&ops, sizeof(XRefsOp), NULL, NULL);
 	if (!buf) {
 		RZ_LOG_ERROR("cannot allocate a block\n");
+		rz_cons_break_pop();
 		return -1;
 	}
 
-	ut8 *block = malloc(bsz);
-	if (!block) {
-		RZ_LOG_ERROR("cannot allocate a temp block\n");
-		free(buf);
-		return -1;
-	}
-
-	rz_cons_break_push(NULL, NULL);
-
 	at = from;
-	st64 asm_sub_varmin = rz_config_get_i(core->config, "asm.sub.varmin");
 	while (at < to && !rz_cons_is_breaked()) {
-		int i = 0, ret = bsz;
 		if (!rz_io_is_valid_offset(core->io, at, RZ_PERM_X)) {
 			break;
 		}
 		(void)rz_io_read_at(core->io, at, buf, bsz);
-		memset(block, -1, bsz);
-		if (!memcmp(buf, block, bsz)) {
-			at += ret;
+		if (xrefs_search_is_empty_block(buf, bsz)) {
+			at += bsz;
 			continue;
 		}
-		memset(block, 0, bsz);
-		if (!memcmp(buf, block, bsz)) {
-			at += ret;
-			continue;
-		}
-		while (i < bsz && !rz_cons_is_breaked()) {
-			ret = rz_analysis_op(core->analysis, &op, at + i, buf + i, bsz - i, RZ_ANALYSIS_OP_MASK_BASIC | RZ_ANALYSIS_OP_MASK_HINT);
-			ret = ret > 0 ? ret : 1;
-			i += ret;
-			if (ret <= 0 || i > bsz) {
-				break;
-			}
-			// find references
-			if ((st64)op.val > asm_sub_varmin && op.val != UT64_MAX && op.val != UT32_MAX) {
-				if (is_valid_xref(core, op.val, RZ_ANALYSIS_XREF_TYPE_DATA, cfg_debug)) {
-					set_new_xref(core, op.addr, op.val, RZ_ANALYSIS_XREF_TYPE_DATA, decode_str);
-					count++;
-				}
-			}
-			for (ut8 i = 0; i < 6; ++i) {
-				st64 aval = op.analysis_vals[i].imm;
-				if (aval > asm_sub_varmin && aval != UT64_MAX && aval != UT32_MAX) {
-					if (is_valid_xref(core, aval, RZ_ANALYSIS_XREF_TYPE_DATA, cfg_debug)) {
-						set_new_xref(core, op.addr, aval, RZ_ANALYSIS_XREF_TYPE_DATA, decode_str);
-						count++;
-					}
-				}
-			}
-			// find references
-			if (op.ptr && op.ptr != UT64_MAX && op.ptr != UT32_MAX) {
-				if (is_valid_xref(core, op.ptr, RZ_ANALYSIS_XREF_TYPE_DATA, cfg_debug)) {
-					set_new_xref(core, op.addr, op.ptr, RZ_ANALYSIS_XREF_TYPE_DATA, decode_str);
-					count++;
-				}
-			}
-			// find references
-			if (op.addr > 512 && op.disp > 512 && op.disp && op.disp != UT64_MAX) {
-				if (is_valid_xref(core, op.disp, RZ_ANALYSIS_XREF_TYPE_DATA, cfg_debug)) {
-					set_new_xref(core, op.addr, op.disp, RZ_ANALYSIS_XREF_TYPE_DATA, decode_str);
-					count++;
-				}
-			}
-			switch (op.type) {
-			case RZ_ANALYSIS_OP_TYPE_JMP:
-				if (is_valid_xref(core, op.jump, RZ_ANALYSIS_XREF_TYPE_CODE, cfg_debug)) {
-					set_new_xref(core, op.addr, op.jump, RZ_ANALYSIS_XREF_TYPE_CODE, decode_str);
-					count++;
-				}
-				break;
-			case RZ_ANALYSIS_OP_TYPE_CJMP:
-				if (rz_config_get_b(core->config, "analysis.jmp.cref") &&
-					is_valid_xref(core, op.jump, RZ_ANALYSIS_XREF_TYPE_CODE, cfg_debug)) {
-					set_new_xref(core, op.addr, op.jump, RZ_ANALYSIS_XREF_TYPE_CODE, decode_str);
-					count++;
-				}
-				break;
-			case RZ_ANALYSIS_OP_TYPE_CALL:
-			case RZ_ANALYSIS_OP_TYPE_CCALL:
-				if (is_valid_xref(core, op.jump, RZ_ANALYSIS_XREF_TYPE_CALL, cfg_debug)) {
-					set_new_xref(core, op.addr, op.jump, RZ_ANALYSIS_XREF_TYPE_CALL, decode_str);
-					count++;
-				}
-				break;
-			case RZ_ANALYSIS_OP_TYPE_UJMP:
-			case RZ_ANALYSIS_OP_TYPE_IJMP:
-			case RZ_ANALYSIS_OP_TYPE_RJMP:
-			case RZ_ANALYSIS_OP_TYPE_IRJMP:
-			case RZ_ANALYSIS_OP_TYPE_MJMP:
-			case RZ_ANALYSIS_OP_TYPE_UCJMP:
-				count++;
-				if (is_valid_xref(core, op.ptr, RZ_ANALYSIS_XREF_TYPE_CODE, cfg_debug)) {
-					set_new_xref(core, op.addr, op.ptr, RZ_ANALYSIS_XREF_TYPE_CODE, decode_str);
-					count++;
-				}
-				break;
-			case RZ_ANALYSIS_OP_TYPE_UCALL:
-			case RZ_ANALYSIS_OP_TYPE_ICALL:
-			case RZ_ANALYSIS_OP_TYPE_RCALL:
-			case RZ_ANALYSIS_OP_TYPE_IRCALL:
-			case RZ_ANALYSIS_OP_TYPE_UCCALL:
-				if (is_valid_xref(core, op.ptr, RZ_ANALYSIS_XREF_TYPE_CALL, cfg_debug)) {
-					set_new_xref(core, op.addr, op.ptr, RZ_ANALYSIS_XREF_TYPE_CALL, decode_str);
-					count++;
-				}
-				break;
-			default:
-				break;
-			}
-			rz_analysis_op_fini(&op);
+		rz_vector_clear(&ops);
+		xrefs_search_decode_block(core->analysis, RZ_ANALYSIS_OP_MASK_BASIC | RZ_ANALYSIS_OP_MASK_HINT, at, buf, bsz, &ops, true);
+		XRefsOp *xop;
+		rz_vector_foreach(&ops, xop) {
+			count += xrefs_search_apply_op(&ctx, xop);
 		}
 		at += bsz;
-		rz_analysis_op_fini(&op);
 	}
 	rz_cons_break_pop();
+	rz_vector_fini(&ops);
 	free(buf);
-	free(block);
 	return count;
 }
 
@@ -2372,7 +2624,7 @@ static bool isSkippable(RzBinSymbol *s) {
 }
 
 RZ_API int rz_core_analysis_all(RzCore *core) {
-	RzList *list;
+	const RzList *list;
 	RzListIter *iter;
 	RzFlagItem *item;
 	RzAnalysisFunction *fcni;
@@ -2399,7 +2651,7 @@ RZ_API int rz_core_analysis_all(RzCore *core) {
 	RzBinFile *bf = core->bin->cur;
 	RzBinObject *o = bf ? bf->o : NULL;
 	/* Symbols (Imports are already analyzed by rz_bin on init) */
-	if (o && (list = o->symbols) != NULL) {
+	if (o && (list = rz_bin_object_get_symbols(o)) != NULL) {
 		rz_list_foreach (list, iter, symbol) {
 			if (rz_cons_is_breaked()) {
 				break;
@@ -3519,7 +3771,7 @@ RZ_API void rz_core_analysis_esil(RzCore *core, ut64 addr, ut64 size, RZ_NULLABL
 		if (gp_fixed && gp_reg) {
 			rz_reg_setv(core->analysis->reg, gp_reg, gp);
 		}
-		(void)rz_analysis_esil_parse(ESIL, esilstr);
+		(void)rz_analysis_esil_parse_at(ESIL, cur, esilstr);
 #define CHECKREF(x) ((refptr && (x) == refptr) || !refptr)
 		switch (op.type) {
 		case RZ_ANALYSIS_OP_TYPE_LEA:
@@ -4363,15 +4615,14 @@ struct core_noretl {
 	SetU *todo;
 };
 
-static bool process_reference_noreturn_cb(void *u, const ut64 k, const void *v) {
-	RzCore *core = ((struct core_noretl *)u)->core;
-	RzList *noretl = ((struct core_noretl *)u)->noretl;
-	SetU *todo = ((struct core_noretl *)u)->todo;
-	RzAnalysisXRef *xref = (RzAnalysisXRef *)v;
+static void process_reference_noreturn(struct core_noretl *u, RzAnalysisXRef *xref) {
+	RzCore *core = u->core;
+	RzList *noretl = u->noretl;
+	SetU *todo = u->todo;
 	if (xref->type == RZ_ANALYSIS_XREF_TYPE_CALL || xref->type == RZ_ANALYSIS_XREF_TYPE_CODE) {
 		// At first we check if there are any relocations that override the call address
 		// Note, that the relocation overrides only the part of the instruction
-		ut64 addr = k;
+		ut64 addr = xref->from;
 		ut8 buf[CALL_BUF_SIZE] = { 0 };
 		RzAnalysisOp op = { 0 };
 		if (core->analysis->iob.read_at(core->analysis->iob.io, addr, buf, CALL_BUF_SIZE)) {
@@ -4382,7 +4633,7 @@ static bool process_reference_noreturn_cb(void *u, const ut64 k, const void *v)
 					RzAnalysisBlock *block = find_block_at_xref_addr(core, addr);
 					if (!block) {
 						rz_analysis_op_fini(&op);
-						return true;
+						return;
 					}
 					relocation_noreturn_process(core, noretl, todo, block, rel, op.size, addr);
 				}
@@ -4392,13 +4643,6 @@ static bool process_reference_noreturn_cb(void *u, const ut64 k, const void *v)
 			RZ_LOG_INFO("analysis: Fail to load %d bytes of data at 0x%08" PFMT64x "\n", CALL_BUF_SIZE, addr);
 		}
 	}
-	return true;
-}
-
-static bool process_refs_cb(void *u, const ut64 k, const void *v) {
-	HtUP *ht = (HtUP *)v;
-	ht_up_foreach(ht, process_reference_noreturn_cb, u);
-	return true;
 }
 
 static bool reanalyze_fcns_cb(void *u, const ut64 k, const void *v) {
@@ -4422,7 +4666,14 @@ RZ_API void rz_core_analysis_propagate_noreturn_relocs(RzCore *core, ut64 addr)
 	// List of the potentially noreturn functions
 	SetU *todo = set_u_new();
 	struct core_noretl u = { core, noretl, todo };
-	ht_up_foreach(core->analysis->ht_xrefs_to, process_refs_cb, &u);
+	// processing may change the xrefs, so iterate over a copy of them
+	RzList *xrefs = rz_analysis_xrefs_list(core->analysis);
+	RzListIter *it;
+	RzAnalysisXRef *xref;
+	rz_list_foreach (xrefs, it, xref) {
+		process_reference_noreturn(&u, xref);
+	}
+	rz_list_free(xrefs);
 	rz_list_free(noretl);
 	core->analysis->bits = bits1;
 	core->rasm->bits = bits2;
@@ -5034,8 +5285,8 @@ RZ_API bool rz_core_analysis_sigdb_apply(RZ_NONNULL RzCore *core, RZ_NULLABLE in
 			if (strcmp(bin, sig->bin_name) || strcmp(arch, sig->arch_name) || bits != sig->arch_bits) {
 				continue;
 			} else if (strstr(sig->base_name, "c++") &&
-				obj->lang != RZ_BIN_LANGUAGE_CXX &&
-				obj->lang != RZ_BIN_LANGUAGE_RUST) {
+				rz_bin_object_get_language(obj) != RZ_BIN_LANGUAGE_CXX &&
+				rz_bin_object_get_language(obj) != RZ_BIN_LANGUAGE_RUST) {
 				// C++ libs can create many false positives, especially on C binaries.
 				// So their usage is limited to C++ and RUST lang
 				continue;
@@ -95,6 +95,7 @@ RZ_API void rz_core_bin_options_init(RzCore *core, RZ_OUT RzBinOptions *opts, in
 	opts->obj_opts.elf_checks_sections = rz_config_get_b(core->config, "elf.checks.sections");
 	opts->obj_opts.elf_checks_segments = rz_config_get_b(core->config, "elf.checks.segments");
 	opts->obj_opts.big_endian = rz_config_get_b(core->config, "cfg.bigendian");
+	opts->obj_opts.lazy = rz_config_get_b(core->config, "bin.lazy");
 }
 
 RZ_API int rz_core_bin_set_by_fd(RzCore *core, ut64 bin_fd) {
@@ -241,6 +242,7 @@ RZ_API bool rz_core_bin_load_structs(RZ_NONNULL RzCore *core, RZ_NONNULL const c
 		return false;
 	}
 	RzBinOptions opt = { 0 };
+	opt.obj_opts.lazy = rz_config_get_b(core->config, "bin.lazy");
 	RzBinFile *bf = rz_bin_open(core->bin, file, &opt);
 	if (!bf) {
 		RZ_LOG_ERROR("core: cannot open bin '%s'\n", file);
@@ -595,6 +597,7 @@ RZ_API bool rz_core_bin_apply_config(RzCore *r, RzBinFile *binfile) {
 	rz_config_set(r->config, "file.type", rz_str_get(info->rclass));
 	rz_config_set(r->config, "cfg.bigendian",
 		info->big_endian ? "true" : "false");
+	rz_bin_object_get_language(obj);
 	if (info->lang) {
 		rz_config_set(r->config, "bin.lang", info->lang);
 	}
@@ -1214,7 +1217,7 @@ RZ_API bool rz_core_bin_apply_relocs(RzCore *core, RzBinFile *binfile, bool va_b
 	int va = VA_TRUE; // XXX relocs always vaddr?
 	RzBinRelocStorage *relocs = rz_bin_object_patch_relocs(binfile, o);
 	if (!relocs) {
-		relocs = o->relocs;
+		relocs = rz_bin_object_get_relocs(o);
 		if (!relocs) {
 			return false;
 		}
@@ -1266,7 +1269,7 @@ RZ_API bool rz_core_bin_apply_imports(RzCore *core, RzBinFile *binfile, bool va)
 	}
 	RzListIter *iter;
 	RzBinImport *import;
-	RzList *imports = o->imports;
+	const RzList *imports = rz_bin_object_get_imports(o);
 	rz_list_foreach (imports, iter, import) {
 		if (!import->libname || !strstr(import->libname, ".dll")) {
 			continue;
@@ -1551,7 +1554,7 @@ RZ_API bool rz_core_bin_apply_symbols(RzCore *core, RzBinFile *binfile, bool va)
 RZ_API bool rz_core_bin_apply_classes(RzCore *core, RzBinFile *binfile) {
 	rz_return_val_if_fail(core && binfile, false);
 	RzBinObject *o = binfile->o;
-	RzList *cs = o ? o->classes : NULL;
+	const RzList *cs = o ? rz_bin_object_get_classes(o) : NULL;
 	if (!cs) {
 		return false;
 	}
@@ -3054,6 +3057,9 @@ RZ_API bool rz_core_bin_info_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFile
 	bool havecode;
 	int bits;
 
+	// loading the language also fills info->lang
+	rz_bin_object_get_language(obj);
+
 	havecode = is_executable(obj) | (obj->entries != NULL);
 	compiled = rz_core_bin_get_compile_time(bf);
 	bits = (plugin && !strcmp(plugin->name, "any")) ? rz_config_get_i(core->config, "asm.bits") : info->bits;
@@ -3756,7 +3762,8 @@ static void bin_class_print_rizin(RzCore *r, RzBinClass *c, ut64 at_min) {
 	}
 
 	// C struct
-	if (bf->o->lang == RZ_BIN_LANGUAGE_C || bf->o->lang == RZ_BIN_LANGUAGE_CXX || bf->o->lang == RZ_BIN_LANGUAGE_OBJC) {
+	RzBinLanguage lang = rz_bin_object_get_language(bf->o);
+	if (lang == RZ_BIN_LANGUAGE_C || lang == RZ_BIN_LANGUAGE_CXX || lang == RZ_BIN_LANGUAGE_OBJC) {
 		rz_cons_printf("td \"struct %s {", c->name);
 		rz_list_foreach (c->fields, iter2, f) {
 			char *n = objc_name_toc(f->name);
@@ -3786,7 +3793,7 @@ RZ_API bool rz_core_bin_class_as_source_print(RZ_NONNULL RzCore *core, RZ_NONNUL
 			continue;
 		}
 		found = true;
-		switch (bf->o->lang & (~RZ_BIN_LANGUAGE_BLOCKS)) {
+		switch (rz_bin_object_get_language(bf->o) & (~RZ_BIN_LANGUAGE_BLOCKS)) {
 		case RZ_BIN_LANGUAGE_KOTLIN:
 		case RZ_BIN_LANGUAGE_GROOVY:
 		case RZ_BIN_LANGUAGE_DART:
@@ -959,6 +959,13 @@ static bool cb_usextr(void *user, void *data) {
 	return true;
 }
 
+static bool cb_binmmap(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	core->bin->use_mmap = node->i_value;
+	return true;
+}
+
 static bool cb_strpurge(void *user, void *data) {
 	RzCore *core = (RzCore *)user;
 	RzConfigNode *node = (RzConfigNode *)data;
@@ -1625,6 +1632,20 @@ static bool cb_iopcache(void *user, void *data) {
 	return true;
 }
 
+static bool cb_io_pagecache(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	if (!core || !core->io) {
+		return false;
+	}
+	ut64 n_pages = rz_config_get_b(core->config, "io.pagecache") ? rz_config_get_i(core->config, "io.pagecache.pages") : 0;
+	ut64 page_size = rz_config_get_i(core->config, "io.pagecache.pagesize");
+	if (n_pages > UT16_MAX || page_size > UT16_MAX * 256) {
+		RZ_LOG_ERROR("io.pagecache: too many pages or too big pages\n");
+		return false;
+	}
+	return rz_io_page_cache_set(core->io, (ut32)page_size, (ut32)n_pages);
+}
+
 static bool cb_iopcacheread(void *user, void *data) {
 	RzCore *core = (RzCore *)user;
 	RzConfigNode *node = (RzConfigNode *)data;
@@ -2167,6 +2188,12 @@ static bool cb_scrflush(void *user, void *data) {
 	return true;
 }
 
+static bool cb_scrstream(void *user, void *data) {
+	RzConfigNode *node = (RzConfigNode *)data;
+	rz_cons_singleton()->stream = node->i_value;
+	return true;
+}
+
 static bool cb_scrstrconv(void *user, void *data) {
 	RzCore *core = (RzCore *)user;
 	RzConfigNode *node = (RzConfigNode *)data;
@@ -2894,6 +2921,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 		"analysis.fcn", "analysis.bb",
 		NULL);
 	SETI("analysis.timeout", 0, "Stop analyzing after a couple of seconds");
+	SETI("analysis.threads", 1, "Number of threads used to decode instructions in aar (0: all cores, 1: sequential)");
 	SETCB("analysis.jmp.retpoline", "true", &cb_analysis_jmpretpoline, "Analyze retpolines, may be slower if not needed");
 	SETICB("analysis.jmp.tailcall", 0, &cb_analysis_jmptailcall, "Consume a branch as a call if delta is big");
 
@@ -3098,6 +3126,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETBPREF("asm.stackptr", "false", "Show stack pointer at disassembly");
 	SETBPREF("asm.cyclespace", "false", "Indent instructions depending on CPU-cycles");
 	SETBPREF("asm.cycles", "false", "Show CPU-cycles taken by instruction at disassembly");
+	SETI("asm.threads", 1, "Number of threads used to decode instructions in pI (0: all cores, 1: sequential)");
 	SETI("asm.tabs", 6, "Use tabs in disassembly");
 	SETBPREF("asm.tabs.once", "true", "Only tabulate the opcode, not the arguments");
 	SETI("asm.tabs.off", 0, "tabulate spaces after the offset");
@@ -3163,6 +3192,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	/* bin */
 	SETPREF("bin.hashlimit", "10M", "Only compute hash when opening a file if smaller than this size");
 	SETCB("bin.usextr", "true", &cb_usextr, "Use extract plugins when loading files");
+	SETCB("bin.mmap", "false", &cb_binmmap, "Map read-only local files in memory to parse them instead of reading them through io");
 	SETCB("bin.str.purge", "", &cb_strpurge, "Purge strings (e bin.str.purge=? provides more detail)");
 	SETBPREF("bin.b64str", "false", "Try to debase64 the strings");
 	SETCB("bin.at", "false", &cb_binat, "RzBin.cur depends on RzCore.offset");
@@ -3189,11 +3219,14 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETCB("bin.strings", "true", &cb_binstrings, "Load strings from rbin on startup");
 	SETCB("bin.debase64", "false", &cb_debase64, "Try to debase64 all strings");
 	SETBPREF("bin.classes", "true", "Load classes from rbin on startup");
+	SETBPREF("bin.lazy", "false", "Load symbols, imports, relocs, strings and classes of new binaries on their first use");
 	SETCB("bin.verbose", "false", &cb_binverbose, "Show RzBin warnings when loading binaries");
 
 	/* prj */
 	SETPREF("prj.file", "", "Path of the currently opened project");
 	SETBPREF("prj.compress", "false", "Compress the project file while saving");
+	SETBPREF("prj.binary", "false", "Save the project file in the binary sdb format, which loads faster than text");
+	SETBPREF("prj.incremental", "false", "Only append the changes to the project file when saving it again (use Psc to compact it)");
 
 	/* cfg */
 	SETBPREF("cfg.plugins", "true", "Load plugins at startup");
@@ -3390,6 +3423,10 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETICB("hex.stride", 0, &cb_hexstride, "Line stride in hexdump (default is 0)");
 	SETCB("hex.comments", "true", &cb_hexcomments, "Show comments in 'px' hexdump");
 
+	/* hash */
+	SETI("hash.blocksize", 0x100000, "Size of the blocks hashed separately by phm");
+	SETI("hash.threads", 0, "Number of threads used to hash the blocks in phm (0: all cores, 1: sequential)");
+
 	/* http */
 	SETBPREF("http.log", "true", "Show HTTP requests processed");
 	SETBPREF("http.colon", "false", "Only accept the : command");
@@ -3501,6 +3538,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETICB("scr.maxtab", 4096, &cb_completion_maxtab, "Change max number of auto completion suggestions");
 	SETICB("scr.pagesize", 1, &cb_scrpagesize, "Flush in pages when scr.linesleep is != 0");
 	SETCB("scr.flush", "false", &cb_scrflush, "Force flush to console in realtime (breaks scripting)");
+	SETCB("scr.stream", "false", &cb_scrstream, "Write output to files and pipes in chunks while it is produced, keeping memory bounded");
 	SETBPREF("scr.slow", "true", "Do slow stuff on visual mode like RzFlag.get_at(true)");
 	SETCB("scr.prompt.popup", "false", &cb_scr_prompt_popup, "Show widget dropdown for autocomplete");
 #if __WINDOWS__
@@ -3594,6 +3632,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETPREF("search.prefix", "hit", "Prefix name in search hits label");
 	SETBPREF("search.show", "true", "Show search results");
 	SETI("search.to", -1, "Search end address");
+	SETI("search.threads", 1, "Number of threads used to search the memory in /, /x, /v, /e and /z (0: all cores, 1: sequential)");
 	n = NODECB("search.case_sensitive", "smart", &cb_search_case_sensitive);
 	SETDESC(n, "Set grep(~) as case smart/sensitive/insensitive");
 	SETOPTIONS(n, "smart", "sensitive", "insensitive", NULL);
@@ -3614,6 +3653,9 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETCB("io.pcache", "false", &cb_iopcache, "io.cache for p-level");
 	SETCB("io.pcache.write", "false", &cb_iopcachewrite, "Enable write-cache");
 	SETCB("io.pcache.read", "false", &cb_iopcacheread, "Enable read-cache");
+	SETICB("io.pagecache.pagesize", 0x1000, &cb_io_pagecache, "Size of the pages of the io page cache");
+	SETICB("io.pagecache.pages", 256, &cb_io_pagecache, "Maximum number of pages kept in the io page cache");
+	SETCB("io.pagecache", "false", &cb_io_pagecache, "Serve the small reads from a cache of pages (see oP)");
 	SETCB("io.ff", "true", &cb_ioff, "Fill invalid buffers with 0xff instead of returning error");
 	SETBPREF("io.exec", "true", "See !!rizin -h~-x");
 	SETICB("io.0xff", 0xff, &cb_io_oxff, "Use this value instead of 0xff to fill unallocated areas");
@@ -3679,6 +3721,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	/* RzIL config */
 	SETB("rzil.step.events.read", false, "enables/disables printing aezse read event");
 	SETB("rzil.step.events.write", true, "enables/disables printing aezse write event");
+	SETB("rzil.compile", false, "Compile the ops of repeatedly stepped instructions for faster emulation");
 
 	/* FLIRT config */
 	SETBPREF("flirt.sig.library", RZ_FLIRT_LIBRARY_NAME_DFL, "FLIRT library name for sig format");
@@ -163,7 +163,7 @@ repeat:
 			rz_debug_trace_op(core->dbg, &op);
 			core->dbg->reg = reg;
 		} else if (RZ_STR_ISNOTEMPTY(e)) {
-			rz_analysis_esil_parse(esil, e);
+			rz_analysis_esil_parse_at(esil, addr, e);
 			if (core->analysis->cur && core->analysis->cur->esil_post_loop) {
 				core->analysis->cur->esil_post_loop(esil, &op);
 			}
@@ -202,7 +202,7 @@ repeat:
 				}
 				const char *e = RZ_STRBUF_SAFEGET(&op2.esil);
 				if (RZ_STR_ISNOTEMPTY(e)) {
-					rz_analysis_esil_parse(esil, e);
+					rz_analysis_esil_parse_at(esil, naddr, e);
 				}
 			} else {
 				RZ_LOG_ERROR("core: Invalid instruction at 0x%08" PFMT64x "\n", naddr);
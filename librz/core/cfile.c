@@ -105,19 +105,8 @@ static bool __rebase_flags(RzFlagItem *flag, void *user) {
 	return true;
 }
 
-static bool __rebase_xrefs_i(void *user, const ut64 k, const void *v) {
-	struct __rebase_struct *reb = (void *)user;
-	RzAnalysisXRef *xref = (RzAnalysisXRef *)v;
-	xref->from += reb->diff;
-	xref->to += reb->diff;
-	rz_analysis_xrefs_set(reb->core->analysis, xref->from, xref->to, xref->type);
-	return true;
-}
-
-static bool __rebase_xrefs(void *user, const ut64 k, const void *v) {
-	HtUP *ht = (HtUP *)v;
-	ht_up_foreach(ht, __rebase_xrefs_i, user);
-	return true;
+static bool __rebase_xrefs(const RzAnalysisXRef *xref, void *user) {
+	return rz_vector_push(user, (void *)xref);
 }
 
 static void __rebase_everything(RzCore *core, RzList /*<RzBinSection *>*/ *old_sections, ut64 old_base) {
@@ -168,14 +157,18 @@ static void __rebase_everything(RzCore *core, RzList /*<RzBinSection *>*/ *old_s
 	rz_meta_rebase(core->analysis, diff);
 
 	// XREFS
-	HtUP *xrefs_from = core->analysis->ht_xrefs_from;
-	HtUP *xrefs_to = core->analysis->ht_xrefs_to;
-	core->analysis->ht_xrefs_from = NULL;
-	core->analysis->ht_xrefs_to = NULL;
+	RzVector xrefs;
+	rz_vector_init(&xrefs, sizeof(RzAnalysisXRef), NULL, NULL);
+	rz_vector_reserve(&xrefs, rz_analysis_xrefs_count(core->analysis));
+	rz_analysis_xrefs_foreach(core->analysis, __rebase_xrefs, &xrefs);
+	RzAnalysisXRef *xref;
+	rz_vector_foreach(&xrefs, xref) {
+		xref->from += diff;
+		xref->to += diff;
+	}
 	rz_analysis_xrefs_init(core->analysis);
-	ht_up_foreach(xrefs_from, __rebase_xrefs, &reb);
-	ht_up_free(xrefs_from);
-	ht_up_free(xrefs_to);
+	rz_analysis_xrefs_set_bulk(core->analysis, xrefs.a, rz_vector_len(&xrefs));
+	rz_vector_fini(&xrefs);
 
 	// BREAKPOINTS
 	rz_debug_bp_rebase(core->dbg, old_base, new_base);
@@ -668,6 +661,7 @@ static bool core_file_do_load_for_debug(RzCore *r, ut64 baseaddr, const char *fi
 	opt.obj_opts.elf_checks_sections = rz_config_get_b(r->config, "elf.checks.sections");
 	opt.obj_opts.elf_checks_segments = rz_config_get_b(r->config, "elf.checks.segments");
 	opt.obj_opts.big_endian = rz_config_get_b(r->config, "cfg.bigendian");
+	opt.obj_opts.lazy = rz_config_get_b(r->config, "bin.lazy");
 	opt.xtr_idx = xtr_idx;
 	RzBinFile *binfile = rz_bin_open(r->bin, filenameuri, &opt);
 	if (!binfile) {
@@ -1274,6 +1268,9 @@ RZ_IPI void rz_core_file_io_desc_closed(RzCore *core, RzIODesc *desc) {
 	rz_list_foreach (core->files, it, cf) {
 		rz_pvector_remove_data(&cf->extra_files, desc);
 	}
+	if (core->hash_index && core->hash_index_fd == desc->fd) {
+		RZ_FREE_CUSTOM(core->hash_index, rz_hash_block_index_free);
+	}
 }
 
 RZ_IPI void rz_core_file_io_map_deleted(RzCore *core, RzIOMap *map) {
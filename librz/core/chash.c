@@ -53,3 +53,50 @@ RZ_API RzCmdStatus rz_core_hash_plugins_print(RzHash *hash, RzCmdStateOutput *st
 	rz_cmd_state_output_array_end(state);
 	return RZ_CMD_STATUS_OK;
 }
+
+static ut64 hash_block_index_read(void *user, ut64 offset, ut8 *buf, ut64 len) {
+	int read = rz_io_desc_read_at(user, offset, buf, (int)len);
+	return read > 0 ? read : 0;
+}
+
+/**
+ * \brief Returns the block index of the current file, with the digests of the written blocks computed again
+ *
+ * The index is kept in RzCore and created again when the file, \p algo or
+ * hash.blocksize change, so only the first call hashes the whole file.
+ *
+ * \param  core  The RzCore instance
+ * \param  algo  Name of the hash algorithm
+ * \return The block index without dirty blocks, or NULL on failure
+ */
+RZ_API RZ_BORROW RzHashBlockIndex *rz_core_hash_block_index(RZ_NONNULL RzCore *core, RZ_NONNULL const char *algo) {
+	rz_return_val_if_fail(core && algo, NULL);
+	RzIODesc *desc = core->io->desc;
+	if (!desc) {
+		RZ_LOG_ERROR("core: there is no opened file to hash\n");
+		return NULL;
+	}
+	ut64 block_size = rz_config_get_i(core->config, "hash.blocksize");
+	if (!block_size || block_size > ST32_MAX) {
+		RZ_LOG_ERROR("core: invalid hash.blocksize 0x%" PFMT64x "\n", block_size);
+		return NULL;
+	}
+	ut64 size = rz_io_desc_size(desc);
+	RzHashBlockIndex *index = core->hash_index;
+	if (index && (core->hash_index_fd != desc->fd || strcmp(index->plugin->name, algo) ||
+		index->size != size || index->block_size != block_size)) {
+		RZ_FREE_CUSTOM(core->hash_index, rz_hash_block_index_free);
+	}
+	if (!core->hash_index) {
+		core->hash_index = rz_hash_block_index_new(core->hash, algo, size, block_size);
+		if (!core->hash_index) {
+			return NULL;
+		}
+		core->hash_index_fd = desc->fd;
+	}
+	size_t n_threads = rz_config_get_i(core->config, "hash.threads");
+	if (rz_hash_block_index_update(core->hash_index, hash_block_index_read, desc, n_threads) == UT64_MAX) {
+		return NULL;
+	}
+	return core->hash_index;
+}
@@ -667,6 +667,7 @@ RZ_IPI bool rz_core_il_step(RzCore *core, ut64 n) {
 	if (!step_assert_vm(core)) {
 		return false;
 	}
+	core->analysis->il_vm->il_compile = rz_config_get_b(core->config, "rzil.compile");
 	RzAnalysisILStepResult r = rz_analysis_il_vm_step_while(core->analysis, core->analysis->il_vm, core->analysis->reg,
 		step_cond_n, &n);
 	return step_handle_result(core, r);
@@ -692,6 +693,7 @@ RZ_IPI bool rz_core_il_step_until(RzCore *core, ut64 until) {
 	if (!step_assert_vm(core)) {
 		return false;
 	}
+	core->analysis->il_vm->il_compile = rz_config_get_b(core->config, "rzil.compile");
 	RzAnalysisILStepResult r = rz_analysis_il_vm_step_while(core->analysis, core->analysis->il_vm, core->analysis->reg,
 		step_cond_until, &until);
 	return step_handle_result(core, r);
@@ -5031,14 +5031,22 @@ DEFINE_HANDLE_TS_FCN_AND_SYMBOL(iter_threads_stmt) {
 	return res;
 }
 
+/**
+ * Set up the grep of the console from \p specifier, which is left owned by the caller
+ */
+static bool grep_stmt_setup(const char *specifier) {
+	char *grep = strdup(specifier);
+	if (!grep) {
+		return false;
+	}
+	rz_cons_grep_process(grep);
+	return true;
+}
+
 DEFINE_HANDLE_TS_FCN_AND_SYMBOL(grep_stmt) {
 	TSNode command = ts_node_child_by_field_name(node, "command", strlen("command"));
 	TSNode arg = ts_node_child_by_field_name(node, "specifier", strlen("specifier"));
 	char *arg_str = ts_node_handle_arg(state, node, arg, 1);
-	bool is_pipe = state->core->is_pipe;
-	state->core->is_pipe = true;
-	RzCmdStatus res = handle_ts_stmt(state, command);
-	state->core->is_pipe = is_pipe;
 	RZ_LOG_DEBUG("grep_stmt specifier: '%s'\n", arg_str);
 	RzStrBuf *sb = rz_strbuf_new(arg_str);
 	rz_strbuf_prepend(sb, "~");
@@ -5046,7 +5054,27 @@ DEFINE_HANDLE_TS_FCN_AND_SYMBOL(grep_stmt) {
 	rz_strbuf_free(sb);
 	char *specifier_str = rz_cmd_unescape_arg(specifier_str_es, true);
 	RZ_LOG_DEBUG("grep_stmt processed specifier: '%s'\n", specifier_str);
-	rz_cons_grep_process(specifier_str);
+	RzCmdStatus res = RZ_CMD_STATUS_ERROR;
+	if (!specifier_str) {
+		goto err;
+	}
+	// only the top-level output is streamed, a captured one is filtered once complete
+	RzStack *cons_stack = state->core->cons->context->cons_stack;
+	bool stream = state->core->cons->stream && (!cons_stack || rz_stack_is_empty(cons_stack));
+	// set up the grep before the command runs, so its output can be filtered while streamed
+	if (stream && !grep_stmt_setup(specifier_str)) {
+		goto err;
+	}
+	bool is_pipe = state->core->is_pipe;
+	state->core->is_pipe = true;
+	res = handle_ts_stmt(state, command);
+	state->core->is_pipe = is_pipe;
+	// not set up yet, or reset by a flush inside the command
+	if ((!stream || !state->core->cons->context->grep.str) && !grep_stmt_setup(specifier_str)) {
+		res = RZ_CMD_STATUS_ERROR;
+	}
+err:
+	free(specifier_str);
 	free(specifier_str_es);
 	free(arg_str);
 	return res;
@@ -3419,6 +3419,33 @@ RZ_IPI RzCmdStatus rz_analysis_xrefs_graph_handler(RzCore *core, int argc, const
 	return RZ_CMD_STATUS_OK;
 }
 
+RZ_IPI RzCmdStatus rz_analysis_xrefs_stats_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
+	RzAnalysisXRefsStats stats;
+	rz_analysis_xrefs_stats(core->analysis, &stats);
+	switch (state->mode) {
+	case RZ_OUTPUT_MODE_STANDARD:
+		rz_cons_printf("count   %" PFMT64u "\n", stats.count);
+		rz_cons_printf("pending %" PFMT64u "\n", stats.pending);
+		rz_cons_printf("delta   %" PFMT64u "\n", stats.delta);
+		rz_cons_printf("deleted %" PFMT64u "\n", stats.deleted);
+		rz_cons_printf("memory  %" PFMT64u "\n", stats.bytes);
+		break;
+	case RZ_OUTPUT_MODE_JSON:
+		pj_o(state->d.pj);
+		pj_kn(state->d.pj, "count", stats.count);
+		pj_kn(state->d.pj, "pending", stats.pending);
+		pj_kn(state->d.pj, "delta", stats.delta);
+		pj_kn(state->d.pj, "deleted", stats.deleted);
+		pj_kn(state->d.pj, "memory", stats.bytes);
+		pj_end(state->d.pj);
+		break;
+	default:
+		rz_warn_if_reached();
+		return RZ_CMD_STATUS_WRONG_ARGS;
+	}
+	return RZ_CMD_STATUS_OK;
+}
+
 #define CMD_REGS_PREFIX   analysis
 #define CMD_REGS_REG_PATH analysis->reg
 #define CMD_REGS_SYNC     NULL
@@ -4551,6 +4578,45 @@ RZ_IPI RzCmdStatus rz_il_vm_status_handler(RzCore *core, int argc, const char **
 	return RZ_CMD_STATUS_OK;
 }
 
+RZ_IPI RzCmdStatus rz_il_vm_stats_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
+	RzAnalysisILVM *vm = core->analysis->il_vm;
+	if (!vm) {
+		RZ_LOG_ERROR("RzIL: Run 'aezi' first to initialize the VM\n");
+		return RZ_CMD_STATUS_ERROR;
+	}
+	RzILVMStats stats;
+	rz_il_vm_get_stats(vm->vm, &stats);
+	switch (state->mode) {
+	case RZ_OUTPUT_MODE_STANDARD:
+		rz_cons_printf("steps   %" PFMT64u "\n", stats.steps);
+		rz_cons_printf("lifts   %" PFMT64u " lifted, %" PFMT64u " cached\n", vm->il_cache_misses, vm->il_cache_hits);
+		rz_cons_printf("ops     %" PFMT64u " allocated, %" PFMT64u " reused\n", stats.op_allocs, stats.op_reuses);
+		rz_cons_printf("bitvs   %" PFMT64u " allocated, %" PFMT64u " reused\n", stats.bv_allocs, stats.bv_reuses);
+		rz_cons_printf("bools   %" PFMT64u " allocated, %" PFMT64u " reused\n", stats.bool_allocs, stats.bool_reuses);
+		rz_cons_printf("values  %" PFMT64u " allocated, %" PFMT64u " reused\n", stats.val_allocs, stats.val_reuses);
+		break;
+	case RZ_OUTPUT_MODE_JSON:
+		pj_o(state->d.pj);
+		pj_kn(state->d.pj, "steps", stats.steps);
+		pj_kn(state->d.pj, "lifts", vm->il_cache_misses);
+		pj_kn(state->d.pj, "lifts_cached", vm->il_cache_hits);
+		pj_kn(state->d.pj, "op_allocs", stats.op_allocs);
+		pj_kn(state->d.pj, "op_reuses", stats.op_reuses);
+		pj_kn(state->d.pj, "bv_allocs", stats.bv_allocs);
+		pj_kn(state->d.pj, "bv_reuses", stats.bv_reuses);
+		pj_kn(state->d.pj, "bool_allocs", stats.bool_allocs);
+		pj_kn(state->d.pj, "bool_reuses", stats.bool_reuses);
+		pj_kn(state->d.pj, "val_allocs", stats.val_allocs);
+		pj_kn(state->d.pj, "val_reuses", stats.val_reuses);
+		pj_end(state->d.pj);
+		break;
+	default:
+		rz_warn_if_reached();
+		break;
+	}
+	return RZ_CMD_STATUS_OK;
+}
+
 RZ_IPI char **rz_analysis_graph_format_choices(RzCore *core) {
 	static const char *formats[] = {
 		"ascii", "cmd", "dot", "gml", "json", "json_disasm", "sdb", "tiny", "interactive", NULL
@@ -5637,6 +5703,16 @@ RZ_IPI RzCmdStatus rz_list_mne_handler(RzCore *core, int argc, const char **argv
 	return RZ_CMD_STATUS_OK;
 }
 
+RZ_IPI RzCmdStatus rz_analyze_decode_cache_stats_handler(RzCore *core, int argc, const char **argv) {
+	ut64 hits, lookups;
+	if (!rz_analysis_decode_cache_stats(core->analysis, &hits, &lookups)) {
+		RZ_LOG_ERROR("core: the analysis plugin has no decode cache.\n");
+		return RZ_CMD_STATUS_ERROR;
+	}
+	rz_cons_printf("hits %" PFMT64u "\nlookups %" PFMT64u "\n", hits, lookups);
+	return RZ_CMD_STATUS_OK;
+}
+
 RZ_IPI RzCmdStatus rz_list_plugins_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
 	return rz_core_asm_plugins_print(core, NULL, state);
 }
@@ -5955,7 +6031,8 @@ RZ_IPI RzCmdStatus rz_analyze_all_function_calls_to_imports_handler(RzCore *core
 RZ_IPI RzCmdStatus rz_analyze_all_data_references_to_code_handler(RzCore *core, int argc, const char **argv) {
 	RzListIter *iter;
 	RzAnalysisXRef *xref;
-	RzList *list = rz_analysis_xrefs_get_from(core->analysis, UT64_MAX);
+	// the analysis adds new xrefs, thus the list is a copy instead of a foreach
+	RzList *list = rz_analysis_xrefs_list(core->analysis);
 	rz_list_foreach (list, iter, xref) {
 		if (xref->type == RZ_ANALYSIS_XREF_TYPE_DATA && rz_io_is_valid_offset(core->io, xref->to, false)) {
 			rz_core_analysis_fcn(core, xref->from, xref->to, RZ_ANALYSIS_XREF_TYPE_NULL, 1);
@@ -1767,7 +1767,11 @@ RZ_IPI RzCmdStatus rz_cmd_debug_load_trace_session_handler(RzCore *core, int arg
 		core->dbg->session = NULL;
 	}
 	core->dbg->session = rz_debug_session_new();
-	rz_debug_session_load(core->dbg, argv[1]);
+	if (!rz_debug_session_load(core->dbg, argv[1])) {
+		rz_debug_session_free(core->dbg->session);
+		core->dbg->session = NULL;
+		return RZ_CMD_STATUS_ERROR;
+	}
 	return RZ_CMD_STATUS_OK;
 }
 
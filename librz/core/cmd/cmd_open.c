@@ -848,6 +848,45 @@ RZ_IPI RzCmdStatus rz_open_exchange_handler(RzCore *core, int argc, const char *
 	return RZ_CMD_STATUS_OK;
 }
 
+RZ_IPI RzCmdStatus rz_open_page_cache_stats_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
+	RzIOPageCacheStats stats;
+	if (!rz_io_page_cache_stats(core->io, &stats)) {
+		RZ_LOG_ERROR("The io page cache is disabled, see io.pagecache.\n");
+		return RZ_CMD_STATUS_ERROR;
+	}
+	ut64 reads = stats.hits + stats.misses;
+	switch (state->mode) {
+	case RZ_OUTPUT_MODE_STANDARD:
+		rz_cons_printf("pagesize  0x%" PFMT32x "\n", stats.page_size);
+		rz_cons_printf("pages     %" PFMT32u "/%" PFMT32u "\n", stats.used, stats.n_pages);
+		rz_cons_printf("hits      %" PFMT64u "\n", stats.hits);
+		rz_cons_printf("misses    %" PFMT64u "\n", stats.misses);
+		rz_cons_printf("evictions %" PFMT64u "\n", stats.evictions);
+		rz_cons_printf("hitratio  %.2f%%\n", reads ? stats.hits * 100.0 / reads : 0.0);
+		break;
+	case RZ_OUTPUT_MODE_JSON:
+		pj_o(state->d.pj);
+		pj_kn(state->d.pj, "pagesize", stats.page_size);
+		pj_kn(state->d.pj, "pages", stats.n_pages);
+		pj_kn(state->d.pj, "used", stats.used);
+		pj_kn(state->d.pj, "hits", stats.hits);
+		pj_kn(state->d.pj, "misses", stats.misses);
+		pj_kn(state->d.pj, "evictions", stats.evictions);
+		pj_end(state->d.pj);
+		break;
+	default:
+		rz_warn_if_reached();
+		break;
+	}
+	return RZ_CMD_STATUS_OK;
+}
+
+RZ_IPI RzCmdStatus rz_open_page_cache_reset_handler(RzCore *core, int argc, const char **argv) {
+	rz_io_page_cache_invalidate(core->io, -1);
+	rz_io_page_cache_stats_reset(core->io);
+	return RZ_CMD_STATUS_OK;
+}
+
 static RzCmdStatus open_core_file(RzCore *core, const char *filename) {
 	if (core->tasks.current_task != core->tasks.main_task) {
 		RZ_LOG_ERROR("This command can only be executed on the main task!\n");
@@ -2331,6 +2331,15 @@ RZ_IPI RzCmdStatus rz_cmd_print_hash_cfg_handler(RzCore *core, int argc, const c
 	return RZ_CMD_STATUS_OK;
 }
 
+RZ_IPI RzCmdStatus rz_cmd_print_hash_tree_handler(RzCore *core, int argc, const char **argv) {
+	RzHashBlockIndex *index = rz_core_hash_block_index(core, argv[1]);
+	if (!index) {
+		return RZ_CMD_STATUS_ERROR;
+	}
+	hexprint(rz_hash_block_index_root(index), index->digest_size);
+	return RZ_CMD_STATUS_OK;
+}
+
 RZ_IPI RzCmdStatus rz_cmd_print_hash_cfg_algo_list_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
 	return rz_core_hash_plugins_print(core->hash, state);
 }
@@ -3,7 +3,7 @@
 
 #include <rz_project.h>
 
-RZ_IPI RzCmdStatus rz_project_save_handler(RzCore *core, int argc, const char **argv) {
+static RzCmdStatus project_save(RzCore *core, int argc, const char **argv, bool full) {
 	const char *file;
 	if (argc == 1) {
 		file = rz_config_get(core->config, "prj.file");
@@ -16,13 +16,21 @@ RZ_IPI RzCmdStatus rz_project_save_handler(RzCore *core, int argc, const char **
 		file = argv[1];
 	}
 	bool compress = rz_config_get_b(core->config, "prj.compress");
-	RzProjectErr err = rz_project_save_file(core, file, compress);
+	RzProjectErr err = full ? rz_project_save_file_full(core, file, compress) : rz_project_save_file(core, file, compress);
 	if (err != RZ_PROJECT_ERR_SUCCESS) {
 		RZ_LOG_ERROR("core: Failed to save project to file %s: %s\n", file, rz_project_err_message(err));
 	}
 	return RZ_CMD_STATUS_OK;
 }
 
+RZ_IPI RzCmdStatus rz_project_save_handler(RzCore *core, int argc, const char **argv) {
+	return project_save(core, argc, argv, false);
+}
+
+RZ_IPI RzCmdStatus rz_project_save_compact_handler(RzCore *core, int argc, const char **argv) {
+	return project_save(core, argc, argv, true);
+}
+
 RZ_IPI RzCmdStatus rz_project_open_handler(RzCore *core, int argc, const char **argv) {
 	return rz_core_project_load_for_cli(core, argv[1], true) ? RZ_CMD_STATUS_OK : RZ_CMD_STATUS_ERROR;
 }
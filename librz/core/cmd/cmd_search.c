@@ -2301,6 +2301,255 @@ static void do_asm_search(RzCore *core, struct search_parameters *param, const c
 	rz_cons_break_pop();
 }
 
+#define SEARCH_CHUNK_SIZE        0x100000
+#define SEARCH_CHUNKS_PER_THREAD 4
+
+typedef struct search_chunk_hit_t {
+	ut64 addr;
+	ut32 kw; ///< index of the keyword in RzSearch.kws
+} SearchChunkHit;
+
+typedef struct search_chunk_t {
+	ut64 from;
+	ut64 to; ///< end of the chunk, the reported hits start before it
+	RzVector /*<SearchChunkHit>*/ hits;
+} SearchChunk;
+
+typedef struct search_worker_t {
+	RzSearch *search; ///< copy of the keywords, reporting every match
+	RzIOSnapshot *snapshot;
+	RzThreadQueue *chunks;
+	SearchChunk *chunk; ///< chunk being searched
+	ut8 *buf; ///< bytes of the chunk being searched
+	ut64 buf_size;
+	ut64 block_size;
+	ut64 overlap; ///< bytes read after the end of each chunk
+	ut64 end; ///< end of the searched interval
+	bool failed;
+} SearchWorker;
+
+static int search_worker_hit(RzSearchKeyword *kw, void *user, ut64 addr) {
+	SearchWorker *worker = user;
+	SearchChunkHit hit = { .addr = addr, .kw = kw->kwidx };
+	return rz_vector_push(&worker->chunk->hits, &hit) ? 1 : 0;
+}
+
+static int search_chunk_hit_cmp(const void *a, const void *b) {
+	const SearchChunkHit *ha = a, *hb = b;
+	if (ha->addr != hb->addr) {
+		return ha->addr < hb->addr ? -1 : 1;
+	}
+	return ha->kw < hb->kw ? -1 : ha->kw > hb->kw ? 1
+						      : 0;
+}
+
+/**
+ * \brief Returns a RzSearch with a copy of the keywords of \p search which reports every match.
+ *
+ * The matches are then filtered by search_itv_parallel(), like the
+ * sequential search would do, when applied to the keywords of \p search.
+ */
+static RzSearch *search_worker_search_new(RzSearch *search, SearchWorker *worker) {
+	RzSearch *s = rz_search_new(search->mode);
+	if (!s) {
+		return NULL;
+	}
+	s->overlap = true;
+	s->contiguous = true;
+	s->distance = search->distance;
+	s->string_min = search->string_min;
+	s->string_max = search->string_max;
+	RzListIter *it;
+	RzSearchKeyword *kw;
+	rz_list_foreach (search->kws, it, kw) {
+		RzSearchKeyword *copy = search->mode == RZ_SEARCH_REGEXP
+			// the regexp is a NUL-terminated string
+			? rz_search_keyword_new(kw->bin_keyword, strlen((const char *)kw->bin_keyword) + 1, NULL, 0, NULL)
+			: rz_search_keyword_new(kw->bin_keyword, kw->keyword_length, kw->bin_binmask, kw->binmask_length, NULL);
+		if (!copy) {
+			rz_search_free(s);
+			return NULL;
+		}
+		copy->icase = kw->icase;
+		copy->type = kw->type;
+		rz_search_kw_add(s, copy);
+	}
+	rz_search_set_callback(s, search_worker_hit, worker);
+	return s;
+}
+
+static void search_worker_run(SearchWorker *worker) {
+	SearchChunk *chunk = NULL;
+	while ((chunk = rz_th_queue_pop(worker->chunks, false))) {
+		ut64 end = worker->end - chunk->to > worker->overlap ? chunk->to + worker->overlap : worker->end;
+		ut64 size = end - chunk->from;
+		if (size > worker->buf_size) {
+			ut8 *tmp = realloc(worker->buf, size);
+			if (!tmp) {
+				worker->failed = true;
+				continue;
+			}
+			worker->buf = tmp;
+			worker->buf_size = size;
+		}
+		ut8 *buf = worker->buf;
+		(void)rz_io_snapshot_read_at(worker->snapshot, chunk->from, buf, size);
+		worker->chunk = chunk;
+		rz_search_begin(worker->search);
+		// the blocks are the same of the sequential search, so the regexps match the same bytes
+		for (ut64 at = 0; at < size; at += worker->block_size) {
+			ut64 len = RZ_MIN(worker->block_size, size - at);
+			if (rz_search_update(worker->search, chunk->from + at, buf + at, len) < 0) {
+				worker->failed = true;
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * \brief Reports the matches found by the workers in \p chunk through rz_search_hit_new().
+ *
+ * \return -1 on error, 1 when the search must stop and 0 otherwise
+ */
+static int search_chunk_report(RzSearch *search, RzSearchKeyword **kws, ut64 *next, SearchChunk *chunk) {
+	if (rz_vector_empty(&chunk->hits)) {
+		return 0;
+	}
+	rz_vector_sort(&chunk->hits, search_chunk_hit_cmp, false);
+	const SearchChunkHit *hit, *prev = NULL;
+	rz_vector_foreach(&chunk->hits, hit) {
+		if (hit->addr >= chunk->to) {
+			break;
+		} else if (prev && !search_chunk_hit_cmp(prev, hit)) {
+			continue;
+		}
+		prev = hit;
+		RzSearchKeyword *kw = kws[hit->kw];
+		if (search->mode != RZ_SEARCH_REGEXP && !search->overlap && hit->addr < next[hit->kw]) {
+			// overlaps the previous hit of the keyword
+			continue;
+		}
+		int t = rz_search_hit_new(search, kw, hit->addr);
+		if (!t) {
+			return -1;
+		} else if (t > 1) {
+			return 1;
+		}
+		next[hit->kw] = hit->addr + kw->keyword_length;
+	}
+	return 0;
+}
+
+/**
+ * \brief Searches the keywords in \p itv by fanning out its chunks to a thread pool.
+ *
+ * Each worker thread reads the chunks via \p snapshot and looks for every match of
+ * its own copy of the keywords, also in the bytes following the end of the chunk
+ * (up to the longest keyword); then the matches are sorted and reported in address
+ * order on the calling thread, skipping the overlapping ones unless search.overlap is set.
+ * The same threads search all the batches of chunks of the interval.
+ *
+ * \return -1 on error, 1 when the search must stop and 0 otherwise
+ */
+static int search_itv_parallel(RzCore *core, RzIOSnapshot *snapshot, RzInterval itv, size_t n_threads, struct search_parameters *param) {
+	RzSearch *search = core->search;
+	const size_t n_kws = rz_list_length(search->kws);
+	const size_t n_chunks = n_threads * SEARCH_CHUNKS_PER_THREAD;
+	const ut64 chunk_size = (ut64)core->blocksize * RZ_MAX(1, SEARCH_CHUNK_SIZE / core->blocksize);
+	SearchWorker *workers = RZ_NEWS0(SearchWorker, n_threads);
+	SearchChunk *chunks = RZ_NEWS0(SearchChunk, n_chunks);
+	RzSearchKeyword **kws = RZ_NEWS0(RzSearchKeyword *, n_kws);
+	ut64 *next = RZ_NEWS0(ut64, n_kws);
+	RzThreadQueue *queue = rz_th_queue_new(RZ_THREAD_QUEUE_UNLIMITED, NULL);
+	RzCoreWorkers *threads = NULL;
+	int ret = -1;
+	if (!workers || !chunks || !kws || !next || !queue) {
+		RZ_LOG_ERROR("core: cannot allocate the search workers\n");
+		goto end;
+	}
+
+	ut64 longest = 0;
+	size_t idx = 0;
+	RzListIter *it;
+	RzSearchKeyword *kw;
+	rz_list_foreach (search->kws, it, kw) {
+		longest = RZ_MAX(longest, kw->keyword_length);
+		kws[idx++] = kw;
+	}
+	for (size_t i = 0; i < n_threads; i++) {
+		workers[i].snapshot = snapshot;
+		workers[i].block_size = core->blocksize;
+		// regexps and strings match only inside a block, like in the sequential search
+		workers[i].overlap = search->mode == RZ_SEARCH_REGEXP || search->mode == RZ_SEARCH_STRING || !longest ? 0 : longest - 1;
+		workers[i].end = rz_itv_end(itv);
+		workers[i].chunks = queue;
+		workers[i].search = search_worker_search_new(search, &workers[i]);
+		if (!workers[i].search) {
+			goto end;
+		}
+	}
+	for (size_t i = 0; i < n_chunks; i++) {
+		rz_vector_init(&chunks[i].hits, sizeof(SearchChunkHit), NULL, NULL);
+	}
+	threads = rz_core_workers_new(n_threads, (RzCoreWorkerRun)search_worker_run, workers, sizeof(SearchWorker));
+	if (!threads) {
+		RZ_LOG_ERROR("core: cannot allocate the search thread pool\n");
+		goto end;
+	}
+
+	ret = 0;
+	ut64 at = rz_itv_begin(itv);
+	const ut64 to = rz_itv_end(itv);
+	while (!ret && at < to) {
+		print_search_progress(at, to, search->nhits, param);
+		if (rz_cons_is_breaked()) {
+			ret = 1;
+			break;
+		}
+		size_t used = 0;
+		for (; used < n_chunks && at < to; used++) {
+			SearchChunk *chunk = &chunks[used];
+			chunk->from = at;
+			chunk->to = to - at > chunk_size ? at + chunk_size : to;
+			rz_vector_clear(&chunk->hits);
+			rz_th_queue_push(queue, chunk, true);
+			at = chunk->to;
+		}
+		rz_core_workers_run(threads);
+
+		for (size_t i = 0; i < n_threads; i++) {
+			if (workers[i].failed) {
+				ret = -1;
+			}
+		}
+		for (size_t i = 0; !ret && i < used; i++) {
+			ret = search_chunk_report(search, kws, next, &chunks[i]);
+		}
+	}
+	print_search_progress(at, to, search->nhits, param);
+
+end:
+	rz_core_workers_free(threads);
+	rz_th_queue_free(queue);
+	if (workers) {
+		for (size_t i = 0; i < n_threads; i++) {
+			rz_search_free(workers[i].search);
+			free(workers[i].buf);
+		}
+		free(workers);
+	}
+	if (chunks) {
+		for (size_t i = 0; i < n_chunks; i++) {
+			rz_vector_fini(&chunks[i].hits);
+		}
+		free(chunks);
+	}
+	free(kws);
+	free(next);
+	return ret;
+}
+
 static void do_string_search(RzCore *core, RzInterval search_itv, struct search_parameters *param) {
 	ut64 at;
 	ut8 *buf;
@@ -2333,6 +2582,14 @@ static void do_string_search(RzCore *core, RzInterval search_itv, struct search_
 			rz_search_string_prepare_backward(search);
 		}
 		rz_cons_break_push(NULL, NULL);
+		// the keywords are searched with multiple threads only when the hits
+		// can be reported in address order, like in the sequential search
+		size_t n_threads = rz_th_request_physical_cores(rz_config_get_i(core->config, "search.threads"));
+		const bool parallel = n_threads > 1 && !search->bckwrds && !search->inverse &&
+			!param->aes_search && !param->privkey_search &&
+			(search->mode == RZ_SEARCH_KEYWORD || search->mode == RZ_SEARCH_MULTI ||
+				search->mode == RZ_SEARCH_REGEXP || search->mode == RZ_SEARCH_STRING);
+		RzIOSnapshot *snapshot = parallel ? rz_io_snapshot_new(core->io) : NULL;
 		// TODO search cross boundary
 		rz_list_foreach (param->boundaries, iter, map) {
 			if (!rz_itv_overlap(search_itv, map->itv)) {
@@ -2362,7 +2619,15 @@ static void do_string_search(RzCore *core, RzInterval search_itv, struct search_
 				   from1 = search->bckwrds ? to : from,
 				   to1 = search->bckwrds ? from : to;
 			ut64 len;
-			for (at = from1; at != to1; at = search->bckwrds ? at - len : at + len) {
+			bool searched = false;
+			if (snapshot && rz_itv_size(itv) > core->blocksize) {
+				if (search_itv_parallel(core, snapshot, itv, n_threads, param) < 0 ||
+					(search->maxhits && search->nhits >= search->maxhits)) {
+					goto done;
+				}
+				searched = true;
+			}
+			for (at = searched ? to1 : from1; at != to1; at = search->bckwrds ? at - len : at + len) {
 				print_search_progress(at, to1, search->nhits, param);
 				if (rz_cons_is_breaked()) {
 					eprintf("\n\n");
@@ -2407,6 +2672,7 @@ static void do_string_search(RzCore *core, RzInterval search_itv, struct search_
 		}
 	done:
 		rz_cons_break_pop();
+		rz_io_snapshot_free(snapshot);
 		free(buf);
 	} else {
 		RZ_LOG_ERROR("core: No keywords defined\n");
@@ -567,6 +567,10 @@ RZ_IPI RzCmdStatus rz_write_cache_remove_handler(RzCore *core, int argc, const c
 	ut64 from = argc > 1 ? rz_num_math(core->num, argv[1]) : core->offset;
 	ut64 to = argc > 2 ? rz_num_math(core->num, argv[2]) : from + core->blocksize;
 	int ninvalid = rz_io_cache_invalidate(core->io, from, to);
+	if (ninvalid < 0) {
+		RZ_LOG_ERROR("core: cannot invalidate the cache\n");
+		return RZ_CMD_STATUS_ERROR;
+	}
 	RZ_LOG_INFO("Invalidated %d cache(s)\n", ninvalid);
 	rz_core_block_read(core);
 	return RZ_CMD_STATUS_OK;
@@ -580,13 +584,39 @@ RZ_IPI RzCmdStatus rz_write_cache_remove_all_handler(RzCore *core, int argc, con
 RZ_IPI RzCmdStatus rz_write_cache_commit_handler(RzCore *core, int argc, const char **argv) {
 	ut64 from = argc > 1 ? rz_num_math(core->num, argv[1]) : core->offset;
 	ut64 to = argc > 2 ? rz_num_math(core->num, argv[2]) : from + core->blocksize;
-	rz_io_cache_commit(core->io, from, to);
-	return RZ_CMD_STATUS_OK;
+	return bool2status(rz_io_cache_commit(core->io, from, to));
 }
 
 RZ_IPI RzCmdStatus rz_write_cache_commit_all_handler(RzCore *core, int argc, const char **argv) {
-	rz_io_cache_commit(core->io, 0, UT64_MAX);
+	bool ret = rz_io_cache_commit(core->io, 0, UT64_MAX);
 	rz_core_block_read(core);
+	return bool2status(ret);
+}
+
+RZ_IPI RzCmdStatus rz_write_cache_memory_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
+	RzIOCacheStats stats;
+	rz_io_cache_stats(core->io, &stats);
+	switch (state->mode) {
+	case RZ_OUTPUT_MODE_STANDARD:
+		rz_cons_printf("writes  %" PFMT64u "\n", stats.writes);
+		rz_cons_printf("bytes   %" PFMT64u "\n", stats.bytes);
+		rz_cons_printf("written %" PFMT64u "\n", stats.written);
+		rz_cons_printf("memory  %" PFMT64u "\n", stats.memory);
+		rz_cons_printf("saved   %" PFMT64u "\n", stats.saved);
+		break;
+	case RZ_OUTPUT_MODE_JSON:
+		pj_o(state->d.pj);
+		pj_kn(state->d.pj, "writes", stats.writes);
+		pj_kn(state->d.pj, "bytes", stats.bytes);
+		pj_kn(state->d.pj, "written", stats.written);
+		pj_kn(state->d.pj, "memory", stats.memory);
+		pj_kn(state->d.pj, "saved", stats.saved);
+		pj_end(state->d.pj);
+		break;
+	default:
+		rz_warn_if_reached();
+		break;
+	}
 	return RZ_CMD_STATUS_OK;
 }
 
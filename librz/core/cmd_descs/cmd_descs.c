@@ -521,6 +521,7 @@ static const RzCmdDescArg cmd_disassemble_summarize_n_bytes_args[2];
 static const RzCmdDescArg cmd_print_gadget_add_args[6];
 static const RzCmdDescArg cmd_print_gadget_move_args[6];
 static const RzCmdDescArg cmd_print_hash_cfg_args[2];
+static const RzCmdDescArg cmd_print_hash_tree_args[2];
 static const RzCmdDescArg print_instr_args[2];
 static const RzCmdDescArg print_instr_opcodes_args[2];
 static const RzCmdDescArg print_instr_esil_args[2];
@@ -592,6 +593,7 @@ static const RzCmdDescArg print_minus_args[2];
 static const RzCmdDescArg print_minus_entropy_args[2];
 static const RzCmdDescArg print_minus_table_args[2];
 static const RzCmdDescArg project_save_args[2];
+static const RzCmdDescArg project_save_compact_args[2];
 static const RzCmdDescArg project_open_args[2];
 static const RzCmdDescArg project_open_no_bin_io_args[2];
 static const RzCmdDescArg resize_args[2];
@@ -3109,6 +3111,14 @@ static const RzCmdDescHelp il_vm_status_help = {
 	.args = il_vm_status_args,
 };
 
+static const RzCmdDescArg il_vm_stats_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp il_vm_stats_help = {
+	.summary = "Show the allocation and lifting counters of the RzIL Virtual Machine",
+	.args = il_vm_stats_args,
+};
+
 static const RzCmdDescDetailEntry ag_Formats_detail_entries[] = {
 	{ .text = "ascii", .arg_str = NULL, .comment = "Ascii art" },
 	{ .text = "cmd", .arg_str = NULL, .comment = "rizin commands" },
@@ -4147,6 +4157,14 @@ static const RzCmdDescHelp analysis_xrefs_graph_help = {
 	.args = analysis_xrefs_graph_args,
 };
 
+static const RzCmdDescArg analysis_xrefs_stats_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp analysis_xrefs_stats_help = {
+	.summary = "Show the number of xrefs and the memory used to store them",
+	.args = analysis_xrefs_stats_args,
+};
+
 static const RzCmdDescHelp ah_help = {
 	.summary = "Analysis hints",
 };
@@ -5156,6 +5174,14 @@ static const RzCmdDescHelp list_mne_help = {
 	.args = list_mne_args,
 };
 
+static const RzCmdDescArg analyze_decode_cache_stats_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp analyze_decode_cache_stats_help = {
+	.summary = "Print the hits and lookups of the decode cache of the analysis plugin",
+	.args = analyze_decode_cache_stats_args,
+};
+
 static const RzCmdDescArg analyse_name_args[] = {
 	{
 		.name = "name",
@@ -11509,6 +11535,25 @@ static const RzCmdDescHelp open_exchange_help = {
 	.args = open_exchange_args,
 };
 
+static const RzCmdDescHelp oP_help = {
+	.summary = "IO page cache commands (see io.pagecache)",
+};
+static const RzCmdDescArg open_page_cache_stats_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp open_page_cache_stats_help = {
+	.summary = "Show the hit/miss/eviction counters of the io page cache",
+	.args = open_page_cache_stats_args,
+};
+
+static const RzCmdDescArg open_page_cache_reset_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp open_page_cache_reset_help = {
+	.summary = "Drop all the cached pages and reset the counters of the io page cache",
+	.args = open_page_cache_reset_args,
+};
+
 static const RzCmdDescHelp cmd_print_help = {
 	.summary = "Print commands",
 };
@@ -12183,6 +12228,20 @@ static const RzCmdDescHelp cmd_print_hash_cfg_help = {
 	.args = cmd_print_hash_cfg_args,
 };
 
+static const RzCmdDescArg cmd_print_hash_tree_args[] = {
+	{
+		.name = "algo",
+		.type = RZ_CMD_ARG_TYPE_STRING,
+		.flags = RZ_CMD_ARG_FLAG_LAST,
+
+	},
+	{ 0 },
+};
+static const RzCmdDescHelp cmd_print_hash_tree_help = {
+	.summary = "Prints the tree digest of the opened file, hashing again only the written blocks (see hash.blocksize)",
+	.args = cmd_print_hash_tree_args,
+};
+
 static const RzCmdDescArg cmd_print_hash_cfg_algo_list_args[] = {
 	{ 0 },
 };
@@ -13428,6 +13487,20 @@ static const RzCmdDescHelp project_save_help = {
 	.args = project_save_args,
 };
 
+static const RzCmdDescArg project_save_compact_args[] = {
+	{
+		.name = "project.rzdb",
+		.type = RZ_CMD_ARG_TYPE_FILE,
+		.optional = true,
+
+	},
+	{ 0 },
+};
+static const RzCmdDescHelp project_save_compact_help = {
+	.summary = "Save the whole project, compacting the changes appended with prj.incremental",
+	.args = project_save_compact_args,
+};
+
 static const RzCmdDescArg project_open_args[] = {
 	{
 		.name = "project.rzdb",
@@ -15041,6 +15114,14 @@ static const RzCmdDescHelp write_cache_commit_all_help = {
 	.args = write_cache_commit_all_args,
 };
 
+static const RzCmdDescArg write_cache_memory_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp write_cache_memory_help = {
+	.summary = "Show the size and the memory usage of the cache",
+	.args = write_cache_memory_args,
+};
+
 static const RzCmdDescArg write_pcache_list_args[] = {
 	{
 		.name = "fd",
@@ -16892,6 +16973,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *il_vm_status_cd = rz_cmd_desc_argv_modes_new(core->rcmd, aez_cd, "aezv", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_TABLE | RZ_OUTPUT_MODE_JSON | RZ_OUTPUT_MODE_QUIET, rz_il_vm_status_handler, &il_vm_status_help);
 	rz_warn_if_fail(il_vm_status_cd);
 
+	RzCmdDesc *il_vm_stats_cd = rz_cmd_desc_argv_state_new(core->rcmd, aez_cd, "aezvs", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON, rz_il_vm_stats_handler, &il_vm_stats_help);
+	rz_warn_if_fail(il_vm_stats_cd);
+
 	RzCmdDesc *ag_cd = rz_cmd_desc_group_new(core->rcmd, cmd_analysis_cd, "ag", NULL, NULL, &ag_help);
 	rz_warn_if_fail(ag_cd);
 	RzCmdDesc *analysis_graph_dataref_cd = rz_cmd_desc_argv_new(core->rcmd, ag_cd, "aga", rz_analysis_graph_dataref_handler, &analysis_graph_dataref_help);
@@ -17096,6 +17180,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *analysis_xrefs_graph_cd = rz_cmd_desc_argv_state_new(core->rcmd, ax_cd, "axg", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON | RZ_OUTPUT_MODE_RIZIN, rz_analysis_xrefs_graph_handler, &analysis_xrefs_graph_help);
 	rz_warn_if_fail(analysis_xrefs_graph_cd);
 
+	RzCmdDesc *analysis_xrefs_stats_cd = rz_cmd_desc_argv_state_new(core->rcmd, ax_cd, "axi", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON, rz_analysis_xrefs_stats_handler, &analysis_xrefs_stats_help);
+	rz_warn_if_fail(analysis_xrefs_stats_cd);
+
 	RzCmdDesc *ah_cd = rz_cmd_desc_group_new(core->rcmd, cmd_analysis_cd, "ah", NULL, NULL, &ah_help);
 	rz_warn_if_fail(ah_cd);
 	RzCmdDesc *analysis_hint_list_cd = rz_cmd_desc_argv_state_new(core->rcmd, ah_cd, "ahl", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON | RZ_OUTPUT_MODE_RIZIN, rz_analysis_hint_list_handler, &analysis_hint_list_help);
@@ -17290,6 +17377,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *list_mne_cd = rz_cmd_desc_argv_new(core->rcmd, ao_cd, "aoma", rz_list_mne_handler, &list_mne_help);
 	rz_warn_if_fail(list_mne_cd);
 
+	RzCmdDesc *analyze_decode_cache_stats_cd = rz_cmd_desc_argv_new(core->rcmd, ao_cd, "aoC", rz_analyze_decode_cache_stats_handler, &analyze_decode_cache_stats_help);
+	rz_warn_if_fail(analyze_decode_cache_stats_cd);
+
 	RzCmdDesc *analyse_name_cd = rz_cmd_desc_argv_state_new(core->rcmd, cmd_analysis_cd, "an", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON, rz_analyse_name_handler, &analyse_name_help);
 	rz_warn_if_fail(analyse_name_cd);
 
@@ -18756,6 +18846,11 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *open_exchange_cd = rz_cmd_desc_argv_new(core->rcmd, o_cd, "ox", rz_open_exchange_handler, &open_exchange_help);
 	rz_warn_if_fail(open_exchange_cd);
 
+	RzCmdDesc *oP_cd = rz_cmd_desc_group_state_new(core->rcmd, o_cd, "oP", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON, rz_open_page_cache_stats_handler, &open_page_cache_stats_help, &oP_help);
+	rz_warn_if_fail(oP_cd);
+	RzCmdDesc *open_page_cache_reset_cd = rz_cmd_desc_argv_new(core->rcmd, oP_cd, "oP-", rz_open_page_cache_reset_handler, &open_page_cache_reset_help);
+	rz_warn_if_fail(open_page_cache_reset_cd);
+
 	RzCmdDesc *cmd_print_cd = rz_cmd_desc_oldinput_new(core->rcmd, root_cd, "p", rz_cmd_print, &cmd_print_help);
 	rz_warn_if_fail(cmd_print_cd);
 	RzCmdDesc *print_bitstream_cd = rz_cmd_desc_argv_modes_new(core->rcmd, cmd_print_cd, "pb", RZ_OUTPUT_MODE_STANDARD, rz_print_bitstream_handler, &print_bitstream_help);
@@ -18914,6 +19009,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 
 	RzCmdDesc *cmd_print_default_cd = rz_cmd_desc_group_new(core->rcmd, cmd_print_cd, "ph", rz_cmd_print_hash_cfg_handler, &cmd_print_hash_cfg_help, &cmd_print_default_help);
 	rz_warn_if_fail(cmd_print_default_cd);
+	RzCmdDesc *cmd_print_hash_tree_cd = rz_cmd_desc_argv_new(core->rcmd, cmd_print_default_cd, "phm", rz_cmd_print_hash_tree_handler, &cmd_print_hash_tree_help);
+	rz_warn_if_fail(cmd_print_hash_tree_cd);
+
 	RzCmdDesc *cmd_print_hash_cfg_algo_list_cd = rz_cmd_desc_argv_state_new(core->rcmd, cmd_print_default_cd, "phl", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_RIZIN | RZ_OUTPUT_MODE_JSON | RZ_OUTPUT_MODE_QUIET, rz_cmd_print_hash_cfg_algo_list_handler, &cmd_print_hash_cfg_algo_list_help);
 	rz_warn_if_fail(cmd_print_hash_cfg_algo_list_cd);
 
@@ -19187,6 +19285,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *project_save_cd = rz_cmd_desc_argv_new(core->rcmd, P_cd, "Ps", rz_project_save_handler, &project_save_help);
 	rz_warn_if_fail(project_save_cd);
 
+	RzCmdDesc *project_save_compact_cd = rz_cmd_desc_argv_new(core->rcmd, P_cd, "Psc", rz_project_save_compact_handler, &project_save_compact_help);
+	rz_warn_if_fail(project_save_compact_cd);
+
 	RzCmdDesc *project_open_cd = rz_cmd_desc_argv_new(core->rcmd, P_cd, "Po", rz_project_open_handler, &project_open_help);
 	rz_warn_if_fail(project_open_cd);
 
@@ -19513,6 +19614,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *write_cache_commit_all_cd = rz_cmd_desc_argv_new(core->rcmd, wc_cd, "wci", rz_write_cache_commit_all_handler, &write_cache_commit_all_help);
 	rz_warn_if_fail(write_cache_commit_all_cd);
 
+	RzCmdDesc *write_cache_memory_cd = rz_cmd_desc_argv_state_new(core->rcmd, wc_cd, "wcm", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON, rz_write_cache_memory_handler, &write_cache_memory_help);
+	rz_warn_if_fail(write_cache_memory_cd);
+
 	RzCmdDesc *write_pcache_list_cd = rz_cmd_desc_argv_state_new(core->rcmd, wc_cd, "wcp", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_RIZIN, rz_write_pcache_list_handler, &write_pcache_list_help);
 	rz_warn_if_fail(write_pcache_list_cd);
 
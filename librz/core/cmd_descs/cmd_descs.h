@@ -361,6 +361,8 @@ RZ_IPI RzCmdStatus rz_il_vm_step_with_events_handler(RzCore *core, int argc, con
 RZ_IPI RzCmdStatus rz_il_vm_step_until_addr_handler(RzCore *core, int argc, const char **argv);
 // "aezv"
 RZ_IPI RzCmdStatus rz_il_vm_status_handler(RzCore *core, int argc, const char **argv, RzOutputMode mode);
+// "aezvs"
+RZ_IPI RzCmdStatus rz_il_vm_stats_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "aga"
 RZ_IPI RzCmdStatus rz_analysis_graph_dataref_handler(RzCore *core, int argc, const char **argv);
 RZ_IPI char **rz_analysis_graph_format_choices(RzCore *core);
@@ -504,6 +506,8 @@ RZ_IPI RzCmdStatus rz_analysis_xrefs_del_all_handler(RzCore *core, int argc, con
 RZ_IPI RzCmdStatus rz_analysis_xrefs_copy_handler(RzCore *core, int argc, const char **argv);
 // "axg"
 RZ_IPI RzCmdStatus rz_analysis_xrefs_graph_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
+// "axi"
+RZ_IPI RzCmdStatus rz_analysis_xrefs_stats_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "ahl"
 RZ_IPI RzCmdStatus rz_analysis_hint_list_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "ahl."
@@ -636,6 +640,8 @@ RZ_IPI RzCmdStatus rz_analyze_cycles_handler(RzCore *core, int argc, const char
 RZ_IPI RzCmdStatus rz_convert_mne_handler(RzCore *core, int argc, const char **argv);
 // "aoma"
 RZ_IPI RzCmdStatus rz_list_mne_handler(RzCore *core, int argc, const char **argv);
+// "aoC"
+RZ_IPI RzCmdStatus rz_analyze_decode_cache_stats_handler(RzCore *core, int argc, const char **argv);
 // "an"
 RZ_IPI RzCmdStatus rz_analyse_name_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "abi"
@@ -1619,6 +1625,10 @@ RZ_IPI RzCmdStatus rz_open_maps_deprioritize_handler(RzCore *core, int argc, con
 RZ_IPI RzCmdStatus rz_open_maps_prioritize_fd_handler(RzCore *core, int argc, const char **argv);
 // "ox"
 RZ_IPI RzCmdStatus rz_open_exchange_handler(RzCore *core, int argc, const char **argv);
+// "oP"
+RZ_IPI RzCmdStatus rz_open_page_cache_stats_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
+// "oP-"
+RZ_IPI RzCmdStatus rz_open_page_cache_reset_handler(RzCore *core, int argc, const char **argv);
 // "pb"
 RZ_IPI RzCmdStatus rz_print_bitstream_handler(RzCore *core, int argc, const char **argv, RzOutputMode mode);
 // "pB"
@@ -1729,6 +1739,8 @@ RZ_IPI RzCmdStatus rz_cmd_print_gadget_remove_handler(RzCore *core, int argc, co
 RZ_IPI RzCmdStatus rz_cmd_print_gadget_move_handler(RzCore *core, int argc, const char **argv);
 // "ph"
 RZ_IPI RzCmdStatus rz_cmd_print_hash_cfg_handler(RzCore *core, int argc, const char **argv);
+// "phm"
+RZ_IPI RzCmdStatus rz_cmd_print_hash_tree_handler(RzCore *core, int argc, const char **argv);
 // "phl"
 RZ_IPI RzCmdStatus rz_cmd_print_hash_cfg_algo_list_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "pi"
@@ -1913,6 +1925,8 @@ RZ_IPI RzCmdStatus rz_print_minus_table_handler(RzCore *core, int argc, const ch
 RZ_IPI int rz_cmd_print(void *data, const char *input);
 // "Ps"
 RZ_IPI RzCmdStatus rz_project_save_handler(RzCore *core, int argc, const char **argv);
+// "Psc"
+RZ_IPI RzCmdStatus rz_project_save_compact_handler(RzCore *core, int argc, const char **argv);
 // "Po"
 RZ_IPI RzCmdStatus rz_project_open_handler(RzCore *core, int argc, const char **argv);
 // "Poo"
@@ -2131,6 +2145,8 @@ RZ_IPI RzCmdStatus rz_write_cache_remove_all_handler(RzCore *core, int argc, con
 RZ_IPI RzCmdStatus rz_write_cache_commit_handler(RzCore *core, int argc, const char **argv);
 // "wci"
 RZ_IPI RzCmdStatus rz_write_cache_commit_all_handler(RzCore *core, int argc, const char **argv);
+// "wcm"
+RZ_IPI RzCmdStatus rz_write_cache_memory_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "wcp"
 RZ_IPI RzCmdStatus rz_write_pcache_list_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "wcpi"
@@ -180,19 +180,21 @@ RZ_API RzBinReloc *rz_core_getreloc(RzCore *core, ut64 addr, int size) {
 		return NULL;
 	}
 	RzBinFile *bf = rz_bin_cur(core->bin);
-	if (!bf || !bf->o || !bf->o->relocs) {
+	RzBinRelocStorage *relocs = bf && bf->o ? rz_bin_object_get_relocs(bf->o) : NULL;
+	if (!relocs) {
 		return NULL;
 	}
-	return rz_bin_reloc_storage_get_reloc_in(bf->o->relocs, addr, size);
+	return rz_bin_reloc_storage_get_reloc_in(relocs, addr, size);
 }
 
 RZ_API RzBinReloc *rz_core_get_reloc_to(RzCore *core, ut64 addr) {
 	rz_return_val_if_fail(core, NULL);
 	RzBinFile *bf = rz_bin_cur(core->bin);
-	if (!bf || !bf->o || !bf->o->relocs) {
+	RzBinRelocStorage *relocs = bf && bf->o ? rz_bin_object_get_relocs(bf->o) : NULL;
+	if (!relocs) {
 		return NULL;
 	}
-	return rz_bin_reloc_storage_get_reloc_to(bf->o->relocs, addr);
+	return rz_bin_reloc_storage_get_reloc_to(relocs, addr);
 }
 
 /* returns the address of a jmp/call given a shortcut by the user or UT64_MAX
@@ -2318,6 +2320,20 @@ static int bp_bits_at(ut64 addr, void *user) {
 static void ev_iowrite_cb(RzEvent *ev, int type, void *user, void *data) {
 	RzCore *core = user;
 	RzEventIOWrite *iow = data;
+	if (core->analysis->esil) {
+		rz_analysis_esil_code_cache_invalidate(core->analysis->esil, iow->addr, iow->len);
+	}
+	if (core->analysis->il_vm) {
+		rz_analysis_il_vm_cache_invalidate(core->analysis->il_vm, iow->addr, iow->len);
+	}
+	if (core->hash_index) {
+		// the writes to the io cache are reported with virtual addresses
+		rz_hash_block_index_invalidate(core->hash_index, iow->addr, iow->len);
+		ut64 paddr = rz_io_v2p(core->io, iow->addr);
+		if (paddr != UT64_MAX && paddr != iow->addr) {
+			rz_hash_block_index_invalidate(core->hash_index, paddr, iow->len);
+		}
+	}
 	if (rz_config_get_i(core->config, "analysis.detectwrites")) {
 		rz_analysis_update_analysis_range(core->analysis, iow->addr, iow->len);
 		if (core->cons->event_resize && core->cons->event_data) {
@@ -2491,6 +2507,7 @@ RZ_API bool rz_core_init(RzCore *core) {
 		core->asmqjmps = RZ_NEWS(ut64, core->asmqjmps_size);
 	}
 	core->hash = rz_hash_new();
+	core->hash_index_fd = -1;
 
 	rz_bin_bind(core->bin, &(core->rasm->binb));
 	rz_bin_bind(core->bin, &(core->analysis->binb));
@@ -2604,6 +2621,8 @@ RZ_API void rz_core_fini(RzCore *c) {
 	rz_core_task_join(&c->tasks, NULL, -1);
 	rz_core_wait(c);
 	//  avoid double free
+	RZ_FREE_CUSTOM(c->hash_index, rz_hash_block_index_free);
+	RZ_FREE_CUSTOM(c->prj_snapshot, rz_project_snapshot_free);
 	RZ_FREE_CUSTOM(c->hash, rz_hash_free);
 	RZ_FREE_CUSTOM(c->ropchain, rz_list_free);
 	RZ_FREE_CUSTOM(c->ev, rz_event_free);
@@ -9,6 +9,7 @@
 #include <rz_il.h>
 
 RZ_IPI void rz_core_kuery_print(RzCore *core, const char *k);
+RZ_IPI void rz_project_snapshot_free(RzProjectSnapshot *snap);
 RZ_IPI int rz_output_mode_to_char(RzOutputMode mode);
 
 RZ_IPI int bb_cmpaddr(const void *_a, const void *_b);
@@ -39,6 +40,7 @@ RZ_IPI char *rz_core_analysis_var_display(RzCore *core, RzAnalysisVar *var, bool
 RZ_IPI char *rz_core_analysis_all_vars_display(RzCore *core, RzAnalysisFunction *fcn, bool add_name);
 RZ_IPI bool rz_analysis_var_global_list_show(RzAnalysis *analysis, RzCmdStateOutput *state, RZ_NULLABLE const char *name);
 RZ_IPI bool rz_core_analysis_types_propagation(RzCore *core);
+RZ_IPI bool rz_core_analysis_can_use_decoders(RzCore *core);
 RZ_IPI bool rz_core_analysis_function_set_signature(RzCore *core, RzAnalysisFunction *fcn, const char *newsig);
 RZ_IPI void rz_core_analysis_function_signature_editor(RzCore *core, ut64 addr);
 RZ_IPI void rz_core_analysis_bbs_asciiart(RzCore *core, RzAnalysisFunction *fcn);
@@ -51,6 +53,13 @@ RZ_IPI void rz_core_analysis_cc_print(RzCore *core, RZ_NONNULL const char *cc, R
 RZ_IPI void rz_core_analysis_resolve_pointers_to_data(RzCore *core);
 RZ_IPI ut64 rz_core_prevop_addr_heuristic(RzCore *core, ut64 addr);
 
+/* cworkers.c */
+typedef struct rz_core_workers_t RzCoreWorkers;
+typedef void (*RzCoreWorkerRun)(void *user);
+RZ_IPI RZ_OWN RzCoreWorkers *rz_core_workers_new(size_t n_threads, RZ_NONNULL RzCoreWorkerRun run, RZ_NONNULL void *users, size_t user_size);
+RZ_IPI void rz_core_workers_run(RZ_NONNULL RzCoreWorkers *workers);
+RZ_IPI void rz_core_workers_free(RZ_NULLABLE RzCoreWorkers *workers);
+
 /* cmeta.c */
 RZ_IPI void rz_core_spaces_print(RzCore *core, RzSpaces *spaces, RzCmdStateOutput *state);
 RZ_IPI void rz_core_meta_print(RzCore *core, RzAnalysisMetaItem *d, ut64 start, ut64 size, bool show_full, RzCmdStateOutput *state);
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_th.h>
+#include "core_private.h"
+
+/*
+ * A set of threads started once and woken up for each batch of work, so the
+ * commands which process a range in batches (aar, /x, pI, ...) do not start and
+ * join a thread pool for each one of them.
+ */
+
+typedef struct rz_core_worker_t {
+	RzCoreWorkers *workers;
+	RzThreadSemaphore *start; ///< posted for each batch
+	void *user;
+} RzCoreWorker;
+
+struct rz_core_workers_t {
+	RzThreadPool *pool;
+	RzCoreWorker *threads;
+	RzThreadSemaphore *done; ///< posted by each thread once its run is completed
+	RzCoreWorkerRun run;
+	void *first; ///< user data of the first thread, used when no thread could be started
+	size_t started;
+	bool stop;
+};
+
+static void *core_worker_loop(RzCoreWorker *worker) {
+	RzCoreWorkers *workers = worker->workers;
+	while (true) {
+		rz_th_sem_wait(worker->start);
+		if (workers->stop) {
+			break;
+		}
+		workers->run(worker->user);
+		rz_th_sem_post(workers->done);
+	}
+	return NULL;
+}
+
+/**
+ * \brief Starts up to \p n_threads threads, which call \p run on each rz_core_workers_run()
+ *
+ * The thread i passes to \p run the element i of \p users, an array of \p n_threads
+ * elements of \p user_size bytes. Less threads than requested may be started, thus
+ * \p run is expected to consume a queue of work shared by all the threads.
+ */
+RZ_IPI RZ_OWN RzCoreWorkers *rz_core_workers_new(size_t n_threads, RZ_NONNULL RzCoreWorkerRun run, RZ_NONNULL void *users, size_t user_size) {
+	rz_return_val_if_fail(n_threads && run && users, NULL);
+	RzCoreWorkers *workers = RZ_NEW0(RzCoreWorkers);
+	if (!workers) {
+		return NULL;
+	}
+	workers->run = run;
+	workers->first = users;
+	workers->pool = rz_th_pool_new(n_threads);
+	workers->threads = RZ_NEWS0(RzCoreWorker, n_threads);
+	workers->done = rz_th_sem_new(0);
+	if (!workers->pool || !workers->threads || !workers->done) {
+		rz_core_workers_free(workers);
+		return NULL;
+	}
+	for (; workers->started < n_threads; workers->started++) {
+		RzCoreWorker *worker = &workers->threads[workers->started];
+		worker->workers = workers;
+		worker->start = rz_th_sem_new(0);
+		worker->user = (ut8 *)users + workers->started * user_size;
+		RzThread *th = worker->start ? rz_th_new((RzThreadFunction)core_worker_loop, worker) : NULL;
+		if (!th) {
+			// the started threads will do all the work.
+			rz_th_sem_free(worker->start);
+			worker->start = NULL;
+			break;
+		} else if (!rz_th_pool_add_thread(workers->pool, th)) {
+			workers->stop = true;
+			rz_th_sem_post(worker->start);
+			rz_th_wait(th);
+			rz_th_free(th);
+			rz_th_sem_free(worker->start);
+			worker->start = NULL;
+			workers->stop = false;
+			break;
+		}
+	}
+	return workers;
+}
+
+/**
+ * \brief Calls the run callback on all the threads and waits for them to return
+ *
+ * When no thread could be started, the callback is called on the calling thread.
+ */
+RZ_IPI void rz_core_workers_run(RZ_NONNULL RzCoreWorkers *workers) {
+	rz_return_if_fail(workers);
+	if (!workers->started) {
+		workers->run(workers->first);
+		return;
+	}
+	for (size_t i = 0; i < workers->started; i++) {
+		rz_th_sem_post(workers->threads[i].start);
+	}
+	for (size_t i = 0; i < workers->started; i++) {
+		rz_th_sem_wait(workers->done);
+	}
+}
+
+/**
+ * \brief Stops and joins the threads
+ */
+RZ_IPI void rz_core_workers_free(RZ_NULLABLE RzCoreWorkers *workers) {
+	if (!workers) {
+		return;
+	}
+	if (workers->started) {
+		workers->stop = true;
+		for (size_t i = 0; i < workers->started; i++) {
+			rz_th_sem_post(workers->threads[i].start);
+		}
+		rz_th_pool_wait(workers->pool);
+	}
+	rz_th_pool_free(workers->pool);
+	for (size_t i = 0; i < workers->started; i++) {
+		rz_th_sem_free(workers->threads[i].start);
+	}
+	rz_th_sem_free(workers->done);
+	free(workers->threads);
+	free(workers);
+}
@@ -82,6 +82,13 @@ static const char *rz_vline_uc[] = {
 #define DS_PRE_FCN_MIDDLE 3
 #define DS_PRE_FCN_TAIL   4
 
+// what is attached to an address of the printed window, see ds_annotations_prefetch()
+#define DS_ANNOT_FLAGS      (1 << 0) ///< flags at the address
+#define DS_ANNOT_XREFS_FROM (1 << 1) ///< xrefs from the address
+#define DS_ANNOT_XREFS_TO   (1 << 2) ///< xrefs to the address
+#define DS_ANNOT_META_AT    (1 << 3) ///< meta items starting at the address
+#define DS_ANNOT_META_IN    (1 << 4) ///< meta items containing the address
+
 // TODO: what about using bit shifting and enum for keys? see librz/util/bitmap.c
 // the problem of this is that the fields will be more opaque to bindings, but we will earn some bits
 typedef struct {
@@ -300,6 +307,11 @@ typedef struct {
 	ut64 printed_flag_addr;
 	ut64 min_ref_addr;
 
+	ut8 *annotations; ///< DS_ANNOT_* bits of each address in [annotations_addr, annotations_addr + annotations_size)
+	ut64 annotations_addr;
+	ut64 annotations_size;
+	ut64 annotations_cap;
+
 	PJ *pj; // not null if printing json
 	int buf_line_begin;
 	const char *strip;
@@ -936,9 +948,90 @@ static void ds_free(RzDisasmState *ds) {
 	free(ds->osl);
 	free(ds->sl);
 	free(ds->_tabsbuf);
+	free(ds->annotations);
 	RZ_FREE(ds);
 }
 
+static inline void ds_annotate(RzDisasmState *ds, ut64 at, ut8 kind) {
+	if (at >= ds->annotations_addr && at - ds->annotations_addr < ds->annotations_size) {
+		ds->annotations[at - ds->annotations_addr] |= kind;
+	}
+}
+
+static bool annotate_flags_cb(RzFlagItem *fi, void *user) {
+	ds_annotate(user, fi->offset, DS_ANNOT_FLAGS);
+	return true;
+}
+
+static bool annotate_xref_from_cb(const RzAnalysisXRef *xref, void *user) {
+	ds_annotate(user, xref->from, DS_ANNOT_XREFS_FROM);
+	return true;
+}
+
+static bool annotate_xref_to_cb(const RzAnalysisXRef *xref, void *user) {
+	ds_annotate(user, xref->to, DS_ANNOT_XREFS_TO);
+	return true;
+}
+
+/**
+ * Collect what is attached to each address of [addr, addr + size) with one range query
+ * per store (flags, xrefs, meta), so the printers only query a store for the lines that
+ * actually have something in it instead of for every line.
+ */
+static void ds_annotations_prefetch(RzDisasmState *ds, ut64 addr, ut64 size) {
+	RzCore *core = ds->core;
+	ds->annotations_size = 0;
+	if (!size) {
+		return;
+	}
+	if (addr + size - 1 < addr) {
+		size = UT64_MAX - addr + 1;
+	}
+	if (size > ds->annotations_cap) {
+		ut8 *annotations = realloc(ds->annotations, size);
+		if (!annotations) {
+			return;
+		}
+		ds->annotations = annotations;
+		ds->annotations_cap = size;
+	}
+	memset(ds->annotations, 0, size);
+	ds->annotations_addr = addr;
+	ds->annotations_size = size;
+	ut64 last = addr + size - 1;
+	rz_flag_foreach_range(core->flags, addr, last, annotate_flags_cb, ds);
+	rz_analysis_xrefs_foreach_from_in(core->analysis, addr, size, annotate_xref_from_cb, ds);
+	rz_analysis_xrefs_foreach_to_in(core->analysis, addr, size, annotate_xref_to_cb, ds);
+	RzPVector *metas = rz_meta_get_all_intersect(core->analysis, addr, size, RZ_META_TYPE_ANY);
+	if (metas) {
+		void **it;
+		rz_pvector_foreach (metas, it) {
+			RzIntervalNode *node = *it;
+			ds_annotate(ds, node->start, DS_ANNOT_META_AT);
+			ut64 from = RZ_MAX(node->start, addr);
+			ut64 to = RZ_MIN(node->end, last);
+			for (ut64 at = from; at <= to; at++) {
+				ds->annotations[at - addr] |= DS_ANNOT_META_IN;
+				if (at == UT64_MAX) {
+					break;
+				}
+			}
+		}
+		rz_pvector_free(metas);
+	}
+}
+
+/**
+ * Whether \p at may have something of \p kind attached to it.
+ * Addresses outside of the prefetched window always may.
+ */
+static inline bool ds_has_annotation(RzDisasmState *ds, ut64 at, ut8 kind) {
+	if (at < ds->annotations_addr || at - ds->annotations_addr >= ds->annotations_size) {
+		return true;
+	}
+	return ds->annotations[at - ds->annotations_addr] & kind;
+}
+
 static bool ds_must_strip(RzDisasmState *ds) {
 	if (ds && ds->strip && *ds->strip) {
 		const char *optype = rz_analysis_optype_to_string(ds->analysis_op.type);
@@ -1172,7 +1265,9 @@ static void ds_build_op_str(RzDisasmState *ds, bool print_color) {
 		int i = 0;
 		char *word = NULL;
 		char *bgcolor = NULL;
-		const char *wcdata = rz_meta_get_string(ds->core->analysis, RZ_META_TYPE_HIGHLIGHT, ds->at);
+		const char *wcdata = ds_has_annotation(ds, ds->at, DS_ANNOT_META_AT)
+			? rz_meta_get_string(ds->core->analysis, RZ_META_TYPE_HIGHLIGHT, ds->at)
+			: NULL;
 		int argc = 0;
 		char **wc_array = rz_str_argv(wcdata, &argc);
 		for (i = 0; i < argc; i++) {
@@ -1332,6 +1427,9 @@ static void ds_show_refs(RzDisasmState *ds) {
 	if (!ds->show_cmtrefs) {
 		return;
 	}
+	if (!ds_has_annotation(ds, ds->at, DS_ANNOT_XREFS_FROM)) {
+		return;
+	}
 	RzList *list = rz_analysis_xrefs_get_from(ds->core->analysis, ds->at);
 
 	rz_list_foreach (list, iter, xref) {
@@ -1381,6 +1479,9 @@ static void ds_show_xrefs(RzDisasmState *ds) {
 	if (!ds->show_xrefs || !ds->show_comments) {
 		return;
 	}
+	if (!ds_has_annotation(ds, ds->at, DS_ANNOT_XREFS_TO)) {
+		return;
+	}
 	/* show xrefs */
 	RzList *xrefs = rz_analysis_xrefs_get_to(core->analysis, ds->at);
 	if (!xrefs) {
@@ -2176,9 +2277,13 @@ static void ds_show_comments_right(RzDisasmState *ds) {
 	if (!ds->show_comments && !ds->show_usercomments) {
 		return;
 	}
-	RzFlagItem *item = rz_flag_get_i(core->flags, ds->at);
-	const char *comment = rz_meta_get_string(core->analysis, RZ_META_TYPE_COMMENT, ds->at);
-	const char *vartype = rz_meta_get_string(core->analysis, RZ_META_TYPE_VARTYPE, ds->at);
+	RzFlagItem *item = ds_has_annotation(ds, ds->at, DS_ANNOT_FLAGS) ? rz_flag_get_i(core->flags, ds->at) : NULL;
+	const char *comment = NULL;
+	const char *vartype = NULL;
+	if (ds_has_annotation(ds, ds->at, DS_ANNOT_META_AT)) {
+		comment = rz_meta_get_string(core->analysis, RZ_META_TYPE_COMMENT, ds->at);
+		vartype = rz_meta_get_string(core->analysis, RZ_META_TYPE_VARTYPE, ds->at);
+	}
 	if (!comment) {
 		if (vartype) {
 			ds->comment = rz_str_newf("%s; %s", COLOR_ARG(ds, color_func_var_type), vartype);
@@ -2289,7 +2394,7 @@ static void ds_show_flags(RzDisasmState *ds, bool overlapped) {
 	ut64 switch_addr = UT64_MAX;
 	int case_start = -1, case_prev = 0, case_current = 0;
 	f = rz_analysis_get_function_at(ds->core->analysis, ds->at);
-	const RzList *flaglist = rz_flag_get_list(core->flags, ds->at);
+	const RzList *flaglist = ds_has_annotation(ds, ds->at, DS_ANNOT_FLAGS) ? rz_flag_get_list(core->flags, ds->at) : NULL;
 	RzList *uniqlist = flaglist ? rz_list_uniq(flaglist, flagCmp) : NULL;
 	int count = 0;
 	bool outline = !ds->flags_inline;
@@ -2532,7 +2637,7 @@ static int ds_disassemble(RzDisasmState *ds, ut8 *buf, int len) {
 	int ret;
 
 	// find the meta item at this offset if any
-	RzPVector *metas = rz_meta_get_all_at(ds->core->analysis, ds->at); // TODO: do in range
+	RzPVector *metas = ds_has_annotation(ds, ds->at, DS_ANNOT_META_AT) ? rz_meta_get_all_at(ds->core->analysis, ds->at) : NULL;
 	RzAnalysisMetaItem *meta = NULL;
 	ut64 meta_size = UT64_MAX;
 	if (metas) {
@@ -2971,6 +3076,9 @@ static void ds_print_offset(RzDisasmState *ds) {
 }
 
 static bool requires_op_size(RzDisasmState *ds) {
+	if (!ds_has_annotation(ds, ds->at, DS_ANNOT_META_IN)) {
+		return false;
+	}
 	RzPVector *metas = rz_meta_get_all_in(ds->core->analysis, ds->at, RZ_META_TYPE_ANY);
 	if (!metas) {
 		return false;
@@ -3128,7 +3236,7 @@ static bool ds_print_meta_infos(RzDisasmState *ds, ut8 *buf, int len, int idx, i
 	bool ret = false;
 	RzAnalysisMetaItem *fmi;
 	RzCore *core = ds->core;
-	if (!ds->asm_meta) {
+	if (!ds->asm_meta || !ds_has_annotation(ds, ds->at, DS_ANNOT_META_IN)) {
 		return false;
 	}
 	RzPVector *metas = rz_meta_get_all_in(core->analysis, ds->at, RZ_META_TYPE_ANY);
@@ -3684,7 +3792,9 @@ static bool ds_print_core_vmode(RzDisasmState *ds, int pos) {
 	}
 	if (ds->asm_hint_lea) {
 		ut64 size;
-		RzAnalysisMetaItem *mi = rz_meta_get_at(ds->core->analysis, ds->at, RZ_META_TYPE_ANY, &size);
+		RzAnalysisMetaItem *mi = ds_has_annotation(ds, ds->at, DS_ANNOT_META_AT)
+			? rz_meta_get_at(ds->core->analysis, ds->at, RZ_META_TYPE_ANY, &size)
+			: NULL;
 		if (mi) {
 			int obits = ds->core->rasm->bits;
 			ds->core->rasm->bits = size * 8;
@@ -4056,7 +4166,7 @@ static void ds_print_ptr(RzDisasmState *ds, int len, int idx) {
 	}
 	RzListIter *iter;
 	RzAnalysisXRef *xref;
-	RzList *list = rz_analysis_xrefs_get_from(core->analysis, ds->at);
+	RzList *list = ds_has_annotation(ds, ds->at, DS_ANNOT_XREFS_FROM) ? rz_analysis_xrefs_get_from(core->analysis, ds->at) : NULL;
 	rz_list_foreach (list, iter, xref) {
 		if (xref->type == RZ_ANALYSIS_XREF_TYPE_STRING || xref->type == RZ_ANALYSIS_XREF_TYPE_DATA) {
 			if ((f = rz_flag_get_i(core->flags, xref->to))) {
@@ -4588,7 +4698,7 @@ static void ds_pre_emulation(RzDisasmState *ds) {
 		if (op) {
 			if (do_esil) {
 				rz_analysis_esil_set_pc(esil, addr);
-				rz_analysis_esil_parse(esil, RZ_STRBUF_SAFEGET(&op->esil));
+				rz_analysis_esil_parse_at(esil, addr, RZ_STRBUF_SAFEGET(&op->esil));
 				if (op->size > 0) {
 					i += op->size - 1;
 				}
@@ -5019,7 +5129,7 @@ static void ds_print_comments_right(RzDisasmState *ds) {
 	RzCore *core = ds->core;
 	ds_print_relocs(ds);
 	bool is_code = (!ds->hint) || (ds->hint && ds->hint->type != 'd');
-	RzAnalysisMetaItem *mi = rz_meta_get_at(ds->core->analysis, ds->at, RZ_META_TYPE_ANY, NULL);
+	RzAnalysisMetaItem *mi = ds_has_annotation(ds, ds->at, DS_ANNOT_META_AT) ? rz_meta_get_at(ds->core->analysis, ds->at, RZ_META_TYPE_ANY, NULL) : NULL;
 	if (mi) {
 		is_code = mi->type != 'd';
 		mi = NULL;
@@ -5387,6 +5497,7 @@ toro:
 	}
 
 	ds_print_esil_analysis_init(ds);
+	ds_annotations_prefetch(ds, ds->addr, (len + addrbytes - 1) / addrbytes);
 	inc = 0;
 	if (!ds->l) {
 		ds->l = core->blocksize;
@@ -5766,6 +5877,212 @@ RZ_IPI bool rz_disasm_check_end(int nb_opcodes, int i_opcodes, int nb_bytes, int
 	return i_bytes < nb_bytes;
 }
 
+#define DISASM_BULK_BLOCK_SIZE        0x2000
+#define DISASM_BULK_BLOCKS_PER_THREAD 16
+
+typedef struct disasm_bulk_op_t {
+	int i; ///< offset of the instruction in the buffer
+	int ret; ///< value returned by rz_asm_disassemble()
+	RzAsmOp asmop;
+	RzAnalysisOp analysis_op;
+} DisasmBulkOp;
+
+typedef struct disasm_bulk_block_t {
+	int from; ///< offset in the buffer where the decoding starts
+	int to; ///< offset in the buffer where the decoding stops
+	RzVector /*<DisasmBulkOp>*/ ops;
+} DisasmBulkBlock;
+
+typedef struct disasm_bulk_t {
+	ut64 address;
+	const ut8 *buf;
+	int nb_bytes;
+	int from; ///< offset of the first block of the last round
+	int to; ///< end offset of the last block of the last round
+	size_t n_threads;
+	RzAsm **rasm;
+	RzAnalysis **analysis;
+	size_t n_blocks;
+	DisasmBulkBlock *blocks;
+	RzThreadQueue *queue; ///< blocks of the current round
+	struct disasm_bulk_worker_t *workers;
+	RzCoreWorkers *threads; ///< started once, woken up for each round
+} DisasmBulk;
+
+typedef struct disasm_bulk_worker_t {
+	DisasmBulk *bulk;
+	RzAsm *rasm;
+	RzAnalysis *analysis;
+	RzThreadQueue *blocks;
+} DisasmBulkWorker;
+
+static void disasm_bulk_op_fini(void *e, void *user) {
+	DisasmBulkOp *op = e;
+	rz_asm_op_fini(&op->asmop);
+	rz_analysis_op_fini(&op->analysis_op);
+}
+
+static void disasm_bulk_worker_run(DisasmBulkWorker *worker) {
+	const DisasmBulk *bulk = worker->bulk;
+	DisasmBulkBlock *block = NULL;
+	while ((block = rz_th_queue_pop(worker->blocks, false))) {
+		for (int i = block->from; i < block->to;) {
+			DisasmBulkOp *op = rz_vector_push(&block->ops, NULL);
+			if (!op) {
+				break;
+			}
+			// same arguments of the sequential loop, thus the same results.
+			op->i = i;
+			rz_asm_set_pc(worker->rasm, bulk->address + i);
+			op->ret = rz_asm_disassemble(worker->rasm, &op->asmop, bulk->buf + i, bulk->nb_bytes - i);
+			rz_analysis_op_init(&op->analysis_op);
+			rz_analysis_op(worker->analysis, &op->analysis_op, bulk->address + i, bulk->buf + i, bulk->nb_bytes - i, RZ_ANALYSIS_OP_MASK_ALL);
+			i += RZ_MAX(1, op->ret);
+		}
+	}
+}
+
+static void disasm_bulk_free(DisasmBulk *bulk) {
+	if (!bulk) {
+		return;
+	}
+	rz_core_workers_free(bulk->threads);
+	rz_th_queue_free(bulk->queue);
+	free(bulk->workers);
+	if (bulk->blocks) {
+		for (size_t i = 0; i < bulk->n_blocks; i++) {
+			rz_vector_fini(&bulk->blocks[i].ops);
+		}
+		free(bulk->blocks);
+	}
+	for (size_t i = 0; i < bulk->n_threads; i++) {
+		if (bulk->rasm) {
+			rz_asm_free(bulk->rasm[i]);
+		}
+		if (bulk->analysis) {
+			rz_analysis_free(bulk->analysis[i]);
+		}
+	}
+	free(bulk->rasm);
+	free(bulk->analysis);
+	free(bulk);
+}
+
+/**
+ * \brief Returns true if the instructions printed by pI can be decoded by worker threads.
+ *
+ * Only the x86 plugins keep all their decoding state in the plugin data and decode each
+ * instruction without looking at the previous ones (unlike e.g. the arm IT blocks or the
+ * hexagon packets), and no hint, per-address arch/bits change or pseudo syntax can make
+ * the output differ from the sequential one.
+ */
+static bool disasm_bulk_can_be_used(RzCore *core) {
+	RzAsm *rasm = core->rasm;
+	RzAnalysis *analysis = core->analysis;
+	if (!rasm->cur || !rasm->cur->disassemble || !analysis->cur) {
+		return false;
+	} else if (strcmp(rasm->cur->name, "x86") || strcmp(analysis->cur->name, "x86")) {
+		return false;
+	} else if (rasm->ofilter || rasm->bitshift) {
+		return false;
+	}
+	return rz_core_analysis_can_use_decoders(core);
+}
+
+/**
+ * \brief Prepares the worker threads decoding the \p nb_bytes of \p buf ahead of the pI loop.
+ *
+ * \return NULL when `asm.threads` is 1 or the decoding cannot be parallelized.
+ */
+static DisasmBulk *disasm_bulk_new(RzCore *core, ut64 address, const ut8 *buf, int nb_bytes) {
+	size_t n_threads = rz_th_request_physical_cores(rz_config_get_i(core->config, "asm.threads"));
+	if (n_threads < 2 || nb_bytes <= DISASM_BULK_BLOCK_SIZE || !disasm_bulk_can_be_used(core)) {
+		return NULL;
+	}
+	DisasmBulk *bulk = RZ_NEW0(DisasmBulk);
+	if (!bulk) {
+		return NULL;
+	}
+	bulk->address = address;
+	bulk->buf = buf;
+	bulk->nb_bytes = nb_bytes;
+	bulk->n_threads = n_threads;
+	bulk->n_blocks = n_threads * DISASM_BULK_BLOCKS_PER_THREAD;
+	bulk->rasm = RZ_NEWS0(RzAsm *, n_threads);
+	bulk->analysis = RZ_NEWS0(RzAnalysis *, n_threads);
+	bulk->blocks = RZ_NEWS0(DisasmBulkBlock, bulk->n_blocks);
+	bulk->workers = RZ_NEWS0(DisasmBulkWorker, n_threads);
+	bulk->queue = rz_th_queue_new(RZ_THREAD_QUEUE_UNLIMITED, NULL);
+	if (!bulk->rasm || !bulk->analysis || !bulk->blocks || !bulk->workers || !bulk->queue) {
+		goto fail;
+	}
+	for (size_t i = 0; i < bulk->n_blocks; i++) {
+		rz_vector_init(&bulk->blocks[i].ops, sizeof(DisasmBulkOp), disasm_bulk_op_fini, NULL);
+	}
+	for (size_t i = 0; i < n_threads; i++) {
+		bulk->rasm[i] = rz_asm_new_decoder(core->rasm);
+		bulk->analysis[i] = rz_analysis_new_decoder(core->analysis);
+		if (!bulk->rasm[i] || !bulk->analysis[i]) {
+			goto fail;
+		}
+		bulk->workers[i].bulk = bulk;
+		bulk->workers[i].rasm = bulk->rasm[i];
+		bulk->workers[i].analysis = bulk->analysis[i];
+		bulk->workers[i].blocks = bulk->queue;
+	}
+	bulk->threads = rz_core_workers_new(n_threads, (RzCoreWorkerRun)disasm_bulk_worker_run, bulk->workers, sizeof(DisasmBulkWorker));
+	if (!bulk->threads) {
+		RZ_LOG_ERROR("cannot allocate disassembly thread pool\n");
+		goto fail;
+	}
+	return bulk;
+
+fail:
+	disasm_bulk_free(bulk);
+	return NULL;
+}
+
+/**
+ * \brief Decodes the next blocks of the buffer in parallel, starting from the offset \p i
+ */
+static bool disasm_bulk_decode(DisasmBulk *bulk, int i) {
+	bulk->from = bulk->to = i;
+	for (size_t b = 0; b < bulk->n_blocks && bulk->to < bulk->nb_bytes; b++) {
+		DisasmBulkBlock *block = &bulk->blocks[b];
+		rz_vector_clear(&block->ops);
+		block->from = bulk->to;
+		block->to = RZ_MIN(bulk->nb_bytes, block->from + DISASM_BULK_BLOCK_SIZE);
+		if (!rz_th_queue_push(bulk->queue, block, true)) {
+			break;
+		}
+		bulk->to = block->to;
+	}
+	rz_core_workers_run(bulk->threads);
+	return bulk->to > bulk->from;
+}
+
+#define DISASM_BULK_OP_CMP(i, e) ((i) - ((DisasmBulkOp *)(e))->i)
+
+/**
+ * \brief Returns the instruction decoded by the workers at the offset \p i of the buffer.
+ *
+ * Every block is decoded from its beginning, so an instruction crossing the end of the
+ * previous block is not found and must be decoded by the caller until both are in sync.
+ */
+static DisasmBulkOp *disasm_bulk_get(DisasmBulk *bulk, int i) {
+	if (i < 0 || i >= bulk->nb_bytes) {
+		return NULL;
+	}
+	if ((i < bulk->from || i >= bulk->to) && !disasm_bulk_decode(bulk, i)) {
+		return NULL;
+	}
+	DisasmBulkBlock *block = &bulk->blocks[(i - bulk->from) / DISASM_BULK_BLOCK_SIZE];
+	size_t idx;
+	rz_vector_lower_bound(&block->ops, i, idx, DISASM_BULK_OP_CMP);
+	DisasmBulkOp *op = idx < rz_vector_len(&block->ops) ? rz_vector_index_ptr(&block->ops, idx) : NULL;
+	return op && op->i == i ? op : NULL;
+}
+
 RZ_API int rz_core_print_disasm_instructions_with_buf(RzCore *core, ut64 address, ut8 *buf, int nb_bytes, int nb_opcodes) {
 	RzDisasmState *ds = NULL;
 	int i, j, ret, len = 0;
@@ -5774,6 +6091,8 @@ RZ_API int rz_core_print_disasm_instructions_with_buf(RzCore *core, ut64 address
 	bool hasanalysis = false;
 	const size_t addrbytes = buf ? 1 : core->io->addrbytes;
 	int skip_bytes_flag = 0, skip_bytes_bb = 0;
+	DisasmBulk *bulk = NULL;
+	DisasmBulkOp *bop;
 
 	if (nb_bytes < 1 && nb_opcodes < 1) {
 		return 0;
@@ -5791,6 +6110,9 @@ RZ_API int rz_core_print_disasm_instructions_with_buf(RzCore *core, ut64 address
 	}
 
 	core->offset = address;
+	if (addrbytes == 1 && nb_bytes > 0 && nb_opcodes < 1) {
+		bulk = disasm_bulk_new(core, address, buf, nb_bytes);
+	}
 
 	rz_cons_break_push(NULL, NULL);
 	// build ranges to map addr with bits
@@ -5807,11 +6129,19 @@ toro:
 		}
 		ds->hint = rz_core_hint_begin(core, ds->hint, ds->at);
 		ds->has_description = false;
-		rz_asm_set_pc(core->rasm, ds->at);
-		// XXX copypasta from main disassembler function
-		// rz_analysis_get_fcn_in (core->analysis, ds->at, RZ_ANALYSIS_FCN_TYPE_NULL);
-		ret = rz_asm_disassemble(core->rasm, &ds->asmop,
-			buf + addrbytes * i, len);
+		bop = bulk ? disasm_bulk_get(bulk, i) : NULL;
+		if (bop) {
+			rz_asm_op_fini(&ds->asmop);
+			ds->asmop = bop->asmop;
+			rz_asm_op_init(&bop->asmop);
+			ret = bop->ret;
+		} else {
+			rz_asm_set_pc(core->rasm, ds->at);
+			// XXX copypasta from main disassembler function
+			// rz_analysis_get_fcn_in (core->analysis, ds->at, RZ_ANALYSIS_FCN_TYPE_NULL);
+			ret = rz_asm_disassemble(core->rasm, &ds->asmop,
+				buf + addrbytes * i, len);
+		}
 		ds->oplen = ret;
 		skip_bytes_flag = handleMidFlags(core, ds, true);
 		if (ds->midbb) {
@@ -5824,7 +6154,11 @@ toro:
 			ret = skip_bytes_bb;
 		}
 		rz_analysis_op_fini(&ds->analysis_op);
-		if (!hasanalysis) {
+		if (bop) {
+			ds->analysis_op = bop->analysis_op;
+			rz_analysis_op_init(&bop->analysis_op);
+			hasanalysis = true;
+		} else if (!hasanalysis) {
 			// XXX we probably don't need MASK_ALL
 			rz_analysis_op(core->analysis, &ds->analysis_op, ds->at, buf + addrbytes * i, len, RZ_ANALYSIS_OP_MASK_ALL);
 			hasanalysis = true;
@@ -5920,6 +6254,7 @@ toro:
 		goto toro;
 	}
 	rz_cons_break_pop();
+	disasm_bulk_free(bulk);
 	ds_free(ds);
 	core->offset = old_offset;
 	rz_reg_arena_pop(core->analysis->reg);
@@ -6550,17 +6885,8 @@ RZ_API int rz_core_disasm_pde(RzCore *core, int nb_opcodes, RzCmdStateOutput *st
 		}
 	}
 	RzAnalysisEsil *esil = core->analysis->esil;
-	RzPVector ocache = core->io->cache;
 	const int ocached = core->io->cached;
-	if (ocache.v.a) {
-		RzPVector *vec = rz_pvector_clone(&ocache);
-		vec->v.free = NULL;
-		vec->v.free_user = ocache.v.free_user;
-		core->io->cache = *vec;
-		free(vec);
-	} else {
-		rz_io_cache_init(core->io);
-	}
+	const bool cache_pushed = rz_io_cache_push(core->io);
 	rz_reg_arena_push(reg);
 	RzConfigHold *chold = rz_config_hold_new(core->config);
 	rz_config_hold_i(chold, "io.cache", "asm.lines", NULL);
@@ -6656,22 +6982,8 @@ RZ_API int rz_core_disasm_pde(RzCore *core, int nb_opcodes, RzCmdStateOutput *st
 	rz_cmd_state_output_array_end(state);
 	free(buf);
 	rz_reg_arena_pop(reg);
-	int len = rz_pvector_len(&ocache);
-	if (rz_pvector_len(&core->io->cache) > len) {
-		// TODO: Implement push/pop for IO.cache
-		while (len > 0) {
-			(void)rz_pvector_pop_front(&core->io->cache);
-			len--;
-		}
-		core->io->cache.v.free = ocache.v.free;
-	}
-	rz_io_cache_fini(core->io);
-	core->io->cache = ocache;
-	rz_skyline_clear(&core->io->cache_skyline);
-	void **it;
-	rz_pvector_foreach (&ocache, it) {
-		RzIOCache *c = (RzIOCache *)*it;
-		rz_skyline_add(&core->io->cache_skyline, c->itv, c);
+	if (cache_pushed) {
+		rz_io_cache_pop(core->io);
 	}
 	core->io->cached = ocached;
 	rz_config_hold_restore(chold);
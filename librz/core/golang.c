@@ -136,7 +136,8 @@ static bool is_pclntab_valid(GoPcLnTab *pclntab) {
 
 static void add_new_func_symbol(RzCore *core, const char *name, ut64 vaddr) {
 	RzBinFile *bf = rz_bin_cur(core->bin);
-	if (!bf || !bf->o || !bf->o->symbols) {
+	RzList *symbols = bf && bf->o ? (RzList *)rz_bin_object_get_symbols(bf->o) : NULL;
+	if (!symbols) {
 		return;
 	}
 	ut64 paddr = rz_io_v2p(core->io, vaddr);
@@ -148,7 +149,7 @@ static void add_new_func_symbol(RzCore *core, const char *name, ut64 vaddr) {
 
 	symbol->bind = RZ_BIN_BIND_GLOBAL_STR;
 	symbol->type = RZ_BIN_TYPE_FUNC_STR;
-	if (!rz_list_append(bf->o->symbols, symbol)) {
+	if (!rz_list_append(symbols, symbol)) {
 		RZ_LOG_ERROR("Failed append new go symbol to symbols list\n");
 		rz_bin_symbol_free(symbol);
 	}
@@ -489,7 +490,7 @@ static bool add_new_bin_string(RzCore *core, char *string, ut64 vaddr, ut32 size
 	RzBinString *bstr;
 	RzBin *bin = core->bin;
 	RzBinFile *bf = rz_bin_cur(bin);
-	if (!bf || !bf->o || !bf->o->strings) {
+	if (!bf || !bf->o || !rz_bin_object_get_strings(bf->o)) {
 		free(string);
 		return false;
 	}
@@ -517,7 +518,7 @@ static bool add_new_bin_string(RzCore *core, char *string, ut64 vaddr, ut32 size
 	bstr->length = bstr->size = size;
 	bstr->string = string;
 	bstr->type = RZ_STRING_ENC_UTF8;
-	if (!rz_bin_string_database_add(bf->o->strings, bstr)) {
+	if (!rz_bin_object_add_string(bf->o, bstr)) {
 		RZ_LOG_ERROR("Failed append new go string to strings database\n");
 		rz_bin_string_free(bstr);
 		return false;
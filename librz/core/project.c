@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 
 #include <rz_project.h>
+#include "core_private.h"
 
 #define RZ_PROJECT_KEY_TYPE    "type"
 #define RZ_PROJECT_KEY_VERSION "version"
@@ -39,7 +40,171 @@ RZ_API RzProjectErr rz_project_save(RzCore *core, RzProject *prj, const char *fi
 	return RZ_PROJECT_ERR_SUCCESS;
 }
 
-RZ_API RzProjectErr rz_project_save_file(RzCore *core, const char *file, bool compress) {
+#define PRJ_SNAPSHOT_TAIL 64
+
+/**
+ * The contents of the project file that was last saved by a core, so the next save
+ * of the same file only has to append the records that changed since.
+ */
+struct rz_project_snapshot_t {
+	char *file; ///< absolute path of the project file
+	RzProject *prj; ///< contents of the file
+	ut64 base_size; ///< size of the file after its last full save
+	ut64 size; ///< size of the file after the last save
+	char tail[PRJ_SNAPSHOT_TAIL]; ///< last bytes of the file after the last save, to detect writes by others
+	int tail_len;
+};
+
+RZ_IPI void rz_project_snapshot_free(RzProjectSnapshot *snap) {
+	if (!snap) {
+		return;
+	}
+	sdb_free(snap->prj);
+	free(snap->file);
+	free(snap);
+}
+
+static bool file_tail_read(const char *file, ut64 size, char *tail, int *tail_len) {
+	int len = RZ_MIN(size, PRJ_SNAPSHOT_TAIL);
+	int read_len = 0;
+	char *buf = rz_file_slurp_range(file, size - len, len, &read_len);
+	if (!buf || read_len != len) {
+		free(buf);
+		return false;
+	}
+	memcpy(tail, buf, len);
+	*tail_len = len;
+	free(buf);
+	return true;
+}
+
+static bool snapshot_update(RzProjectSnapshot *snap, RZ_OWN RzProject *prj) {
+	sdb_free(snap->prj);
+	snap->prj = prj;
+	snap->size = rz_file_size(snap->file);
+	return file_tail_read(snap->file, snap->size, snap->tail, &snap->tail_len);
+}
+
+/// Whether the file at \p file is still the one that \p snap was saved to
+static bool snapshot_matches(RzProjectSnapshot *snap, const char *file) {
+	if (strcmp(snap->file, file) || rz_file_size(file) != snap->size) {
+		return false;
+	}
+	char tail[PRJ_SNAPSHOT_TAIL];
+	int tail_len;
+	return file_tail_read(file, snap->size, tail, &tail_len) &&
+		tail_len == snap->tail_len && !memcmp(tail, snap->tail, tail_len);
+}
+
+typedef struct {
+	Sdb *old;
+	Sdb *delta;
+	size_t count; ///< records in cur
+	size_t added; ///< records that do not exist in old
+	size_t changed; ///< records that are new or changed
+} ProjectDeltaCtx;
+
+static bool count_kv_cb(void *user, const char *k, const char *v) {
+	(*(size_t *)user)++;
+	return true;
+}
+
+static bool delta_kv_cb(void *user, const char *k, const char *v) {
+	ProjectDeltaCtx *ctx = user;
+	ctx->count++;
+	const char *old_v = ctx->old ? sdb_const_get(ctx->old, k, NULL) : NULL;
+	if (!old_v) {
+		ctx->added++;
+	}
+	if (!old_v || strcmp(old_v, v)) {
+		sdb_set(ctx->delta, k, v, 0);
+		ctx->changed++;
+	}
+	return true;
+}
+
+/**
+ * \brief Collect all records and namespaces of \p cur that are new or changed compared to \p old into \p delta.
+ *
+ * Loading \p old and then \p delta in the text format yields \p cur, as later lines override earlier ones.
+ * The format has no way to remove records though.
+ *
+ * \param old the previous contents, NULL if the namespace did not exist
+ * \param changed incremented by the number of new or changed records and namespaces
+ * \return false if anything of \p old was removed in \p cur
+ */
+static bool project_delta(RZ_NULLABLE Sdb *old, Sdb *cur, Sdb *delta, size_t *changed) {
+	ProjectDeltaCtx ctx = { old, delta, 0, 0, 0 };
+	sdb_foreach(cur, delta_kv_cb, &ctx);
+	*changed += ctx.changed;
+	if (old) {
+		// sdb_count() also counts unset records
+		size_t old_count = 0;
+		sdb_foreach(old, count_kv_cb, &old_count);
+		if (old_count != ctx.count - ctx.added) {
+			return false;
+		}
+	}
+	size_t matched = 0;
+	SdbListIter *it;
+	SdbNs *ns;
+	ls_foreach (cur->ns, it, ns) {
+		Sdb *old_sub = old ? sdb_ns(old, ns->name, false) : NULL;
+		if (old_sub) {
+			matched++;
+		}
+		Sdb *delta_sub = sdb_ns(delta, ns->name, true);
+		if (!delta_sub) {
+			return false;
+		}
+		size_t sub_changed = old_sub ? 0 : 1;
+		if (!project_delta(old_sub, ns->sdb, delta_sub, &sub_changed)) {
+			return false;
+		}
+		if (!sub_changed) {
+			sdb_ns_unset(delta, ns->name, NULL);
+		}
+		*changed += sub_changed;
+	}
+	return !old || ls_length(old->ns) == matched;
+}
+
+/**
+ * \brief Append the records of \p prj that changed since \p snap was saved to \p file
+ * \return false if the file has to be saved in full instead, true if \p snap took ownership of \p prj
+ */
+static bool project_append(RzProjectSnapshot *snap, const char *file, RzProject *prj) {
+	if (!snapshot_matches(snap, file) || snap->size - snap->base_size > snap->base_size) {
+		// written by someone else or too many changes appended already, compact it
+		return false;
+	}
+	Sdb *delta = sdb_new0();
+	if (!delta) {
+		return false;
+	}
+	size_t changed = 0;
+	if (!project_delta(snap->prj, prj, delta, &changed)) {
+		sdb_free(delta);
+		return false;
+	}
+	if (changed) {
+		int fd = rz_sys_open(file, O_WRONLY | O_APPEND | O_BINARY, 0644);
+		if (fd < 0) {
+			sdb_free(delta);
+			return false;
+		}
+		sdb_text_save_fd(delta, fd, false);
+		close(fd);
+	}
+	sdb_free(delta);
+	if (!snapshot_update(snap, prj)) {
+		// the next save cannot append without knowing the file's tail
+		snap->size = UT64_MAX;
+	}
+	return true;
+}
+
+static RzProjectErr project_save_file(RzCore *core, const char *file, bool compress, bool append) {
 	char *tmp_file = NULL;
 
 	if (compress) {
@@ -52,6 +217,7 @@ RZ_API RzProjectErr rz_project_save_file(RzCore *core, const char *file, bool co
 
 	RzProjectErr err;
 	const char *save_file = compress ? tmp_file : file;
+	char *abs_file = NULL;
 	RzProject *prj = sdb_new0();
 	if (!prj) {
 		err = RZ_PROJECT_ERR_UNKNOWN;
@@ -62,9 +228,32 @@ RZ_API RzProjectErr rz_project_save_file(RzCore *core, const char *file, bool co
 		sdb_free(prj);
 		return err;
 	}
-	if (!sdb_text_save(prj, save_file, true)) {
+	bool binary = rz_config_get_b(core->config, "prj.binary");
+	if (!compress && !binary && rz_config_get_b(core->config, "prj.incremental")) {
+		abs_file = rz_file_abspath(file);
+	}
+	if (append && abs_file && core->prj_snapshot && project_append(core->prj_snapshot, abs_file, prj)) {
+		rz_config_set(core->config, "prj.file", file);
+		goto tmp_file_err;
+	}
+	RZ_FREE_CUSTOM(core->prj_snapshot, rz_project_snapshot_free);
+	if (!(binary ? sdb_bin_save(prj, save_file) : sdb_text_save(prj, save_file, true))) {
 		err = RZ_PROJECT_ERR_FILE;
 	}
+	if (err == RZ_PROJECT_ERR_SUCCESS && abs_file) {
+		RzProjectSnapshot *snap = RZ_NEW0(RzProjectSnapshot);
+		if (snap) {
+			snap->file = abs_file;
+			abs_file = NULL;
+			if (snapshot_update(snap, prj)) {
+				snap->base_size = snap->size;
+				core->prj_snapshot = snap;
+			} else {
+				rz_project_snapshot_free(snap);
+			}
+			prj = NULL;
+		}
+	}
 	sdb_free(prj);
 
 	if (err != RZ_PROJECT_ERR_SUCCESS) {
@@ -79,11 +268,34 @@ RZ_API RzProjectErr rz_project_save_file(RzCore *core, const char *file, bool co
 	rz_config_set(core->config, "prj.file", file);
 
 tmp_file_err:
+	free(abs_file);
 	rz_file_rm(tmp_file);
 	free(tmp_file);
 	return err;
 }
 
+/**
+ * \brief Save the project of \p core to \p file
+ *
+ * If prj.incremental is set and \p file was last saved uncompressed by this core, only the records
+ * that changed since are appended to it. Anything removed, a file changed by others or appended
+ * records growing larger than the last full save make it save the whole project again.
+ * If prj.binary is set, the project is written in the binary sdb format instead, which is
+ * always saved whole but loads without parsing any text.
+ */
+RZ_API RzProjectErr rz_project_save_file(RzCore *core, const char *file, bool compress) {
+	rz_return_val_if_fail(core && file, RZ_PROJECT_ERR_UNKNOWN);
+	return project_save_file(core, file, compress, true);
+}
+
+/**
+ * \brief Save the whole project of \p core to \p file, compacting any changes appended by incremental saves
+ */
+RZ_API RzProjectErr rz_project_save_file_full(RzCore *core, const char *file, bool compress) {
+	rz_return_val_if_fail(core && file, RZ_PROJECT_ERR_UNKNOWN);
+	return project_save_file(core, file, compress, false);
+}
+
 /// Load a file into an RzProject but don't actually migrate anything or load it into an RzCore
 RZ_API RzProject *rz_project_load_file_raw(const char *file) {
 	RzProject *prj = sdb_new0();
@@ -115,7 +327,8 @@ RZ_API RzProject *rz_project_load_file_raw(const char *file) {
 		load_file = file;
 	}
 
-	if (!sdb_text_load(prj, load_file)) {
+	bool loaded = sdb_bin_check_file(load_file) ? sdb_bin_load(prj, load_file) : sdb_text_load(prj, load_file);
+	if (!loaded) {
 		sdb_free(prj);
 		prj = NULL;
 	}
@@ -3,6 +3,7 @@
 
 #include <rz_util/rz_serialize.h>
 #include <rz_core.h>
+#include <sys/stat.h>
 
 /*
  * SDB Format:
@@ -12,6 +13,7 @@
  *   /flags => see flag.c
  *   /analysis => see analysis.c
  *   /file => see below
+ *   /hashes => see below, only if the file was hashed by phm
  *   offset=<offset>
  *   blocksize=<blocksize>
  */
@@ -19,6 +21,8 @@
 static void file_save(RZ_NONNULL Sdb *db, RZ_NONNULL RzCore *core, RZ_NULLABLE const char *prj_file);
 static bool file_load(RZ_NONNULL Sdb *db, RZ_NONNULL RzCore *core, RZ_NULLABLE const char *prj_file,
 	RZ_NULLABLE RzSerializeResultInfo *res);
+static void hashes_save(RZ_NONNULL Sdb *db, RZ_NONNULL RzCore *core);
+static bool hashes_load(RZ_NONNULL Sdb *db, RZ_NONNULL RzCore *core, RZ_NULLABLE RzSerializeResultInfo *res);
 
 RZ_API void rz_serialize_core_save(RZ_NONNULL Sdb *db, RZ_NONNULL RzCore *core, RZ_NULLABLE const char *prj_file) {
 	file_save(sdb_ns(db, "file", true), core, prj_file);
@@ -26,6 +30,9 @@ RZ_API void rz_serialize_core_save(RZ_NONNULL Sdb *db, RZ_NONNULL RzCore *core,
 	rz_serialize_flag_save(sdb_ns(db, "flags", true), core->flags);
 	rz_serialize_analysis_save(sdb_ns(db, "analysis", true), core->analysis);
 	rz_serialize_debug_save(sdb_ns(db, "debug", true), core->dbg);
+	if (core->hash_index) {
+		hashes_save(sdb_ns(db, "hashes", true), core);
+	}
 
 	char buf[0x20];
 	if (snprintf(buf, sizeof(buf), "0x%" PFMT64x, core->offset) < 0) {
@@ -80,6 +87,13 @@ RZ_API bool rz_serialize_core_load(RZ_NONNULL Sdb *db, RZ_NONNULL RzCore *core,
 	SUB("analysis", rz_serialize_analysis_load(subdb, core->analysis, res));
 	SUB("debug", rz_serialize_debug_load(subdb, core->dbg, res));
 
+	RZ_FREE_CUSTOM(core->hash_index, rz_hash_block_index_free);
+	subdb = sdb_ns(db, "hashes", false);
+	if (subdb && core->io->desc) {
+		// the index is only a cache, without it the next phm hashes the whole file again
+		hashes_load(subdb, core, res);
+	}
+
 	const char *str = sdb_const_get(db, "offset", 0);
 	if (!str || !*str) {
 		RZ_SERIALIZE_ERR(res, "missing offset in core");
@@ -256,3 +270,120 @@ static bool file_load(RZ_NONNULL Sdb *db, RZ_NONNULL RzCore *core, RZ_NULLABLE c
 	RZ_SERIALIZE_ERR(res, "failed to re-locate file referenced by project");
 	return false;
 }
+
+/*
+ * SDB Format:
+ *
+ * /hashes
+ *   algo=<name of the plugin>
+ *   size=<size of the indexed data:uint>
+ *   block_size=<block size:uint>
+ *   blocks=<hex digest of each block, empty for the dirty ones, separated by ",">
+ *   mtime=<modification time of the file when saved:uint>
+ *   inode=<inode of the file when saved:uint>
+ */
+
+static bool file_identity(RzCore *core, ut64 *mtime, ut64 *inode) {
+	RzIODesc *desc = core->io->desc;
+	struct stat st;
+	if (!desc || !desc->name || stat(desc->name, &st) == -1) {
+		return false;
+	}
+	*mtime = (ut64)st.st_mtime;
+	*inode = (ut64)st.st_ino;
+	return true;
+}
+
+static void hashes_save(RZ_NONNULL Sdb *db, RZ_NONNULL RzCore *core) {
+	RzHashBlockIndex *index = core->hash_index;
+	sdb_set(db, "algo", index->plugin->name, 0);
+	sdb_num_set(db, "size", index->size, 0);
+	sdb_num_set(db, "block_size", index->block_size, 0);
+	ut64 mtime, inode;
+	if (file_identity(core, &mtime, &inode)) {
+		sdb_num_set(db, "mtime", mtime, 0);
+		sdb_num_set(db, "inode", inode, 0);
+	}
+	char *hex = malloc(index->digest_size * 2 + 1);
+	if (!hex) {
+		return;
+	}
+	RzStrBuf sb;
+	rz_strbuf_init(&sb);
+	for (ut64 i = 0; i < index->blocks_count; i++) {
+		if (i) {
+			rz_strbuf_append(&sb, ",");
+		}
+		if (!index->dirty[i]) {
+			rz_hex_bin2str(rz_hash_block_index_block(index, i), index->digest_size, hex);
+			rz_strbuf_append(&sb, hex);
+		}
+	}
+	free(hex);
+	sdb_set(db, "blocks", rz_strbuf_get(&sb), 0);
+	rz_strbuf_fini(&sb);
+}
+
+static bool hashes_load(RZ_NONNULL Sdb *db, RZ_NONNULL RzCore *core, RZ_NULLABLE RzSerializeResultInfo *res) {
+	const char *algo = sdb_const_get(db, "algo", 0);
+	const char *blocks = sdb_const_get(db, "blocks", 0);
+	const char *size = sdb_const_get(db, "size", 0);
+	const char *block_size = sdb_const_get(db, "block_size", 0);
+	if (!algo || !blocks || !size || !block_size) {
+		RZ_SERIALIZE_ERR(res, "missing algo, size, block_size or blocks in hashes");
+		return false;
+	}
+	RzHashBlockIndex *index = rz_hash_block_index_new(core->hash, algo, strtoull(size, NULL, 0), strtoull(block_size, NULL, 0));
+	if (!index) {
+		RZ_SERIALIZE_ERR(res, "cannot create the block index of hashes");
+		return false;
+	}
+	ut8 *digests = RZ_NEWS0(ut8, index->blocks_count * index->digest_size);
+	ut8 *dirty = RZ_NEWS0(ut8, index->blocks_count);
+	if (!digests || !dirty) {
+		goto fail;
+	}
+	const char *p = blocks;
+	for (ut64 i = 0; i < index->blocks_count; i++) {
+		const char *end = strchr(p, ',');
+		size_t len = end ? end - p : strlen(p);
+		if (len) {
+			char *hex = len == index->digest_size * 2 ? rz_str_ndup(p, len) : NULL;
+			int n = hex ? rz_hex_str2bin(hex, digests + i * index->digest_size) : 0;
+			free(hex);
+			if (n != index->digest_size) {
+				RZ_SERIALIZE_ERR(res, "invalid digest of the block %" PFMT64u " in hashes", i);
+				goto fail;
+			}
+		} else {
+			dirty[i] = 1;
+		}
+		if (!end != (i + 1 == index->blocks_count)) {
+			RZ_SERIALIZE_ERR(res, "wrong number of blocks in hashes");
+			goto fail;
+		}
+		p = end + 1;
+	}
+	// a file modified after the save may keep its size, so its digests are trusted
+	// only if it is still the same file, otherwise the next phm hashes it again
+	ut64 mtime, inode;
+	if (!file_identity(core, &mtime, &inode) ||
+		mtime != sdb_num_get(db, "mtime", 0) || inode != sdb_num_get(db, "inode", 0)) {
+		memset(dirty, 1, index->blocks_count);
+	}
+	if (!rz_hash_block_index_restore(index, digests, dirty)) {
+		RZ_SERIALIZE_ERR(res, "cannot compute the tree of the block index of hashes");
+		goto fail;
+	}
+	free(digests);
+	free(dirty);
+	core->hash_index = index;
+	core->hash_index_fd = core->io->desc->fd;
+	return true;
+
+fail:
+	free(digests);
+	free(dirty);
+	rz_hash_block_index_free(index);
+	return false;
+}
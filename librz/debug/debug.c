@@ -604,6 +604,9 @@ RZ_API bool rz_debug_select(RzDebug *dbg, int pid, int tid) {
 	if (dbg->cur && dbg->cur->select && !dbg->cur->select(dbg, pid, tid)) {
 		return false;
 	}
+	if (dbg->iob.page_cache_invalidate) {
+		dbg->iob.page_cache_invalidate(dbg->iob.io, -1);
+	}
 
 	// Don't change the pid/tid if the plugin already modified it due to internal constraints
 	if (dbg->pid == prev_pid) {
@@ -693,6 +696,10 @@ RZ_API RzDebugReasonType rz_debug_wait(RzDebug *dbg, RzBreakpointItem **bp) {
 	/* if our debugger plugin has wait */
 	if (dbg->cur && dbg->cur->wait) {
 		reason = dbg->cur->wait(dbg, dbg->pid);
+		// the memory of the debuggee may have changed
+		if (dbg->iob.page_cache_invalidate) {
+			dbg->iob.page_cache_invalidate(dbg->iob.io, -1);
+		}
 		if (reason == RZ_DEBUG_REASON_DEAD) {
 			eprintf("\n==> Process finished\n\n");
 			RzEventDebugProcessFinished event = {
@@ -4,9 +4,10 @@
 #include <rz_debug.h>
 #include <rz_util/rz_json.h>
 
-#define CMP_CNUM_REG(x, y)   ((x) >= ((RzDebugChangeReg *)y)->cnum ? 1 : -1)
-#define CMP_CNUM_MEM(x, y)   ((x) >= ((RzDebugChangeMem *)y)->cnum ? 1 : -1)
-#define CMP_CNUM_CHKPT(x, y) ((x) >= ((RzDebugCheckpoint *)y)->cnum ? 1 : -1)
+#define CMP_CNUM_REG(x, y)     ((x) >= ((RzDebugChangeReg *)y)->cnum ? 1 : -1)
+#define CMP_CNUM_MEM(x, y)     ((x) >= ((RzDebugChangeMem *)y)->cnum ? 1 : -1)
+#define CMP_CNUM_CHKPT(x, y)   ((x) >= ((RzDebugCheckpoint *)y)->cnum ? 1 : -1)
+#define SESSION_FORMAT_VERSION 2
 
 RZ_API void rz_debug_session_free(RzDebugSession *session) {
 	if (session) {
@@ -30,6 +31,56 @@ static void htup_vector_free(HtUPKv *kv) {
 	rz_vector_free(kv->value);
 }
 
+static void mem_page_free(RzDebugChangeMemPage *page) {
+	if (!page) {
+		return;
+	}
+	rz_vector_fini(&page->changes);
+	rz_vector_fini(&page->bytes);
+	free(page);
+}
+
+static void htup_mem_page_free(HtUPKv *kv) {
+	mem_page_free(kv->value);
+}
+
+static RzDebugChangeMemPage *mem_page_get(HtUP *memory, ut64 page_addr) {
+	RzDebugChangeMemPage *page = ht_up_find(memory, page_addr, NULL);
+	if (page) {
+		return page;
+	}
+	page = RZ_NEW0(RzDebugChangeMemPage);
+	if (!page) {
+		return NULL;
+	}
+	rz_vector_init(&page->changes, sizeof(RzDebugChangeMem), NULL, NULL);
+	rz_vector_init(&page->bytes, sizeof(ut8), NULL, NULL);
+	if (!ht_up_insert(memory, page_addr, page)) {
+		mem_page_free(page);
+		return NULL;
+	}
+	return page;
+}
+
+static bool mem_page_add_change(RzDebugChangeMemPage *page, int cnum, ut16 offset, const ut8 *data, ut16 size) {
+	size_t start = rz_vector_len(&page->bytes);
+	if (!rz_vector_insert_range(&page->bytes, start, (void *)data, size)) {
+		return false;
+	}
+	RzDebugChangeMem *last = rz_vector_empty(&page->changes) ? NULL : rz_vector_tail(&page->changes);
+	if (last && last->cnum == cnum && last->offset + last->size == offset && last->data + last->size == start) {
+		// bytes following the previous change of the same step
+		last->size += size;
+		return true;
+	}
+	RzDebugChangeMem mem = { cnum, offset, size, (ut32)start };
+	if (!rz_vector_push(&page->changes, &mem)) {
+		rz_vector_remove_range(&page->bytes, start, size, NULL);
+		return false;
+	}
+	return true;
+}
+
 RZ_API RzDebugSession *rz_debug_session_new(void) {
 	RzDebugSession *session = RZ_NEW0(RzDebugSession);
 	if (!session) {
@@ -46,7 +97,7 @@ RZ_API RzDebugSession *rz_debug_session_new(void) {
 		rz_debug_session_free(session);
 		return NULL;
 	}
-	session->memory = ht_up_new(NULL, htup_vector_free, NULL);
+	session->memory = ht_up_new(NULL, htup_mem_page_free, NULL);
 	if (!session->memory) {
 		rz_debug_session_free(session);
 		return NULL;
@@ -141,16 +192,34 @@ static void _set_initial_memory(RzDebug *dbg) {
 }
 
 static bool _restore_memory_cb(void *user, const ut64 key, const void *value) {
-	size_t index;
 	RzDebug *dbg = user;
-	RzVector *vmem = (RzVector *)value;
-
-	rz_vector_upper_bound(vmem, dbg->session->cnum, index, CMP_CNUM_MEM);
-	if (index > 0 && index <= vmem->len) {
-		RzDebugChangeMem *mem = rz_vector_index_ptr(vmem, index - 1);
-		if (mem->cnum > dbg->session->cur_chkpt->cnum) {
-			dbg->iob.write_at(dbg->iob.io, key, &mem->data, 1);
+	RzDebugChangeMemPage *page = (RzDebugChangeMemPage *)value;
+	ut8 buf[RZ_DEBUG_SESSION_PAGE_SIZE];
+	bool changed[RZ_DEBUG_SESSION_PAGE_SIZE] = { 0 };
+	size_t from, to, i;
+
+	// replay the changes made after the checkpoint, up to cnum
+	rz_vector_upper_bound(&page->changes, dbg->session->cur_chkpt->cnum, from, CMP_CNUM_MEM);
+	rz_vector_upper_bound(&page->changes, dbg->session->cnum, to, CMP_CNUM_MEM);
+	if (from >= to) {
+		return true;
+	}
+	for (i = from; i < to; i++) {
+		RzDebugChangeMem *mem = rz_vector_index_ptr(&page->changes, i);
+		memcpy(buf + mem->offset, rz_vector_index_ptr(&page->bytes, mem->data), mem->size);
+		memset(changed + mem->offset, true, mem->size);
+	}
+	for (i = 0; i < RZ_DEBUG_SESSION_PAGE_SIZE;) {
+		if (!changed[i]) {
+			i++;
+			continue;
 		}
+		size_t end = i + 1;
+		while (end < RZ_DEBUG_SESSION_PAGE_SIZE && changed[end]) {
+			end++;
+		}
+		dbg->iob.write_at(dbg->iob.io, key + i, buf + i, (int)(end - i));
+		i = end;
 	}
 	return true;
 }
@@ -231,17 +300,30 @@ RZ_API bool rz_debug_session_add_reg_change(RzDebugSession *session, int arena,
 }
 
 RZ_API bool rz_debug_session_add_mem_change(RzDebugSession *session, ut64 addr, ut8 data) {
-	RzVector *vmem = ht_up_find(session->memory, addr, NULL);
-	if (!vmem) {
-		vmem = rz_vector_new(sizeof(RzDebugChangeMem), NULL, NULL);
-		if (!vmem) {
-			eprintf("Error: creating a memory vector.\n");
+	return rz_debug_session_add_mem_range_change(session, addr, &data, 1);
+}
+
+/**
+ * \brief Records that \p size bytes were written at \p addr during the current step
+ *
+ * The changes are journaled per page of RZ_DEBUG_SESSION_PAGE_SIZE bytes and
+ * consecutive writes of the same step are merged in a single change.
+ */
+RZ_API bool rz_debug_session_add_mem_range_change(RZ_NONNULL RzDebugSession *session, ut64 addr, RZ_NONNULL const ut8 *data, ut64 size) {
+	rz_return_val_if_fail(session && data, false);
+	while (size) {
+		ut64 page_addr = addr & ~(ut64)(RZ_DEBUG_SESSION_PAGE_SIZE - 1);
+		ut16 offset = addr - page_addr;
+		ut16 chunk = RZ_MIN(size, RZ_DEBUG_SESSION_PAGE_SIZE - offset);
+		RzDebugChangeMemPage *page = mem_page_get(session->memory, page_addr);
+		if (!page || !mem_page_add_change(page, session->cnum, offset, data, chunk)) {
+			RZ_LOG_ERROR("debug: cannot record the memory change at 0x%" PFMT64x "\n", addr);
 			return false;
 		}
-		ht_up_insert(session->memory, addr, vmem);
+		addr += chunk;
+		data += chunk;
+		size -= chunk;
 	}
-	RzDebugChangeMem mem = { session->cnum, data };
-	rz_vector_push(vmem, &mem);
 	return true;
 }
 
@@ -274,21 +356,28 @@ static void serialize_registers(Sdb *db, HtUP *registers) {
 	ht_up_foreach(registers, serialize_register_cb, db);
 }
 
-// 0x<addr>={"size":<size_t>, "a":[<RzDebugChangeMem>]}},
+// 0x<page>=[<RzDebugChangeMem>]
 static bool serialize_memory_cb(void *db, const ut64 k, const void *v) {
 	RzDebugChangeMem *mem;
-	RzVector *vmem = (RzVector *)v;
+	RzDebugChangeMemPage *page = (RzDebugChangeMemPage *)v;
 	PJ *j = pj_new();
 	if (!j) {
 		return false;
 	}
 	pj_a(j);
 
-	rz_vector_foreach(vmem, mem) {
+	rz_vector_foreach(&page->changes, mem) {
+		char *edata = sdb_encode(rz_vector_index_ptr(&page->bytes, mem->data), mem->size);
+		if (!edata) {
+			pj_free(j);
+			return false;
+		}
 		pj_o(j);
 		pj_kN(j, "cnum", mem->cnum);
-		pj_kn(j, "data", mem->data);
+		pj_kn(j, "offset", mem->offset);
+		pj_ks(j, "data", edata);
 		pj_end(j);
+		free(edata);
 	}
 
 	pj_end(j);
@@ -369,13 +458,14 @@ static void serialize_checkpoints(Sdb *db, RzVector /*<RzDebugCheckpoint>*/ *che
  * SDB Format:
  *
  * /
+ *   version=<SESSION_FORMAT_VERSION>
  *   maxcnum=<maxcnum>
  *
  *   /registers
  *     0x<addr>={"size":<size_t>, "a":[<RzDebugChangeReg>]}
  *
  *   /memory
- *     0x<addr>={"size":<size_t>, "a":[<RzDebugChangeMem>]}
+ *     0x<page>=[<RzDebugChangeMem>]
  *
  *   /checkpoints
  *     0x<cnum>={
@@ -387,7 +477,11 @@ static void serialize_checkpoints(Sdb *db, RzVector /*<RzDebugCheckpoint>*/ *che
  * {"cnum":<int>, "data":<ut64>}
  *
  * RzDebugChangeMem JSON:
- * {"cnum":<int>, "data":<ut8>}
+ * {"cnum":<int>, "offset":<ut16>, "data":"<base64>"}
+ *
+ * Sessions without version (1) have one memory entry per byte:
+ *     0x<addr>=[{"cnum":<int>, "data":<ut8>}]
+ * and are converted to pages when loaded.
  *
  * RzRegArena JSON:
  * {"size":<int>, "bytes":"<base64>"}
@@ -400,6 +494,7 @@ static void serialize_checkpoints(Sdb *db, RzVector /*<RzDebugCheckpoint>*/ *che
  * - This mostly follows rz-db-style serialization
  */
 RZ_API void rz_debug_session_serialize(RzDebugSession *session, Sdb *db) {
+	sdb_num_set(db, "version", SESSION_FORMAT_VERSION, 0);
 	sdb_num_set(db, "maxcnum", session->maxcnum, 0);
 	serialize_registers(sdb_ns(db, "registers", true), session->registers);
 	serialize_memory(sdb_ns(db, "memory", true), session->memory);
@@ -474,17 +569,15 @@ static bool deserialize_memory_cb(void *user, const char *addr, const char *v) {
 	}
 
 	HtUP *memory = user;
-	// Insert a new vector into `memory` HtUP at `addr`
-	RzVector *vmem = rz_vector_new(sizeof(RzDebugChangeMem), NULL, NULL);
-	if (!vmem) {
-		eprintf("Error: failed to allocate RzVector vmem.\n");
+	RzDebugChangeMemPage *page = mem_page_get(memory, sdb_atoi(addr));
+	if (!page) {
+		eprintf("Error: failed to allocate RzDebugChangeMemPage page.\n");
 		free(json_str);
 		rz_json_free(reg_json);
 		return false;
 	}
-	ht_up_insert(memory, sdb_atoi(addr), vmem);
 
-	// Extract <RzDebugChangeMem>'s into the new vector
+	// Extract <RzDebugChangeMem>'s into the page
 	for (child = reg_json->children.first; child; child = child->next) {
 		if (child->type != RZ_JSON_OBJECT) {
 			continue;
@@ -493,12 +586,18 @@ static bool deserialize_memory_cb(void *user, const char *addr, const char *v) {
 		CHECK_TYPE(baby, RZ_JSON_INTEGER);
 		int cnum = baby->num.s_value;
 
-		baby = rz_json_get(child, "data");
+		baby = rz_json_get(child, "offset");
 		CHECK_TYPE(baby, RZ_JSON_INTEGER);
-		ut64 data = baby->num.u_value;
+		ut64 offset = baby->num.u_value;
 
-		RzDebugChangeMem mem = { cnum, data };
-		rz_vector_push(vmem, &mem);
+		baby = rz_json_get(child, "data");
+		CHECK_TYPE(baby, RZ_JSON_STRING);
+		int size = 0;
+		ut8 *data = sdb_decode(baby->str_value, &size);
+		if (data && size > 0 && offset + size <= RZ_DEBUG_SESSION_PAGE_SIZE) {
+			mem_page_add_change(page, cnum, offset, data, size);
+		}
+		free(data);
 	}
 
 	free(json_str);
@@ -510,6 +609,90 @@ static void deserialize_memory(Sdb *db, HtUP *memory) {
 	sdb_foreach(db, deserialize_memory_cb, memory);
 }
 
+typedef struct {
+	ut64 addr;
+	int cnum;
+	ut32 seq; ///< order of the change among the ones of its byte
+	ut8 data;
+} SessionMemByte;
+
+static bool deserialize_memory_v1_cb(void *user, const char *addr, const char *v) {
+	RzVector *bytes = user;
+	char *json_str = strdup(v);
+	if (!json_str) {
+		return false;
+	}
+	RzJson *mem_json = rz_json_parse(json_str);
+	if (!mem_json || mem_json->type != RZ_JSON_ARRAY) {
+		free(json_str);
+		rz_json_free(mem_json);
+		return true;
+	}
+	ut32 seq = 0;
+	for (RzJson *child = mem_json->children.first; child; child = child->next) {
+		if (child->type != RZ_JSON_OBJECT) {
+			continue;
+		}
+		const RzJson *baby = rz_json_get(child, "cnum");
+		CHECK_TYPE(baby, RZ_JSON_INTEGER);
+		int cnum = baby->num.s_value;
+
+		baby = rz_json_get(child, "data");
+		CHECK_TYPE(baby, RZ_JSON_INTEGER);
+		SessionMemByte byte = { sdb_atoi(addr), cnum, seq++, baby->num.u_value };
+		if (!rz_vector_push(bytes, &byte)) {
+			free(json_str);
+			rz_json_free(mem_json);
+			return false;
+		}
+	}
+	free(json_str);
+	rz_json_free(mem_json);
+	return true;
+}
+
+static int session_mem_byte_cmp(const void *a, const void *b) {
+	const SessionMemByte *x = a, *y = b;
+	const ut64 page_mask = ~(ut64)(RZ_DEBUG_SESSION_PAGE_SIZE - 1);
+	if ((x->addr & page_mask) != (y->addr & page_mask)) {
+		return (x->addr & page_mask) < (y->addr & page_mask) ? -1 : 1;
+	}
+	if (x->cnum != y->cnum) {
+		return x->cnum < y->cnum ? -1 : 1;
+	}
+	if (x->addr != y->addr) {
+		return x->addr < y->addr ? -1 : 1;
+	}
+	return x->seq < y->seq ? -1 : (x->seq > y->seq);
+}
+
+/**
+ * Converts the per-byte memory changes of a version 1 session into pages: the
+ * changes of each page are added sorted by cnum, like they were recorded.
+ */
+static bool deserialize_memory_v1(Sdb *db, HtUP *memory) {
+	RzVector bytes;
+	rz_vector_init(&bytes, sizeof(SessionMemByte), NULL, NULL);
+	bool ret = sdb_foreach(db, deserialize_memory_v1_cb, &bytes);
+	if (!rz_vector_empty(&bytes)) {
+		rz_vector_sort(&bytes, session_mem_byte_cmp, false);
+	}
+	SessionMemByte *byte;
+	rz_vector_foreach(&bytes, byte) {
+		if (!ret) {
+			break;
+		}
+		ut64 page_addr = byte->addr & ~(ut64)(RZ_DEBUG_SESSION_PAGE_SIZE - 1);
+		RzDebugChangeMemPage *page = mem_page_get(memory, page_addr);
+		ret = page && mem_page_add_change(page, byte->cnum, byte->addr - page_addr, &byte->data, 1);
+	}
+	rz_vector_fini(&bytes);
+	if (!ret) {
+		RZ_LOG_ERROR("debug: cannot convert the memory changes of the session\n");
+	}
+	return ret;
+}
+
 static bool deserialize_registers_cb(void *user, const char *addr, const char *v) {
 	RzJson *child;
 	char *json_str = strdup(v);
@@ -704,9 +887,27 @@ error:
 	return NULL;
 }
 
-RZ_API void rz_debug_session_deserialize(RzDebugSession *session, Sdb *db) {
+/**
+ * \brief Loads into \p session the session serialized in \p db
+ *
+ * Sessions saved by older versions are converted, the ones saved by newer
+ * versions are refused.
+ *
+ * \return false if \p db cannot be loaded
+ */
+RZ_API bool rz_debug_session_deserialize(RzDebugSession *session, Sdb *db) {
 	Sdb *subdb;
 
+	ut64 version = sdb_num_get(db, "version", 0);
+	if (!version) {
+		// saved before the format had a version
+		version = 1;
+	}
+	if (version > SESSION_FORMAT_VERSION) {
+		RZ_LOG_ERROR("debug: the session format version %" PFMT64u " is newer than the supported one (%d)\n",
+			version, SESSION_FORMAT_VERSION);
+		return false;
+	}
 	session->maxcnum = sdb_num_get(db, "maxcnum", 0);
 
 #define DESERIALIZE(ns, func) \
@@ -714,14 +915,19 @@ RZ_API void rz_debug_session_deserialize(RzDebugSession *session, Sdb *db) {
 		subdb = sdb_ns(db, ns, false); \
 		if (!subdb) { \
 			eprintf("Error: missing " ns " namespace\n"); \
-			return; \
+			return false; \
 		} \
 		func; \
 	} while (0)
 
-	DESERIALIZE("memory", deserialize_memory(subdb, session->memory));
+	if (version == 1) {
+		DESERIALIZE("memory", if (!deserialize_memory_v1(subdb, session->memory)) { return false; });
+	} else {
+		DESERIALIZE("memory", deserialize_memory(subdb, session->memory));
+	}
 	DESERIALIZE("registers", deserialize_registers(subdb, session->registers));
 	DESERIALIZE("checkpoints", deserialize_checkpoints(subdb, session->checkpoints));
+	return true;
 }
 
 RZ_API bool rz_debug_session_load(RzDebug *dbg, const char *path) {
@@ -729,7 +935,10 @@ RZ_API bool rz_debug_session_load(RzDebug *dbg, const char *path) {
 	if (!db) {
 		return false;
 	}
-	rz_debug_session_deserialize(dbg->session, db);
+	if (!rz_debug_session_deserialize(dbg->session, db)) {
+		sdb_free(db);
+		return false;
+	}
 	// Restore debugger to the beginning of the session
 	rz_debug_session_restore_reg_mem(dbg, 0);
 	sdb_free(db);
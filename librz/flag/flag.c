@@ -812,7 +812,23 @@ RZ_API void rz_flag_foreach_prefix(RzFlag *f, const char *pfx, int pfx_len, RzFl
  */
 RZ_API void rz_flag_foreach_range(RZ_NONNULL RzFlag *f, ut64 from, ut64 to, RzFlagItemCb cb, void *user) {
 	rz_return_if_fail(f);
-	FOREACH_BODY(fi->offset >= from && fi->offset <= to);
+	// only walk the offsets in the range instead of all flags
+	RzFlagsAtOffset key = { .off = from };
+	RzSkipListNode *it = rz_skiplist_find_geq(f->by_off, &key), *tmp;
+	RzListIter *it2, *tmp2;
+	RzFlagItem *fi;
+	for (; it && it != f->by_off->head; it = tmp) {
+		RzFlagsAtOffset *flags_at = it->data;
+		if (flags_at->off > to) {
+			break;
+		}
+		tmp = it->forward[0];
+		rz_list_foreach_safe (flags_at->flags, it2, tmp2, fi) {
+			if (fi->offset >= from && fi->offset <= to && !cb(fi, user)) {
+				return;
+			}
+		}
+	}
 }
 
 RZ_API void rz_flag_foreach_glob(RzFlag *f, const char *glob, RzFlagItemCb cb, void *user) {
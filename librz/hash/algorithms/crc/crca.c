@@ -4,6 +4,37 @@
 // some definitions and test cases borrowed from http://www.nightmare.com/~ryb/code/CrcMoose.py (Ray Burr)
 
 #include "crca.h"
+#include <rz_endian.h>
+#include <rz_th.h>
+#include <rz_constructor.h>
+
+/* bytes that are cheaper to process bit by bit than generating the tables */
+#define CRC_TABLE_THRESHOLD 256
+
+typedef utcrc RzCrcTable[CRC_TABLE_SLICES][256];
+
+/* slicing-by-8 tables of each preset, generated the first time a context needs them */
+static RzCrcTable *crc_tables[CRC_PRESET_SIZE] = { 0 };
+static RzThreadLock *crc_tables_lock = NULL;
+
+#ifdef RZ_DEFINE_CONSTRUCTOR_NEEDS_PRAGMA
+#pragma RZ_DEFINE_CONSTRUCTOR_PRAGMA_ARGS(crc_tables_init)
+#endif
+RZ_DEFINE_CONSTRUCTOR(crc_tables_init)
+static void crc_tables_init(void) {
+	crc_tables_lock = rz_th_lock_new(false);
+}
+
+#ifdef RZ_DEFINE_DESTRUCTOR_NEEDS_PRAGMA
+#pragma RZ_DEFINE_DESTRUCTOR_PRAGMA_ARGS(crc_tables_fini)
+#endif
+RZ_DEFINE_DESTRUCTOR(crc_tables_fini)
+static void crc_tables_fini(void) {
+	for (size_t i = 0; i < CRC_PRESET_SIZE; i++) {
+		RZ_FREE(crc_tables[i]);
+	}
+	RZ_FREE_CUSTOM(crc_tables_lock, rz_th_lock_free);
+}
 
 void crc_init_custom(RzCrc *ctx, utcrc crc, ut32 size, int reflect, utcrc poly, utcrc xout) {
 	ctx->crc = crc;
@@ -11,9 +42,113 @@ void crc_init_custom(RzCrc *ctx, utcrc crc, ut32 size, int reflect, utcrc poly,
 	ctx->reflect = reflect;
 	ctx->poly = poly;
 	ctx->xout = xout;
+	ctx->bitwise = 0;
+	ctx->preset = CRC_PRESET_SIZE;
+	ctx->table = NULL;
 }
 
-void crc_update(RzCrc *ctx, const ut8 *data, ut32 sz) {
+static inline utcrc crc_mask(ut32 size) {
+	return (((UTCRC_C(1) << (size - 1)) - 1) << 1) | 1;
+}
+
+/* reverses the lowest size bits of x */
+static utcrc crc_reflect(utcrc x, ut32 size) {
+	x = ((x >> 1) & UTCRC_C(0x5555555555555555)) | ((x & UTCRC_C(0x5555555555555555)) << 1);
+	x = ((x >> 2) & UTCRC_C(0x3333333333333333)) | ((x & UTCRC_C(0x3333333333333333)) << 2);
+	x = ((x >> 4) & UTCRC_C(0x0F0F0F0F0F0F0F0F)) | ((x & UTCRC_C(0x0F0F0F0F0F0F0F0F)) << 4);
+	x = rz_swap_ut64(x);
+	return x >> (64 - size);
+}
+
+/*
+ * Non-reflected crcs are computed left-aligned in the 64 bits and reflected
+ * ones right-aligned with the reflected polynomial, so that in both cases the
+ * next input byte is xored with the register bits that leave it first.
+ */
+static void crc_table_generate(const RzCrc *ctx, utcrc (*t)[256]) {
+	if (ctx->reflect) {
+		utcrc poly = crc_reflect(ctx->poly & crc_mask(ctx->size), ctx->size);
+		for (int b = 0; b < 256; b++) {
+			utcrc crc = b;
+			for (int j = 0; j < 8; j++) {
+				crc = (crc & 1 ? poly : 0) ^ (crc >> 1);
+			}
+			t[0][b] = crc;
+		}
+		for (int i = 1; i < CRC_TABLE_SLICES; i++) {
+			for (int b = 0; b < 256; b++) {
+				t[i][b] = (t[i - 1][b] >> 8) ^ t[0][t[i - 1][b] & 0xff];
+			}
+		}
+	} else {
+		utcrc poly = ctx->poly << (64 - ctx->size);
+		for (int b = 0; b < 256; b++) {
+			utcrc crc = (utcrc)b << 56;
+			for (int j = 0; j < 8; j++) {
+				crc = (crc >> 63 ? poly : 0) ^ (crc << 1);
+			}
+			t[0][b] = crc;
+		}
+		for (int i = 1; i < CRC_TABLE_SLICES; i++) {
+			for (int b = 0; b < 256; b++) {
+				t[i][b] = (t[i - 1][b] << 8) ^ t[0][t[i - 1][b] >> 56];
+			}
+		}
+	}
+}
+
+/* returns the shared tables of the preset of ctx, generating them once */
+static const utcrc (*crc_table_get(const RzCrc *ctx))[256] {
+	if (ctx->preset >= CRC_PRESET_SIZE || !crc_tables_lock) {
+		return NULL;
+	}
+	rz_th_lock_enter(crc_tables_lock);
+	RzCrcTable *table = crc_tables[ctx->preset];
+	if (!table) {
+		table = RZ_NEW(RzCrcTable);
+		if (table) {
+			crc_table_generate(ctx, *table);
+			crc_tables[ctx->preset] = table;
+		}
+	}
+	rz_th_lock_leave(crc_tables_lock);
+	return table ? (const utcrc(*)[256])(*table) : NULL;
+}
+
+static void crc_update_table(RzCrc *ctx, const ut8 *data, ut32 sz) {
+	const utcrc(*t)[256] = ctx->table;
+	utcrc crc;
+	if (ctx->reflect) {
+		crc = crc_reflect(ctx->crc & crc_mask(ctx->size), ctx->size);
+		for (; sz >= 8; sz -= 8, data += 8) {
+			crc ^= rz_read_le64(data);
+			crc = t[7][crc & 0xff] ^ t[6][(crc >> 8) & 0xff] ^
+				t[5][(crc >> 16) & 0xff] ^ t[4][(crc >> 24) & 0xff] ^
+				t[3][(crc >> 32) & 0xff] ^ t[2][(crc >> 40) & 0xff] ^
+				t[1][(crc >> 48) & 0xff] ^ t[0][crc >> 56];
+		}
+		for (; sz; sz--, data++) {
+			crc = t[0][(crc ^ *data) & 0xff] ^ (crc >> 8);
+		}
+		ctx->crc = crc_reflect(crc, ctx->size);
+	} else {
+		ut32 shift = 64 - ctx->size;
+		crc = (ctx->crc & crc_mask(ctx->size)) << shift;
+		for (; sz >= 8; sz -= 8, data += 8) {
+			crc ^= rz_read_be64(data);
+			crc = t[7][crc >> 56] ^ t[6][(crc >> 48) & 0xff] ^
+				t[5][(crc >> 40) & 0xff] ^ t[4][(crc >> 32) & 0xff] ^
+				t[3][(crc >> 24) & 0xff] ^ t[2][(crc >> 16) & 0xff] ^
+				t[1][(crc >> 8) & 0xff] ^ t[0][crc & 0xff];
+		}
+		for (; sz; sz--, data++) {
+			crc = t[0][(crc >> 56) ^ *data] ^ (crc << 8);
+		}
+		ctx->crc = crc >> shift;
+	}
+}
+
+static void crc_update_bitwise(RzCrc *ctx, const ut8 *data, ut32 sz) {
 	utcrc crc, d;
 	int i, j;
 
@@ -35,12 +170,24 @@ void crc_update(RzCrc *ctx, const ut8 *data, ut32 sz) {
 	ctx->crc = crc;
 }
 
+void crc_update(RzCrc *ctx, const ut8 *data, ut32 sz) {
+	if (!ctx->table) {
+		if (ctx->size < 8 || ctx->size > 64 || (sz < CRC_TABLE_THRESHOLD && ctx->bitwise < CRC_TABLE_THRESHOLD) ||
+			!(ctx->table = crc_table_get(ctx))) {
+			crc_update_bitwise(ctx, data, sz);
+			ctx->bitwise += RZ_MIN(sz, CRC_TABLE_THRESHOLD);
+			return;
+		}
+	}
+	crc_update_table(ctx, data, sz);
+}
+
 void crc_final(RzCrc *ctx, utcrc *r) {
 	utcrc crc;
 	int i;
 
 	crc = ctx->crc;
-	crc &= (((UTCRC_C(1) << (ctx->size - 1)) - 1) << 1) | 1;
+	crc &= crc_mask(ctx->size);
 	if (ctx->reflect) {
 		for (i = 0; i < (ctx->size >> 1); i++) {
 			if (((crc >> i) ^ (crc >> (ctx->size - 1 - i))) & 1) {
@@ -52,12 +199,20 @@ void crc_final(RzCrc *ctx, utcrc *r) {
 	*r = crc ^ ctx->xout;
 }
 
+typedef struct {
+	utcrc crc;
+	ut32 size;
+	int reflect;
+	utcrc poly;
+	utcrc xout;
+} RzCrcPreset;
+
 /* preset initializer to provide compatibility */
 #define CRC_PRESET(crc, size, reflect, poly, xout) \
 	{ UTCRC_C(crc), (size), (reflect), UTCRC_C(poly), UTCRC_C(xout) }
 
 /* NOTE: Run `rz-hash -a <algo> -s 123456789` to test CRC. */
-RzCrc crc_presets[] = {
+static const RzCrcPreset crc_presets[] = {
 	CRC_PRESET(0x00, 8, 0, 0x07, 0x00), // CRC-8-SMBUS, test vector for "1234567892: f4
 	CRC_PRESET(0xFF, 8, 0, 0x9B, 0x00), // CRC-8/CDMA2000,     test vector for "123456789": 0xda
 	CRC_PRESET(0x00, 8, 1, 0x39, 0x00), // CRC-8/DARC,         test vector for "123456789": 0x15
@@ -112,11 +267,9 @@ RzCrc crc_presets[] = {
 };
 
 void crc_init_preset(RzCrc *ctx, RzCrcPresets preset) {
-	ctx->crc = crc_presets[preset].crc;
-	ctx->size = crc_presets[preset].size;
-	ctx->reflect = crc_presets[preset].reflect;
-	ctx->poly = crc_presets[preset].poly;
-	ctx->xout = crc_presets[preset].xout;
+	const RzCrcPreset *p = &crc_presets[preset];
+	crc_init_custom(ctx, p->crc, p->size, p->reflect, p->poly, p->xout);
+	ctx->preset = preset;
 }
 
 utcrc rz_hash_crc_preset(const ut8 *data, ut32 size, RzCrcPresets preset) {
@@ -65,12 +65,17 @@ typedef enum {
 	CRC_PRESET_SIZE
 } RzCrcPresets;
 
+#define CRC_TABLE_SLICES 8
+
 typedef struct {
 	utcrc crc;
 	ut32 size;
 	int reflect;
 	utcrc poly;
 	utcrc xout;
+	ut32 bitwise; ///< bytes processed bit by bit, the table is used once this is worth it
+	RzCrcPresets preset; ///< CRC_PRESET_SIZE for custom parameters, which are always processed bit by bit
+	const utcrc (*table)[256]; ///< slicing-by-8 tables shared by all the contexts of the preset, NULL until used
 } RzCrc;
 
 void crc_init_preset(RzCrc *ctx, RzCrcPresets preset);
@@ -0,0 +1,336 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_hash.h>
+#include <rz_util.h>
+
+/*
+ * The digests of the blocks are the leaves of a binary tree, stored level by
+ * level in RzHashBlockIndex.digests. Each node is the digest of the
+ * concatenation of its two children; when a level has an odd number of nodes
+ * the last one is copied as is in the next level. The last node is the root.
+ */
+
+#define BLOCK_INDEX_BATCH_SIZE (16 * 1024 * 1024) ///< bytes read before hashing them in parallel
+
+typedef struct {
+	ut64 index;
+	const ut8 *data;
+	ut64 size;
+	bool failed;
+} BlockIndexJob;
+
+typedef struct {
+	RzHashBlockIndex *index;
+	RzThreadQueue *jobs;
+} BlockIndexCtx;
+
+static ut64 level_count(ut64 count) {
+	return (count + 1) / 2;
+}
+
+static ut8 *node_at(RzHashBlockIndex *index, ut64 level_start, ut64 i) {
+	return index->digests + (level_start + i) * index->digest_size;
+}
+
+static bool digest_block(const RzHashPlugin *plugin, void *context, const ut8 *a, ut64 a_size, const ut8 *b, ut64 b_size, ut8 *digest) {
+	return plugin->init(context) &&
+		plugin->update(context, a, a_size) &&
+		(!b_size || plugin->update(context, b, b_size)) &&
+		plugin->final(context, digest);
+}
+
+/**
+ * \brief Creates an index of the digests of the \p block_size blocks of \p size bytes
+ *
+ * All the blocks are dirty until rz_hash_block_index_update() is called.
+ *
+ * \param  rh          The RzHash containing the plugins
+ * \param  name        Name of the algorithm used for the blocks and the nodes of the tree
+ * \param  size        Size of the indexed data
+ * \param  block_size  Size of each block
+ */
+RZ_API RZ_OWN RzHashBlockIndex *rz_hash_block_index_new(RZ_NONNULL RzHash *rh, RZ_NONNULL const char *name, ut64 size, ut64 block_size) {
+	rz_return_val_if_fail(rh && name && block_size, NULL);
+	const RzHashPlugin *plugin = rz_hash_plugin_by_name(rh, name);
+	if (!plugin) {
+		RZ_LOG_ERROR("msg digest: '%s' does not exists.\n", name);
+		return NULL;
+	}
+	RzHashBlockIndex *index = RZ_NEW0(RzHashBlockIndex);
+	if (!index) {
+		return NULL;
+	}
+	index->plugin = plugin;
+	index->size = size;
+	index->block_size = block_size;
+	// empty data has a single empty block
+	index->blocks_count = RZ_MAX(1, size / block_size + !!(size % block_size));
+	void *context = plugin->context_new();
+	if (!context) {
+		goto fail;
+	}
+	index->digest_size = plugin->digest_size(context);
+	plugin->context_free(context);
+
+	ut64 nodes = 0;
+	for (ut64 count = index->blocks_count; count > 1; count = level_count(count)) {
+		nodes += count;
+	}
+	nodes++;
+	index->digests = RZ_NEWS0(ut8, nodes * index->digest_size);
+	index->dirty = RZ_NEWS(ut8, index->blocks_count);
+	if (!index->digests || !index->dirty) {
+		goto fail;
+	}
+	memset(index->dirty, 1, index->blocks_count);
+	index->dirty_count = index->blocks_count;
+	return index;
+
+fail:
+	RZ_LOG_ERROR("msg digest: cannot allocate the block index.\n");
+	rz_hash_block_index_free(index);
+	return NULL;
+}
+
+RZ_API void rz_hash_block_index_free(RZ_NULLABLE RzHashBlockIndex *index) {
+	if (!index) {
+		return;
+	}
+	free(index->digests);
+	free(index->dirty);
+	free(index);
+}
+
+/**
+ * \brief Marks the blocks overlapping [offset, offset + size) as dirty
+ */
+RZ_API void rz_hash_block_index_invalidate(RZ_NONNULL RzHashBlockIndex *index, ut64 offset, ut64 size) {
+	rz_return_if_fail(index);
+	if (!size || offset >= index->size) {
+		return;
+	}
+	ut64 last = RZ_MIN(offset + size - 1, index->size - 1);
+	if (last < offset) {
+		// overflow
+		last = index->size - 1;
+	}
+	for (ut64 i = offset / index->block_size; i <= last / index->block_size; i++) {
+		if (!index->dirty[i]) {
+			index->dirty[i] = 1;
+			index->dirty_count++;
+		}
+	}
+}
+
+static void *block_index_worker_run(BlockIndexCtx *ctx) {
+	const RzHashPlugin *plugin = ctx->index->plugin;
+	void *context = plugin->context_new();
+	BlockIndexJob *job;
+	while ((job = rz_th_queue_pop(ctx->jobs, false))) {
+		job->failed = !context || !digest_block(plugin, context, job->data, job->size, NULL, 0, node_at(ctx->index, 0, job->index));
+	}
+	if (context) {
+		plugin->context_free(context);
+	}
+	return NULL;
+}
+
+static void block_index_hash_jobs(BlockIndexCtx *ctx, size_t n_threads) {
+	RzThreadPool *pool = NULL;
+	size_t started = 0;
+	if (n_threads > 1) {
+		pool = rz_th_pool_new(n_threads);
+		for (; pool && started < n_threads; ++started) {
+			RzThread *th = rz_th_new((RzThreadFunction)block_index_worker_run, ctx);
+			if (!th) {
+				// the started threads will consume the whole queue.
+				break;
+			} else if (!rz_th_pool_add_thread(pool, th)) {
+				rz_th_wait(th);
+				rz_th_free(th);
+				break;
+			}
+		}
+	}
+	if (!started) {
+		block_index_worker_run(ctx);
+	} else {
+		rz_th_pool_wait(pool);
+	}
+	rz_th_pool_free(pool);
+}
+
+static bool block_index_update_blocks(RzHashBlockIndex *index, RzHashBlockIndexRead read, void *user, size_t n_threads) {
+	ut64 batch_blocks = RZ_MAX(1, BLOCK_INDEX_BATCH_SIZE / index->block_size);
+	batch_blocks = RZ_MIN(batch_blocks, index->dirty_count);
+	ut8 *buf = malloc(batch_blocks * index->block_size);
+	BlockIndexJob *jobs = RZ_NEWS(BlockIndexJob, batch_blocks);
+	BlockIndexCtx ctx = {
+		.index = index,
+		.jobs = rz_th_queue_new(batch_blocks, NULL),
+	};
+	bool succ = false;
+	if (!buf || !jobs || !ctx.jobs) {
+		RZ_LOG_ERROR("msg digest: cannot allocate the blocks to hash.\n");
+		goto end;
+	}
+	n_threads = RZ_MIN(rz_th_request_physical_cores(n_threads), batch_blocks);
+
+	ut64 i = 0;
+	while (i < index->blocks_count) {
+		// the blocks are read sequentially by the caller thread and then hashed in parallel
+		ut64 n_jobs = 0;
+		for (; i < index->blocks_count && n_jobs < batch_blocks; i++) {
+			if (!index->dirty[i]) {
+				continue;
+			}
+			BlockIndexJob *job = &jobs[n_jobs];
+			ut64 offset = i * index->block_size;
+			job->index = i;
+			job->data = buf + n_jobs * index->block_size;
+			job->size = RZ_MIN(index->block_size, index->size - offset);
+			job->failed = true;
+			if (job->size && read(user, offset, (ut8 *)job->data, job->size) != job->size) {
+				RZ_LOG_ERROR("msg digest: cannot read the block at 0x%" PFMT64x ".\n", offset);
+				goto end;
+			}
+			if (!rz_th_queue_push(ctx.jobs, job, true)) {
+				goto end;
+			}
+			n_jobs++;
+		}
+		if (!n_jobs) {
+			continue;
+		}
+		block_index_hash_jobs(&ctx, RZ_MIN(n_threads, n_jobs));
+		for (ut64 j = 0; j < n_jobs; j++) {
+			if (jobs[j].failed) {
+				RZ_LOG_ERROR("msg digest: failed to hash the blocks with %s.\n", index->plugin->name);
+				goto end;
+			}
+		}
+	}
+	succ = true;
+
+end:
+	rz_th_queue_free(ctx.jobs);
+	free(jobs);
+	free(buf);
+	return succ;
+}
+
+static bool block_index_update_tree(RzHashBlockIndex *index) {
+	const RzHashPlugin *plugin = index->plugin;
+	void *context = plugin->context_new();
+	if (!context) {
+		return false;
+	}
+	bool succ = true;
+	ut64 start = 0;
+	for (ut64 count = index->blocks_count; succ && count > 1; count = level_count(count)) {
+		ut64 next_start = start + count;
+		// the dirty flags of each level are moved to the parents, which never come after the children
+		for (ut64 i = 0; i < count; i++) {
+			ut8 dirty = index->dirty[i];
+			index->dirty[i] = 0;
+			index->dirty[i / 2] |= dirty;
+		}
+		for (ut64 i = 0; i < level_count(count); i++) {
+			if (!index->dirty[i]) {
+				continue;
+			}
+			ut8 *node = node_at(index, next_start, i);
+			if (2 * i + 1 == count) {
+				memcpy(node, node_at(index, start, 2 * i), index->digest_size);
+			} else if (!digest_block(plugin, context, node_at(index, start, 2 * i), index->digest_size,
+				node_at(index, start, 2 * i + 1), index->digest_size, node)) {
+				succ = false;
+				break;
+			}
+		}
+		start = next_start;
+	}
+	index->dirty[0] = 0;
+	plugin->context_free(context);
+	return succ;
+}
+
+/**
+ * \brief Computes again the digests of the dirty blocks and of the nodes above them
+ *
+ * The dirty blocks are read in batches by the caller thread, then the blocks of
+ * each batch are hashed by up to \p n_threads threads.
+ *
+ * \param  index      The block index
+ * \param  read       Callback used to read the data of the blocks
+ * \param  user       User data passed to \p read
+ * \param  n_threads  Number of threads used to hash the blocks (0: all cores, 1: sequential)
+ * \return Number of blocks hashed, or UT64_MAX on failure
+ */
+RZ_API ut64 rz_hash_block_index_update(RZ_NONNULL RzHashBlockIndex *index, RZ_NONNULL RzHashBlockIndexRead read, RZ_NULLABLE void *user, size_t n_threads) {
+	rz_return_val_if_fail(index && read, UT64_MAX);
+	ut64 hashed = index->dirty_count;
+	if (!hashed) {
+		return 0;
+	}
+	if (!block_index_update_blocks(index, read, user, n_threads) ||
+		!block_index_update_tree(index)) {
+		// the dirty flags are not reliable anymore
+		memset(index->dirty, 1, index->blocks_count);
+		index->dirty_count = index->blocks_count;
+		return UT64_MAX;
+	}
+	index->dirty_count = 0;
+	return hashed;
+}
+
+/**
+ * \brief Returns the digest of the block at \p i, which is valid only if the index has no dirty block
+ */
+RZ_API RZ_BORROW const ut8 *rz_hash_block_index_block(RZ_NONNULL RzHashBlockIndex *index, ut64 i) {
+	rz_return_val_if_fail(index && i < index->blocks_count, NULL);
+	return node_at(index, 0, i);
+}
+
+/**
+ * \brief Returns the root of the tree, which is valid only if the index has no dirty block
+ *
+ * When the data fits in a single block, the root is the digest of the data.
+ */
+RZ_API RZ_BORROW const ut8 *rz_hash_block_index_root(RZ_NONNULL RzHashBlockIndex *index) {
+	rz_return_val_if_fail(index, NULL);
+	ut64 nodes = 0;
+	for (ut64 count = index->blocks_count; count > 1; count = level_count(count)) {
+		nodes += count;
+	}
+	return node_at(index, nodes, 0);
+}
+
+/**
+ * \brief Restores the digests of the blocks computed by a previous update, e.g. saved in a project
+ *
+ * The tree is rebuilt from the digests of the clean blocks, the nodes above
+ * the dirty blocks are computed again by the next update.
+ *
+ * \param  index   The block index, as returned by rz_hash_block_index_new()
+ * \param  blocks  The digests of the blocks_count blocks, each one of digest_size bytes
+ * \param  dirty   For each block, non-zero if its digest in \p blocks is not valid
+ */
+RZ_API bool rz_hash_block_index_restore(RZ_NONNULL RzHashBlockIndex *index, RZ_NONNULL const ut8 *blocks, RZ_NONNULL const ut8 *dirty) {
+	rz_return_val_if_fail(index && blocks && dirty, false);
+	memcpy(index->digests, blocks, index->blocks_count * index->digest_size);
+	// every node is computed, the ones above the dirty blocks only hold garbage until the next update
+	memset(index->dirty, 1, index->blocks_count);
+	if (!block_index_update_tree(index)) {
+		memset(index->dirty, 1, index->blocks_count);
+		index->dirty_count = index->blocks_count;
+		return false;
+	}
+	index->dirty_count = 0;
+	for (ut64 i = 0; i < index->blocks_count; i++) {
+		index->dirty[i] = !!dirty[i];
+		index->dirty_count += index->dirty[i];
+	}
+	return true;
+}
@@ -23,6 +23,41 @@ typedef struct hash_cfg_config_t {
 	const RzHashPlugin *plugin;
 } HashCfgConfig;
 
+#define HASH_CFG_RING_SIZE 4 ///< blocks read ahead of the slowest digest in parallel mode
+
+/**
+ * \brief Copy of the data of one update, shared by all the workers
+ */
+typedef struct hash_cfg_block_t {
+	ut8 *data;
+	ut64 size;
+	ut64 capacity;
+	size_t pending; ///< workers that still have to consume the block
+} HashCfgBlock;
+
+typedef struct hash_cfg_worker_t HashCfgWorker;
+
+/**
+ * \brief Worker threads of the parallel mode, each one updating a single configuration
+ */
+typedef struct hash_cfg_pipeline_t {
+	RzThreadLock *lock;
+	RzThreadCond *filled; ///< signaled when a block is added to the ring or the workers must stop
+	RzThreadCond *consumed; ///< signaled when a block has been consumed by all the workers
+	HashCfgBlock ring[HASH_CFG_RING_SIZE];
+	ut64 produced; ///< number of blocks added to the ring so far
+	bool stop;
+	bool failed; ///< an update failed, reported by the next update or final
+	HashCfgWorker *workers;
+	size_t workers_count;
+} HashCfgPipeline;
+
+struct hash_cfg_worker_t {
+	HashCfgPipeline *pipeline;
+	HashCfgConfig *mdc;
+	RzThread *thread;
+};
+
 const static RzHashPlugin *hash_static_plugins[] = { RZ_HASH_STATIC_PLUGINS };
 
 /**
@@ -168,6 +203,165 @@ static HashCfgConfig *hash_cfg_config_new(const RzHashPlugin *plugin) {
 	return mdc;
 }
 
+static void *hash_cfg_worker_run(void *user) {
+	HashCfgWorker *w = user;
+	HashCfgPipeline *p = w->pipeline;
+	ut64 next = 0;
+	rz_th_lock_enter(p->lock);
+	while (true) {
+		while (next == p->produced && !p->stop) {
+			rz_th_cond_wait(p->filled, p->lock);
+		}
+		if (next == p->produced) {
+			break;
+		}
+		HashCfgBlock *b = &p->ring[next % HASH_CFG_RING_SIZE];
+		rz_th_lock_leave(p->lock);
+		bool succ = w->mdc->plugin->update(w->mdc->context, b->data, b->size);
+		rz_th_lock_enter(p->lock);
+		if (!succ) {
+			RZ_LOG_ERROR("msg digest: failed to call update for %s.\n", w->mdc->plugin->name);
+			p->failed = true;
+		}
+		next++;
+		if (!--b->pending) {
+			rz_th_cond_signal_all(p->consumed);
+		}
+	}
+	rz_th_lock_leave(p->lock);
+	return NULL;
+}
+
+/**
+ * Wait until all the blocks in the ring have been consumed
+ * \return false if any of the updates failed
+ */
+static bool hash_cfg_pipeline_drain(HashCfgPipeline *p) {
+	rz_th_lock_enter(p->lock);
+	for (size_t i = 0; i < HASH_CFG_RING_SIZE; i++) {
+		while (p->ring[i].pending) {
+			rz_th_cond_wait(p->consumed, p->lock);
+		}
+	}
+	bool succ = !p->failed;
+	p->failed = false;
+	rz_th_lock_leave(p->lock);
+	return succ;
+}
+
+static void hash_cfg_pipeline_free(HashCfgPipeline *p) {
+	if (!p) {
+		return;
+	}
+	if (p->workers) {
+		rz_th_lock_enter(p->lock);
+		p->stop = true;
+		rz_th_cond_signal_all(p->filled);
+		rz_th_lock_leave(p->lock);
+		for (size_t i = 0; i < p->workers_count; i++) {
+			if (p->workers[i].thread) {
+				rz_th_wait(p->workers[i].thread);
+				rz_th_free(p->workers[i].thread);
+			}
+		}
+		free(p->workers);
+	}
+	for (size_t i = 0; i < HASH_CFG_RING_SIZE; i++) {
+		free(p->ring[i].data);
+	}
+	rz_th_cond_free(p->consumed);
+	rz_th_cond_free(p->filled);
+	rz_th_lock_free(p->lock);
+	free(p);
+}
+
+static HashCfgPipeline *hash_cfg_pipeline_new(RzList /*<HashCfgConfig *>*/ *configurations) {
+	HashCfgPipeline *p = RZ_NEW0(HashCfgPipeline);
+	if (!p) {
+		return NULL;
+	}
+	p->lock = rz_th_lock_new(false);
+	p->filled = rz_th_cond_new();
+	p->consumed = rz_th_cond_new();
+	p->workers_count = rz_list_length(configurations);
+	p->workers = RZ_NEWS0(HashCfgWorker, p->workers_count);
+	if (!p->lock || !p->filled || !p->consumed || !p->workers) {
+		goto fail;
+	}
+	RzListIter *iter;
+	HashCfgConfig *mdc;
+	size_t i = 0;
+	rz_list_foreach (configurations, iter, mdc) {
+		HashCfgWorker *w = &p->workers[i++];
+		w->pipeline = p;
+		w->mdc = mdc;
+		w->thread = rz_th_new(hash_cfg_worker_run, w);
+		if (!w->thread) {
+			goto fail;
+		}
+	}
+	return p;
+fail:
+	RZ_LOG_ERROR("msg digest: cannot start the worker threads.\n");
+	hash_cfg_pipeline_free(p);
+	return NULL;
+}
+
+/**
+ * Add a copy of \p data to the ring, to be consumed by all the workers
+ */
+static bool hash_cfg_pipeline_push(HashCfgPipeline *p, const ut8 *data, ut64 size) {
+	rz_th_lock_enter(p->lock);
+	HashCfgBlock *b = &p->ring[p->produced % HASH_CFG_RING_SIZE];
+	while (b->pending) {
+		rz_th_cond_wait(p->consumed, p->lock);
+	}
+	bool succ = !p->failed;
+	rz_th_lock_leave(p->lock);
+	if (!succ) {
+		return false;
+	}
+	// no worker reads the block until it is produced again
+	if (size > b->capacity) {
+		ut8 *tmp = realloc(b->data, size);
+		if (!tmp) {
+			RZ_LOG_ERROR("msg digest: cannot allocate memory for the block.\n");
+			return false;
+		}
+		b->data = tmp;
+		b->capacity = size;
+	}
+	memcpy(b->data, data, size);
+	b->size = size;
+	rz_th_lock_enter(p->lock);
+	b->pending = p->workers_count;
+	p->produced++;
+	rz_th_cond_signal_all(p->filled);
+	rz_th_lock_leave(p->lock);
+	return true;
+}
+
+/**
+ * \brief Runs the updates of each configured algorithm on its own thread
+ *
+ * When enabled and more than one algorithm is configured, rz_hash_cfg_update()
+ * only copies the data into a ring of blocks and returns, while a worker thread
+ * per algorithm consumes them, so hashing a buffer with several algorithms takes
+ * about as long as with the slowest of them and the caller can already read the
+ * next buffer. rz_hash_cfg_final() waits for all the pending updates.
+ *
+ * \param parallel whether to run the updates in parallel
+ */
+RZ_API void rz_hash_cfg_set_parallel(RZ_NONNULL RzHashCfg *md, bool parallel) {
+	rz_return_if_fail(md);
+	if (!parallel && md->pipeline) {
+		hash_cfg_pipeline_drain(md->pipeline);
+		hash_cfg_pipeline_free(md->pipeline);
+		md->pipeline = NULL;
+	}
+	md->parallel = parallel;
+}
+
 RZ_API RZ_BORROW const RzHashPlugin *rz_hash_plugin_by_index(RZ_NONNULL RzHash *rh, size_t index) {
 	rz_return_val_if_fail(rh, NULL);
 
@@ -253,6 +447,7 @@ RZ_API RZ_OWN RzHashCfg *rz_hash_cfg_new_with_algo(RZ_NONNULL RzHash *rh, RZ_NON
 RZ_API void rz_hash_cfg_free(RZ_NONNULL RzHashCfg *md) {
 	rz_return_if_fail(md);
 
+	hash_cfg_pipeline_free(md->pipeline);
 	rz_list_free(md->configurations);
 	free(md);
 }
@@ -271,6 +466,10 @@ RZ_API bool rz_hash_cfg_configure(RZ_NONNULL RzHashCfg *md, RZ_NONNULL const cha
 		return false;
 	}
 
+	// the workers are started again for the new list of configurations
+	hash_cfg_pipeline_free(md->pipeline);
+	md->pipeline = NULL;
+
 	bool is_all = !strcmp(name, "all");
 
 	if (is_all && rz_list_length(md->configurations) > 0) {
@@ -365,6 +564,10 @@ RZ_API bool rz_hash_cfg_hmac(RZ_NONNULL RzHashCfg *md, RZ_NONNULL const ut8 *key
 RZ_API bool rz_hash_cfg_init(RZ_NONNULL RzHashCfg *md) {
 	rz_return_val_if_fail(md && hash_cfg_can_init(md), false);
 
+	if (md->pipeline && !hash_cfg_pipeline_drain(md->pipeline)) {
+		return false;
+	}
+
 	RzListIter *iter = NULL;
 	HashCfgConfig *mdc = NULL;
 	rz_list_foreach (md->configurations, iter, mdc) {
@@ -404,6 +607,19 @@ RZ_API bool rz_hash_cfg_init(RZ_NONNULL RzHashCfg *md) {
 RZ_API bool rz_hash_cfg_update(RZ_NONNULL RzHashCfg *md, RZ_NONNULL const ut8 *data, ut64 size) {
 	rz_return_val_if_fail(md && hash_cfg_can_update(md), false);
 
+	if (md->parallel && !md->pipeline && rz_list_length(md->configurations) > 1) {
+		md->pipeline = hash_cfg_pipeline_new(md->configurations);
+		// fallback to the sequential updates
+		md->parallel = md->pipeline != NULL;
+	}
+	if (md->pipeline) {
+		if (!hash_cfg_pipeline_push(md->pipeline, data, size)) {
+			return false;
+		}
+		md->status = RZ_MSG_DIGEST_STATUS_UPDATE;
+		return true;
+	}
+
 	RzListIter *iter = NULL;
 	HashCfgConfig *mdc = NULL;
 	rz_list_foreach (md->configurations, iter, mdc) {
@@ -426,6 +642,10 @@ RZ_API bool rz_hash_cfg_update(RZ_NONNULL RzHashCfg *md, RZ_NONNULL const ut8 *d
 RZ_API bool rz_hash_cfg_final(RZ_NONNULL RzHashCfg *md) {
 	rz_return_val_if_fail(md && hash_cfg_can_final(md), false);
 
+	if (md->pipeline && !hash_cfg_pipeline_drain(md->pipeline)) {
+		return false;
+	}
+
 	RzListIter *iter = NULL;
 	HashCfgConfig *mdc = NULL;
 	rz_list_foreach (md->configurations, iter, mdc) {
@@ -3,9 +3,117 @@
 
 #include <rz_il/rz_il_opcodes.h>
 
+#if defined(_MSC_VER)
+#define IL_THREAD_LOCAL __declspec(thread)
+#else
+#define IL_THREAD_LOCAL __thread
+#endif
+
+#define IL_OP_POOL_MAX 0x1000
+
+/// op pool in use by the current thread, see rz_il_op_pool_use()
+static IL_THREAD_LOCAL RzILOpPool *cur_pool = NULL;
+
+/**
+ * \brief Create an empty pool to recycle the op nodes
+ */
+RZ_API RZ_OWN RzILOpPool *rz_il_op_pool_new(void) {
+	RzILOpPool *pool = RZ_NEW0(RzILOpPool);
+	if (!pool) {
+		return NULL;
+	}
+	rz_pvector_init(&pool->pure, free);
+	rz_pvector_init(&pool->effect, free);
+	rz_pvector_init(&pool->bv, (RzPVectorFree)rz_bv_free);
+	return pool;
+}
+
+RZ_API void rz_il_op_pool_free(RZ_NULLABLE RzILOpPool *pool) {
+	if (!pool) {
+		return;
+	}
+	if (cur_pool == pool) {
+		cur_pool = NULL;
+	}
+	rz_pvector_fini(&pool->pure);
+	rz_pvector_fini(&pool->effect);
+	rz_pvector_fini(&pool->bv);
+	free(pool);
+}
+
+/**
+ * \brief Make the calling thread allocate and free its op nodes through \p pool
+ *
+ * While a pool is in use, the ops freed by rz_il_op_pure_free() and rz_il_op_effect_free()
+ * are kept in the pool and handed out again by the rz_il_op_new_*() constructors, so that
+ * lifting and freeing an instruction for every step does not hit the heap once the pool is warm.
+ * Ops created while a pool is in use can still be freed at any time, with or without a pool.
+ *
+ * \param pool the pool to use, or NULL to allocate everything on the heap again
+ * \return the pool used before, to be restored by the caller
+ */
+RZ_API RZ_NULLABLE RzILOpPool *rz_il_op_pool_use(RZ_NULLABLE RzILOpPool *pool) {
+	RzILOpPool *prev = cur_pool;
+	cur_pool = pool;
+	return prev;
+}
+
+static void *op_pool_get(RzILOpPool *pool, RzPVector *vec, size_t size) {
+	if (rz_pvector_empty(vec)) {
+		pool->allocs++;
+		return calloc(1, size);
+	}
+	pool->reuses++;
+	void *r = rz_pvector_pop(vec);
+	memset(r, 0, size);
+	return r;
+}
+
+static void op_pool_put(RzPVector *vec, void *ptr) {
+	if (rz_pvector_len(vec) >= IL_OP_POOL_MAX || !rz_pvector_push(vec, ptr)) {
+		free(ptr);
+	}
+}
+
+static RzILOpPure *op_pure_alloc(void) {
+	return cur_pool ? op_pool_get(cur_pool, &cur_pool->pure, sizeof(RzILOpPure)) : RZ_NEW0(RzILOpPure);
+}
+
+static RzILOpEffect *op_effect_alloc(void) {
+	return cur_pool ? op_pool_get(cur_pool, &cur_pool->effect, sizeof(RzILOpEffect)) : RZ_NEW0(RzILOpEffect);
+}
+
+static RzBitVector *op_bv_new(ut32 length) {
+	if (!cur_pool || length > 64) {
+		return rz_bv_new(length);
+	}
+	RzBitVector *bv = op_pool_get(cur_pool, &cur_pool->bv, sizeof(RzBitVector));
+	if (!bv || !rz_bv_init(bv, length)) {
+		free(bv);
+		return NULL;
+	}
+	return bv;
+}
+
+static void op_bv_free(RzBitVector *bv) {
+	if (!bv) {
+		return;
+	}
+	if (!cur_pool || bv->len > 64) {
+		rz_bv_free(bv);
+		return;
+	}
+	op_pool_put(&cur_pool->bv, bv);
+}
+
+#define op_alloc_Pure()      op_pure_alloc()
+#define op_alloc_Bool()      op_pure_alloc()
+#define op_alloc_BitVector() op_pure_alloc()
+#define op_alloc_Effect()    op_effect_alloc()
+
 #define rz_il_op_new_0(sort, id) \
 	do { \
-		ret = RZ_NEW0(RzILOp##sort); \
+		ret = op_alloc_##sort(); \
 		if (!ret) { \
 			return NULL; \
 		} \
@@ -14,7 +122,7 @@
 
 #define rz_il_op_new_1(sort, id, t, s, v0) \
 	do { \
-		ret = RZ_NEW0(RzILOp##sort); \
+		ret = op_alloc_##sort(); \
 		if (!ret) { \
 			return NULL; \
 		} \
@@ -24,7 +132,7 @@
 
 #define rz_il_op_new_2(sort, id, t, s, v0, v1) \
 	do { \
-		ret = RZ_NEW0(RzILOp##sort); \
+		ret = op_alloc_##sort(); \
 		if (!ret) { \
 			return NULL; \
 		} \
@@ -35,7 +143,7 @@
 
 #define rz_il_op_new_3(sort, id, t, s, v0, v1, v2) \
 	do { \
-		ret = RZ_NEW0(RzILOp##sort); \
+		ret = op_alloc_##sort(); \
 		if (!ret) { \
 			return NULL; \
 		} \
@@ -171,13 +279,14 @@ RZ_API RZ_OWN RzILOpBitVector *rz_il_op_new_bitv(RZ_NONNULL RzBitVector *value)
  *  value is a bitvector constant.
  */
 RZ_API RZ_OWN RzILOpBool *rz_il_op_new_bitv_from_ut64(ut32 length, ut64 number) {
-	RzBitVector *value = rz_bv_new_from_ut64(length, number);
+	RzBitVector *value = op_bv_new(length);
 	if (!value) {
 		return NULL;
 	}
-	RzILOpBool *ret = RZ_NEW0(RzILOpBool);
+	rz_bv_set_from_ut64(value, number);
+	RzILOpBool *ret = op_pure_alloc();
 	if (!ret) {
-		rz_bv_free(value);
+		op_bv_free(value);
 		return NULL;
 	}
 	ret->code = RZ_IL_OP_BITV;
@@ -191,13 +300,14 @@ RZ_API RZ_OWN RzILOpBool *rz_il_op_new_bitv_from_ut64(ut32 length, ut64 number)
  *  value is a bitvector constant.
  */
 RZ_API RZ_OWN RzILOpBool *rz_il_op_new_bitv_from_st64(ut32 length, st64 number) {
-	RzBitVector *value = rz_bv_new_from_st64(length, number);
+	RzBitVector *value = op_bv_new(length);
 	if (!value) {
 		return NULL;
 	}
-	RzILOpBool *ret = RZ_NEW0(RzILOpBool);
+	rz_bv_set_from_st64(value, number);
+	RzILOpBool *ret = op_pure_alloc();
 	if (!ret) {
-		rz_bv_free(value);
+		op_bv_free(value);
 		return NULL;
 	}
 	ret->code = RZ_IL_OP_BITV;
@@ -649,7 +759,7 @@ RZ_API RZ_OWN RzILOpEffect *rz_il_op_new_seqn(ut32 n, ...) {
 			}
 			break;
 		}
-		RzILOpEffect *seq = RZ_NEW0(RzILOpEffect);
+		RzILOpEffect *seq = op_effect_alloc();
 		if (!seq) {
 			break;
 		}
@@ -762,7 +872,7 @@ RZ_API RZ_OWN RzILOpEffect *rz_il_op_new_storew(RzILMemIndex mem, RZ_NONNULL RzI
  */
 RZ_API RzILOpPure *rz_il_op_pure_dup(RZ_NONNULL RzILOpPure *op) {
 	rz_return_val_if_fail(op, NULL);
-	RzILOpPure *r = RZ_NEW0(RzILOpPure);
+	RzILOpPure *r = op_pure_alloc();
 	if (!r) {
 		return NULL;
 	}
@@ -951,7 +1061,7 @@ RZ_API void rz_il_op_pure_free(RZ_NULLABLE RzILOpPure *op) {
 		rz_il_op_free_2(pure, boolxor, x, y);
 		break;
 	case RZ_IL_OP_BITV:
-		rz_bv_free(op->op.bitv.value);
+		op_bv_free(op->op.bitv.value);
 		break;
 	case RZ_IL_OP_MSB:
 		rz_il_op_free_1(pure, msb, bv);
@@ -1030,7 +1140,11 @@ RZ_API void rz_il_op_pure_free(RZ_NULLABLE RzILOpPure *op) {
 		RZ_LOG_ERROR("RzIL: unknown opcode %u\n", op->code);
 		break;
 	}
-	free(op);
+	if (cur_pool) {
+		op_pool_put(&cur_pool->pure, op);
+	} else {
+		free(op);
+	}
 }
 
 RZ_API void rz_il_op_effect_free(RZ_NULLABLE RzILOpEffect *op) {
@@ -1075,7 +1189,11 @@ RZ_API void rz_il_op_effect_free(RZ_NULLABLE RzILOpEffect *op) {
 		RZ_LOG_ERROR("RzIL: unknown opcode %u\n", op->code);
 		break;
 	}
-	free(op);
+	if (cur_pool) {
+		op_pool_put(&cur_pool->effect, op);
+	} else {
+		free(op);
+	}
 }
 
 #undef rz_il_op_free_0
@@ -154,7 +154,7 @@ err:
  */
 RZ_API RzILRegBinding *rz_il_reg_binding_exactly(RZ_NONNULL RzReg *reg, size_t regs_count, RZ_NONNULL RZ_BORROW const char **regs) {
 	rz_return_val_if_fail(reg && regs, NULL);
-	RzILRegBinding *rb = RZ_NEW(RzILRegBinding);
+	RzILRegBinding *rb = RZ_NEW0(RzILRegBinding);
 	if (!rb) {
 		return NULL;
 	}
@@ -213,9 +213,34 @@ RZ_API void rz_il_reg_binding_free(RzILRegBinding *rb) {
 		reg_binding_item_fini(&rb->regs[i], NULL);
 	}
 	free(rb->regs);
+	free(rb->items);
 	free(rb);
 }
 
+/**
+ * Look up the RzRegItem of PC and every bound register in \p reg, unless they are still cached from the last sync with it.
+ * \return false if the items could not be allocated
+ */
+static bool reg_binding_resolve(RzILRegBinding *rb, RzReg *reg) {
+	if (rb->items && rb->items_reg == reg && rb->items_gen == reg->profile_gen) {
+		return true;
+	}
+	if (!rb->items) {
+		rb->items = RZ_NEWS(RzRegItem *, RZ_MAX(rb->regs_count, 1));
+		if (!rb->items) {
+			return false;
+		}
+	}
+	for (size_t i = 0; i < rb->regs_count; i++) {
+		rb->items[i] = rz_reg_get(reg, rb->regs[i].name, RZ_REG_TYPE_ANY);
+	}
+	const char *pc = rz_reg_get_name(reg, RZ_REG_NAME_PC);
+	rb->pc_item = pc ? rz_reg_get(reg, pc, RZ_REG_TYPE_ANY) : NULL;
+	rb->items_reg = reg;
+	rb->items_gen = reg->profile_gen;
+	return true;
+}
+
 /**
  * Setup variables to bind against registers
  * \p rb the binding for which to create variables
@@ -237,24 +262,48 @@ RZ_API void rz_il_vm_setup_reg_binding(RZ_NONNULL RzILVM *vm, RZ_NONNULL RZ_BORR
  * different errors might happen, e.g. a register size might not match the variable's value size.
  * In such cases, this function still applies everything it can, zero-extending or cropping values where necessary.
  *
+ * The register items are resolved only once per RzReg and profile, and values of up to 64 bits
+ * are written directly, without intermediate bitvectors.
+ *
  * \return whether the sync was cleanly applied without errors or adjustments
  */
 RZ_API bool rz_il_vm_sync_to_reg(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILRegBinding *rb, RZ_NONNULL RzReg *reg) {
 	rz_return_val_if_fail(vm && rb && reg, false);
+	return rz_il_vm_sync_to_reg_type(vm, rb, reg, RZ_REG_TYPE_ANY);
+}
+
+static inline bool reg_item_has_type(RZ_NULLABLE RzRegItem *ri, RzRegisterType type) {
+	return type == RZ_REG_TYPE_ANY || (ri && ri->type == type);
+}
+
+/**
+ * \brief Like rz_il_vm_sync_to_reg(), but only for the bound registers and PC of type \p type
+ *
+ * All the registers of the type are copied in a single pass over the binding, e.g. only the
+ * RZ_REG_TYPE_GPR ones after an instruction which did not change any flag.
+ * RZ_REG_TYPE_ANY syncs all the registers. Bound registers missing in \p reg are only
+ * reported as errors when syncing RZ_REG_TYPE_ANY, since their type is unknown.
+ *
+ * \return whether the sync was cleanly applied without errors or adjustments
+ */
+RZ_API bool rz_il_vm_sync_to_reg_type(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILRegBinding *rb, RZ_NONNULL RzReg *reg, RzRegisterType type) {
+	rz_return_val_if_fail(vm && rb && reg, false);
+	if (!reg_binding_resolve(rb, reg)) {
+		return false;
+	}
 	bool perfect = true;
-	const char *pc = rz_reg_get_name(reg, RZ_REG_NAME_PC);
-	if (pc) {
-		RzRegItem *ri = rz_reg_get(reg, pc, RZ_REG_TYPE_ANY);
-		if (ri) {
-			RzBitVector *pcbv = rz_bv_new_zero(ri->size);
-			if (pcbv) {
-				perfect &= rz_bv_len(pcbv) == rz_bv_len(vm->pc);
-				rz_bv_copy_nbits(vm->pc, 0, pcbv, 0, RZ_MIN(rz_bv_len(pcbv), rz_bv_len(vm->pc)));
-				rz_reg_set_bv(reg, ri, pcbv);
-				rz_bv_free(pcbv);
-			} else {
-				perfect = false;
-			}
+	RzRegItem *ri = rb->pc_item;
+	if (!reg_item_has_type(ri, type)) {
+		// pc is not part of the synced registers
+	} else if (ri && ri->size == rz_bv_len(vm->pc) && ri->size <= 64) {
+		rz_reg_set_value(reg, ri, rz_bv_to_ut64(vm->pc));
+	} else if (ri) {
+		RzBitVector *pcbv = rz_bv_new_zero(ri->size);
+		if (pcbv) {
+			perfect &= rz_bv_len(pcbv) == rz_bv_len(vm->pc);
+			rz_bv_copy_nbits(vm->pc, 0, pcbv, 0, RZ_MIN(rz_bv_len(pcbv), rz_bv_len(vm->pc)));
+			rz_reg_set_bv(reg, ri, pcbv);
+			rz_bv_free(pcbv);
 		} else {
 			perfect = false;
 		}
@@ -263,7 +312,10 @@ RZ_API bool rz_il_vm_sync_to_reg(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILRegBindin
 	}
 	for (size_t i = 0; i < rb->regs_count; i++) {
 		RzILRegBindingItem *item = &rb->regs[i];
-		RzRegItem *ri = rz_reg_get(reg, item->name, RZ_REG_TYPE_ANY);
+		ri = rb->items[i];
+		if (!reg_item_has_type(ri, type)) {
+			continue;
+		}
 		if (!ri) {
 			perfect = false;
 			continue;
@@ -281,6 +333,14 @@ RZ_API bool rz_il_vm_sync_to_reg(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILRegBindin
 			}
 			continue;
 		}
+		if (val->type == RZ_IL_TYPE_PURE_BOOL && ri->size == 1) {
+			perfect &= rz_reg_set_value(reg, ri, val->data.b->b);
+			continue;
+		}
+		if (val->type == RZ_IL_TYPE_PURE_BITVECTOR && rz_bv_len(val->data.bv) == ri->size && ri->size <= 64) {
+			perfect &= rz_reg_set_value(reg, ri, rz_bv_to_ut64(val->data.bv));
+			continue;
+		}
 		RzBitVector *dupped = NULL;
 		const RzBitVector *bv;
 		if (val->type == RZ_IL_TYPE_PURE_BITVECTOR) {
@@ -313,29 +373,60 @@ RZ_API bool rz_il_vm_sync_to_reg(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILRegBindin
 /**
  * Set the values of all variables in \p vm that are bound to registers and PC to the respective contents from \p reg.
  * Contents of variables that are not bound to a register are left unchanged.
+ *
+ * Like rz_il_vm_sync_to_reg(), the register items are resolved only once per RzReg and profile.
+ * Variables whose values already have the size of their register are updated in place.
  */
 RZ_API void rz_il_vm_sync_from_reg(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILRegBinding *rb, RZ_NONNULL RzReg *reg) {
 	rz_return_if_fail(vm && rb && reg);
-	const char *pc = rz_reg_get_name(reg, RZ_REG_NAME_PC);
-	if (pc) {
-		RzRegItem *ri = rz_reg_get(reg, pc, RZ_REG_TYPE_ANY);
-		if (ri) {
-			rz_bv_set_all(vm->pc, 0);
-			RzBitVector *pcbv = rz_reg_get_bv(reg, ri);
-			if (pcbv) {
-				rz_bv_copy_nbits(pcbv, 0, vm->pc, 0, RZ_MIN(rz_bv_len(pcbv), rz_bv_len(vm->pc)));
-				rz_bv_free(pcbv);
-			}
+	rz_il_vm_sync_from_reg_type(vm, rb, reg, RZ_REG_TYPE_ANY);
+}
+
+/**
+ * \brief Like rz_il_vm_sync_from_reg(), but only for the variables bound to registers of type \p type
+ *
+ * PC is only set if its register has the type. RZ_REG_TYPE_ANY syncs all the variables,
+ * including the ones bound to registers missing in \p reg, which are set to zero.
+ */
+RZ_API void rz_il_vm_sync_from_reg_type(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILRegBinding *rb, RZ_NONNULL RzReg *reg, RzRegisterType type) {
+	rz_return_if_fail(vm && rb && reg);
+	if (!reg_binding_resolve(rb, reg)) {
+		return;
+	}
+	RzRegItem *ri = rb->pc_item;
+	if (!reg_item_has_type(ri, type)) {
+		// pc is not part of the synced registers
+	} else if (ri && ri->size == rz_bv_len(vm->pc) && ri->size <= 64) {
+		rz_bv_set_from_ut64(vm->pc, rz_reg_get_value(reg, ri));
+	} else if (ri) {
+		rz_bv_set_all(vm->pc, 0);
+		RzBitVector *pcbv = rz_reg_get_bv(reg, ri);
+		if (pcbv) {
+			rz_bv_copy_nbits(pcbv, 0, vm->pc, 0, RZ_MIN(rz_bv_len(pcbv), rz_bv_len(vm->pc)));
+			rz_bv_free(pcbv);
 		}
 	}
 	for (size_t i = 0; i < rb->regs_count; i++) {
 		RzILRegBindingItem *item = &rb->regs[i];
+		ri = rb->items[i];
+		if (!reg_item_has_type(ri, type)) {
+			continue;
+		}
+		RzILVal *val = ri ? rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, item->name) : NULL;
+		if (val && item->size == 1 && val->type == RZ_IL_TYPE_PURE_BOOL) {
+			val->data.b->b = rz_reg_get_value(reg, ri) != 0;
+			continue;
+		}
+		if (val && item->size != 1 && item->size <= 64 && ri->size == item->size &&
+			val->type == RZ_IL_TYPE_PURE_BITVECTOR && rz_bv_len(val->data.bv) == item->size) {
+			rz_bv_set_from_ut64(val->data.bv, rz_reg_get_value(reg, ri));
+			continue;
+		}
 		RzILVar *var = rz_il_vm_get_var(vm, RZ_IL_VAR_KIND_GLOBAL, item->name);
 		if (!var) {
 			RZ_LOG_ERROR("IL Variable \"%s\" does not exist for bound register of the same name.\n", item->name);
 			continue;
 		}
-		RzRegItem *ri = rz_reg_get(reg, item->name, RZ_REG_TYPE_ANY);
 		if (item->size == 1) {
 			bool b = ri ? rz_reg_get_value(reg, ri) != 0 : false;
 			rz_il_vm_set_global_var(vm, var->name, rz_il_value_new_bool(rz_il_bool_new(b)));
@@ -13,6 +13,8 @@
 extern RZ_IPI RzILOpPureHandler rz_il_op_handler_pure_table_default[RZ_IL_OP_PURE_MAX];
 extern RZ_IPI RzILOpEffectHandler rz_il_op_handler_effect_table_default[RZ_IL_OP_EFFECT_MAX];
 
+#define RZ_IL_VM_POOL_MAX 0x100
+
 static void free_label_kv(HtPPKv *kv) {
 	free(kv->key);
 	rz_il_effect_label_free(kv->value);
@@ -27,6 +29,16 @@ static void free_label_kv(HtPPKv *kv) {
 RZ_API bool rz_il_vm_init(RzILVM *vm, ut64 start_addr, ut32 addr_size, bool big_endian) {
 	rz_return_val_if_fail(vm, false);
 
+	rz_pvector_init(&vm->bv_pool, (RzPVectorFree)rz_bv_free);
+	rz_pvector_init(&vm->bool_pool, (RzPVectorFree)rz_il_bool_free);
+	rz_pvector_init(&vm->val_pool, free);
+	memset(&vm->stats, 0, sizeof(vm->stats));
+	vm->op_pool = rz_il_op_pool_new();
+	if (!vm->op_pool) {
+		rz_il_vm_fini(vm);
+		return false;
+	}
+
 	if (!rz_il_var_set_init(&vm->global_vars)) {
 		rz_il_vm_fini(vm);
 		return false;
@@ -110,6 +122,12 @@ RZ_API void rz_il_vm_fini(RzILVM *vm) {
 
 	rz_list_free(vm->events);
 	vm->events = NULL;
+
+	rz_pvector_fini(&vm->bv_pool);
+	rz_pvector_fini(&vm->bool_pool);
+	rz_pvector_fini(&vm->val_pool);
+	rz_il_op_pool_free(vm->op_pool);
+	vm->op_pool = NULL;
 }
 
 /**
@@ -146,6 +164,142 @@ RZ_API ut32 rz_il_vm_get_pc_len(RzILVM *vm) {
 	return rz_bv_len(vm->pc);
 }
 
+/**
+ * \brief Get the allocation counters of \p vm, including the ones of its op pool
+ */
+RZ_API void rz_il_vm_get_stats(RZ_NONNULL RzILVM *vm, RZ_NONNULL RZ_OUT RzILVMStats *stats) {
+	rz_return_if_fail(vm && stats);
+	*stats = vm->stats;
+	if (vm->op_pool) {
+		stats->op_allocs = vm->op_pool->allocs;
+		stats->op_reuses = vm->op_pool->reuses;
+	}
+}
+
+static void *pool_pop(RzPVector *pool, ut64 *allocs, ut64 *reuses, size_t size) {
+	if (rz_pvector_empty(pool)) {
+		(*allocs)++;
+		return malloc(size);
+	}
+	(*reuses)++;
+	return rz_pvector_pop(pool);
+}
+
+static bool pool_push(RzPVector *pool, void *ptr) {
+	return rz_pvector_len(pool) < RZ_IL_VM_POOL_MAX && rz_pvector_push(pool, ptr);
+}
+
+/**
+ * \brief Create a zeroed bitvector, taken from the pool of \p vm if possible
+ *
+ * The result is a regular RzBitVector which may also be freed with rz_bv_free(),
+ * but rz_il_vm_bv_release() gives it back to the pool.
+ */
+RZ_API RZ_OWN RzBitVector *rz_il_vm_bv_new(RZ_NONNULL RzILVM *vm, ut32 length) {
+	rz_return_val_if_fail(vm && length, NULL);
+	if (length > 64) {
+		vm->stats.bv_allocs++;
+		return rz_bv_new(length);
+	}
+	RzBitVector *bv = pool_pop(&vm->bv_pool, &vm->stats.bv_allocs, &vm->stats.bv_reuses, sizeof(RzBitVector));
+	if (!bv || !rz_bv_init(bv, length)) {
+		free(bv);
+		return NULL;
+	}
+	return bv;
+}
+
+/**
+ * \brief Same as rz_bv_dup(), but the copy is taken from the pool of \p vm if possible
+ */
+RZ_API RZ_OWN RzBitVector *rz_il_vm_bv_dup(RZ_NONNULL RzILVM *vm, RZ_NONNULL const RzBitVector *bv) {
+	rz_return_val_if_fail(vm && bv, NULL);
+	RzBitVector *r = rz_il_vm_bv_new(vm, bv->len);
+	if (!r) {
+		return NULL;
+	}
+	rz_bv_copy(bv, r);
+	return r;
+}
+
+/**
+ * \brief Give \p bv back to the pool of \p vm, or free it if it can't be reused
+ */
+RZ_API void rz_il_vm_bv_release(RZ_NONNULL RzILVM *vm, RZ_NULLABLE RZ_OWN RzBitVector *bv) {
+	rz_return_if_fail(vm);
+	if (!bv) {
+		return;
+	}
+	if (bv->len > 64 || !pool_push(&vm->bv_pool, bv)) {
+		rz_bv_free(bv);
+	}
+}
+
+/**
+ * \brief Same as rz_il_bool_new(), but the bool is taken from the pool of \p vm if possible
+ */
+RZ_API RZ_OWN RzILBool *rz_il_vm_bool_new(RZ_NONNULL RzILVM *vm, bool b) {
+	rz_return_val_if_fail(vm, NULL);
+	RzILBool *r = pool_pop(&vm->bool_pool, &vm->stats.bool_allocs, &vm->stats.bool_reuses, sizeof(RzILBool));
+	if (r) {
+		r->b = b;
+	}
+	return r;
+}
+
+/**
+ * \brief Give \p b back to the pool of \p vm, or free it if it can't be reused
+ */
+RZ_API void rz_il_vm_bool_release(RZ_NONNULL RzILVM *vm, RZ_NULLABLE RZ_OWN RzILBool *b) {
+	rz_return_if_fail(vm);
+	if (b && !pool_push(&vm->bool_pool, b)) {
+		rz_il_bool_free(b);
+	}
+}
+
+/**
+ * \brief Wrap \p data into a value, taken from the pool of \p vm if possible
+ * \param data RzBitVector or RzILBool, depending on \p type
+ */
+RZ_API RZ_OWN RzILVal *rz_il_vm_value_new(RZ_NONNULL RzILVM *vm, RzILTypePure type, RZ_NONNULL RZ_OWN void *data) {
+	rz_return_val_if_fail(vm && data, NULL);
+	RzILVal *r = pool_pop(&vm->val_pool, &vm->stats.val_allocs, &vm->stats.val_reuses, sizeof(RzILVal));
+	if (!r) {
+		return NULL;
+	}
+	r->type = type;
+	switch (type) {
+	case RZ_IL_TYPE_PURE_BOOL:
+		r->data.b = data;
+		break;
+	case RZ_IL_TYPE_PURE_BITVECTOR:
+		r->data.bv = data;
+		break;
+	}
+	return r;
+}
+
+/**
+ * \brief Give \p val and its contents back to the pools of \p vm, or free them if they can't be reused
+ */
+RZ_API void rz_il_vm_value_release(RZ_NONNULL RzILVM *vm, RZ_NULLABLE RZ_OWN RzILVal *val) {
+	rz_return_if_fail(vm);
+	if (!val) {
+		return;
+	}
+	switch (val->type) {
+	case RZ_IL_TYPE_PURE_BOOL:
+		rz_il_vm_bool_release(vm, val->data.b);
+		break;
+	case RZ_IL_TYPE_PURE_BITVECTOR:
+		rz_il_vm_bv_release(vm, val->data.bv);
+		break;
+	}
+	if (!pool_push(&vm->val_pool, val)) {
+		free(val);
+	}
+}
+
 /**
  * Add a memory to VM at the given index.
  * Ownership of the memory is transferred to the VM.
@@ -228,7 +382,7 @@ RZ_API void rz_il_vm_pop_local_pure_var(RZ_NONNULL RzILVM *vm, RZ_NONNULL const
 	rz_return_if_fail(vm && name);
 	RzILVal *r = rz_il_var_set_remove_var(&vm->local_pure_vars, name);
 	rz_warn_if_fail(r); // the var should always be bound when calling this function
-	rz_il_value_free(r);
+	rz_il_vm_value_release(vm, r);
 	if (prev) {
 		rz_il_var_set_create_var(&vm->local_pure_vars, name, rz_il_value_get_sort(prev));
 		rz_il_var_set_bind(&vm->local_pure_vars, name, prev);
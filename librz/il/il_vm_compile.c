@@ -0,0 +1,1098 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file
+ * Compilation of RzIL ops into trees of pre-bound closures.
+ *
+ * The compiled code computes on plain ut64 values instead of RzBitVector and RzILBool,
+ * does not dispatch on op codes and resolves all variables to slots when compiled,
+ * while producing exactly the same results and events as the interpreter in il_vm_eval.c.
+ * Only bitvectors of up to 64 bits are supported, ops using anything else are not compiled
+ * and must be interpreted instead.
+ */
+
+#include <rz_il/rz_il_vm.h>
+
+extern RZ_IPI RzILOpPureHandler rz_il_op_handler_pure_table_default[RZ_IL_OP_PURE_MAX];
+extern RZ_IPI RzILOpEffectHandler rz_il_op_handler_effect_table_default[RZ_IL_OP_EFFECT_MAX];
+RZ_IPI bool rz_il_vm_step_begin(RzILVM *vm, ut64 fallthrough_addr);
+RZ_IPI void rz_il_vm_step_end(RzILVM *vm);
+
+typedef struct il_exec_t ILExec;
+typedef struct il_pure_code_t ILPureCode;
+typedef struct il_effect_code_t ILEffectCode;
+
+typedef ut64 (*ILPureFn)(ILExec *x, const ILPureCode *c);
+typedef bool (*ILEffectFn)(ILExec *x, const ILEffectCode *c);
+
+/**
+ * \brief Compiled pure op, bools are 0 or 1
+ */
+struct il_pure_code_t {
+	ILPureFn fn;
+	ut32 len; ///< bits of the resulting bitvector, 0 for bools
+	ut32 idx; ///< variable slot, let slot or memory index
+	ut64 imm; ///< constant value
+	const ILPureCode *x, *y, *z; ///< operands, in evaluation order
+};
+
+/**
+ * \brief Compiled effect op
+ */
+struct il_effect_code_t {
+	ILEffectFn fn;
+	ut32 idx; ///< variable slot or memory index
+	const ILPureCode *x, *y; ///< operands, in evaluation order
+	const ILEffectCode *a, *b; ///< sub-effects
+	ILEffectCode **seq; ///< effects of a sequence
+	size_t seq_count;
+	RzILOpEffect *op; ///< source op, borrowed
+};
+
+/**
+ * \brief Variable referenced by compiled code
+ */
+typedef struct {
+	const char *name;
+	RzILVarKind kind; ///< only RZ_IL_VAR_KIND_GLOBAL or RZ_IL_VAR_KIND_LOCAL
+	RzILSortPure sort;
+	RzILVal *val; ///< value bound during execution, resolved at the beginning of every step
+	ut64 local; ///< value of a local variable if RzILCompiled.private_locals
+	bool local_set; ///< whether local has been set in the current step
+} ILVarSlot;
+
+struct rz_il_compiled_t {
+	RzILVM *vm; ///< vm the code was compiled for
+	RzPVector /*<void *>*/ nodes; ///< all ILPureCode and ILEffectCode
+	RzVector /*<ILVarSlot>*/ vars;
+	ut64 *lets; ///< values bound by let during execution
+	ut32 lets_count;
+	ILEffectCode *root;
+	bool interprets; ///< some effects are executed by the interpreter
+	bool private_locals; ///< local variables are only kept in their slots instead of the vm
+};
+
+struct il_exec_t {
+	RzILVM *vm;
+	RzILCompiled *code;
+	bool error; ///< a pure op failed, the current effect must fail
+};
+
+static inline ut64 len_mask(ut32 len) {
+	return UT64_MAX >> (64 - len);
+}
+
+static inline ut64 eval(ILExec *x, const ILPureCode *c) {
+	return c->fn(x, c);
+}
+
+static inline bool exec(ILExec *x, const ILEffectCode *c) {
+	return c->fn(x, c);
+}
+
+static void vars_resolve(ILExec *x) {
+	ILVarSlot *slot;
+	rz_vector_foreach(&x->code->vars, slot) {
+		if (slot->kind == RZ_IL_VAR_KIND_LOCAL && x->code->private_locals) {
+			continue;
+		}
+		RzILVarSet *vs = slot->kind == RZ_IL_VAR_KIND_GLOBAL ? &x->vm->global_vars : &x->vm->local_vars;
+		slot->val = rz_il_var_set_get_value(vs, slot->name);
+	}
+}
+
+/**
+ * Forget the private local variables of the previous step and resolve all others
+ */
+static void vars_begin(ILExec *x) {
+	if (x->code->private_locals) {
+		ILVarSlot *slot;
+		rz_vector_foreach(&x->code->vars, slot) {
+			slot->local_set = false;
+		}
+	}
+	vars_resolve(x);
+}
+
+static inline ILVarSlot *var_slot(ILExec *x, ut32 idx) {
+	return rz_vector_index_ptr(&x->code->vars, idx);
+}
+
+static inline ut64 val_get(RzILVal *val) {
+	return val->type == RZ_IL_TYPE_PURE_BOOL ? val->data.b->b : val->data.bv->bits.small_u;
+}
+
+/**
+ * \name Pure ops
+ * @{
+ */
+
+static ut64 pure_const(ILExec *x, const ILPureCode *c) {
+	return c->imm;
+}
+
+static ut64 pure_var(ILExec *x, const ILPureCode *c) {
+	ILVarSlot *slot = var_slot(x, c->idx);
+	if (slot->kind == RZ_IL_VAR_KIND_LOCAL && x->code->private_locals) {
+		if (!slot->local_set) {
+			RZ_LOG_ERROR("RzIL: reading value of variable \"%s\" of kind %s failed.\n",
+				slot->name, rz_il_var_kind_name(slot->kind));
+			x->error = true;
+		}
+		return slot->local;
+	}
+	if (!slot->val) {
+		RZ_LOG_ERROR("RzIL: reading value of variable \"%s\" of kind %s failed.\n",
+			slot->name, rz_il_var_kind_name(slot->kind));
+		x->error = true;
+		return 0;
+	}
+	if (slot->kind == RZ_IL_VAR_KIND_GLOBAL) {
+		rz_il_vm_event_add(x->vm, rz_il_event_var_read_new(slot->name, slot->val));
+	}
+	return val_get(slot->val);
+}
+
+static ut64 pure_let_var(ILExec *x, const ILPureCode *c) {
+	return x->code->lets[c->idx];
+}
+
+static ut64 pure_let(ILExec *x, const ILPureCode *c) {
+	ut64 v = eval(x, c->x);
+	if (x->error) {
+		return 0;
+	}
+	x->code->lets[c->idx] = v;
+	return eval(x, c->y);
+}
+
+static ut64 pure_ite(ILExec *x, const ILPureCode *c) {
+	ut64 cond = eval(x, c->x);
+	if (x->error) {
+		return 0;
+	}
+	return cond ? eval(x, c->y) : eval(x, c->z);
+}
+
+static ut64 pure_inv(ILExec *x, const ILPureCode *c) {
+	return !eval(x, c->x);
+}
+
+static ut64 pure_and(ILExec *x, const ILPureCode *c) {
+	ut64 a = eval(x, c->x);
+	return eval(x, c->y) & a;
+}
+
+static ut64 pure_or(ILExec *x, const ILPureCode *c) {
+	ut64 a = eval(x, c->x);
+	return eval(x, c->y) | a;
+}
+
+static ut64 pure_xor(ILExec *x, const ILPureCode *c) {
+	ut64 a = eval(x, c->x);
+	return eval(x, c->y) ^ a;
+}
+
+static ut64 pure_msb(ILExec *x, const ILPureCode *c) {
+	return (eval(x, c->x) >> (c->x->len - 1)) & 1;
+}
+
+static ut64 pure_lsb(ILExec *x, const ILPureCode *c) {
+	return eval(x, c->x) & 1;
+}
+
+static ut64 pure_is_zero(ILExec *x, const ILPureCode *c) {
+	return !eval(x, c->x);
+}
+
+static ut64 pure_neg(ILExec *x, const ILPureCode *c) {
+	return -eval(x, c->x) & len_mask(c->len);
+}
+
+static ut64 pure_lognot(ILExec *x, const ILPureCode *c) {
+	return ~eval(x, c->x) & len_mask(c->len);
+}
+
+#define PURE_BINOP(name, expr) \
+	static ut64 pure_##name(ILExec *x, const ILPureCode *c) { \
+		ut64 a = eval(x, c->x); \
+		ut64 b = eval(x, c->y); \
+		return (expr) & len_mask(c->len); \
+	}
+
+PURE_BINOP(add, a + b)
+PURE_BINOP(sub, a - b)
+PURE_BINOP(mul, a * b)
+PURE_BINOP(logand, a & b)
+PURE_BINOP(logor, a | b)
+PURE_BINOP(logxor, a ^ b)
+PURE_BINOP(mod, b ? a % b : a)
+
+#undef PURE_BINOP
+
+static ut64 pure_div(ILExec *x, const ILPureCode *c) {
+	ut64 a = eval(x, c->x);
+	ut64 b = eval(x, c->y);
+	if (x->error) {
+		return 0;
+	}
+	if (!b) {
+		rz_il_vm_event_add(x->vm, rz_il_event_exception_new("division by zero"));
+		return len_mask(c->len);
+	}
+	return a / b;
+}
+
+/**
+ * Signed division and modulo are rare, so just run the bitvector implementation on them
+ */
+static ut64 pure_signed_divmod(ILExec *x, const ILPureCode *c, RzBitVector *(*op)(RzBitVector *, RzBitVector *)) {
+	ut64 a = eval(x, c->x);
+	ut64 b = eval(x, c->y);
+	if (x->error) {
+		return 0;
+	}
+	RzBitVector bx, by;
+	rz_bv_init(&bx, c->len);
+	rz_bv_init(&by, c->len);
+	rz_bv_set_from_ut64(&bx, a);
+	rz_bv_set_from_ut64(&by, b);
+	RzBitVector *r = op(&bx, &by);
+	if (!r) {
+		x->error = true;
+		return 0;
+	}
+	ut64 v = rz_bv_to_ut64(r);
+	rz_bv_free(r);
+	return v;
+}
+
+static ut64 pure_sdiv(ILExec *x, const ILPureCode *c) {
+	return pure_signed_divmod(x, c, rz_bv_sdiv);
+}
+
+static ut64 pure_smod(ILExec *x, const ILPureCode *c) {
+	return pure_signed_divmod(x, c, rz_bv_smod);
+}
+
+static ut64 pure_shiftl(ILExec *x, const ILPureCode *c) {
+	ut64 v = eval(x, c->x);
+	ut32 shift = eval(x, c->y) & UT32_MAX;
+	ut64 fill = eval(x, c->z);
+	if (!shift) {
+		return v;
+	}
+	if (shift >= c->len) {
+		return fill ? len_mask(c->len) : 0;
+	}
+	v <<= shift;
+	if (fill) {
+		v |= len_mask(shift);
+	}
+	return v & len_mask(c->len);
+}
+
+static ut64 pure_shiftr(ILExec *x, const ILPureCode *c) {
+	ut64 v = eval(x, c->x);
+	ut32 shift = eval(x, c->y) & UT32_MAX;
+	ut64 fill = eval(x, c->z);
+	if (!shift) {
+		return v;
+	}
+	if (shift >= c->len) {
+		return fill ? len_mask(c->len) : 0;
+	}
+	v >>= shift;
+	if (fill) {
+		v |= len_mask(c->len) & ~len_mask(c->len - shift);
+	}
+	return v;
+}
+
+static ut64 pure_eq(ILExec *x, const ILPureCode *c) {
+	ut64 a = eval(x, c->x);
+	return a == eval(x, c->y);
+}
+
+static ut64 pure_ule(ILExec *x, const ILPureCode *c) {
+	ut64 a = eval(x, c->x);
+	return a <= eval(x, c->y);
+}
+
+static ut64 pure_sle(ILExec *x, const ILPureCode *c) {
+	ut64 a = eval(x, c->x);
+	ut64 b = eval(x, c->y);
+	ut32 sign = c->x->len - 1;
+	bool ma = (a >> sign) & 1;
+	bool mb = (b >> sign) & 1;
+	return ma == mb ? a <= b : ma;
+}
+
+static ut64 pure_cast(ILExec *x, const ILPureCode *c) {
+	// the fill bit is evaluated first, as in rz_il_handler_cast()
+	ut64 fill = eval(x, c->x);
+	if (x->error) {
+		return 0;
+	}
+	ut64 v = eval(x, c->y);
+	if (fill && c->y->len < 64) {
+		v |= UT64_MAX << c->y->len;
+	}
+	return v & len_mask(c->len);
+}
+
+static ut64 pure_append(ILExec *x, const ILPureCode *c) {
+	ut64 high = eval(x, c->x);
+	ut64 low = eval(x, c->y);
+	return (high << c->y->len) | low;
+}
+
+static ut64 pure_load(ILExec *x, const ILPureCode *c) {
+	ut64 key = eval(x, c->x);
+	if (x->error) {
+		return 0;
+	}
+	RzBitVector bkey;
+	rz_bv_init(&bkey, c->x->len);
+	rz_bv_set_from_ut64(&bkey, key);
+	RzBitVector *v = c->imm
+		? rz_il_vm_mem_loadw(x->vm, c->idx, &bkey, c->len)
+		: rz_il_vm_mem_load(x->vm, c->idx, &bkey);
+	if (!v) {
+		x->error = true;
+		return 0;
+	}
+	key = rz_bv_to_ut64(v);
+	rz_bv_free(v);
+	return key;
+}
+
+/// @}
+
+/**
+ * \name Effect ops
+ * @{
+ */
+
+static bool effect_nop(ILExec *x, const ILEffectCode *c) {
+	return true;
+}
+
+/**
+ * Effects that need the full vm, like goto with its hooks, are interpreted.
+ */
+static bool effect_interpret(ILExec *x, const ILEffectCode *c) {
+	bool r = rz_il_evaluate_effect(x->vm, c->op);
+	// the interpreter may have bound new values
+	vars_resolve(x);
+	return r;
+}
+
+static bool effect_seq(ILExec *x, const ILEffectCode *c) {
+	for (size_t i = 0; i < c->seq_count; i++) {
+		if (!exec(x, c->seq[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool effect_label(ILExec *x, const ILEffectCode *c) {
+	rz_il_vm_create_label(x->vm, c->op->op.blk.label, x->vm->pc);
+	return true;
+}
+
+static bool effect_set(ILExec *x, const ILEffectCode *c) {
+	ILVarSlot *slot = var_slot(x, c->idx);
+	if (slot->kind == RZ_IL_VAR_KIND_GLOBAL && !slot->val) {
+		// let the interpreter report the error
+		return effect_interpret(x, c);
+	}
+	ut64 v = eval(x, c->x);
+	if (x->error) {
+		return false;
+	}
+	if (slot->kind == RZ_IL_VAR_KIND_LOCAL && x->code->private_locals) {
+		slot->local = v;
+		slot->local_set = true;
+		return true;
+	}
+	RzILVal *cur = slot->val;
+	bool is_bool = !c->x->len;
+	if (cur && cur->type == (is_bool ? RZ_IL_TYPE_PURE_BOOL : RZ_IL_TYPE_PURE_BITVECTOR) &&
+		(is_bool || rz_bv_len(cur->data.bv) == c->x->len)) {
+		// same as il_set_in_place()
+		if (slot->kind == RZ_IL_VAR_KIND_GLOBAL) {
+			RzBitVector bv;
+			RzILBool b = { .b = v };
+			RzILVal new_val = { .type = cur->type };
+			if (is_bool) {
+				new_val.data.b = &b;
+			} else {
+				rz_bv_init(&bv, c->x->len);
+				rz_bv_set_from_ut64(&bv, v);
+				new_val.data.bv = &bv;
+			}
+			rz_il_vm_event_add(x->vm, rz_il_event_var_write_new(slot->name, cur, &new_val));
+		}
+		if (is_bool) {
+			cur->data.b->b = v;
+		} else {
+			cur->data.bv->bits.small_u = v;
+		}
+		return true;
+	}
+	// first assignment of a local variable in this step
+	RzILVal *val;
+	if (is_bool) {
+		val = rz_il_vm_value_new(x->vm, RZ_IL_TYPE_PURE_BOOL, rz_il_vm_bool_new(x->vm, v));
+	} else {
+		RzBitVector *bv = rz_il_vm_bv_new(x->vm, c->x->len);
+		if (!bv) {
+			return false;
+		}
+		rz_bv_set_from_ut64(bv, v);
+		val = rz_il_vm_value_new(x->vm, RZ_IL_TYPE_PURE_BITVECTOR, bv);
+	}
+	if (!val) {
+		return false;
+	}
+	rz_il_vm_set_local_var(x->vm, slot->name, val);
+	slot->val = rz_il_var_set_get_value(&x->vm->local_vars, slot->name);
+	return true;
+}
+
+static bool effect_jmp(ILExec *x, const ILEffectCode *c) {
+	ut64 v = eval(x, c->x);
+	if (x->error) {
+		return false;
+	}
+	RzBitVector *dst = rz_il_vm_bv_new(x->vm, c->x->len);
+	if (!dst) {
+		return false;
+	}
+	rz_bv_set_from_ut64(dst, v);
+	rz_il_vm_event_add(x->vm, rz_il_event_pc_write_new(x->vm->pc, dst));
+	rz_il_vm_bv_release(x->vm, x->vm->pc);
+	x->vm->pc = dst;
+	return true;
+}
+
+static bool effect_branch(ILExec *x, const ILEffectCode *c) {
+	ut64 cond = eval(x, c->x);
+	if (x->error) {
+		return false;
+	}
+	return exec(x, cond ? c->a : c->b);
+}
+
+static bool effect_repeat(ILExec *x, const ILEffectCode *c) {
+	bool res = true;
+	while (true) {
+		ut64 cond = eval(x, c->x);
+		if (x->error) {
+			// rz_il_handler_repeat() just stops on a failing condition
+			x->error = false;
+			break;
+		}
+		if (!cond) {
+			break;
+		}
+		res = res && exec(x, c->a);
+	}
+	return res;
+}
+
+static bool effect_store(ILExec *x, const ILEffectCode *c) {
+	ut64 key = eval(x, c->x);
+	ut64 v = eval(x, c->y);
+	if (x->error) {
+		return false;
+	}
+	RzBitVector bkey, bv;
+	rz_bv_init(&bkey, c->x->len);
+	rz_bv_set_from_ut64(&bkey, key);
+	rz_bv_init(&bv, c->y->len);
+	rz_bv_set_from_ut64(&bv, v);
+	if (c->op->code == RZ_IL_OP_STOREW) {
+		rz_il_vm_mem_storew(x->vm, c->idx, &bkey, &bv);
+	} else {
+		rz_il_vm_mem_store(x->vm, c->idx, &bkey, &bv);
+	}
+	return true;
+}
+
+/// @}
+
+/**
+ * \name Compiler
+ * @{
+ */
+
+typedef struct {
+	const char *name;
+	ut32 idx;
+	ut32 len;
+} ILLetScope;
+
+typedef struct {
+	RzILVM *vm;
+	RzILCompiled *code;
+	RzVector /*<ILLetScope>*/ lets; ///< let-bound variables visible at the current op, innermost last
+} ILCompiler;
+
+static void *node_new(ILCompiler *cc, size_t size) {
+	void *r = calloc(1, size);
+	if (r && !rz_pvector_push(&cc->code->nodes, r)) {
+		free(r);
+		return NULL;
+	}
+	return r;
+}
+
+static bool sort_len(RzILSortPure sort, ut32 *len) {
+	if (sort.type == RZ_IL_TYPE_PURE_BOOL) {
+		*len = 0;
+		return true;
+	}
+	if (sort.type == RZ_IL_TYPE_PURE_BITVECTOR && sort.props.bv.length && sort.props.bv.length <= 64) {
+		*len = sort.props.bv.length;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Get the slot of the global or local variable \p name, adding it if necessary
+ */
+static ILVarSlot *var_slot_get(ILCompiler *cc, const char *name, RzILVarKind kind, ut32 *idx) {
+	ILVarSlot *slot;
+	ut32 i = 0;
+	rz_vector_foreach(&cc->code->vars, slot) {
+		if (slot->kind == kind && !strcmp(slot->name, name)) {
+			*idx = i;
+			return slot;
+		}
+		i++;
+	}
+	RzILSortPure sort = { 0 };
+	if (kind == RZ_IL_VAR_KIND_GLOBAL) {
+		RzILVar *var = rz_il_vm_get_var(cc->vm, RZ_IL_VAR_KIND_GLOBAL, name);
+		if (!var) {
+			return NULL;
+		}
+		sort = var->sort;
+	} else {
+		// unknown until the first set
+		sort.type = -1;
+	}
+	slot = rz_vector_push(&cc->code->vars, NULL);
+	if (!slot) {
+		return NULL;
+	}
+	slot->name = name;
+	slot->kind = kind;
+	slot->sort = sort;
+	slot->val = NULL;
+	*idx = i;
+	return slot;
+}
+
+static const ILPureCode *compile_pure(ILCompiler *cc, RzILOpPure *op);
+
+static ILPureCode *pure_new(ILCompiler *cc, ILPureFn fn, ut32 len) {
+	ILPureCode *c = node_new(cc, sizeof(ILPureCode));
+	if (c) {
+		c->fn = fn;
+		c->len = len;
+	}
+	return c;
+}
+
+static ILPureCode *compile_var(ILCompiler *cc, RzILOpArgsVar *args) {
+	if (args->kind == RZ_IL_VAR_KIND_LOCAL_PURE) {
+		for (size_t i = rz_vector_len(&cc->lets); i; i--) {
+			ILLetScope *scope = rz_vector_index_ptr(&cc->lets, i - 1);
+			if (!strcmp(scope->name, args->v)) {
+				ILPureCode *c = pure_new(cc, pure_let_var, scope->len);
+				if (c) {
+					c->idx = scope->idx;
+				}
+				return c;
+			}
+		}
+		return NULL;
+	}
+	ut32 idx, len;
+	ILVarSlot *slot = var_slot_get(cc, args->v, args->kind, &idx);
+	if (!slot || !sort_len(slot->sort, &len)) {
+		return NULL;
+	}
+	ILPureCode *c = pure_new(cc, pure_var, len);
+	if (c) {
+		c->idx = idx;
+	}
+	return c;
+}
+
+static ILPureCode *compile_let(ILCompiler *cc, RzILOpArgsLet *args) {
+	const ILPureCode *exp = compile_pure(cc, args->exp);
+	if (!exp) {
+		return NULL;
+	}
+	ILLetScope *scope = rz_vector_push(&cc->lets, NULL);
+	if (!scope) {
+		return NULL;
+	}
+	scope->name = args->name;
+	scope->idx = cc->code->lets_count++;
+	scope->len = exp->len;
+	ut32 idx = scope->idx;
+	const ILPureCode *body = compile_pure(cc, args->body);
+	rz_vector_pop(&cc->lets, NULL);
+	if (!body) {
+		return NULL;
+	}
+	ILPureCode *c = pure_new(cc, pure_let, body->len);
+	if (c) {
+		c->idx = idx;
+		c->x = exp;
+		c->y = body;
+	}
+	return c;
+}
+
+/**
+ * Compile the operands \p ops, which must have the lengths \p lens (UT32_MAX for any bitvector)
+ */
+static bool compile_operands(ILCompiler *cc, size_t n, RzILOpPure **ops, const ut32 *lens, const ILPureCode **out) {
+	for (size_t i = 0; i < n; i++) {
+		out[i] = compile_pure(cc, ops[i]);
+		if (!out[i]) {
+			return false;
+		}
+		if (lens[i] == UT32_MAX ? !out[i]->len : out[i]->len != lens[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+#define BV UT32_MAX
+
+static const ILPureCode *compile_pure(ILCompiler *cc, RzILOpPure *op) {
+	if (!op || op->code >= RZ_IL_OP_PURE_MAX ||
+		cc->vm->op_handler_pure_table[op->code] != rz_il_op_handler_pure_table_default[op->code]) {
+		return NULL;
+	}
+	const ILPureCode *a[3] = { 0 };
+	ILPureFn fn = NULL;
+	ut32 len = 0;
+	switch (op->code) {
+	case RZ_IL_OP_VAR:
+		return compile_var(cc, &op->op.var);
+	case RZ_IL_OP_LET:
+		return compile_let(cc, &op->op.let);
+	case RZ_IL_OP_ITE: {
+		RzILOpPure *ops[] = { op->op.ite.condition, op->op.ite.x, op->op.ite.y };
+		if (!compile_operands(cc, 1, ops, (ut32[]){ 0 }, a)) {
+			return NULL;
+		}
+		a[1] = compile_pure(cc, ops[1]);
+		a[2] = compile_pure(cc, ops[2]);
+		if (!a[1] || !a[2] || a[1]->len != a[2]->len) {
+			return NULL;
+		}
+		fn = pure_ite;
+		len = a[1]->len;
+		break;
+	}
+	case RZ_IL_OP_B0:
+	case RZ_IL_OP_B1: {
+		ILPureCode *c = pure_new(cc, pure_const, 0);
+		if (c) {
+			c->imm = op->code == RZ_IL_OP_B1;
+		}
+		return c;
+	}
+	case RZ_IL_OP_BITV: {
+		RzBitVector *bv = op->op.bitv.value;
+		if (!bv || !bv->len || bv->len > 64) {
+			return NULL;
+		}
+		ILPureCode *c = pure_new(cc, pure_const, bv->len);
+		if (c) {
+			c->imm = rz_bv_to_ut64(bv);
+		}
+		return c;
+	}
+	case RZ_IL_OP_INV:
+		if (!compile_operands(cc, 1, &op->op.boolinv.x, (ut32[]){ 0 }, a)) {
+			return NULL;
+		}
+		fn = pure_inv;
+		break;
+	case RZ_IL_OP_AND:
+	case RZ_IL_OP_OR:
+	case RZ_IL_OP_XOR: {
+		RzILOpPure *ops[] = { op->op.booland.x, op->op.booland.y };
+		if (!compile_operands(cc, 2, ops, (ut32[]){ 0, 0 }, a)) {
+			return NULL;
+		}
+		fn = op->code == RZ_IL_OP_AND ? pure_and : op->code == RZ_IL_OP_OR ? pure_or : pure_xor;
+		break;
+	}
+	case RZ_IL_OP_MSB:
+	case RZ_IL_OP_LSB:
+	case RZ_IL_OP_IS_ZERO:
+		if (!compile_operands(cc, 1, &op->op.msb.bv, (ut32[]){ BV }, a)) {
+			return NULL;
+		}
+		fn = op->code == RZ_IL_OP_MSB ? pure_msb : op->code == RZ_IL_OP_LSB ? pure_lsb : pure_is_zero;
+		break;
+	case RZ_IL_OP_NEG:
+	case RZ_IL_OP_LOGNOT:
+		if (!compile_operands(cc, 1, &op->op.neg.bv, (ut32[]){ BV }, a)) {
+			return NULL;
+		}
+		fn = op->code == RZ_IL_OP_NEG ? pure_neg : pure_lognot;
+		len = a[0]->len;
+		break;
+	case RZ_IL_OP_ADD:
+	case RZ_IL_OP_SUB:
+	case RZ_IL_OP_MUL:
+	case RZ_IL_OP_DIV:
+	case RZ_IL_OP_SDIV:
+	case RZ_IL_OP_MOD:
+	case RZ_IL_OP_SMOD:
+	case RZ_IL_OP_LOGAND:
+	case RZ_IL_OP_LOGOR:
+	case RZ_IL_OP_LOGXOR:
+	case RZ_IL_OP_EQ:
+	case RZ_IL_OP_SLE:
+	case RZ_IL_OP_ULE: {
+		RzILOpPure *ops[] = { op->op.add.x, op->op.add.y };
+		if (!compile_operands(cc, 2, ops, (ut32[]){ BV, BV }, a) || a[0]->len != a[1]->len) {
+			return NULL;
+		}
+		static const ILPureFn fns[RZ_IL_OP_PURE_MAX] = {
+			[RZ_IL_OP_ADD] = pure_add,
+			[RZ_IL_OP_SUB] = pure_sub,
+			[RZ_IL_OP_MUL] = pure_mul,
+			[RZ_IL_OP_DIV] = pure_div,
+			[RZ_IL_OP_SDIV] = pure_sdiv,
+			[RZ_IL_OP_MOD] = pure_mod,
+			[RZ_IL_OP_SMOD] = pure_smod,
+			[RZ_IL_OP_LOGAND] = pure_logand,
+			[RZ_IL_OP_LOGOR] = pure_logor,
+			[RZ_IL_OP_LOGXOR] = pure_logxor,
+			[RZ_IL_OP_EQ] = pure_eq,
+			[RZ_IL_OP_SLE] = pure_sle,
+			[RZ_IL_OP_ULE] = pure_ule,
+		};
+		fn = fns[op->code];
+		bool cmp = op->code == RZ_IL_OP_EQ || op->code == RZ_IL_OP_SLE || op->code == RZ_IL_OP_ULE;
+		len = cmp ? 0 : a[0]->len;
+		break;
+	}
+	case RZ_IL_OP_SHIFTR:
+	case RZ_IL_OP_SHIFTL: {
+		RzILOpPure *ops[] = { op->op.shiftl.x, op->op.shiftl.y, op->op.shiftl.fill_bit };
+		if (!compile_operands(cc, 3, ops, (ut32[]){ BV, BV, 0 }, a)) {
+			return NULL;
+		}
+		fn = op->code == RZ_IL_OP_SHIFTL ? pure_shiftl : pure_shiftr;
+		len = a[0]->len;
+		break;
+	}
+	case RZ_IL_OP_CAST: {
+		RzILOpPure *ops[] = { op->op.cast.fill, op->op.cast.val };
+		len = op->op.cast.length;
+		if (!len || len > 64 || !compile_operands(cc, 2, ops, (ut32[]){ 0, BV }, a)) {
+			return NULL;
+		}
+		fn = pure_cast;
+		break;
+	}
+	case RZ_IL_OP_APPEND: {
+		RzILOpPure *ops[] = { op->op.append.high, op->op.append.low };
+		if (!compile_operands(cc, 2, ops, (ut32[]){ BV, BV }, a) || a[0]->len + a[1]->len > 64) {
+			return NULL;
+		}
+		fn = pure_append;
+		len = a[0]->len + a[1]->len;
+		break;
+	}
+	case RZ_IL_OP_LOAD:
+	case RZ_IL_OP_LOADW: {
+		RzILMemIndex idx = op->code == RZ_IL_OP_LOAD ? op->op.load.mem : op->op.loadw.mem;
+		RzILMem *mem = rz_il_vm_get_mem(cc->vm, idx);
+		if (!mem) {
+			return NULL;
+		}
+		len = op->code == RZ_IL_OP_LOAD ? rz_il_mem_value_len(mem) : op->op.loadw.n_bits;
+		if (!len || len > 64 || !compile_operands(cc, 1, &op->op.load.key, (ut32[]){ BV }, a)) {
+			return NULL;
+		}
+		ILPureCode *c = pure_new(cc, pure_load, len);
+		if (c) {
+			c->idx = idx;
+			c->imm = op->code == RZ_IL_OP_LOADW;
+			c->x = a[0];
+		}
+		return c;
+	}
+	default:
+		return NULL;
+	}
+	ILPureCode *c = pure_new(cc, fn, len);
+	if (c) {
+		c->x = a[0];
+		c->y = a[1];
+		c->z = a[2];
+	}
+	return c;
+}
+
+static ILEffectCode *compile_effect(ILCompiler *cc, RzILOpEffect *op);
+
+static ILEffectCode *effect_new(ILCompiler *cc, ILEffectFn fn, RzILOpEffect *op) {
+	ILEffectCode *c = node_new(cc, sizeof(ILEffectCode));
+	if (c) {
+		c->fn = fn;
+		c->op = op;
+	}
+	return c;
+}
+
+/**
+ * Flatten nested sequences into \p seq
+ */
+static bool compile_seq(ILCompiler *cc, RzILOpEffect *op, RzPVector *seq) {
+	if (op->code == RZ_IL_OP_SEQ) {
+		return compile_seq(cc, op->op.seq.x, seq) && compile_seq(cc, op->op.seq.y, seq);
+	}
+	if (op->code == RZ_IL_OP_NOP) {
+		return true;
+	}
+	ILEffectCode *c = compile_effect(cc, op);
+	return c && rz_pvector_push(seq, c);
+}
+
+static ILEffectCode *seq_new(ILCompiler *cc, RzILOpEffect *op, RzPVector *seq) {
+	if (rz_pvector_len(seq) == 1) {
+		return rz_pvector_at(seq, 0);
+	}
+	ILEffectCode *c = effect_new(cc, rz_pvector_empty(seq) ? effect_nop : effect_seq, op);
+	if (!c || rz_pvector_empty(seq)) {
+		return c;
+	}
+	ILEffectCode **arr = RZ_NEWS(ILEffectCode *, rz_pvector_len(seq));
+	if (!arr || !rz_pvector_push(&cc->code->nodes, arr)) {
+		free(arr);
+		return NULL;
+	}
+	memcpy(arr, rz_pvector_data(seq), sizeof(ILEffectCode *) * rz_pvector_len(seq));
+	c->seq = arr;
+	c->seq_count = rz_pvector_len(seq);
+	return c;
+}
+
+static ILEffectCode *compile_set(ILCompiler *cc, RzILOpEffect *op) {
+	RzILOpArgsSet *args = &op->op.set;
+	const ILPureCode *x = compile_pure(cc, args->x);
+	if (!x) {
+		return NULL;
+	}
+	ut32 idx, len;
+	ILVarSlot *slot = var_slot_get(cc, args->v, args->is_local ? RZ_IL_VAR_KIND_LOCAL : RZ_IL_VAR_KIND_GLOBAL, &idx);
+	if (!slot) {
+		return NULL;
+	}
+	if (slot->kind == RZ_IL_VAR_KIND_LOCAL && slot->sort.type == (RzILTypePure)-1) {
+		slot->sort = x->len ? rz_il_sort_pure_bv(x->len) : rz_il_sort_pure_bool();
+	}
+	if (!sort_len(slot->sort, &len) || len != x->len) {
+		return NULL;
+	}
+	ILEffectCode *c = effect_new(cc, effect_set, op);
+	if (c) {
+		c->idx = idx;
+		c->x = x;
+	}
+	return c;
+}
+
+static ILEffectCode *compile_effect(ILCompiler *cc, RzILOpEffect *op) {
+	if (!op || op->code >= RZ_IL_OP_EFFECT_MAX ||
+		cc->vm->op_handler_effect_table[op->code] != rz_il_op_handler_effect_table_default[op->code]) {
+		return NULL;
+	}
+	ILEffectCode *c = NULL;
+	switch (op->code) {
+	case RZ_IL_OP_NOP:
+		return effect_new(cc, effect_nop, op);
+	case RZ_IL_OP_EMPTY:
+	case RZ_IL_OP_GOTO:
+		cc->code->interprets = true;
+		return effect_new(cc, effect_interpret, op);
+	case RZ_IL_OP_SET:
+		return compile_set(cc, op);
+	case RZ_IL_OP_JMP: {
+		const ILPureCode *dst = compile_pure(cc, op->op.jmp.dst);
+		if (!dst || !dst->len) {
+			return NULL;
+		}
+		c = effect_new(cc, effect_jmp, op);
+		if (c) {
+			c->x = dst;
+		}
+		return c;
+	}
+	case RZ_IL_OP_SEQ:
+	case RZ_IL_OP_BLK: {
+		RzPVector seq;
+		rz_pvector_init(&seq, NULL);
+		bool succ = true;
+		if (op->code == RZ_IL_OP_SEQ) {
+			succ = compile_seq(cc, op, &seq);
+		} else {
+			if (op->op.blk.label) {
+				ILEffectCode *label = effect_new(cc, effect_label, op);
+				succ = label && rz_pvector_push(&seq, label);
+			}
+			succ = succ && compile_seq(cc, op->op.blk.data_eff, &seq) && compile_seq(cc, op->op.blk.ctrl_eff, &seq);
+		}
+		c = succ ? seq_new(cc, op, &seq) : NULL;
+		rz_pvector_fini(&seq);
+		return c;
+	}
+	case RZ_IL_OP_BRANCH: {
+		const ILPureCode *cond = compile_pure(cc, op->op.branch.condition);
+		if (!cond || cond->len) {
+			return NULL;
+		}
+		const ILEffectCode *t = compile_effect(cc, op->op.branch.true_eff);
+		const ILEffectCode *f = t ? compile_effect(cc, op->op.branch.false_eff) : NULL;
+		if (!f) {
+			return NULL;
+		}
+		c = effect_new(cc, effect_branch, op);
+		if (c) {
+			c->x = cond;
+			c->a = t;
+			c->b = f;
+		}
+		return c;
+	}
+	case RZ_IL_OP_REPEAT: {
+		const ILPureCode *cond = compile_pure(cc, op->op.repeat.condition);
+		if (!cond || cond->len) {
+			return NULL;
+		}
+		const ILEffectCode *body = compile_effect(cc, op->op.repeat.data_eff);
+		if (!body) {
+			return NULL;
+		}
+		c = effect_new(cc, effect_repeat, op);
+		if (c) {
+			c->x = cond;
+			c->a = body;
+		}
+		return c;
+	}
+	case RZ_IL_OP_STORE:
+	case RZ_IL_OP_STOREW: {
+		RzILMemIndex idx = op->code == RZ_IL_OP_STORE ? op->op.store.mem : op->op.storew.mem;
+		if (!rz_il_vm_get_mem(cc->vm, idx)) {
+			return NULL;
+		}
+		const ILPureCode *key = compile_pure(cc, op->op.store.key);
+		const ILPureCode *val = key ? compile_pure(cc, op->op.store.value) : NULL;
+		if (!val || !key->len || !val->len) {
+			return NULL;
+		}
+		c = effect_new(cc, effect_store, op);
+		if (c) {
+			c->idx = idx;
+			c->x = key;
+			c->y = val;
+		}
+		return c;
+	}
+	default:
+		return NULL;
+	}
+}
+
+#undef BV
+
+/// @}
+
+/**
+ * \brief Compile \p op to be executed faster in \p vm
+ *
+ * The compiled code gives the same results and events as interpreting \p op,
+ * but it only supports bitvectors of up to 64 bits and the default op handlers.
+ *
+ * \param op the op to compile, which must be kept alive and unchanged as long as the compiled code is used
+ * \return the compiled code or NULL if \p op can not be compiled and must be interpreted with rz_il_vm_step()
+ */
+RZ_API RZ_OWN RZ_NULLABLE RzILCompiled *rz_il_compile_effect(RZ_NONNULL RzILVM *vm, RZ_NONNULL RZ_BORROW RzILOpEffect *op) {
+	rz_return_val_if_fail(vm && op, NULL);
+	RzILCompiled *code = RZ_NEW0(RzILCompiled);
+	if (!code) {
+		return NULL;
+	}
+	code->vm = vm;
+	rz_pvector_init(&code->nodes, free);
+	rz_vector_init(&code->vars, sizeof(ILVarSlot), NULL, NULL);
+	ILCompiler cc = { .vm = vm, .code = code };
+	rz_vector_init(&cc.lets, sizeof(ILLetScope), NULL, NULL);
+	code->root = compile_effect(&cc, op);
+	rz_vector_fini(&cc.lets);
+	if (!code->root) {
+		goto fail;
+	}
+	// the interpreter needs the local variables in the vm, otherwise they never leave the compiled code
+	code->private_locals = !code->interprets;
+	if (code->lets_count) {
+		code->lets = RZ_NEWS0(ut64, code->lets_count);
+		if (!code->lets) {
+			goto fail;
+		}
+	}
+	return code;
+fail:
+	rz_il_compiled_free(code);
+	return NULL;
+}
+
+RZ_API void rz_il_compiled_free(RZ_NULLABLE RzILCompiled *code) {
+	if (!code) {
+		return;
+	}
+	rz_pvector_fini(&code->nodes);
+	rz_vector_fini(&code->vars);
+	free(code->lets);
+	free(code);
+}
+
+/**
+ * \brief Execute the compiled code of a single instruction, like rz_il_vm_step() does for its op
+ *
+ * \param code code compiled with rz_il_compile_effect() for \p vm
+ * \param fallthrough_addr initial address to set PC to. Thus also the address to "step to" if no explicit jump occurs.
+ */
+RZ_API bool rz_il_vm_step_compiled(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILCompiled *code, ut64 fallthrough_addr) {
+	rz_return_val_if_fail(vm && code && code->vm == vm, false);
+	if (!rz_il_vm_step_begin(vm, fallthrough_addr)) {
+		return false;
+	}
+	ILExec x = { .vm = vm, .code = code };
+	vars_begin(&x);
+	bool succ = exec(&x, code->root);
+	rz_il_vm_step_end(vm);
+	return succ;
+}
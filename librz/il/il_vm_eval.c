@@ -60,6 +60,9 @@ bool rz_il_handler_store(RzILVM *vm, RzILOpEffect *op);
 void *rz_il_handler_loadw(RzILVM *vm, RzILOpPure *op, RzILTypePure *type);
 bool rz_il_handler_storew(RzILVM *vm, RzILOpEffect *op);
 
+RZ_IPI bool rz_il_vm_step_begin(RzILVM *vm, ut64 fallthrough_addr);
+RZ_IPI void rz_il_vm_step_end(RzILVM *vm);
+
 // TODO: remove me when all the handlers are implemented
 void *rz_il_handler_pure_unimplemented(RzILVM *vm, RzILOpPure *op, RzILTypePure *type);
 bool rz_il_handler_effect_unimplemented(RzILVM *vm, RzILOpEffect *op);
@@ -221,20 +224,42 @@ RZ_API void rz_il_vm_clear_events(RzILVM *vm) {
  */
 RZ_API bool rz_il_vm_step(RzILVM *vm, RzILOpEffect *op, ut64 fallthrough_addr) {
 	rz_return_val_if_fail(vm && op, false);
+	if (!rz_il_vm_step_begin(vm, fallthrough_addr)) {
+		return false;
+	}
+	bool succ = rz_il_evaluate_effect(vm, op);
+	rz_il_vm_step_end(vm);
+	return succ;
+}
 
+/**
+ * Start a step of \p vm: clear the events of the last one and set pc to \p fallthrough_addr
+ */
+RZ_IPI bool rz_il_vm_step_begin(RzILVM *vm, ut64 fallthrough_addr) {
 	rz_il_vm_clear_events(vm);
 
+	vm->stats.steps++;
+
 	// Set the successor pc **before** evaluating. Any jmp/goto may then overwrite it again.
-	RzBitVector *next_pc = rz_bv_new_from_ut64(vm->pc->len, fallthrough_addr);
+	RzBitVector *next_pc = rz_il_vm_bv_new(vm, vm->pc->len);
+	if (!next_pc) {
+		return false;
+	}
+	rz_bv_set_from_ut64(next_pc, fallthrough_addr);
 	rz_il_vm_event_add(vm, rz_il_event_pc_write_new(vm->pc, next_pc));
-	rz_bv_free(vm->pc);
+	rz_il_vm_bv_release(vm, vm->pc);
 	vm->pc = next_pc;
+	return true;
+}
 
-	bool succ = rz_il_evaluate_effect(vm, op);
-
+/**
+ * Finish a step of \p vm started with rz_il_vm_step_begin()
+ */
+RZ_IPI void rz_il_vm_step_end(RzILVM *vm) {
 	// remove any local defined variable (local pure vars are unbound automatically)
-	rz_il_var_set_reset(&vm->local_vars);
-	return succ;
+	if (vm->local_vars.vars->count) {
+		rz_il_var_set_reset(&vm->local_vars);
+	}
 }
 
 static void *eval_pure(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILOpPure *op, RZ_NONNULL RzILTypePure *type) {
@@ -317,9 +342,8 @@ RZ_API RZ_NULLABLE RZ_OWN RzILVal *rz_il_evaluate_val(RZ_NONNULL RzILVM *vm, RZ_
 	}
 	switch (type) {
 	case RZ_IL_TYPE_PURE_BOOL:
-		return rz_il_value_new_bool(res);
 	case RZ_IL_TYPE_PURE_BITVECTOR:
-		return rz_il_value_new_bitv(res);
+		return rz_il_vm_value_new(vm, type, res);
 	default:
 		RZ_LOG_ERROR("RzIL: type error: got %s\n", pure_type_name(type));
 		return NULL;
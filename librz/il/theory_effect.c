@@ -36,10 +36,49 @@ bool rz_il_handler_nop(RzILVM *vm, RzILOpEffect *op) {
 	return true;
 }
 
+/**
+ * Overwrite the contents of \p cur with \p data if they are of the same sort,
+ * which saves replacing the bound value.
+ */
+static bool il_set_in_place(RzILVM *vm, const char *var_name, bool is_local, RzILVal *cur, RzILTypePure type, void *data) {
+	if (!cur || cur->type != type) {
+		return false;
+	}
+	if (type == RZ_IL_TYPE_PURE_BITVECTOR && rz_bv_len(cur->data.bv) != rz_bv_len(data)) {
+		return false;
+	}
+	if (!is_local) {
+		RzILVal new_val = { .type = type };
+		if (type == RZ_IL_TYPE_PURE_BOOL) {
+			new_val.data.b = data;
+		} else {
+			new_val.data.bv = data;
+		}
+		rz_il_vm_event_add(vm, rz_il_event_var_write_new(var_name, cur, &new_val));
+	}
+	if (type == RZ_IL_TYPE_PURE_BOOL) {
+		cur->data.b->b = ((RzILBool *)data)->b;
+		rz_il_vm_bool_release(vm, data);
+	} else {
+		rz_bv_copy(data, cur->data.bv);
+		rz_il_vm_bv_release(vm, data);
+	}
+	return true;
+}
+
 bool rz_il_handler_set(RzILVM *vm, RzILOpEffect *op) {
 	rz_return_val_if_fail(vm && op, false);
 	RzILOpArgsSet *set_op = &op->op.set;
-	RzILVal *val = rz_il_evaluate_val(vm, set_op->x);
+	RzILTypePure type = -1;
+	void *data = rz_il_evaluate_pure(vm, set_op->x, &type);
+	if (!data) {
+		return false;
+	}
+	RzILVal *cur = rz_il_vm_get_var_value(vm, set_op->is_local ? RZ_IL_VAR_KIND_LOCAL : RZ_IL_VAR_KIND_GLOBAL, set_op->v);
+	if (il_set_in_place(vm, set_op->v, set_op->is_local, cur, type, data)) {
+		return true;
+	}
+	RzILVal *val = rz_il_vm_value_new(vm, type, data);
 	if (!val) {
 		return false;
 	}
@@ -49,7 +88,7 @@ bool rz_il_handler_set(RzILVM *vm, RzILOpEffect *op) {
 
 static void perform_jump(RzILVM *vm, RZ_OWN RzBitVector *dst) {
 	rz_il_vm_event_add(vm, rz_il_event_pc_write_new(vm->pc, dst));
-	rz_bv_free(vm->pc);
+	rz_il_vm_bv_release(vm, vm->pc);
 	vm->pc = dst;
 }
 
@@ -75,7 +114,7 @@ bool rz_il_handler_goto(RzILVM *vm, RzILOpEffect *op) {
 		RzILVmHook internal_hook = (RzILVmHook)label->hook;
 		internal_hook(vm, op);
 	} else {
-		perform_jump(vm, rz_bv_dup(label->addr));
+		perform_jump(vm, rz_il_vm_bv_dup(vm, label->addr));
 	}
 	return true;
 }
@@ -108,9 +147,9 @@ bool rz_il_handler_repeat(RzILVM *vm, RzILOpEffect *op) {
 			break;
 		}
 		res = res && rz_il_evaluate_effect(vm, op_repeat->data_eff);
-		rz_il_bool_free(condition);
+		rz_il_vm_bool_release(vm, condition);
 	}
-	rz_il_bool_free(condition);
+	rz_il_vm_bool_release(vm, condition);
 
 	return res;
 }
@@ -130,7 +169,7 @@ bool rz_il_handler_branch(RzILVM *vm, RzILOpEffect *op) {
 	} else {
 		ret = rz_il_evaluate_effect(vm, op_branch->false_eff);
 	}
-	rz_il_bool_free(condition);
+	rz_il_vm_bool_release(vm, condition);
 
 	return ret;
 }
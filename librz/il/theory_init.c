@@ -19,7 +19,7 @@ void *rz_il_handler_ite(RzILVM *vm, RzILOpPure *op, RzILTypePure *type) {
 	} else {
 		ret = rz_il_evaluate_pure(vm, op_ite->y, type); // false branch
 	}
-	rz_il_bool_free(condition);
+	rz_il_vm_bool_release(vm, condition);
 	return ret;
 }
 
@@ -42,11 +42,11 @@ void *rz_il_handler_var(RzILVM *vm, RzILOpPure *op, RzILTypePure *type) {
 	switch (val->type) {
 	case RZ_IL_TYPE_PURE_BOOL:
 		*type = RZ_IL_TYPE_PURE_BOOL;
-		ret = rz_il_bool_new(val->data.b->b);
+		ret = rz_il_vm_bool_new(vm, val->data.b->b);
 		break;
 	case RZ_IL_TYPE_PURE_BITVECTOR:
 		*type = RZ_IL_TYPE_PURE_BITVECTOR;
-		ret = rz_bv_dup(val->data.bv);
+		ret = rz_il_vm_bv_dup(vm, val->data.bv);
 		break;
 	default:
 		break;
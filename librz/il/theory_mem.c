@@ -14,7 +14,7 @@ void *rz_il_handler_load(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 		return NULL;
 	}
 	RzBitVector *ret = rz_il_vm_mem_load(vm, op_load->mem, addr);
-	rz_bv_free(addr);
+	rz_il_vm_bv_release(vm, addr);
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return ret;
 }
@@ -32,8 +32,8 @@ bool rz_il_handler_store(RzILVM *vm, RzILOpEffect *op) {
 		ret = true;
 		rz_il_vm_mem_store(vm, op_store->mem, addr, value);
 	}
-	rz_bv_free(addr);
-	rz_bv_free(value);
+	rz_il_vm_bv_release(vm, addr);
+	rz_il_vm_bv_release(vm, value);
 
 	return ret;
 }
@@ -47,7 +47,7 @@ void *rz_il_handler_loadw(RzILVM *vm, RzILOpBitVector *op, RzILTypePure *type) {
 		return NULL;
 	}
 	RzBitVector *ret = rz_il_vm_mem_loadw(vm, op_loadw->mem, addr, op_loadw->n_bits);
-	rz_bv_free(addr);
+	rz_il_vm_bv_release(vm, addr);
 	*type = RZ_IL_TYPE_PURE_BITVECTOR;
 	return ret;
 }
@@ -66,8 +66,8 @@ bool rz_il_handler_storew(RzILVM *vm, RzILOpEffect *op) {
 		rz_il_vm_mem_storew(vm, op_storew->mem, addr, value);
 	}
 
-	rz_bv_free(addr);
-	rz_bv_free(value);
+	rz_il_vm_bv_release(vm, addr);
+	rz_il_vm_bv_release(vm, value);
 
 	return ret;
 }
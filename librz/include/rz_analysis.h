@@ -451,6 +451,7 @@ typedef struct rz_analysis_hint_cb_t {
 } RHintCb;
 
 typedef struct rz_analysis_il_vm_t RzAnalysisILVM;
+typedef struct rz_analysis_xref_index_t RzAnalysisXRefIndex;
 
 typedef struct rz_analysis_t {
 	char *cpu; // analysis.cpu
@@ -487,8 +488,7 @@ typedef struct rz_analysis_t {
 	RzList /*<RzAnalysisPlugin *>*/ *plugins;
 	Sdb *sdb_noret;
 	Sdb *sdb_fmts;
-	HtUP *ht_xrefs_from;
-	HtUP *ht_xrefs_to;
+	RzAnalysisXRefIndex *xref_index; ///< all xrefs, see xrefs.c
 	bool recursive_noreturn; // analysis.rnr
 	// moved from RzAnalysisFcn
 	Sdb *sdb; // root
@@ -882,6 +882,20 @@ typedef struct rz_analysis_ref_t {
 	ut64 to;
 	RzAnalysisXRefType type;
 } RzAnalysisXRef;
+
+/**
+ * \brief Callback for iterating over xrefs, \p xref is only valid during the call
+ * \return false to stop the iteration
+ */
+typedef bool (*RzAnalysisXRefCb)(const RzAnalysisXRef *xref, void *user);
+
+typedef struct rz_analysis_xrefs_stats_t {
+	ut64 count; ///< number of xrefs
+	ut64 pending; ///< xrefs set but not sorted into the runs yet, queries merge them on the fly
+	ut64 delta; ///< xrefs not merged into the main sorted runs yet
+	ut64 deleted; ///< deleted xrefs still taking space until the next merge
+	ut64 bytes; ///< memory used by the xrefs index
+} RzAnalysisXRefsStats;
 RZ_API const char *rz_analysis_ref_type_tostring(RzAnalysisXRefType t);
 
 /* represents a reference line from one address (from) to another (to) */
@@ -997,6 +1011,8 @@ typedef struct rz_analysis_esil_trace_t {
 
 typedef int (*RzAnalysisEsilHookRegWriteCB)(ANALYSIS_ESIL *esil, const char *name, ut64 *val);
 
+typedef struct rz_analysis_esil_literal_t RzAnalysisEsilLiteral;
+
 typedef struct rz_analysis_esil_callbacks_t {
 	void *user;
 	/* callbacks */
@@ -1016,6 +1032,7 @@ typedef struct rz_analysis_esil_t {
 	RzAnalysis *analysis;
 	char **stack;
 	ut64 addrmask;
+	const RzAnalysisEsilLiteral **stack_literals; ///< per stack slot, operand of a compiled expression the string was pushed from
 	int stacksize;
 	int stackptr;
 	ut32 skip;
@@ -1042,6 +1059,7 @@ typedef struct rz_analysis_esil_t {
 	ut8 lastsz; // in bits //used for signature-flag
 	/* native ops and custom ops */
 	HtPP *ops;
+	HtUP *code_cache; ///< instruction address -> expression compiled by rz_analysis_esil_parse_at()
 	RzStrBuf current_opstr;
 	RzIDStorage *sources;
 	HtUP *interrupts;
@@ -1129,6 +1147,11 @@ struct rz_analysis_il_vm_t {
 	RZ_NONNULL RzILVM *vm; ///< low-level vm to execute IL code
 	RZ_NONNULL RzBuffer *io_buf; ///< buffer to use for memory 0 (io)
 	RZ_NONNULL RzILRegBinding *reg_binding; ///< specifies which (global) variables are bound to registers
+	HtUP /*<RzAnalysisILCacheEntry *>*/ *il_cache; ///< instruction address -> lifted op reused while bytes and mode match
+	size_t il_cache_max; ///< maximum number of cached instructions, 0 disables the cache
+	ut64 il_cache_hits; ///< steps that reused a cached op
+	ut64 il_cache_misses; ///< steps that lifted the instruction
+	bool il_compile; ///< execute the cached ops compiled with rz_il_compile_effect() where possible
 } /* RzAnalysisILVM */;
 
 typedef enum {
@@ -1233,6 +1256,8 @@ typedef struct rz_analysis_plugin_t {
 	RzAnalysisEsilTrapCB esil_trap; // traps / exceptions
 	RzAnalysisEsilCB esil_fini; // deinitialize
 	RzAnalysisILConfigCB il_config; ///< return an IL config to execute lifted code of the given analysis' arch/cpu/bits
+	bool il_cacheable; ///< the lifted IL only depends on the bytes and the arch/cpu/bits/endian, thus it can be cached by the IL vm
+	bool (*decode_cache_stats)(RzAnalysis *analysis, RZ_OUT ut64 *hits, RZ_OUT ut64 *lookups); ///< counters of the decode cache of the plugin, if it has one
 
 } RzAnalysisPlugin;
 
@@ -1426,10 +1451,12 @@ RZ_API RZ_OWN char *rz_analysis_function_name_guess(RzTypeDB *typedb, RZ_NONNULL
 
 /* analysis.c */
 RZ_API RzAnalysis *rz_analysis_new(void);
+RZ_API RZ_OWN RzAnalysis *rz_analysis_new_decoder(RZ_NONNULL RzAnalysis *analysis);
 RZ_API void rz_analysis_purge(RzAnalysis *analysis);
 RZ_API RzAnalysis *rz_analysis_free(RzAnalysis *r);
 RZ_API int rz_analysis_add(RzAnalysis *analysis, RzAnalysisPlugin *foo);
 RZ_API int rz_analysis_archinfo(RzAnalysis *analysis, RzAnalysisInfoType query);
+RZ_API bool rz_analysis_decode_cache_stats(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RZ_OUT ut64 *hits, RZ_NONNULL RZ_OUT ut64 *lookups);
 RZ_API bool rz_analysis_use(RzAnalysis *analysis, const char *name);
 RZ_API bool rz_analysis_set_reg_profile(RzAnalysis *analysis);
 RZ_API char *rz_analysis_get_reg_profile(RzAnalysis *analysis);
@@ -1482,6 +1509,11 @@ RZ_API int rz_analysis_esil_get_parm_type(RzAnalysisEsil *esil, const char *str)
 RZ_API int rz_analysis_esil_get_parm(RzAnalysisEsil *esil, const char *str, ut64 *num);
 RZ_API int rz_analysis_esil_condition(RzAnalysisEsil *esil, const char *str);
 
+// esil_code.c
+RZ_API bool rz_analysis_esil_parse_at(RZ_NONNULL RzAnalysisEsil *esil, ut64 addr, RZ_NONNULL const char *str);
+RZ_API void rz_analysis_esil_code_cache_invalidate(RZ_NONNULL RzAnalysisEsil *esil, ut64 addr, ut64 size);
+RZ_API void rz_analysis_esil_code_cache_clear(RZ_NONNULL RzAnalysisEsil *esil);
+
 // esil_interrupt.c
 RZ_API void rz_analysis_esil_interrupts_init(RzAnalysisEsil *esil);
 RZ_API RzAnalysisEsilInterrupt *rz_analysis_esil_interrupt_new(RzAnalysisEsil *esil, ut32 src_id, RzAnalysisEsilInterruptHandler *ih);
@@ -1567,6 +1599,8 @@ RZ_API bool rz_analysis_il_vm_sync_to_reg(RzAnalysisILVM *vm, RZ_NONNULL RzReg *
 RZ_API RzAnalysisILStepResult rz_analysis_il_vm_step(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisILVM *vm, RZ_NULLABLE RzReg *reg);
 RZ_API RzAnalysisILStepResult rz_analysis_il_vm_step_while(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisILVM *vm, RZ_NULLABLE RzReg *reg,
 	bool (*cond)(RzAnalysisILVM *vm, void *user), void *user);
+RZ_API void rz_analysis_il_vm_cache_invalidate(RZ_NONNULL RzAnalysisILVM *vm, ut64 addr, ut64 size);
+RZ_API void rz_analysis_il_vm_cache_clear(RZ_NONNULL RzAnalysisILVM *vm);
 RZ_API bool rz_analysis_il_vm_setup(RzAnalysis *analysis);
 RZ_API void rz_analysis_il_vm_cleanup(RzAnalysis *analysis);
 
@@ -1629,6 +1663,13 @@ RZ_API RzList /*<RzAnalysisXRef *>*/ *rz_analysis_function_get_xrefs_to(RzAnalys
 RZ_API bool rz_analysis_xrefs_set(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type);
 RZ_API bool rz_analysis_xrefs_deln(RzAnalysis *analysis, ut64 from, ut64 to, RzAnalysisXRefType type);
 RZ_API bool rz_analysis_xref_del(RzAnalysis *analysis, ut64 from, ut64 to);
+RZ_API size_t rz_analysis_xrefs_set_bulk(RzAnalysis *analysis, RZ_NONNULL const RzAnalysisXRef *xrefs, size_t count);
+RZ_API bool rz_analysis_xrefs_foreach(RzAnalysis *analysis, RzAnalysisXRefCb cb, void *user);
+RZ_API bool rz_analysis_xrefs_foreach_from(RzAnalysis *analysis, ut64 addr, RzAnalysisXRefCb cb, void *user);
+RZ_API bool rz_analysis_xrefs_foreach_to(RzAnalysis *analysis, ut64 addr, RzAnalysisXRefCb cb, void *user);
+RZ_API bool rz_analysis_xrefs_foreach_from_in(RzAnalysis *analysis, ut64 addr, ut64 size, RzAnalysisXRefCb cb, void *user);
+RZ_API bool rz_analysis_xrefs_foreach_to_in(RzAnalysis *analysis, ut64 addr, ut64 size, RzAnalysisXRefCb cb, void *user);
+RZ_API void rz_analysis_xrefs_stats(RzAnalysis *analysis, RZ_NONNULL RZ_OUT RzAnalysisXRefsStats *stats);
 
 RZ_API RzList /*<RzAnalysisFunction *>*/ *rz_analysis_get_fcns(RzAnalysis *analysis);
 
@@ -149,6 +149,7 @@ typedef struct rz_asm_plugin_t {
 #ifdef RZ_API
 /* asm.c */
 RZ_API RzAsm *rz_asm_new(void);
+RZ_API RZ_OWN RzAsm *rz_asm_new_decoder(RZ_NONNULL RzAsm *a);
 RZ_API void rz_asm_free(RzAsm *a);
 RZ_API char *rz_asm_mnemonics(RzAsm *a, int id, bool json);
 RZ_API int rz_asm_mnemonics_byname(RzAsm *a, const char *name);
@@ -254,6 +254,7 @@ typedef struct rz_bin_file_load_options_t {
 	bool elf_load_sections; ///< ELF specific, load or not ELF sections
 	bool elf_checks_sections; ///< ELF specific, checks or not ELF sections
 	bool elf_checks_segments; ///< ELF specific, checks or not ELF sections
+	bool lazy; ///< load symbols, imports, relocs, strings, classes, ... only on their first access
 } RzBinObjectLoadOptions;
 
 typedef struct rz_bin_string_database_t RzBinStrDb;
@@ -293,6 +294,8 @@ typedef struct rz_bin_object_t {
 	RZ_DEPRECATE RZ_BORROW Sdb *kv; ///< deprecated, put info in C structures instead of this (holds a copy of another pointer.)
 	HtUP *addrzklassmethod;
 	void *bin_obj; // internal pointer used by formats
+	RZ_BORROW RzBinFile *bf; ///< file the object belongs to, used to load the lazy items
+	ut32 pending; ///< items not loaded yet when opts.lazy is set
 } RzBinObject;
 
 // XXX: RbinFile may hold more than one RzBinObject
@@ -360,6 +363,7 @@ struct rz_bin_t {
 	ut64 filter_rules;
 	bool verbose;
 	bool use_xtr; // use extract plugins when loading a file?
+	bool use_mmap; // map local files in memory instead of reading them through RzIO?
 	bool strseach_check_ascii_freq; // str.search.check_ascii_freq
 	RzStrConstPool constpool;
 	bool is_reloc_patched; // used to indicate whether relocations were patched or not
@@ -927,8 +931,12 @@ RZ_API const RzList /*<RzBinString *>*/ *rz_bin_object_get_strings(RZ_NONNULL Rz
 RZ_API const RzList /*<RzBinMem *>*/ *rz_bin_object_get_mem(RZ_NONNULL RzBinObject *obj);
 RZ_API const RzList /*<RzBinResource *>*/ *rz_bin_object_get_resources(RZ_NONNULL RzBinObject *obj);
 RZ_API const RzList /*<RzBinSymbol *>*/ *rz_bin_object_get_symbols(RZ_NONNULL RzBinObject *obj);
+RZ_API RzBinRelocStorage *rz_bin_object_get_relocs(RZ_NONNULL RzBinObject *obj);
+RZ_API RzBinLanguage rz_bin_object_get_language(RZ_NONNULL RzBinObject *obj);
+RZ_API void rz_bin_object_load_lazy_items(RZ_NONNULL RzBinObject *o);
 RZ_API bool rz_bin_object_reset_strings(RZ_NONNULL RzBin *bin, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *obj);
 RZ_API RZ_BORROW RzBinString *rz_bin_object_get_string_at(RZ_NONNULL RzBinObject *obj, ut64 address, bool is_va);
+RZ_API bool rz_bin_object_add_string(RZ_NONNULL RzBinObject *obj, RZ_NONNULL RZ_OWN RzBinString *bstr);
 RZ_API bool rz_bin_object_is_big_endian(RZ_NONNULL RzBinObject *obj);
 RZ_API bool rz_bin_object_is_static(RZ_NONNULL RzBinObject *obj);
 RZ_API RZ_OWN RzVector /*<RzBinSectionMap>*/ *rz_bin_object_sections_mapping_list(RZ_NONNULL RzBinObject *obj);
@@ -485,6 +485,7 @@ typedef struct rz_cons_context_t {
 	bool is_interactive;
 	bool pageable;
 	bool noflush;
+	bool streamed; ///< part of the output was already written while it was produced
 
 	int color_mode;
 	RzConsPalette cpal;
@@ -569,6 +570,7 @@ typedef struct rz_cons_t {
 	RZ_DEPRECATE bool newline;
 	RzVirtTermMode vtmode;
 	bool flush;
+	bool stream; // write non-tty output in chunks while it is produced
 	bool use_utf8; // use utf8 features
 	bool use_utf8_curvy; // use utf8 curved corners
 	bool dotted_lines;
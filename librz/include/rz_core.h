@@ -108,6 +108,7 @@ typedef struct rz_core_plugin_t {
 } RzCorePlugin;
 
 typedef struct rz_core_rtr_host_t RzCoreRtrHost;
+typedef struct rz_project_snapshot_t RzProjectSnapshot;
 
 typedef enum {
 	AUTOCOMPLETE_DEFAULT,
@@ -331,6 +332,9 @@ struct rz_core_t {
 	RzList /*<char *>*/ *ropchain;
 	RzCoreSeekHistory seek_history;
 	RzHash *hash;
+	RzHashBlockIndex *hash_index; ///< block digests of the file with fd hash_index_fd, see rz_core_hash_block_index()
+	int hash_index_fd;
+	RzProjectSnapshot *prj_snapshot; ///< last project saved with prj.incremental, see rz_project_save_file()
 
 	bool marks_init;
 	ut64 marks[UT8_MAX + 1];
@@ -584,6 +588,7 @@ RZ_API void rz_core_debug_map_print(RzCore *core, ut64 addr, RzCmdStateOutput *s
 
 /* chash.c */
 RZ_API RzCmdStatus rz_core_hash_plugins_print(RzHash *hash, RzCmdStateOutput *state);
+RZ_API RZ_BORROW RzHashBlockIndex *rz_core_hash_block_index(RZ_NONNULL RzCore *core, RZ_NONNULL const char *algo);
 
 /* cio.c */
 RZ_API RzCmdStatus rz_core_io_plugins_print(RzIO *io, RzCmdStateOutput *state);
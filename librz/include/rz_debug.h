@@ -175,11 +175,26 @@ typedef struct {
 	ut64 data;
 } RzDebugChangeReg;
 
+#define RZ_DEBUG_SESSION_PAGE_SIZE 0x1000
+
+/**
+ * \brief Bytes written in a page of memory during the step \p cnum
+ */
 typedef struct {
 	int cnum;
-	ut8 data;
+	ut16 offset; ///< offset of the first written byte in the page
+	ut16 size; ///< number of written bytes
+	ut32 data; ///< index of the first written byte in RzDebugChangeMemPage.bytes
 } RzDebugChangeMem;
 
+/**
+ * \brief Journal of the writes to a page of memory of RZ_DEBUG_SESSION_PAGE_SIZE bytes
+ */
+typedef struct {
+	RzVector /*<RzDebugChangeMem>*/ changes; ///< sorted by cnum
+	RzVector /*<ut8>*/ bytes; ///< written bytes of all the changes
+} RzDebugChangeMemPage;
+
 typedef struct rz_debug_checkpoint_t {
 	int cnum;
 	RzRegArena *arena[RZ_REG_TYPE_LAST];
@@ -191,7 +206,7 @@ typedef struct rz_debug_session_t {
 	ut32 maxcnum;
 	RzDebugCheckpoint *cur_chkpt;
 	RzVector /*<RzDebugCheckpoint>*/ *checkpoints;
-	HtUP *memory; /* RzVector<RzDebugChangeMem> */
+	HtUP *memory; /* RzDebugChangeMemPage, by page address */
 	HtUP *registers; /* RzVector<RzDebugChangeReg> */
 	int reasontype /*RzDebugReasonType*/;
 	RzBreakpointItem *bp;
@@ -575,10 +590,11 @@ RZ_API void rz_debug_esil_prestep(RzDebug *d, int p);
 RZ_API bool rz_debug_add_checkpoint(RzDebug *dbg);
 RZ_API bool rz_debug_session_add_reg_change(RzDebugSession *session, int arena, ut64 offset, ut64 data);
 RZ_API bool rz_debug_session_add_mem_change(RzDebugSession *session, ut64 addr, ut8 data);
+RZ_API bool rz_debug_session_add_mem_range_change(RZ_NONNULL RzDebugSession *session, ut64 addr, RZ_NONNULL const ut8 *data, ut64 size);
 RZ_API void rz_debug_session_restore_reg_mem(RzDebug *dbg, ut32 cnum);
 RZ_API void rz_debug_session_list_memory(RzDebug *dbg);
 RZ_API void rz_debug_session_serialize(RzDebugSession *session, Sdb *db);
-RZ_API void rz_debug_session_deserialize(RzDebugSession *session, Sdb *db);
+RZ_API bool rz_debug_session_deserialize(RzDebugSession *session, Sdb *db);
 RZ_API bool rz_debug_session_save(RzDebugSession *session, const char *file);
 RZ_API bool rz_debug_session_load(RzDebug *dbg, const char *file);
 RZ_API bool rz_debug_trace_ins_before(RzDebug *dbg);
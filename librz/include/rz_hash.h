@@ -46,8 +46,33 @@ typedef struct rz_hash_cfg_t {
 	RzList /*<HashCfgConfig *>*/ *configurations;
 	RzHashStatus status;
 	RzHash *hash;
+	bool parallel; ///< update each configuration on its own thread, see rz_hash_cfg_set_parallel()
+	struct hash_cfg_pipeline_t *pipeline; ///< worker threads, started by the first parallel update
 } RzHashCfg;
 
+/**
+ * \brief Reads \p len bytes at \p offset of the indexed data
+ * \return Number of bytes read
+ */
+typedef ut64 (*RzHashBlockIndexRead)(void *user, ut64 offset, RZ_OUT ut8 *buf, ut64 len);
+
+/**
+ * \brief Digests of the fixed-size blocks of some data and of a binary tree above them
+ *
+ * The digest of the whole data is the root of the tree, so after a change only
+ * the digests of the dirty blocks and of the nodes above them are computed again.
+ */
+typedef struct rz_hash_block_index_t {
+	const RzHashPlugin *plugin;
+	ut64 size; ///< size of the indexed data
+	ut64 block_size;
+	ut64 blocks_count;
+	RzHashSize digest_size;
+	ut8 *digests; ///< digests of the blocks followed by the nodes of each level of the tree
+	ut8 *dirty; ///< blocks whose digest has to be computed again
+	ut64 dirty_count;
+} RzHashBlockIndex;
+
 #ifdef RZ_API
 
 RZ_API RzHash *rz_hash_new(void);
@@ -62,6 +87,7 @@ RZ_API RZ_OWN RzHashCfg *rz_hash_cfg_new_with_algo(RZ_NONNULL RzHash *rh, RZ_NON
 RZ_API void rz_hash_cfg_free(RZ_NONNULL RzHashCfg *md);
 
 RZ_API bool rz_hash_cfg_configure(RZ_NONNULL RzHashCfg *md, RZ_NONNULL const char *name);
+RZ_API void rz_hash_cfg_set_parallel(RZ_NONNULL RzHashCfg *md, bool parallel);
 RZ_API bool rz_hash_cfg_hmac(RZ_NONNULL RzHashCfg *md, RZ_NONNULL const ut8 *key, ut64 key_size);
 RZ_API bool rz_hash_cfg_init(RZ_NONNULL RzHashCfg *md);
 RZ_API bool rz_hash_cfg_update(RZ_NONNULL RzHashCfg *md, RZ_NONNULL const ut8 *data, ut64 size);
@@ -80,6 +106,14 @@ RZ_API ut32 rz_hash_xxhash(RZ_NONNULL const ut8 *input, size_t size);
 RZ_API double rz_hash_entropy(RZ_NONNULL const ut8 *data, ut64 len);
 RZ_API double rz_hash_entropy_fraction(RZ_NONNULL const ut8 *data, ut64 len);
 
+RZ_API RZ_OWN RzHashBlockIndex *rz_hash_block_index_new(RZ_NONNULL RzHash *rh, RZ_NONNULL const char *name, ut64 size, ut64 block_size);
+RZ_API void rz_hash_block_index_free(RZ_NULLABLE RzHashBlockIndex *index);
+RZ_API void rz_hash_block_index_invalidate(RZ_NONNULL RzHashBlockIndex *index, ut64 offset, ut64 size);
+RZ_API ut64 rz_hash_block_index_update(RZ_NONNULL RzHashBlockIndex *index, RZ_NONNULL RzHashBlockIndexRead read, RZ_NULLABLE void *user, size_t n_threads);
+RZ_API RZ_BORROW const ut8 *rz_hash_block_index_block(RZ_NONNULL RzHashBlockIndex *index, ut64 i);
+RZ_API RZ_BORROW const ut8 *rz_hash_block_index_root(RZ_NONNULL RzHashBlockIndex *index);
+RZ_API bool rz_hash_block_index_restore(RZ_NONNULL RzHashBlockIndex *index, RZ_NONNULL const ut8 *blocks, RZ_NONNULL const ut8 *dirty);
+
 #endif
 
 /* importing all message digest plugins */
@@ -541,6 +541,21 @@ RZ_API RZ_OWN RzILOpEffect *rz_il_op_new_branch(RZ_NONNULL RzILOpBool *condition
 RZ_API RZ_OWN RzILOpEffect *rz_il_op_new_store(RzILMemIndex mem, RZ_NONNULL RzILOpBitVector *key, RZ_NONNULL RzILOpBitVector *value);
 RZ_API RZ_OWN RzILOpEffect *rz_il_op_new_storew(RzILMemIndex mem, RZ_NONNULL RzILOpBitVector *key, RZ_NONNULL RzILOpBitVector *value);
 
+/**
+ * \brief Freed op nodes kept to build the next ops, see rz_il_op_pool_use()
+ */
+typedef struct rz_il_op_pool_t {
+	RzPVector /*<RzILOpPure *>*/ pure; ///< freed pure ops
+	RzPVector /*<RzILOpEffect *>*/ effect; ///< freed effect ops
+	RzPVector /*<RzBitVector *>*/ bv; ///< freed bitvector constants of up to 64 bits
+	ut64 allocs; ///< nodes allocated on the heap while the pool was in use
+	ut64 reuses; ///< nodes taken from the pool instead
+} RzILOpPool;
+
+RZ_API RZ_OWN RzILOpPool *rz_il_op_pool_new(void);
+RZ_API void rz_il_op_pool_free(RZ_NULLABLE RzILOpPool *pool);
+RZ_API RZ_NULLABLE RzILOpPool *rz_il_op_pool_use(RZ_NULLABLE RzILOpPool *pool);
+
 // Printing/Export
 RZ_API RZ_NONNULL const char *rz_il_op_pure_code_stringify(RzILOpPureCode code);
 
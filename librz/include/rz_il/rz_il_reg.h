@@ -22,6 +22,11 @@ typedef struct rz_il_reg_binding_item_t {
 typedef struct rz_il_reg_binding_t {
 	size_t regs_count;
 	RzILRegBindingItem *regs; ///< regs_count registers that are bound to variables
+	// items resolved for the last synced RzReg, so syncing does not have to look up every register by name
+	RzReg *items_reg; ///< RzReg the items were resolved in, compared together with items_gen
+	ut32 items_gen; ///< RzReg.profile_gen of items_reg when the items were resolved
+	RzRegItem **items; ///< regs_count items in items_reg, NULL for registers that do not exist there
+	RzRegItem *pc_item; ///< item of the program counter in items_reg, or NULL
 } RzILRegBinding;
 
 struct rz_il_vm_t;
@@ -33,6 +38,8 @@ RZ_API void rz_il_reg_binding_free(RzILRegBinding *rb);
 RZ_API void rz_il_vm_setup_reg_binding(RZ_NONNULL struct rz_il_vm_t *vm, RZ_NONNULL RZ_BORROW RzILRegBinding *rb);
 RZ_API bool rz_il_vm_sync_to_reg(RZ_NONNULL struct rz_il_vm_t *vm, RZ_NONNULL RzILRegBinding *rb, RZ_NONNULL RzReg *reg);
 RZ_API void rz_il_vm_sync_from_reg(RZ_NONNULL struct rz_il_vm_t *vm, RZ_NONNULL RzILRegBinding *rb, RZ_NONNULL RzReg *reg);
+RZ_API bool rz_il_vm_sync_to_reg_type(RZ_NONNULL struct rz_il_vm_t *vm, RZ_NONNULL RzILRegBinding *rb, RZ_NONNULL RzReg *reg, RzRegisterType type);
+RZ_API void rz_il_vm_sync_from_reg_type(RZ_NONNULL struct rz_il_vm_t *vm, RZ_NONNULL RzILRegBinding *rb, RZ_NONNULL RzReg *reg, RzRegisterType type);
 
 #ifdef __cplusplus
 }
@@ -15,6 +15,7 @@ extern "C" {
 #endif
 
 typedef struct rz_il_vm_t RzILVM;
+typedef struct rz_il_compiled_t RzILCompiled;
 
 /**
  * \brief Evaluation callback for a single pure opcode
@@ -31,6 +32,21 @@ typedef bool (*RzILOpEffectHandler)(RzILVM *vm, RzILOpEffect *op);
 
 typedef void (*RzILVmHook)(RzILVM *vm, RzILOpEffect *op);
 
+/**
+ * \brief Allocation counters of a RzILVM
+ */
+typedef struct rz_il_vm_stats_t {
+	ut64 steps; ///< number of rz_il_vm_step() calls
+	ut64 bv_allocs; ///< bitvectors allocated on the heap by the evaluation
+	ut64 bv_reuses; ///< bitvectors taken from the vm pool instead
+	ut64 bool_allocs; ///< bools allocated on the heap by the evaluation
+	ut64 bool_reuses; ///< bools taken from the vm pool instead
+	ut64 val_allocs; ///< values allocated on the heap by the evaluation
+	ut64 val_reuses; ///< values taken from the vm pool instead
+	ut64 op_allocs; ///< ops allocated on the heap while the op pool was in use
+	ut64 op_reuses; ///< ops taken from the op pool instead
+} RzILVMStats;
+
 /**
  * \brief Low-level VM to execute raw IL code
  */
@@ -48,6 +64,11 @@ struct rz_il_vm_t {
 	RzILOpEffectHandler *op_handler_effect_table; ///< Array of Handler, handler can be indexed by opcode
 	RzList /*<RzILEvent *>*/ *events; ///< List of events that has happened in the last step
 	bool big_endian; ///< Sets the endianness of the memory reads/writes operations
+	RzPVector /*<RzBitVector *>*/ bv_pool; ///< released bitvectors of up to 64 bits, reused by the evaluation
+	RzPVector /*<RzILBool *>*/ bool_pool; ///< released bools, reused by the evaluation
+	RzPVector /*<RzILVal *>*/ val_pool; ///< released values without contents, reused by the evaluation
+	RzILOpPool *op_pool; ///< pool for the ops lifted to be executed in this vm, see rz_il_op_pool_use()
+	RzILVMStats stats; ///< allocation counters, see rz_il_vm_get_stats()
 };
 
 // VM high level operations
@@ -58,6 +79,17 @@ RZ_API void rz_il_vm_fini(RzILVM *vm);
 
 RZ_API ut32 rz_il_vm_get_pc_len(RzILVM *vm);
 
+RZ_API void rz_il_vm_get_stats(RZ_NONNULL RzILVM *vm, RZ_NONNULL RZ_OUT RzILVMStats *stats);
+
+// Pooled values for the evaluation
+RZ_API RZ_OWN RzBitVector *rz_il_vm_bv_new(RZ_NONNULL RzILVM *vm, ut32 length);
+RZ_API RZ_OWN RzBitVector *rz_il_vm_bv_dup(RZ_NONNULL RzILVM *vm, RZ_NONNULL const RzBitVector *bv);
+RZ_API void rz_il_vm_bv_release(RZ_NONNULL RzILVM *vm, RZ_NULLABLE RZ_OWN RzBitVector *bv);
+RZ_API RZ_OWN RzILBool *rz_il_vm_bool_new(RZ_NONNULL RzILVM *vm, bool b);
+RZ_API void rz_il_vm_bool_release(RZ_NONNULL RzILVM *vm, RZ_NULLABLE RZ_OWN RzILBool *b);
+RZ_API RZ_OWN RzILVal *rz_il_vm_value_new(RZ_NONNULL RzILVM *vm, RzILTypePure type, RZ_NONNULL RZ_OWN void *data);
+RZ_API void rz_il_vm_value_release(RZ_NONNULL RzILVM *vm, RZ_NULLABLE RZ_OWN RzILVal *val);
+
 // VM Event operations
 RZ_API void rz_il_vm_event_add(RzILVM *vm, RzILEvent *evt);
 RZ_API void rz_il_vm_clear_events(RzILVM *vm);
@@ -99,6 +131,11 @@ RZ_API bool rz_il_evaluate_effect(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILOpEffect
 
 RZ_API bool rz_il_vm_step(RzILVM *vm, RzILOpEffect *op, ut64 fallthrough_addr);
 
+// Compiled execution
+RZ_API RZ_OWN RZ_NULLABLE RzILCompiled *rz_il_compile_effect(RZ_NONNULL RzILVM *vm, RZ_NONNULL RZ_BORROW RzILOpEffect *op);
+RZ_API void rz_il_compiled_free(RZ_NULLABLE RzILCompiled *code);
+RZ_API bool rz_il_vm_step_compiled(RZ_NONNULL RzILVM *vm, RZ_NONNULL RzILCompiled *code, ut64 fallthrough_addr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -75,6 +75,10 @@ typedef struct rz_io_t {
 	RzIDStorage *files;
 	RzPVector /*<RzIOCache *>*/ cache;
 	RzSkyline cache_skyline;
+	RzIntervalTree /*<RzIOCache *>*/ cache_index; ///< cached writes by address, they may overlap
+	RzVector /*<ut64>*/ cache_stack; ///< seq of the first write after each rz_io_cache_push()
+	ut64 snapshot_gen; ///< incremented each time the maps or the write cache change, see RzIOSnapshot
+	struct rz_io_page_cache_t *page_cache; ///< read cache of the descs, NULL when disabled
 	ut8 *write_mask;
 	int write_mask_len;
 	RzList /*<RzIOPlugin *>*/ *plugins;
@@ -164,8 +168,29 @@ typedef struct rz_io_cache_t {
 	ut8 *data;
 	ut8 *odata;
 	int written;
+	ut64 seq; ///< order of the write, increasing from the oldest to the newest one
 } RzIOCache;
 
+typedef struct rz_io_cache_stats_t {
+	ut64 writes; ///< number of cached writes
+	ut64 bytes; ///< number of bytes covered by the cached writes
+	ut64 written; ///< number of cached writes already committed
+	ut64 memory; ///< heap memory used by the write cache, in bytes
+	ut64 saved; ///< number of write cache states saved by rz_io_cache_push()
+} RzIOCacheStats;
+
+typedef struct rz_io_snapshot_t RzIOSnapshot;
+typedef struct rz_io_page_cache_t RzIOPageCache;
+
+typedef struct rz_io_page_cache_stats_t {
+	ut32 page_size;
+	ut32 n_pages; ///< capacity of the cache
+	ut32 used; ///< number of pages currently cached
+	ut64 hits;
+	ut64 misses;
+	ut64 evictions;
+} RzIOPageCacheStats;
+
 #define RZ_IO_DESC_CACHE_SIZE (sizeof(ut64) * 8)
 typedef struct rz_io_desc_cache_t {
 	ut64 cached;
@@ -193,6 +218,7 @@ typedef bool (*RzIODescUse)(RzIO *io, int fd);
 typedef RzIODesc *(*RzIODescGet)(RzIO *io, int fd);
 typedef ut64 (*RzIODescSize)(RzIODesc *desc);
 typedef RzIODesc *(*RzIOOpen)(RzIO *io, const char *uri, int flags, int mode);
+typedef void (*RzIOPageCacheInvalidate)(RzIO *io, int fd);
 typedef RzIODesc *(*RzIOOpenAt)(RzIO *io, const char *uri, int flags, int mode, ut64 at, RZ_NULLABLE RZ_OUT RzIOMap **map);
 typedef bool (*RzIOClose)(RzIO *io, int fd);
 typedef bool (*RzIOReadAt)(RzIO *io, ut64 addr, ut8 *buf, int len);
@@ -261,6 +287,7 @@ typedef struct rz_io_bind_t {
 	RzIOMapAdd map_add;
 	RzIOV2P v2p;
 	RzIOP2V p2v;
+	RzIOPageCacheInvalidate page_cache_invalidate;
 #if HAVE_PTRACE
 	RzIOPtraceFn ptrace;
 	RzIOPtraceFuncFn ptrace_func;
@@ -384,12 +411,27 @@ RZ_IPI bool rz_io_desc_fini(RzIO *io);
 /* io/cache.c */
 RZ_API int rz_io_cache_invalidate(RzIO *io, ut64 from, ut64 to);
 RZ_API bool rz_io_cache_at(RzIO *io, ut64 addr);
-RZ_API void rz_io_cache_commit(RzIO *io, ut64 from, ut64 to);
+RZ_API bool rz_io_cache_commit(RzIO *io, ut64 from, ut64 to);
 RZ_API void rz_io_cache_init(RzIO *io);
 RZ_API void rz_io_cache_fini(RzIO *io);
 RZ_API void rz_io_cache_reset(RzIO *io, int set);
 RZ_API bool rz_io_cache_write(RzIO *io, ut64 addr, const ut8 *buf, int len);
 RZ_API bool rz_io_cache_read(RzIO *io, ut64 addr, ut8 *buf, int len);
+RZ_API bool rz_io_cache_push(RZ_NONNULL RzIO *io);
+RZ_API bool rz_io_cache_pop(RZ_NONNULL RzIO *io);
+RZ_API void rz_io_cache_stats(RZ_NONNULL RzIO *io, RZ_NONNULL RZ_OUT RzIOCacheStats *stats);
+
+/* io/io_snapshot.c */
+RZ_API RZ_OWN RzIOSnapshot *rz_io_snapshot_new(RZ_NONNULL RzIO *io);
+RZ_API void rz_io_snapshot_free(RZ_NULLABLE RzIOSnapshot *snap);
+RZ_API bool rz_io_snapshot_is_valid(RZ_NONNULL const RzIOSnapshot *snap);
+RZ_API bool rz_io_snapshot_read_at(RZ_NONNULL RzIOSnapshot *snap, ut64 addr, RZ_NONNULL RZ_OUT ut8 *buf, ut64 len);
+
+/* io/io_page_cache.c */
+RZ_API bool rz_io_page_cache_set(RZ_NONNULL RzIO *io, ut32 page_size, ut32 n_pages);
+RZ_API void rz_io_page_cache_invalidate(RZ_NONNULL RzIO *io, int fd);
+RZ_API bool rz_io_page_cache_stats(RZ_NONNULL RzIO *io, RZ_NONNULL RZ_OUT RzIOPageCacheStats *stats);
+RZ_API void rz_io_page_cache_stats_reset(RZ_NONNULL RzIO *io);
 
 /* io/p_cache.c */
 RZ_API bool rz_io_desc_cache_init(RzIODesc *desc);
@@ -156,6 +156,7 @@ typedef struct rz_reg_t {
 	int size;
 	bool is_thumb;
 	bool big_endian;
+	ut32 profile_gen; ///< changed to a value unique to this RzReg each time the registers or their aliases change, so RzRegItem pointers can be cached
 } RzReg;
 
 typedef struct rz_reg_flags_t {
@@ -23,10 +23,16 @@ enum {
 	RZ_SEARCH_PRIV_KEY,
 	RZ_SEARCH_DELTAKEY,
 	RZ_SEARCH_MAGIC,
+	RZ_SEARCH_MULTI,
 	RZ_SEARCH_LAST
 };
 
 #define RZ_SEARCH_DISTANCE_MAX 10
+/**
+ * Minimum number of keywords for which a RZ_SEARCH_KEYWORD search
+ * matches them all together as in RZ_SEARCH_MULTI
+ */
+#define RZ_SEARCH_MULTI_MIN_KEYWORDS 8
 
 #define RZ_SEARCH_KEYWORD_TYPE_BINARY 'i'
 #define RZ_SEARCH_KEYWORD_TYPE_STRING 's'
@@ -49,6 +55,8 @@ typedef struct rz_search_hit_t {
 	ut64 addr;
 } RzSearchHit;
 
+typedef struct rz_search_automaton_t RzSearchAutomaton;
+
 typedef int (*RzSearchCallback)(RzSearchKeyword *kw, void *user, ut64 where);
 
 typedef struct rz_search_t {
@@ -70,6 +78,7 @@ typedef struct rz_search_t {
 	int align;
 	int (*update)(struct rz_search_t *s, ut64 from, const ut8 *buf, int len);
 	RzList /*<RzSearchKeyword *>*/ *kws; // TODO: Use rz_search_kw_new ()
+	RzSearchAutomaton *automaton; ///< keywords compiled by rz_search_multi_update()
 	RzIOBind iob;
 	char bckwrds;
 } RzSearch;
@@ -102,6 +111,7 @@ RZ_API void rz_search_string_prepare_backward(RzSearch *s);
 
 // TODO: is this an internal API?
 RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, int len);
+RZ_API int rz_search_multi_update(RzSearch *s, ut64 from, const ut8 *buf, int len);
 RZ_API int rz_search_aes_update(RzSearch *s, ut64 from, const ut8 *buf, int len);
 RZ_API int rz_search_privkey_update(RzSearch *s, ut64 from, const ut8 *buf, int len);
 RZ_API int rz_search_magic_update(RzSearch *_s, ut64 from, const ut8 *buf, int len);
@@ -14,6 +14,7 @@ typedef struct rz_skyline_t {
 } RzSkyline;
 
 RZ_API bool rz_skyline_add(RzSkyline *skyline, RzInterval itv, void *user);
+RZ_API bool rz_skyline_remove(RzSkyline *skyline, RzInterval itv);
 RZ_API const RzSkylineItem *rz_skyline_get_item_intersect(RzSkyline *skyline, ut64 addr, ut64 len);
 
 static inline void rz_skyline_init(RzSkyline *skyline) {
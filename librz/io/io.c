@@ -410,6 +410,8 @@ RZ_API bool rz_io_is_listener(RzIO *io) {
 
 RZ_API char *rz_io_system(RzIO *io, const char *cmd) {
 	if (io && io->desc && io->desc->plugin && io->desc->plugin->system && RZ_STR_ISNOTEMPTY(cmd)) {
+		// the command can change anything behind the plugin
+		rz_io_page_cache_invalidate(io, -1);
 		return io->desc->plugin->system(io, io->desc, cmd);
 	}
 	return NULL;
@@ -557,6 +559,7 @@ RZ_API void rz_io_bind(RzIO *io, RzIOBind *bnd) {
 	bnd->desc_get = rz_io_desc_get;
 	bnd->desc_size = rz_io_desc_size;
 	bnd->p2v = rz_io_p2v;
+	bnd->page_cache_invalidate = rz_io_page_cache_invalidate;
 	bnd->v2p = rz_io_v2p;
 	bnd->open = rz_io_open_nomap;
 	bnd->open_at = rz_io_open_at;
@@ -730,6 +733,7 @@ RZ_API int rz_io_fini(RzIO *io) {
 	rz_io_map_fini(io);
 	rz_list_free(io->plugins);
 	rz_io_cache_fini(io);
+	rz_io_page_cache_set(io, 0, 0);
 	if (io->runprofile) {
 		RZ_FREE(io->runprofile);
 	}
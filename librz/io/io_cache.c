@@ -4,6 +4,18 @@
 #include <rz_io.h>
 #include <rz_skyline.h>
 
+/**
+ * \file io_cache.c
+ * \brief Write cache of RzIO (io.cache)
+ *
+ * Every cached write is kept on its own, from the oldest to the newest, so that
+ * invalidating a range drops the whole writes intersecting it and restores the
+ * bytes they replaced. The skyline holds the parts of the writes which are not
+ * hidden by newer ones, and the interval tree indexes the writes by address, so
+ * that an invalidation, a commit or a pop only visits the writes intersecting
+ * the affected range and only rebuilds the skyline in that range.
+ */
+
 static void cache_item_free(RzIOCache *cache) {
 	if (!cache) {
 		return;
@@ -13,6 +25,132 @@ static void cache_item_free(RzIOCache *cache) {
 	free(cache);
 }
 
+static inline ut64 cache_last(const RzIOCache *cache) {
+	return rz_itv_begin(cache->itv) + rz_itv_size(cache->itv) - 1;
+}
+
+static int cache_seq_cmp(const void *a, const void *b) {
+	const ut64 x = ((const RzIOCache *)a)->seq;
+	const ut64 y = ((const RzIOCache *)b)->seq;
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+static int cache_seq_rev_cmp(const void *a, const void *b) {
+	return cache_seq_cmp(b, a);
+}
+
+#define CACHE_SEQ_CMP(x, c) (((x) > ((RzIOCache *)(c))->seq) - ((x) < ((RzIOCache *)(c))->seq))
+
+static bool cache_collect_cb(RzIntervalNode *node, void *user) {
+	return rz_pvector_push(user, node->data);
+}
+
+/**
+ * Collects the cached writes intersecting [from, last] (inclusive).
+ */
+static bool cache_collect(RzIO *io, ut64 from, ut64 last, RzPVector *out) {
+	return rz_interval_tree_all_intersect(&io->cache_index, from, last, true, cache_collect_cb, out);
+}
+
+typedef struct {
+	ut64 to;
+	RzPVector *out;
+} CacheCollectRangeCtx;
+
+static bool cache_collect_range_cb(RzIntervalNode *node, void *user) {
+	CacheCollectRangeCtx *ctx = user;
+	return node->start >= ctx->to || rz_pvector_push(ctx->out, node->data);
+}
+
+/**
+ * Collects the cached writes overlapping the interval starting at \p from and
+ * ending at \p to (exclusive, 0 is the end of the address space), with the same
+ * semantics of rz_itv_overlap(). When \p to is not after \p from, these are the
+ * writes starting before \p to and ending after \p from.
+ */
+static bool cache_collect_range(RzIO *io, ut64 from, ut64 to, RzPVector *out) {
+	if (!to || to > from) {
+		return cache_collect(io, from, to - 1, out);
+	}
+	CacheCollectRangeCtx ctx = { to, out };
+	return rz_interval_tree_all_in(&io->cache_index, from, true, cache_collect_range_cb, &ctx);
+}
+
+/**
+ * Rebuilds the skyline in \p range from the cached writes intersecting it,
+ * applying them from the oldest to the newest.
+ */
+static bool cache_skyline_update(RzIO *io, RzInterval range) {
+	if (!rz_skyline_remove(&io->cache_skyline, range)) {
+		return false;
+	}
+	RzPVector writes;
+	rz_pvector_init(&writes, NULL);
+	bool ret = cache_collect(io, rz_itv_begin(range), rz_itv_begin(range) + rz_itv_size(range) - 1, &writes);
+	rz_pvector_sort(&writes, cache_seq_cmp);
+	void **it;
+	rz_pvector_foreach (&writes, it) {
+		if (!ret) {
+			break;
+		}
+		RzIOCache *c = *it;
+		ret = rz_skyline_add(&io->cache_skyline, rz_itv_intersect(c->itv, range), c);
+	}
+	rz_pvector_fini(&writes);
+	return ret;
+}
+
+/**
+ * Unlinks \p cache from the cached writes, without updating the skyline.
+ */
+static void cache_remove(RzIO *io, RzIOCache *cache) {
+	RzIntervalNode *node = rz_interval_tree_node_at_data(&io->cache_index, rz_itv_begin(cache->itv), cache);
+	if (node) {
+		rz_interval_tree_delete(&io->cache_index, node, false);
+	}
+	size_t i;
+	rz_pvector_lower_bound(&io->cache, cache->seq, i, CACHE_SEQ_CMP);
+	if (i < rz_pvector_len(&io->cache) && rz_pvector_at(&io->cache, i) == cache) {
+		rz_pvector_remove_at(&io->cache, i);
+	}
+}
+
+static int itv_cmp(const void *a, const void *b) {
+	const ut64 x = rz_itv_begin(*(const RzInterval *)a);
+	const ut64 y = rz_itv_begin(*(const RzInterval *)b);
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+/**
+ * Updates the skyline in the \p ranges of the removed writes, merging the
+ * overlapping ones.
+ */
+static bool cache_skyline_update_ranges(RzIO *io, RzVector *ranges) {
+	if (rz_vector_empty(ranges)) {
+		return true;
+	}
+	rz_vector_sort(ranges, itv_cmp, false);
+	bool ret = true;
+	RzInterval cur = { 0 };
+	RzInterval *itv;
+	rz_vector_foreach(ranges, itv) {
+		const ut64 cur_last = rz_itv_begin(cur) + rz_itv_size(cur) - 1;
+		if (rz_itv_size(cur) && rz_itv_begin(*itv) <= cur_last) {
+			const ut64 last = RZ_MAX(cur_last, rz_itv_begin(*itv) + rz_itv_size(*itv) - 1);
+			cur.size = last - rz_itv_begin(cur) + 1;
+			continue;
+		}
+		if (rz_itv_size(cur) && !cache_skyline_update(io, cur)) {
+			ret = false;
+		}
+		cur = *itv;
+	}
+	if (rz_itv_size(cur) && !cache_skyline_update(io, cur)) {
+		ret = false;
+	}
+	return ret;
+}
+
 RZ_API bool rz_io_cache_at(RzIO *io, ut64 addr) {
 	rz_return_val_if_fail(io, false);
 	return rz_skyline_contains(&io->cache_skyline, addr);
@@ -22,85 +160,127 @@ RZ_API void rz_io_cache_init(RzIO *io) {
 	rz_return_if_fail(io);
 	rz_pvector_init(&io->cache, (RzPVectorFree)cache_item_free);
 	rz_skyline_init(&io->cache_skyline);
+	rz_interval_tree_init(&io->cache_index, NULL);
+	rz_vector_init(&io->cache_stack, sizeof(ut64), NULL, NULL);
 	io->cached = 0;
 }
 
 RZ_API void rz_io_cache_fini(RzIO *io) {
 	rz_return_if_fail(io);
+	rz_interval_tree_fini(&io->cache_index);
+	rz_interval_tree_init(&io->cache_index, NULL);
 	rz_pvector_fini(&io->cache);
 	rz_skyline_fini(&io->cache_skyline);
+	rz_vector_fini(&io->cache_stack);
 	io->cached = 0;
+	io->snapshot_gen++;
 }
 
-RZ_API void rz_io_cache_commit(RzIO *io, ut64 from, ut64 to) {
+/**
+ * \brief Writes to the underlying IO the cached writes overlapping [from, to)
+ *
+ * The writes are committed whole, from the oldest to the newest.
+ *
+ * \return false if the writes cannot be collected or written
+ */
+RZ_API bool rz_io_cache_commit(RzIO *io, ut64 from, ut64 to) {
+	rz_return_val_if_fail(io, false);
+	RzPVector writes;
+	rz_pvector_init(&writes, NULL);
+	if (!cache_collect_range(io, from, to, &writes)) {
+		rz_pvector_fini(&writes);
+		return false;
+	}
+	rz_pvector_sort(&writes, cache_seq_cmp);
+	bool ret = true;
 	void **iter;
-	RzIOCache *c;
-	RzInterval range = (RzInterval){ from, to - from };
-	rz_return_if_fail(io);
-	rz_pvector_foreach (&io->cache, iter) {
-		// if (from <= c->to - 1 && c->from <= to - 1) {
-		c = *iter;
-		if (rz_itv_overlap(c->itv, range)) {
-			int cached = io->cached;
-			io->cached = 0;
-			if (rz_io_write_at(io, rz_itv_begin(c->itv), c->data, rz_itv_size(c->itv))) {
-				c->written = true;
-			} else {
-				eprintf("Error writing change at 0x%08" PFMT64x "\n", rz_itv_begin(c->itv));
-			}
-			io->cached = cached;
-			// break; // XXX old behavior, revisit this
+	rz_pvector_foreach (&writes, iter) {
+		RzIOCache *c = *iter;
+		int cached = io->cached;
+		io->cached = 0;
+		if (rz_io_write_at(io, rz_itv_begin(c->itv), c->data, rz_itv_size(c->itv))) {
+			c->written = true;
+		} else {
+			eprintf("Error writing change at 0x%08" PFMT64x "\n", rz_itv_begin(c->itv));
+			ret = false;
 		}
+		io->cached = cached;
 	}
+	rz_pvector_fini(&writes);
+	io->snapshot_gen++;
+	return ret;
 }
 
 RZ_API void rz_io_cache_reset(RzIO *io, int set) {
 	rz_return_if_fail(io);
 	io->cached = set;
+	rz_interval_tree_fini(&io->cache_index);
+	rz_interval_tree_init(&io->cache_index, NULL);
 	rz_pvector_clear(&io->cache);
 	rz_skyline_clear(&io->cache_skyline);
+	io->snapshot_gen++;
 }
 
+/**
+ * \brief Drops the cached writes overlapping [from, to)
+ *
+ * The writes are dropped whole, from the newest to the oldest, restoring in the
+ * underlying IO the bytes they replaced.
+ *
+ * \return the number of writes which were dropped, -1 on failure
+ */
 RZ_API int rz_io_cache_invalidate(RzIO *io, ut64 from, ut64 to) {
-	rz_return_val_if_fail(io, 0);
+	rz_return_val_if_fail(io, -1);
+	RzPVector writes;
+	rz_pvector_init(&writes, NULL);
+	RzVector ranges;
+	rz_vector_init(&ranges, sizeof(RzInterval), NULL, NULL);
+	if (!cache_collect_range(io, from, to, &writes) ||
+		(!rz_pvector_empty(&writes) && !rz_vector_reserve(&ranges, rz_pvector_len(&writes)))) {
+		rz_pvector_fini(&writes);
+		rz_vector_fini(&ranges);
+		return -1;
+	}
+	rz_pvector_sort(&writes, cache_seq_rev_cmp);
 	int invalidated = 0;
 	void **iter;
-	RzIOCache *c;
-	RzInterval range = (RzInterval){ from, to - from };
-	rz_pvector_foreach_prev(&io->cache, iter) {
-		c = *iter;
-		if (rz_itv_overlap(c->itv, range)) {
-			int cached = io->cached;
-			io->cached = 0;
-			rz_io_write_at(io, rz_itv_begin(c->itv), c->odata, rz_itv_size(c->itv));
-			io->cached = cached;
-			c->written = false;
-			rz_pvector_remove_data(&io->cache, c);
-			free(c->data);
-			free(c->odata);
-			free(c);
-			invalidated++;
-		}
+	rz_pvector_foreach (&writes, iter) {
+		RzIOCache *c = *iter;
+		int cached = io->cached;
+		io->cached = 0;
+		rz_io_write_at(io, rz_itv_begin(c->itv), c->odata, rz_itv_size(c->itv));
+		io->cached = cached;
+		cache_remove(io, c);
+		// cannot fail, the ranges are reserved
+		rz_vector_push(&ranges, &c->itv);
+		cache_item_free(c);
+		invalidated++;
 	}
-	rz_skyline_clear(&io->cache_skyline);
-	rz_pvector_foreach (&io->cache, iter) {
-		c = *iter;
-		rz_skyline_add(&io->cache_skyline, c->itv, c);
+	rz_pvector_fini(&writes);
+	bool updated = cache_skyline_update_ranges(io, &ranges);
+	rz_vector_fini(&ranges);
+	io->snapshot_gen++;
+	return updated ? invalidated : -1;
+}
+
+/**
+ * Returns the seq of the next write, greater than the ones of all the writes
+ * cached before the last rz_io_cache_push().
+ */
+static ut64 cache_next_seq(RzIO *io) {
+	RzIOCache *newest = rz_pvector_empty(&io->cache) ? NULL : rz_pvector_tail(&io->cache);
+	ut64 seq = newest ? newest->seq + 1 : 0;
+	if (!rz_vector_empty(&io->cache_stack)) {
+		seq = RZ_MAX(seq, *(ut64 *)rz_vector_tail(&io->cache_stack));
 	}
-	return invalidated;
+	return seq;
 }
 
-RZ_API bool rz_io_cache_write(RzIO *io, ut64 addr, const ut8 *buf, int len) {
-	rz_return_val_if_fail(io && buf, false);
+static bool cache_write(RzIO *io, ut64 addr, const ut8 *buf, ut64 len) {
 	RzIOCache *ch = RZ_NEW0(RzIOCache);
 	if (!ch) {
 		return false;
 	}
-	if (UT64_ADD_OVFCHK(addr, len)) {
-		const ut64 first_len = UT64_MAX - addr;
-		rz_io_cache_write(io, 0, buf + first_len, len - first_len);
-		len = first_len;
-	}
 	ch->itv = (RzInterval){ addr, len };
 	ch->odata = (ut8 *)calloc(1, len + 1);
 	if (!ch->odata) {
@@ -121,49 +301,135 @@ RZ_API bool rz_io_cache_write(RzIO *io, ut64 addr, const ut8 *buf, int len) {
 		io->cachemode = cm;
 	}
 	memcpy(ch->data, buf, len);
-	rz_pvector_push(&io->cache, ch);
-	rz_skyline_add(&io->cache_skyline, ch->itv, ch);
+	ch->seq = cache_next_seq(io);
+	if (!rz_pvector_push(&io->cache, ch)) {
+		cache_item_free(ch);
+		return false;
+	}
+	if (!rz_interval_tree_insert(&io->cache_index, addr, cache_last(ch), ch)) {
+		rz_pvector_pop(&io->cache);
+		cache_item_free(ch);
+		return false;
+	}
+	if (!rz_skyline_add(&io->cache_skyline, ch->itv, ch)) {
+		// the skyline is left untouched on failure
+		cache_remove(io, ch);
+		cache_item_free(ch);
+		return false;
+	}
+	return true;
+}
+
+RZ_API bool rz_io_cache_write(RzIO *io, ut64 addr, const ut8 *buf, int len) {
+	rz_return_val_if_fail(io && buf, false);
+	if (len <= 0) {
+		return len == 0;
+	}
+	bool ret = true;
+	if (UT64_ADD_OVFCHK(addr, len - 1)) {
+		const ut64 first_len = UT64_MAX - addr + 1;
+		ret = cache_write(io, 0, buf + first_len, len - first_len);
+		len = first_len;
+	}
+	if (!cache_write(io, addr, buf, len)) {
+		ret = false;
+	}
+	io->snapshot_gen++;
 	RzEventIOWrite iow = { addr, buf, len };
 	rz_event_send(io->event, RZ_EVENT_IO_WRITE, &iow);
-	return true;
+	return ret;
 }
 
 RZ_API bool rz_io_cache_read(RzIO *io, ut64 addr, ut8 *buf, int len) {
 	rz_return_val_if_fail(io && buf, false);
 	RzSkyline *skyline = &io->cache_skyline;
-	if (!len) {
+	if (len <= 0) {
 		return true;
 	}
-	if (UT64_ADD_OVFCHK(addr, len)) {
-		const ut64 first_len = UT64_MAX - addr;
-		rz_io_cache_read(io, 0, buf + first_len, len - first_len);
+	bool covered = false;
+	if (UT64_ADD_OVFCHK(addr, len - 1)) {
+		const ut64 first_len = UT64_MAX - addr + 1;
+		covered = rz_io_cache_read(io, 0, buf + first_len, len - first_len);
 		len = first_len;
 	}
 	const RzSkylineItem *iter = rz_skyline_get_item_intersect(skyline, addr, len);
 	if (!iter) {
-		return false;
+		return covered;
 	}
 	const RzSkylineItem *last = (RzSkylineItem *)skyline->v.a + skyline->v.len;
-	bool covered = false;
-	while (iter != last) {
-		const ut64 begin = rz_itv_begin(iter->itv);
-		const st64 addr_offset = begin - addr;
-		const ut64 buf_offset = addr_offset > 0 ? addr_offset : 0;
-		const ut64 cur_addr = addr + buf_offset;
-		const ut64 left = len - buf_offset;
-		if (begin > cur_addr + left) {
-			break;
-		}
+	const ut64 read_last = addr + len - 1;
+	for (; iter != last && rz_itv_begin(iter->itv) <= read_last; iter++) {
 		RzIOCache *cache = iter->user;
-		const ut64 cache_shift = addr_offset < 0 ? -addr_offset : 0;
-		const ut64 cache_offset = begin - rz_itv_begin(cache->itv) + cache_shift;
-		const ut64 read = RZ_MIN(left, rz_itv_size(iter->itv) - cache_shift);
-		memcpy(buf + buf_offset, cache->data + cache_offset, read);
+		const ut64 begin = RZ_MAX(addr, rz_itv_begin(iter->itv));
+		const ut64 end = RZ_MIN(read_last, rz_itv_begin(iter->itv) + rz_itv_size(iter->itv) - 1);
+		memcpy(buf + (begin - addr), cache->data + (begin - rz_itv_begin(cache->itv)), end - begin + 1);
 		covered = true;
-		if (left - read <= 0) {
-			break;
-		}
-		iter++;
 	}
 	return covered;
 }
+
+/**
+ * \brief Saves the current state of the write cache, see rz_io_cache_pop()
+ */
+RZ_API bool rz_io_cache_push(RZ_NONNULL RzIO *io) {
+	rz_return_val_if_fail(io, false);
+	ut64 seq = cache_next_seq(io);
+	return rz_vector_push(&io->cache_stack, &seq);
+}
+
+/**
+ * \brief Drops all the cache writes done since the last rz_io_cache_push()
+ *
+ * Differently from rz_io_cache_invalidate(), the underlying IO is not touched,
+ * so the writes must not have been committed in the meantime.
+ */
+RZ_API bool rz_io_cache_pop(RZ_NONNULL RzIO *io) {
+	rz_return_val_if_fail(io, false);
+	if (rz_vector_empty(&io->cache_stack)) {
+		return false;
+	}
+	const ut64 seq = *(ut64 *)rz_vector_tail(&io->cache_stack);
+	size_t first;
+	rz_pvector_lower_bound(&io->cache, seq, first, CACHE_SEQ_CMP);
+	RzVector ranges;
+	rz_vector_init(&ranges, sizeof(RzInterval), NULL, NULL);
+	if (rz_pvector_len(&io->cache) > first && !rz_vector_reserve(&ranges, rz_pvector_len(&io->cache) - first)) {
+		return false;
+	}
+	rz_vector_pop(&io->cache_stack, NULL);
+	while (rz_pvector_len(&io->cache) > first) {
+		RzIOCache *c = rz_pvector_tail(&io->cache);
+		cache_remove(io, c);
+		rz_vector_push(&ranges, &c->itv);
+		cache_item_free(c);
+	}
+	bool ret = cache_skyline_update_ranges(io, &ranges);
+	rz_vector_fini(&ranges);
+	io->snapshot_gen++;
+	return ret;
+}
+
+/**
+ * \brief Fills \p stats with the size and the memory usage of the write cache.
+ */
+RZ_API void rz_io_cache_stats(RZ_NONNULL RzIO *io, RZ_NONNULL RZ_OUT RzIOCacheStats *stats) {
+	rz_return_if_fail(io && stats);
+	memset(stats, 0, sizeof(*stats));
+	void **iter;
+	rz_pvector_foreach (&io->cache, iter) {
+		RzIOCache *c = *iter;
+		const ut64 size = rz_itv_size(c->itv);
+		stats->writes++;
+		if (c->written) {
+			stats->written++;
+		}
+		stats->memory += sizeof(RzIntervalNode) + sizeof(RzIOCache) + 2 * (size + 1);
+	}
+	const RzSkylineItem *item;
+	rz_vector_foreach(&io->cache_skyline.v, item) {
+		stats->bytes += rz_itv_size(item->itv);
+	}
+	stats->memory += io->cache.v.capacity * sizeof(void *);
+	stats->memory += io->cache_skyline.v.capacity * sizeof(RzSkylineItem);
+	stats->saved = rz_vector_len(&io->cache_stack);
+}
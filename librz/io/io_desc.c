@@ -6,6 +6,7 @@
 #include <rz_io.h>
 #include <sdb.h>
 #include <string.h>
+#include "io_private.h"
 
 // shall be used by plugins for creating descs
 RZ_API RzIODesc *rz_io_desc_new(RzIO *io, RzIOPlugin *plugin, const char *uri, int perm, int mode, void *data) {
@@ -38,6 +39,9 @@ RZ_API void rz_io_desc_free(RzIODesc *desc) {
 		free(desc->referer);
 		free(desc->name);
 		rz_io_desc_cache_fini(desc);
+		if (desc->io) {
+			rz_io_page_cache_invalidate(desc->io, desc->fd);
+		}
 		if (desc->io && desc->io->files) {
 			rz_id_storage_delete(desc->io->files, desc->fd);
 		}
@@ -65,6 +69,7 @@ RZ_API bool rz_io_desc_del(RzIO *io, int fd) { // can we pass this a riodesc and
 	if (desc == io->desc) {
 		io->desc = NULL;
 	}
+	io->snapshot_gen++;
 	// remove all dead maps
 	rz_io_map_cleanup(io);
 	return true;
@@ -185,6 +190,14 @@ RZ_API int rz_io_desc_write(RzIODesc *desc, const ut8 *buf, int len) {
 	if (len < 0) {
 		return -1;
 	}
+	if (desc->io) {
+		// the memory of the desc may change or move
+		desc->io->snapshot_gen++;
+		if (desc->io->page_cache) {
+			ut64 at = rz_io_desc_seek(desc, 0LL, RZ_IO_SEEK_CUR);
+			io_page_cache_invalidate_range(desc->io, desc->fd, at, len);
+		}
+	}
 	// check pointers and pcache
 	if (desc->io && (desc->io->p_cache & 2)) {
 		return rz_io_desc_cache_write(desc,
@@ -253,6 +266,10 @@ RZ_API bool rz_io_desc_resize(RzIODesc *desc, ut64 newsize) {
 		if (desc->io && desc->io->p_cache) {
 			rz_io_desc_cache_cleanup(desc);
 		}
+		if (desc->io) {
+			desc->io->snapshot_gen++;
+			rz_io_page_cache_invalidate(desc->io, desc->fd);
+		}
 		return ret;
 	}
 	return false;
@@ -281,6 +298,9 @@ RZ_API bool rz_io_desc_exchange(RzIO *io, int fd, int fdx) {
 	descx->fd = fd;
 	rz_id_storage_set(io->files, desc, fdx);
 	rz_id_storage_set(io->files, descx, fd);
+	rz_io_page_cache_invalidate(io, fd);
+	rz_io_page_cache_invalidate(io, fdx);
+	io->snapshot_gen++;
 	if (io->p_cache) {
 		HtUP *cache = desc->cache;
 		desc->cache = descx->cache;
@@ -349,6 +369,10 @@ RZ_API bool rz_io_desc_get_base(RzIODesc *desc, ut64 *base) {
 }
 
 RZ_API int rz_io_desc_read_at(RzIODesc *desc, ut64 addr, ut8 *buf, int len) {
+	int ret;
+	if (desc && buf && io_page_cache_read(desc, addr, buf, len, &ret)) {
+		return ret;
+	}
 	if (desc && buf && (rz_io_desc_seek(desc, addr, RZ_IO_SEEK_SET) == addr)) {
 		return rz_io_desc_read(desc, buf, len);
 	}
@@ -13,6 +13,7 @@
 // Store map parts that are not covered by others into io->map_skyline
 void io_map_calculate_skyline(RzIO *io) {
 	rz_skyline_clear(&io->map_skyline);
+	io->snapshot_gen++;
 	// Last map has highest priority (it shadows previous maps)
 	void **it;
 	rz_pvector_foreach (&io->maps, it) {
@@ -44,6 +45,7 @@ RzIOMap *io_map_new(RzIO *io, int fd, int perm, ut64 delta, ut64 addr, ut64 size
 	// new map lives on the top, being top the list's tail
 	rz_pvector_push(&io->maps, map);
 	rz_skyline_add(&io->map_skyline, map->itv, map);
+	io->snapshot_gen++;
 	return map;
 }
 
@@ -239,6 +241,7 @@ RZ_API bool rz_io_map_priorize(RzIO *io, ut32 id) {
 			rz_pvector_remove_at(&io->maps, i);
 			rz_pvector_push(&io->maps, map);
 			rz_skyline_add(&io->map_skyline, map->itv, map);
+			io->snapshot_gen++;
 			return true;
 		}
 	}
@@ -327,6 +330,7 @@ RZ_API void rz_io_map_fini(RzIO *io) {
 	rz_id_pool_free(io->map_ids);
 	io->map_ids = NULL;
 	rz_skyline_clear(&io->map_skyline);
+	io->snapshot_gen++;
 }
 
 RZ_API void rz_io_map_set_name(RzIOMap *map, const char *name) {
@@ -142,3 +142,11 @@ ut64 io_memory_lseek(RzIO *io, RzIODesc *fd, ut64 offset, int whence) {
 	_io_malloc_set_off(fd, rz_offset);
 	return rz_offset;
 }
+
+ut8 *io_memory_get_buf(RzIODesc *fd, ut64 *size) {
+	if (!fd || !fd->data) {
+		return NULL;
+	}
+	*size = _io_malloc_sz(fd);
+	return _io_malloc_buf(fd);
+}
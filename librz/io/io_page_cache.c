@@ -0,0 +1,324 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_io.h>
+#include "io_private.h"
+
+/**
+ * \file io_page_cache.c
+ * \brief Read cache of fixed size pages placed between RzIODesc and the io plugins.
+ *
+ * Each page holds the bytes read from a desc at a page-aligned physical address,
+ * so many small reads (e.g. one instruction at a time during the analysis) are
+ * served from memory instead of being dispatched to the plugin, which can be
+ * very slow on remote backends (gdb, rap, ...).
+ *
+ * The pages are evicted with the CLOCK algorithm and are invalidated on every
+ * write, resize or close of the desc they belong to.
+ */
+
+typedef struct io_page_t {
+	int fd;
+	ut64 addr; ///< page-aligned physical address
+	ut32 size; ///< number of valid bytes, can be less than the page size at the end of the desc
+	bool used;
+	bool referenced;
+	ut8 *data;
+	struct io_page_t *next; ///< next page with the same address but different fd
+} IOPage;
+
+struct rz_io_page_cache_t {
+	ut32 page_size;
+	ut32 n_pages;
+	ut32 hand; ///< CLOCK hand
+	ut32 used;
+	IOPage *pages;
+	ut8 *data;
+	HtUP /*<ut64, IOPage *>*/ *index; ///< page address -> chain of pages
+	ut64 hits;
+	ut64 misses;
+	ut64 evictions;
+};
+
+static void page_cache_free(RzIOPageCache *cache) {
+	if (!cache) {
+		return;
+	}
+	ht_up_free(cache->index);
+	free(cache->pages);
+	free(cache->data);
+	free(cache);
+}
+
+static RzIOPageCache *page_cache_new(ut32 page_size, ut32 n_pages) {
+	RzIOPageCache *cache = RZ_NEW0(RzIOPageCache);
+	if (!cache) {
+		return NULL;
+	}
+	cache->page_size = page_size;
+	cache->n_pages = n_pages;
+	cache->pages = RZ_NEWS0(IOPage, n_pages);
+	cache->data = malloc((size_t)page_size * n_pages);
+	cache->index = ht_up_new0();
+	if (!cache->pages || !cache->data || !cache->index) {
+		page_cache_free(cache);
+		return NULL;
+	}
+	for (ut32 i = 0; i < n_pages; i++) {
+		cache->pages[i].data = cache->data + (size_t)i * page_size;
+	}
+	return cache;
+}
+
+static void page_unlink(RzIOPageCache *cache, IOPage *page) {
+	IOPage *head = ht_up_find(cache->index, page->addr, NULL);
+	if (head == page) {
+		if (page->next) {
+			ht_up_update(cache->index, page->addr, page->next);
+		} else {
+			ht_up_delete(cache->index, page->addr);
+		}
+	} else {
+		for (IOPage *p = head; p; p = p->next) {
+			if (p->next == page) {
+				p->next = page->next;
+				break;
+			}
+		}
+	}
+	page->next = NULL;
+	page->used = false;
+	page->referenced = false;
+	cache->used--;
+}
+
+static IOPage *page_find(RzIOPageCache *cache, int fd, ut64 addr) {
+	for (IOPage *p = ht_up_find(cache->index, addr, NULL); p; p = p->next) {
+		if (p->fd == fd) {
+			return p;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Returns an unused page, evicting the first page without the reference bit.
+ */
+static IOPage *page_alloc(RzIOPageCache *cache) {
+	while (true) {
+		IOPage *page = &cache->pages[cache->hand];
+		cache->hand = (cache->hand + 1) % cache->n_pages;
+		if (!page->used) {
+			return page;
+		}
+		if (page->referenced) {
+			page->referenced = false;
+			continue;
+		}
+		page_unlink(cache, page);
+		cache->evictions++;
+		return page;
+	}
+}
+
+static IOPage *page_fill(RzIOPageCache *cache, RzIODesc *desc, ut64 addr) {
+	if (rz_io_desc_seek(desc, addr, RZ_IO_SEEK_SET) != addr) {
+		return NULL;
+	}
+	IOPage *page = page_alloc(cache);
+	int ret = rz_io_plugin_read(desc, page->data, (int)cache->page_size);
+	if (ret <= 0) {
+		return NULL;
+	}
+	page->fd = desc->fd;
+	page->addr = addr;
+	page->size = (ut32)ret;
+	page->used = true;
+	page->referenced = true;
+	page->next = ht_up_find(cache->index, addr, NULL);
+	ht_up_update(cache->index, addr, page);
+	cache->used++;
+	return page;
+}
+
+/**
+ * \brief Reads \p len bytes at \p paddr of \p desc through the page cache.
+ *
+ * The cache only serves reads it can complete: when a page cannot be filled or
+ * is shorter than the requested range (a partially mapped page, the end of the
+ * desc, ...), the caller reads from the desc as if the cache was disabled.
+ *
+ * \return Returns false when the cache cannot be used for this read and the caller
+ *         must read from the desc; otherwise returns true and stores \p len in \p read.
+ */
+RZ_IPI bool io_page_cache_read(RzIODesc *desc, ut64 paddr, ut8 *buf, int len, int *read) {
+	RzIO *io = desc->io;
+	RzIOPageCache *cache = io ? io->page_cache : NULL;
+	if (!cache || len <= 0 || io->cachemode || io->p_cache || !desc->plugin || !(desc->perm & RZ_PERM_R)) {
+		return false;
+	}
+	const ut64 mask = ~(ut64)(cache->page_size - 1);
+	ut64 first = paddr & mask;
+	if (UT64_ADD_OVFCHK(paddr, len) || ((paddr + len - 1 - first) / cache->page_size) >= cache->n_pages / 2) {
+		// big reads would just flush the cache
+		return false;
+	}
+	int done = 0;
+	while (done < len) {
+		ut64 at = paddr + done;
+		ut64 page_addr = at & mask;
+		IOPage *page = page_find(cache, desc->fd, page_addr);
+		if (page) {
+			cache->hits++;
+			page->referenced = true;
+		} else {
+			cache->misses++;
+			page = page_fill(cache, desc, page_addr);
+			if (!page) {
+				break;
+			}
+		}
+		ut64 delta = at - page_addr;
+		if (delta >= page->size) {
+			break;
+		}
+		int size = (int)RZ_MIN((ut64)(len - done), page->size - delta);
+		memcpy(buf + done, page->data + delta, size);
+		done += size;
+		if (page->size < cache->page_size) {
+			// end of the readable bytes of the desc
+			break;
+		}
+	}
+	if (done < len) {
+		return false;
+	}
+	*read = done;
+	return true;
+}
+
+/**
+ * \brief Invalidates the cached pages of \p fd overlapping [paddr, paddr + len)
+ */
+RZ_IPI void io_page_cache_invalidate_range(RzIO *io, int fd, ut64 paddr, ut64 len) {
+	RzIOPageCache *cache = io->page_cache;
+	if (!cache || !cache->used || !len) {
+		return;
+	}
+	const ut64 mask = ~(ut64)(cache->page_size - 1);
+	ut64 last = UT64_ADD_OVFCHK(paddr, len - 1) ? UT64_MAX : paddr + len - 1;
+	if (((last & mask) - (paddr & mask)) / cache->page_size >= cache->used) {
+		// cheaper to walk all the pages
+		for (ut32 i = 0; i < cache->n_pages; i++) {
+			IOPage *page = &cache->pages[i];
+			if (page->used && page->fd == fd && page->addr <= last && page->addr + (cache->page_size - 1) >= paddr) {
+				page_unlink(cache, page);
+			}
+		}
+		return;
+	}
+	for (ut64 addr = paddr & mask;; addr += cache->page_size) {
+		IOPage *page = page_find(cache, fd, addr);
+		if (page) {
+			page_unlink(cache, page);
+		}
+		if (addr == (last & mask)) {
+			break;
+		}
+	}
+}
+
+/**
+ * \brief Enables, resizes or disables the page cache of \p io.
+ *
+ * Any previously cached page and the statistics are dropped.
+ *
+ * \param io The RzIO instance
+ * \param page_size Size of each page, rounded up to a power of two
+ * \param n_pages Maximum number of cached pages, 0 disables the cache
+ * \return true on success, false on failure
+ */
+RZ_API bool rz_io_page_cache_set(RZ_NONNULL RzIO *io, ut32 page_size, ut32 n_pages) {
+	rz_return_val_if_fail(io, false);
+	page_cache_free(io->page_cache);
+	io->page_cache = NULL;
+	if (!n_pages) {
+		return true;
+	}
+	if (page_size < 16 || page_size > (1U << 24)) {
+		RZ_LOG_ERROR("io: invalid page cache page size %u\n", page_size);
+		return false;
+	}
+	ut32 size = 16;
+	while (size < page_size) {
+		size <<= 1;
+	}
+	io->page_cache = page_cache_new(size, n_pages);
+	if (!io->page_cache) {
+		RZ_LOG_ERROR("io: cannot allocate %u pages of %u bytes for the page cache\n", n_pages, size);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * \brief Drops all the cached pages of \p fd, or of every desc when \p fd is -1.
+ */
+RZ_API void rz_io_page_cache_invalidate(RZ_NONNULL RzIO *io, int fd) {
+	rz_return_if_fail(io);
+	RzIOPageCache *cache = io->page_cache;
+	if (!cache || !cache->used) {
+		return;
+	}
+	if (fd == -1) {
+		ht_up_free(cache->index);
+		cache->index = ht_up_new0();
+		for (ut32 i = 0; i < cache->n_pages; i++) {
+			cache->pages[i].used = false;
+			cache->pages[i].referenced = false;
+			cache->pages[i].next = NULL;
+		}
+		cache->used = 0;
+		return;
+	}
+	for (ut32 i = 0; i < cache->n_pages; i++) {
+		IOPage *page = &cache->pages[i];
+		if (page->used && page->fd == fd) {
+			page_unlink(cache, page);
+		}
+	}
+}
+
+/**
+ * \brief Fills \p stats with the counters of the page cache.
+ *
+ * \return false if the page cache is disabled
+ */
+RZ_API bool rz_io_page_cache_stats(RZ_NONNULL RzIO *io, RZ_NONNULL RZ_OUT RzIOPageCacheStats *stats) {
+	rz_return_val_if_fail(io && stats, false);
+	RzIOPageCache *cache = io->page_cache;
+	if (!cache) {
+		memset(stats, 0, sizeof(*stats));
+		return false;
+	}
+	stats->page_size = cache->page_size;
+	stats->n_pages = cache->n_pages;
+	stats->used = cache->used;
+	stats->hits = cache->hits;
+	stats->misses = cache->misses;
+	stats->evictions = cache->evictions;
+	return true;
+}
+
+/**
+ * \brief Resets the hit/miss/eviction counters of the page cache.
+ */
+RZ_API void rz_io_page_cache_stats_reset(RZ_NONNULL RzIO *io) {
+	rz_return_if_fail(io);
+	RzIOPageCache *cache = io->page_cache;
+	if (cache) {
+		cache->hits = 0;
+		cache->misses = 0;
+		cache->evictions = 0;
+	}
+}
@@ -8,4 +8,7 @@ RzIOMap *io_map_new(RzIO *io, int fd, int perm, ut64 delta, ut64 addr, ut64 size
 RzIOMap *io_map_add(RzIO *io, int fd, int flags, ut64 delta, ut64 addr, ut64 size, bool do_skyline);
 void io_map_calculate_skyline(RzIO *io);
 
+RZ_IPI bool io_page_cache_read(RzIODesc *desc, ut64 paddr, ut8 *buf, int len, int *read);
+RZ_IPI void io_page_cache_invalidate_range(RzIO *io, int fd, ut64 paddr, ut64 len);
+
 #endif
@@ -0,0 +1,305 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_io.h>
+#include <rz_th.h>
+#include "io_private.h"
+
+/**
+ * \file io_snapshot.c
+ * \brief Immutable read views of the RzIO maps that can be shared between threads.
+ *
+ * A RzIOSnapshot copies the current map skyline and the write cache of a RzIO.
+ * The map parts which are backed by a plugin exposing its memory (see RzIOPlugin.get_buf)
+ * are read directly without any lock, while all the other parts are read through
+ * the plugin while holding the snapshot lock.
+ *
+ * A snapshot becomes invalid as soon as the maps, the descs size or the write cache
+ * of the RzIO change; the owner of the RzIO can check it via rz_io_snapshot_is_valid().
+ * While other threads are reading from a snapshot, the owner must not use the RzIO,
+ * since the parts without direct memory access are read through it.
+ */
+
+typedef struct io_snapshot_part_t {
+	RzInterval itv; ///< virtual (or physical) interval covered by this part
+	ut64 paddr; ///< physical address of itv.addr
+	int perm;
+	int fd;
+	const ut8 *data; ///< direct access to the bytes at paddr, NULL when the part must be read via plugin
+	ut64 data_size; ///< available bytes in data
+} IOSnapshotPart;
+
+typedef struct io_snapshot_mem_t {
+	int fd;
+	const ut8 *data;
+	ut64 size;
+} IOSnapshotMem;
+
+typedef struct io_snapshot_patch_t {
+	RzInterval itv;
+	ut8 *data;
+} IOSnapshotPatch;
+
+struct rz_io_snapshot_t {
+	RzIO *io;
+	ut64 gen;
+	bool ff;
+	ut8 Oxff;
+	bool p_cache;
+	RzVector /*<IOSnapshotPart>*/ parts;
+	RzVector /*<IOSnapshotPatch>*/ patches;
+	RzVector /*<IOSnapshotMem>*/ mems;
+	RzThreadLock *lock;
+};
+
+static void io_snapshot_patch_fini(void *e, void *user) {
+	IOSnapshotPatch *patch = e;
+	free(patch->data);
+}
+
+/**
+ * The memory of a desc is asked only once per snapshot, because some plugins
+ * (e.g. a file buffer) release the previously returned memory on each call.
+ */
+static const IOSnapshotMem *io_snapshot_get_mem(RzIO *io, RzIOSnapshot *snap, int fd) {
+	IOSnapshotMem *mem;
+	rz_vector_foreach(&snap->mems, mem) {
+		if (mem->fd == fd) {
+			return mem;
+		}
+	}
+	mem = rz_vector_push(&snap->mems, NULL);
+	if (!mem) {
+		return NULL;
+	}
+	mem->fd = fd;
+	mem->data = NULL;
+	mem->size = 0;
+	RzIODesc *desc = rz_io_desc_get(io, fd);
+	if (!desc || io->cachemode || (io->p_cache & 1) || !(desc->perm & RZ_PERM_R)) {
+		// these reads need the plugin or the io caches
+		return mem;
+	}
+	ut64 size = 0;
+	const ut8 *data = rz_io_desc_get_buf(desc, &size);
+	if (data) {
+		mem->data = data;
+		mem->size = size;
+	}
+	return mem;
+}
+
+static bool io_snapshot_add_part(RzIO *io, RzIOSnapshot *snap, RzInterval itv, int fd, int perm, ut64 paddr) {
+	IOSnapshotPart *part = rz_vector_push(&snap->parts, NULL);
+	if (!part) {
+		return false;
+	}
+	part->itv = itv;
+	part->paddr = paddr;
+	part->fd = fd;
+	part->perm = perm;
+	part->data = NULL;
+	part->data_size = 0;
+
+	const IOSnapshotMem *mem = io_snapshot_get_mem(io, snap, fd);
+	if (mem && mem->data && paddr < mem->size) {
+		part->data = mem->data + paddr;
+		part->data_size = mem->size - paddr;
+	}
+	return true;
+}
+
+static bool io_snapshot_copy_cache(RzIO *io, RzIOSnapshot *snap) {
+	const RzSkylineItem *item;
+	rz_vector_foreach(&io->cache_skyline.v, item) {
+		RzIOCache *cache = item->user;
+		IOSnapshotPatch *patch = rz_vector_push(&snap->patches, NULL);
+		if (!patch) {
+			return false;
+		}
+		patch->itv = item->itv;
+		patch->data = rz_mem_dup(cache->data + (rz_itv_begin(item->itv) - rz_itv_begin(cache->itv)), rz_itv_size(item->itv));
+		if (!patch->data) {
+			rz_vector_pop(&snap->patches, NULL);
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Creates a new read-only snapshot of the maps of \p io
+ *
+ * \param io The RzIO to take the snapshot of
+ * \return On success returns a valid pointer, otherwise NULL
+ */
+RZ_API RZ_OWN RzIOSnapshot *rz_io_snapshot_new(RZ_NONNULL RzIO *io) {
+	rz_return_val_if_fail(io, NULL);
+	RzIOSnapshot *snap = RZ_NEW0(RzIOSnapshot);
+	if (!snap) {
+		return NULL;
+	}
+	snap->io = io;
+	snap->gen = io->snapshot_gen;
+	snap->ff = io->ff;
+	snap->Oxff = io->Oxff;
+	snap->p_cache = io->p_cache;
+	rz_vector_init(&snap->parts, sizeof(IOSnapshotPart), NULL, NULL);
+	rz_vector_init(&snap->patches, sizeof(IOSnapshotPatch), io_snapshot_patch_fini, NULL);
+	rz_vector_init(&snap->mems, sizeof(IOSnapshotMem), NULL, NULL);
+	snap->lock = rz_th_lock_new(false);
+	if (!snap->lock) {
+		goto fail;
+	}
+
+	if (io->va) {
+		const RzSkylineItem *item;
+		rz_vector_foreach(&io->map_skyline.v, item) {
+			RzIOMap *map = item->user;
+			ut64 paddr = map->delta + (rz_itv_begin(item->itv) - rz_itv_begin(map->itv));
+			if (!io_snapshot_add_part(io, snap, item->itv, map->fd, map->perm, paddr)) {
+				goto fail;
+			}
+		}
+	} else if (io->desc) {
+		ut64 size = rz_io_desc_size(io->desc);
+		if (size && !io_snapshot_add_part(io, snap, (RzInterval){ 0, size }, io->desc->fd, io->desc->perm, 0)) {
+			goto fail;
+		}
+	}
+
+	if ((io->cached & RZ_PERM_R) && !io_snapshot_copy_cache(io, snap)) {
+		goto fail;
+	}
+	return snap;
+
+fail:
+	RZ_LOG_ERROR("io: cannot allocate snapshot\n");
+	rz_io_snapshot_free(snap);
+	return NULL;
+}
+
+/**
+ * \brief Frees a RzIOSnapshot
+ */
+RZ_API void rz_io_snapshot_free(RZ_NULLABLE RzIOSnapshot *snap) {
+	if (!snap) {
+		return;
+	}
+	rz_vector_fini(&snap->parts);
+	rz_vector_fini(&snap->patches);
+	rz_vector_fini(&snap->mems);
+	rz_th_lock_free(snap->lock);
+	free(snap);
+}
+
+/**
+ * \brief Returns true if the maps and the write cache did not change since the snapshot was taken.
+ *
+ * This must be called by the thread which owns the RzIO.
+ */
+RZ_API bool rz_io_snapshot_is_valid(RZ_NONNULL const RzIOSnapshot *snap) {
+	rz_return_val_if_fail(snap, false);
+	return snap->gen == snap->io->snapshot_gen;
+}
+
+static bool io_snapshot_read_part(RzIOSnapshot *snap, const IOSnapshotPart *part, ut64 paddr, ut8 *buf, ut64 len) {
+	if (!(part->perm & RZ_PERM_R) && !snap->p_cache) {
+		return false;
+	}
+	ut64 delta = paddr - part->paddr;
+	if (part->data) {
+		if (delta >= part->data_size) {
+			return false;
+		}
+		ut64 size = RZ_MIN(len, part->data_size - delta);
+		memcpy(buf, part->data + delta, size);
+		return size == len;
+	}
+	bool ret = true;
+	rz_th_lock_enter(snap->lock);
+	while (len > 0) {
+		int size = (int)RZ_MIN(len, INT_MAX);
+		if (rz_io_fd_read_at(snap->io, part->fd, paddr, buf, size) != size) {
+			ret = false;
+			break;
+		}
+		paddr += size;
+		buf += size;
+		len -= size;
+	}
+	rz_th_lock_leave(snap->lock);
+	return ret;
+}
+
+static void io_snapshot_apply_patches(const RzIOSnapshot *snap, ut64 addr, ut8 *buf, ut64 len) {
+	const IOSnapshotPatch *patch;
+	RzInterval range = { addr, len };
+	rz_vector_foreach(&snap->patches, patch) {
+		if (!rz_itv_overlap(patch->itv, range)) {
+			continue;
+		}
+		ut64 begin = RZ_MAX(rz_itv_begin(patch->itv), addr);
+		ut64 end = RZ_MIN(rz_itv_end(patch->itv), addr + len);
+		memcpy(buf + (begin - addr), patch->data + (begin - rz_itv_begin(patch->itv)), end - begin);
+	}
+}
+
+/**
+ * \brief Reads \p len bytes at \p addr from the snapshot.
+ *
+ * This function can be called concurrently from multiple threads and behaves like
+ * rz_io_read_at_mapped() at the time the snapshot was taken: gaps are filled with
+ * io.Oxff (when io.ff is set) and the write cache is applied when it was enabled.
+ *
+ * \param snap The snapshot to read from
+ * \param addr Address to read at
+ * \param buf Buffer of at least \p len bytes
+ * \param len Number of bytes to read
+ * \return Returns true iff all the reads on mapped regions are successful and complete.
+ *         Like rz_io_read_at_mapped(), unmapped regions are not considered errors.
+ */
+RZ_API bool rz_io_snapshot_read_at(RZ_NONNULL RzIOSnapshot *snap, ut64 addr, RZ_NONNULL RZ_OUT ut8 *buf, ut64 len) {
+	rz_return_val_if_fail(snap && buf, false);
+	if (!len) {
+		return false;
+	}
+	if (UT64_ADD_OVFCHK(addr, len - 1)) {
+		const ut64 first_len = UT64_MAX - addr + 1;
+		bool first = rz_io_snapshot_read_at(snap, addr, buf, first_len);
+		return rz_io_snapshot_read_at(snap, 0, buf + first_len, len - first_len) && first;
+	}
+	if (snap->ff) {
+		memset(buf, snap->Oxff, len);
+	}
+
+	RzVector *parts = &snap->parts;
+	size_t i;
+	ut64 last = addr + len - 1;
+#define CMP(x, part) ((x) < rz_itv_end(((IOSnapshotPart *)(part))->itv) - 1 ? -1 : (x) > rz_itv_end(((IOSnapshotPart *)(part))->itv) - 1 ? 1 \
+																		  : 0)
+	// first part whose last address is >= addr
+	rz_vector_lower_bound(parts, addr, i, CMP);
+#undef CMP
+	bool ret = true;
+	ut64 cur = addr;
+	for (; i < rz_vector_len(parts); i++) {
+		const IOSnapshotPart *part = rz_vector_index_ptr(parts, i);
+		ut64 begin = rz_itv_begin(part->itv);
+		if (begin > last) {
+			break;
+		}
+		// gaps are not errors, they are just left filled with Oxff
+		cur = RZ_MAX(cur, begin);
+		ut64 end = RZ_MIN(rz_itv_end(part->itv) - 1, last);
+		if (!io_snapshot_read_part(snap, part, part->paddr + (cur - begin), buf + (cur - addr), end - cur + 1)) {
+			ret = false;
+		}
+		if (end == last) {
+			break;
+		}
+		cur = end + 1;
+	}
+	io_snapshot_apply_patches(snap, addr, buf, len);
+	return ret;
+}
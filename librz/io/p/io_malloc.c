@@ -59,6 +59,7 @@ RzIOPlugin rz_io_plugin_malloc = {
 	.lseek = io_memory_lseek,
 	.write = io_memory_write,
 	.resize = io_memory_resize,
+	.get_buf = io_memory_get_buf,
 };
 
 #ifndef RZ_PLUGIN_INCORE
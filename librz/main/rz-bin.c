@@ -224,6 +224,7 @@ static int rabin_show_help(int v) {
 		       "?' -\n"
 		       " RZ_BIN_STRPURGE:  e bin.str.purge    # try to purge false positives\n"
 		       " RZ_BIN_DEBASE64:  e bin.debase64     # try to debase64 all strings\n"
+		       " RZ_BIN_LAZY:      e bin.lazy         # load symbols, strings, etc. only when needed\n"
 		       " RZ_BIN_PDBSERVER: e pdb.server       # use alternative PDB server\n"
 		       " RZ_BIN_SYMSTORE:  e pdb.symstore     # path to downstream symbol store\n"
 		       " RZ_BIN_PREFIX:    e bin.prefix       # prefix symbols/sections/relocs with a specific string\n"
@@ -765,6 +766,10 @@ RZ_API int rz_main_rz_bin(int argc, const char **argv) {
 		rz_config_set(core.config, "bin.debase64", tmp);
 		free(tmp);
 	}
+	if ((tmp = rz_sys_getenv("RZ_BIN_LAZY"))) {
+		rz_config_set(core.config, "bin.lazy", tmp);
+		free(tmp);
+	}
 	if ((tmp = rz_sys_getenv("RZ_BIN_PDBSERVER"))) {
 		rz_config_set(core.config, "pdb.server", tmp);
 		free(tmp);
@@ -1155,6 +1160,7 @@ RZ_API int rz_main_rz_bin(int argc, const char **argv) {
 	bo.obj_opts.elf_checks_sections = rz_config_get_b(core.config, "elf.checks.sections");
 	bo.obj_opts.elf_checks_segments = rz_config_get_b(core.config, "elf.checks.segments");
 	bo.obj_opts.big_endian = rz_config_get_b(core.config, "cfg.bigendian");
+	bo.obj_opts.lazy = rz_config_get_b(core.config, "bin.lazy");
 	bo.xtr_idx = xtr_idx;
 
 	RzBinFile *bf = rz_bin_open(bin, file, &bo);
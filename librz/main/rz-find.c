@@ -35,6 +35,7 @@ typedef struct {
 	ut64 cur;
 	RzPrint *pr;
 	RzList /*<char *>*/ *keywords;
+	RzList /*<char *>*/ *patterns; ///< lines read by -P, owned
 	const char *mask;
 	const char *curfile;
 	const char *comma;
@@ -51,6 +52,7 @@ static void rzfind_options_init(RzfindOptions *ro) {
 	ro->bsize = 4096;
 	ro->to = UT64_MAX;
 	ro->keywords = rz_list_newf(NULL);
+	ro->patterns = rz_list_newf(free);
 }
 
 static int rzfind_open(RzfindOptions *ro, const char *file);
@@ -171,7 +173,7 @@ static void print_bin_string(RzBinFile *bf, RzBinString *string, PJ *pj) {
 }
 
 static int show_help(const char *argv0, int line) {
-	printf("Usage: %s [-mXnzZhqv] [-a align] [-b sz] [-f/t from/to] [-[e|s|w|S|I] str] [-x hex] -|file|dir ..\n", argv0);
+	printf("Usage: %s [-mXnzZhqv] [-a align] [-b sz] [-f/t from/to] [-[e|s|w|S|I] str] [-x hex] [-P file] -|file|dir ..\n", argv0);
 	if (line) {
 		return 0;
 	}
@@ -187,6 +189,7 @@ static int show_help(const char *argv0, int line) {
 		" -m         magic search, file-type carver\n"
 		" -M [str]   set a binary mask to be applied on keywords\n"
 		" -n         do not stop on read errors\n"
+		" -P [file]  read the hexpair keywords from file, one per line ('.' for any nibble)\n"
 		" -r         print using rizin commands\n"
 		" -s [str]   search for a specific string (can be used multiple times)\n"
 		" -w [str]   search for a specific wide string (can be used multiple times). Assumes str is UTF-8.\n"
@@ -202,6 +205,37 @@ static int show_help(const char *argv0, int line) {
 	return 0;
 }
 
+/**
+ * Adds the hexpair keywords of \p file to the keywords, the empty lines
+ * and the ones starting with '#' are ignored.
+ */
+static bool rzfind_read_patterns(RzfindOptions *ro, const char *file) {
+	char *data = rz_file_slurp(file, NULL);
+	if (!data) {
+		eprintf("Cannot slurp '%s'\n", file);
+		return false;
+	}
+	RzList *lines = rz_str_split_duplist(data, "\n", true);
+	free(data);
+	if (!lines) {
+		return false;
+	}
+	char *line;
+	while ((line = rz_list_pop_head(lines))) {
+		if (!*line || *line == '#') {
+			free(line);
+			continue;
+		}
+		rz_list_append(ro->patterns, line);
+		rz_list_append(ro->keywords, line);
+	}
+	rz_list_free(lines);
+	ro->mode = RZ_SEARCH_KEYWORD;
+	ro->hexstr = true;
+	ro->widestr = false;
+	return true;
+}
+
 static int rzfind_open_file(RzfindOptions *ro, const char *file, const ut8 *data, int datalen) {
 	RzListIter *iter;
 	RzSearch *rs = NULL;
@@ -479,7 +513,7 @@ RZ_API int rz_main_rz_find(int argc, const char **argv) {
 	const char *file = NULL;
 
 	RzGetopt opt;
-	rz_getopt_init(&opt, argc, argv, "a:ie:b:jmM:s:w:S:I:x:Xzf:F:t:E:rqnhvZ");
+	rz_getopt_init(&opt, argc, argv, "a:ie:b:jmM:s:w:S:I:x:Xzf:F:P:t:E:rqnhvZ");
 	while ((c = rz_getopt_next(&opt)) != -1) {
 		switch (c) {
 		case 'a':
@@ -555,6 +589,13 @@ RZ_API int rz_main_rz_find(int argc, const char **argv) {
 			}
 			free(data);
 		} break;
+		case 'P':
+			if (!rzfind_read_patterns(&ro, opt.arg)) {
+				rz_list_free(ro.keywords);
+				rz_list_free(ro.patterns);
+				return 1;
+			}
+			break;
 		case 't':
 			ro.to = rz_num_math(NULL, opt.arg);
 			break;
@@ -600,11 +641,13 @@ RZ_API int rz_main_rz_find(int argc, const char **argv) {
 		if (RZ_STR_ISEMPTY(file)) {
 			eprintf("Cannot open empty path\n");
 			rz_list_free(ro.keywords);
+			rz_list_free(ro.patterns);
 			return 1;
 		}
 		rzfind_open(&ro, file);
 	}
 	rz_list_free(ro.keywords);
+	rz_list_free(ro.patterns);
 	if (ro.json) {
 		printf("]\n");
 	}
@@ -12,6 +12,7 @@
 #include <rz_lib.h>
 
 #define RZ_HASH_DEFAULT_BLOCK_SIZE 0x1000
+#define RZ_HASH_STREAM_BLOCK_SIZE  0x100000 ///< read size when the digest of the whole range is computed
 
 typedef struct {
 	ut8 *buf;
@@ -804,6 +805,7 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 	RzListIter *it;
 	RzHashCfg *md = NULL;
 	ut64 bsize = 0;
+	ut64 ssize = 0;
 	ut64 filesize;
 	ut8 *block = NULL;
 	ut8 *cmphash = NULL;
@@ -835,7 +837,9 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 	}
 
 	bsize = ctx->block_size;
-	block = malloc(bsize);
+	// the block size only matters when the digest of each block is shown
+	ssize = ctx->show_blocks ? bsize : RZ_MAX(bsize, RZ_HASH_STREAM_BLOCK_SIZE);
+	block = malloc(ssize);
 	if (!block) {
 		RZ_LOG_ERROR("rz-hash: error, cannot allocate block memory\n");
 		goto calculate_hash_end;
@@ -847,6 +851,9 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 		}
 	}
 
+	// each block is hashed by all the algorithms while the next one is read
+	rz_hash_cfg_set_parallel(md, !ctx->show_blocks && rz_list_length(algorithms) > 1);
+
 	if (ctx->key.len > 0 && !rz_hash_cfg_hmac(md, ctx->key.buf, ctx->key.len)) {
 		goto calculate_hash_end;
 	}
@@ -870,8 +877,8 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 			goto calculate_hash_end;
 		}
 
-		for (ut64 j = ctx->offset.from; j < to; j += bsize) {
-			int read = rz_io_pread_at(io, j, block, to - j > bsize ? bsize : (to - j));
+		for (ut64 j = ctx->offset.from; j < to; j += ssize) {
+			int read = rz_io_pread_at(io, j, block, to - j > ssize ? ssize : (to - j));
 			if (!rz_hash_cfg_update(md, block, read)) {
 				goto calculate_hash_end;
 			}
@@ -935,8 +942,8 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 			goto calculate_hash_end;
 		}
 
-		for (ut64 j = ctx->offset.from; j < to; j += bsize) {
-			int read = rz_io_pread_at(io, j, block, to - j > bsize ? bsize : (to - j));
+		for (ut64 j = ctx->offset.from; j < to; j += ssize) {
+			int read = rz_io_pread_at(io, j, block, to - j > ssize ? ssize : (to - j));
 			if (!rz_hash_cfg_update(md, block, read)) {
 				goto calculate_hash_end;
 			}
@@ -9,6 +9,7 @@
 #include <rz_util/rz_assert.h>
 #include <rz_lib.h>
 #include <string.h>
+#include "reg_private.h"
 
 static void rz_reg_profile_def_free(RzRegProfileDef *def) {
 	if (!def) {
@@ -376,6 +377,7 @@ static void add_item_to_regset(RZ_BORROW RzReg *reg, RZ_BORROW RzRegItem *item)
 RZ_API bool rz_reg_set_reg_profile(RZ_BORROW RzReg *reg) {
 	rz_return_val_if_fail(reg, false);
 	rz_return_val_if_fail(reg->reg_profile.alias && reg->reg_profile.defs, false);
+	reg_profile_changed(reg);
 
 	RzListIter *it;
 	RzRegProfileAlias *alias;
@@ -4,9 +4,44 @@
 #include <rz_list.h>
 #include <rz_reg.h>
 #include <rz_util.h>
+#include <rz_th.h>
+#include <rz_constructor.h>
+#include "reg_private.h"
 
 RZ_LIB_VERSION(rz_reg);
 
+static ut32 profile_gens = 0;
+static RzThreadLock *profile_gens_lock = NULL;
+
+#ifdef RZ_DEFINE_CONSTRUCTOR_NEEDS_PRAGMA
+#pragma RZ_DEFINE_CONSTRUCTOR_PRAGMA_ARGS(init_profile_gens)
+#endif
+RZ_DEFINE_CONSTRUCTOR(init_profile_gens)
+static void init_profile_gens(void) {
+	profile_gens_lock = rz_th_lock_new(false);
+}
+
+#ifdef RZ_DEFINE_DESTRUCTOR_NEEDS_PRAGMA
+#pragma RZ_DEFINE_DESTRUCTOR_PRAGMA_ARGS(fini_profile_gens)
+#endif
+RZ_DEFINE_DESTRUCTOR(fini_profile_gens)
+static void fini_profile_gens(void) {
+	RZ_FREE_CUSTOM(profile_gens_lock, rz_th_lock_free);
+}
+
+/**
+ * \brief Give \p reg a new RzReg.profile_gen, invalidating all RzRegItem pointers cached for it.
+ *
+ * Generations are unique across all RzReg instances, so a cached (RzReg *, profile_gen) pair can never
+ * match a different RzReg that was later allocated at the same address.
+ */
+RZ_IPI void reg_profile_changed(RzReg *reg) {
+	// RzReg instances of different threads can change their profile at the same time
+	rz_th_lock_enter(profile_gens_lock);
+	reg->profile_gen = ++profile_gens;
+	rz_th_lock_leave(profile_gens_lock);
+}
+
 static const char *types[RZ_REG_TYPE_LAST + 1] = {
 	"gpr", "drx", "fpu", "mmx", "xmm", "ymm", "flg", "seg", "sys", "sec", "vc", "vcc", "ctr", NULL
 };
@@ -139,6 +174,7 @@ RZ_API bool rz_reg_set_name(RZ_NONNULL RzReg *reg, RzRegisterId role, RZ_NONNULL
 	rz_return_val_if_fail(reg && name, false);
 	if (role >= 0 && role < RZ_REG_NAME_LAST) {
 		reg->name[role] = rz_str_dup(reg->name[role], name);
+		reg_profile_changed(reg);
 		return true;
 	}
 	return false;
@@ -192,6 +228,7 @@ RZ_API void rz_reg_free_internal(RzReg *reg, bool init) {
 	rz_return_if_fail(reg);
 	ut32 i;
 
+	reg_profile_changed(reg);
 	rz_list_free(reg->roregs);
 	reg->roregs = NULL;
 	RZ_FREE(reg->reg_profile_str);
@@ -0,0 +1,9 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#ifndef _REG_PRIVATE_H_
+#define _REG_PRIVATE_H_
+
+RZ_IPI void reg_profile_changed(RzReg *reg);
+
+#endif
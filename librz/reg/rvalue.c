@@ -5,6 +5,21 @@
 #include <rz_reg.h>
 #include <rz_util.h>
 
+/**
+ * Returns the bytes of \p item in its arena, if it is made of 1, 2, 4 or 8
+ * whole bytes, so that its value can be accessed without a bit vector.
+ */
+static inline ut8 *reg_item_bytes(RzReg *reg, RzRegItem *item) {
+	if (item->offset % 8 || (item->size != 8 && item->size != 16 && item->size != 32 && item->size != 64)) {
+		return NULL;
+	}
+	RzRegArena *arena = reg->regset[item->arena].arena;
+	if (!arena || item->offset / 8 + item->size / 8 > arena->size) {
+		return NULL;
+	}
+	return arena->bytes + item->offset / 8;
+}
+
 /**
  * \brief      Read the value of the given register as a bit vector
  *
@@ -39,6 +54,14 @@ RZ_API ut64 rz_reg_get_value(RZ_NONNULL RzReg *reg, RZ_NONNULL RzRegItem *item)
 	if (item->offset < 0) {
 		return 0ll;
 	}
+	const ut8 *bytes = reg_item_bytes(reg, item);
+	if (bytes) {
+		return rz_read_ble(bytes, reg->big_endian, item->size);
+	}
+	RzRegArena *arena = reg->regset[item->arena].arena;
+	if (item->size == 1 && !reg->big_endian && arena && item->offset / 8 < arena->size) {
+		return (arena->bytes[item->offset / 8] >> (item->offset % 8)) & 1;
+	}
 	RzBitVector *bv = rz_reg_get_bv(reg, item);
 	if (!bv) {
 		return 0;
@@ -157,6 +180,14 @@ RZ_API bool rz_reg_set_value(RZ_NONNULL RzReg *reg, RZ_NONNULL RzRegItem *item,
 	if (rz_reg_is_readonly(reg, item) || item->offset < 0) {
 		return true;
 	}
+	ut8 *bytes = reg_item_bytes(reg, item);
+	if (bytes) {
+		rz_write_ble(bytes, value, reg->big_endian, item->size);
+		return true;
+	}
+	if (item->size == 1 && (!reg->big_endian || item->offset % 8)) {
+		return reg_set_value(reg, item, value & 1);
+	}
 
 	RzBitVector *bv = rz_bv_new_from_ut64(item->size, value);
 	if (!bv) {
@@ -0,0 +1,452 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_search.h>
+#include <rz_vector.h>
+#include <ctype.h>
+#include "search_private.h"
+
+/**
+ * \file multi.c
+ * \brief Matches many keywords at once with an Aho-Corasick automaton.
+ *
+ * The longest run of bytes of each keyword which are not masked by its binmask
+ * (the anchor) is added to the automaton, thus a single pass over the data finds
+ * all the positions where any of the keywords can start; each candidate is then
+ * checked against the whole keyword and binmask, exactly like rz_search_mybinparse_update().
+ * The anchors of the icase keywords are added lowercase to a second trie, which is
+ * walked with the lowercase data, so the other keywords keep their exact-case anchors.
+ * The keywords without any unmasked byte are checked at every position.
+ *
+ * Each state only stores its children and failure link, so the automaton takes memory
+ * linear in the length of the anchors; only the transitions of the root, taken at almost
+ * every byte, are kept in a table. Small tries also get a full transitions table, which
+ * saves following the failure links.
+ */
+
+#define AUTOMATON_NO_OUTPUT         UT32_MAX
+#define AUTOMATON_DENSE_MAX_STATES 4096
+
+typedef struct automaton_output_t {
+	ut32 kw; ///< index of the keyword
+	ut32 next; ///< next output of the same state, AUTOMATON_NO_OUTPUT for the last one
+} AutomatonOutput;
+
+typedef struct automaton_state_t {
+	ut32 child; ///< first child, 0 for none
+	ut32 sibling; ///< next child of the same parent, 0 for none
+	ut32 fail; ///< longest proper suffix state
+	ut32 dict; ///< nearest proper suffix state with outputs, 0 for none
+	ut32 output; ///< index of the first AutomatonOutput
+	ut8 byte; ///< byte of the transition from the parent
+} AutomatonState;
+
+typedef struct automaton_trie_t {
+	bool fold; ///< walked with the lowercase data
+	ut32 n_states;
+	AutomatonState *states;
+	ut32 *delta; ///< n_states * 256 transitions, only for the small tries
+	ut32 root[256]; ///< transitions of the root, 0 to stay in the root
+} AutomatonTrie;
+
+struct rz_search_automaton_t {
+	size_t n_kws;
+	ut32 *anchor_end; ///< per keyword, offset of the end of the anchor, 0 when the keyword has no anchor
+	RzVector /*<ut32>*/ *candidates; ///< per keyword and per data region, start offsets of the anchor matches
+	AutomatonTrie tries[2]; ///< exact-case anchors and lowercase anchors of the icase keywords
+	RzVector /*<AutomatonOutput>*/ outputs;
+	ut8 lower[256];
+};
+
+RZ_IPI void search_automaton_free(RzSearchAutomaton *ac) {
+	if (!ac) {
+		return;
+	}
+	if (ac->candidates) {
+		for (size_t i = 0; i < ac->n_kws * 2; i++) {
+			rz_vector_fini(&ac->candidates[i]);
+		}
+		free(ac->candidates);
+	}
+	rz_vector_fini(&ac->outputs);
+	free(ac->anchor_end);
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(ac->tries); i++) {
+		free(ac->tries[i].states);
+		free(ac->tries[i].delta);
+	}
+	free(ac);
+}
+
+static inline bool keyword_byte_is_fixed(RzSearchKeyword *kw, ut32 j) {
+	return !kw->binmask_length || kw->bin_binmask[j % kw->binmask_length] == 0xff;
+}
+
+/**
+ * Finds the longest run of unmasked bytes of \p kw and returns its length.
+ */
+static ut32 keyword_anchor(RzSearchKeyword *kw, ut32 *start) {
+	ut32 best = 0, run = 0;
+	*start = 0;
+	for (ut32 j = 0; j < kw->keyword_length; j++) {
+		if (!keyword_byte_is_fixed(kw, j)) {
+			run = 0;
+			continue;
+		}
+		if (++run > best) {
+			best = run;
+			*start = j + 1 - run;
+		}
+	}
+	return best;
+}
+
+static bool trie_init(AutomatonTrie *trie, bool fold, size_t max_states) {
+	trie->fold = fold;
+	trie->n_states = 1;
+	trie->states = RZ_NEWS0(AutomatonState, max_states);
+	if (!trie->states) {
+		return false;
+	}
+	for (size_t s = 0; s < max_states; s++) {
+		trie->states[s].output = AUTOMATON_NO_OUTPUT;
+	}
+	return true;
+}
+
+static ut32 trie_child(const AutomatonTrie *trie, ut32 state, ut8 c) {
+	if (!state) {
+		return trie->root[c];
+	}
+	for (ut32 child = trie->states[state].child; child; child = trie->states[child].sibling) {
+		if (trie->states[child].byte == c) {
+			return child;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Follows the transition of \p c from \p state, going through the failure links.
+ */
+static inline ut32 trie_next(const AutomatonTrie *trie, ut32 state, ut8 c) {
+	while (state) {
+		ut32 next = trie_child(trie, state, c);
+		if (next) {
+			return next;
+		}
+		state = trie->states[state].fail;
+	}
+	return trie->root[c];
+}
+
+static bool automaton_add(RzSearchAutomaton *ac, ut32 idx, RzSearchKeyword *kw) {
+	ut32 start;
+	ut32 len = keyword_anchor(kw, &start);
+	if (!len) {
+		ac->anchor_end[idx] = 0;
+		return true;
+	}
+	ac->anchor_end[idx] = start + len;
+	AutomatonTrie *trie = &ac->tries[!!kw->icase];
+	ut32 state = 0;
+	for (ut32 j = start; j < start + len; j++) {
+		ut8 c = trie->fold ? ac->lower[kw->bin_keyword[j]] : kw->bin_keyword[j];
+		ut32 next = trie_child(trie, state, c);
+		if (!next) {
+			next = trie->n_states++;
+			trie->states[next].byte = c;
+			if (state) {
+				trie->states[next].sibling = trie->states[state].child;
+				trie->states[state].child = next;
+			} else {
+				trie->root[c] = next;
+			}
+		}
+		state = next;
+	}
+	AutomatonOutput out = { .kw = idx, .next = trie->states[state].output };
+	if (!rz_vector_push(&ac->outputs, &out)) {
+		return false;
+	}
+	trie->states[state].output = rz_vector_len(&ac->outputs) - 1;
+	return true;
+}
+
+/**
+ * Turns the trie into an automaton by computing the failure links in breadth-first order.
+ */
+static bool trie_link(AutomatonTrie *trie) {
+	ut32 *queue = RZ_NEWS(ut32, trie->n_states);
+	if (!queue) {
+		return false;
+	}
+	ut32 head = 0, tail = 0;
+	for (ut32 c = 0; c < 256; c++) {
+		if (trie->root[c]) {
+			queue[tail++] = trie->root[c];
+		}
+	}
+	while (head < tail) {
+		ut32 u = queue[head++];
+		for (ut32 v = trie->states[u].child; v; v = trie->states[v].sibling) {
+			AutomatonState *sv = &trie->states[v];
+			sv->fail = trie_next(trie, trie->states[u].fail, sv->byte);
+			const AutomatonState *sf = &trie->states[sv->fail];
+			sv->dict = sf->output != AUTOMATON_NO_OUTPUT ? sv->fail : sf->dict;
+			queue[tail++] = v;
+		}
+	}
+	free(queue);
+	if (trie->n_states > AUTOMATON_DENSE_MAX_STATES) {
+		return true;
+	}
+	trie->delta = RZ_NEWS(ut32, (size_t)trie->n_states * 256);
+	if (!trie->delta) {
+		return false;
+	}
+	for (ut32 u = 0; u < trie->n_states; u++) {
+		for (ut32 c = 0; c < 256; c++) {
+			trie->delta[(size_t)u * 256 + c] = trie_next(trie, u, c);
+		}
+	}
+	return true;
+}
+
+static RzSearchAutomaton *search_automaton_new(RzList /*<RzSearchKeyword *>*/ *kws) {
+	RzSearchAutomaton *ac = RZ_NEW0(RzSearchAutomaton);
+	if (!ac) {
+		return NULL;
+	}
+	rz_vector_init(&ac->outputs, sizeof(AutomatonOutput), NULL, NULL);
+	for (ut32 c = 0; c < 256; c++) {
+		ac->lower[c] = tolower(c);
+	}
+	ac->n_kws = rz_list_length(kws);
+	ac->anchor_end = RZ_NEWS0(ut32, ac->n_kws);
+	ac->candidates = RZ_NEWS0(RzVector, ac->n_kws * 2);
+	if (!ac->anchor_end || !ac->candidates) {
+		goto fail;
+	}
+	for (size_t i = 0; i < ac->n_kws * 2; i++) {
+		rz_vector_init(&ac->candidates[i], sizeof(ut32), NULL, NULL);
+	}
+
+	size_t max_states[2] = { 1, 1 };
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	rz_list_foreach (kws, iter, kw) {
+		ut32 start;
+		max_states[!!kw->icase] += keyword_anchor(kw, &start);
+	}
+	for (size_t t = 0; t < RZ_ARRAY_SIZE(ac->tries); t++) {
+		if (max_states[t] >= UT32_MAX || !trie_init(&ac->tries[t], t, max_states[t])) {
+			goto fail;
+		}
+	}
+
+	ut32 idx = 0;
+	rz_list_foreach (kws, iter, kw) {
+		if (!automaton_add(ac, idx++, kw)) {
+			goto fail;
+		}
+	}
+	for (size_t t = 0; t < RZ_ARRAY_SIZE(ac->tries); t++) {
+		if (!trie_link(&ac->tries[t])) {
+			goto fail;
+		}
+	}
+	return ac;
+
+fail:
+	RZ_LOG_ERROR("search: cannot allocate the keywords automaton\n");
+	search_automaton_free(ac);
+	return NULL;
+}
+
+/**
+ * Moves \p state of \p trie with the byte \p c at offset \p i of the data and pushes
+ * the candidates of the keywords whose anchor ends there.
+ */
+static inline ut32 trie_step(RzSearchAutomaton *ac, const AutomatonTrie *trie, ut32 state, ut8 c, ut32 i, int region) {
+	state = trie->delta ? trie->delta[(size_t)state * 256 + c] : trie_next(trie, state, c);
+	for (ut32 t = state; t; t = trie->states[t].dict) {
+		for (ut32 o = trie->states[t].output; o != AUTOMATON_NO_OUTPUT;) {
+			const AutomatonOutput *out = rz_vector_index_ptr(&ac->outputs, o);
+			ut32 end = ac->anchor_end[out->kw];
+			if (i + 1 >= end) {
+				ut32 start = i + 1 - end;
+				rz_vector_push(&ac->candidates[out->kw * 2 + region], &start);
+			}
+			o = out->next;
+		}
+	}
+	return state;
+}
+
+/**
+ * Pushes to the \p region candidates of each keyword the offsets in \p data where it can start.
+ */
+static void automaton_scan(RzSearchAutomaton *ac, int region, const ut8 *data, ut32 len) {
+	for (size_t i = 0; i < ac->n_kws; i++) {
+		rz_vector_clear(&ac->candidates[i * 2 + region]);
+	}
+	const AutomatonTrie *exact = &ac->tries[0];
+	const AutomatonTrie *fold = &ac->tries[1];
+	ut32 exact_state = 0, fold_state = 0;
+	if (fold->n_states == 1) {
+		for (ut32 i = 0; i < len; i++) {
+			exact_state = trie_step(ac, exact, exact_state, data[i], i, region);
+		}
+	} else if (exact->n_states == 1) {
+		for (ut32 i = 0; i < len; i++) {
+			fold_state = trie_step(ac, fold, fold_state, ac->lower[data[i]], i, region);
+		}
+	} else {
+		for (ut32 i = 0; i < len; i++) {
+			exact_state = trie_step(ac, exact, exact_state, data[i], i, region);
+			fold_state = trie_step(ac, fold, fold_state, ac->lower[data[i]], i, region);
+		}
+	}
+}
+
+/**
+ * Checks the keyword at the offsets of \p data from \p i, which are all the ones
+ * when \p candidates is NULL, until the keyword would end after \p limit or
+ * the offset reaches \p max_i.
+ *
+ * \return -1 on error, 1 when the search must stop and 0 otherwise
+ */
+static int multi_match_keyword(RzSearch *s, RzSearchKeyword *kw, const RzVector /*<ut32>*/ *candidates,
+	const ut8 *data, ut64 i, ut64 limit, ut64 max_i, ut64 from, st64 shift) {
+	size_t idx = 0;
+	while (true) {
+		ut64 c = i;
+		if (candidates) {
+			while (idx < rz_vector_len(candidates) && *(ut32 *)rz_vector_index_ptr((RzVector *)candidates, idx) < i) {
+				idx++;
+			}
+			if (idx == rz_vector_len(candidates)) {
+				break;
+			}
+			c = *(ut32 *)rz_vector_index_ptr((RzVector *)candidates, idx++);
+		}
+		if (c + kw->keyword_length > limit || c >= max_i) {
+			break;
+		}
+		i = c + 1;
+		if (!search_keyword_match(s, kw, data, c)) {
+			continue;
+		}
+		ut64 pos = c + shift;
+		int t = rz_search_hit_new(s, kw, s->bckwrds ? from - kw->keyword_length - pos : from + pos);
+		if (!t) {
+			return -1;
+		}
+		if (t > 1) {
+			return 1;
+		}
+		if (!s->overlap) {
+			i = c + kw->keyword_length;
+		}
+	}
+	return 0;
+}
+
+/**
+ * \brief Updates the search with all the keywords matched by a single automaton.
+ *
+ * The hits are the same and reported in the same order of rz_search_mybinparse_update(),
+ * which is used instead when every position must be checked (inverse or distance search).
+ * Supported search variants: backward, binmask, icase, overlap
+ */
+RZ_API int rz_search_multi_update(RzSearch *s, ut64 from, const ut8 *buf, int len) {
+	rz_return_val_if_fail(s && buf, -1);
+	if (s->inverse || s->distance) {
+		return rz_search_mybinparse_update(s, from, buf, len);
+	}
+	RzSearchKeyword *kw;
+	RzListIter *iter;
+	RzSearchLeftover *left;
+	int longest = 0;
+	const int old_nhits = s->nhits;
+
+	rz_list_foreach (s->kws, iter, kw) {
+		longest = RZ_MAX(longest, kw->keyword_length);
+	}
+	if (!longest) {
+		return 0;
+	}
+	if (s->automaton && s->automaton->n_kws != rz_list_length(s->kws)) {
+		RZ_FREE_CUSTOM(s->automaton, search_automaton_free);
+	}
+	if (!s->automaton) {
+		s->automaton = search_automaton_new(s->kws);
+		if (!s->automaton) {
+			return rz_search_mybinparse_update(s, from, buf, len);
+		}
+	}
+	RzSearchAutomaton *ac = s->automaton;
+	if (s->data) {
+		left = s->data;
+		if (left->end != from) {
+			left->len = 0;
+		}
+	} else {
+		left = malloc(sizeof(RzSearchLeftover) + (size_t)2 * (longest - 1));
+		if (!left) {
+			return -1;
+		}
+		s->data = left;
+		left->len = 0;
+	}
+	if (s->bckwrds) {
+		// XXX Change function signature from const ut8 * to ut8 *
+		ut8 *i = (ut8 *)buf, *j = i + len;
+		while (i < j) {
+			ut8 t = *i;
+			*i++ = *--j;
+			*j = t;
+		}
+	}
+
+	ut64 len1 = left->len + RZ_MIN(longest - 1, len);
+	memcpy(left->data + left->len, buf, len1 - left->len);
+	automaton_scan(ac, 0, left->data, len1);
+	automaton_scan(ac, 1, buf, len);
+
+	size_t k = 0;
+	rz_list_foreach (s->kws, iter, kw) {
+		bool anchored = ac->anchor_end[k] > 0;
+		ut64 i = s->overlap || !kw->count ? 0 : s->bckwrds ? kw->last - from < left->len ? from + left->len - kw->last : 0
+			: from - kw->last < left->len         ? kw->last + left->len - from
+							      : 0;
+		int ret = multi_match_keyword(s, kw, anchored ? &ac->candidates[k * 2] : NULL,
+			left->data, i, len1, left->len, from, -(st64)left->len);
+		if (ret) {
+			return ret < 0 ? -1 : s->nhits - old_nhits;
+		}
+		i = s->overlap || !kw->count ? 0 : s->bckwrds ? from > kw->last ? from - kw->last : 0
+			: from < kw->last                     ? kw->last - from
+							      : 0;
+		ret = multi_match_keyword(s, kw, anchored ? &ac->candidates[k * 2 + 1] : NULL,
+			buf, i, len, len, from, 0);
+		if (ret) {
+			return ret < 0 ? -1 : s->nhits - old_nhits;
+		}
+		k++;
+	}
+	if (len < longest - 1) {
+		if (len1 < longest) {
+			left->len = len1;
+		} else {
+			left->len = longest - 1;
+			memmove(left->data, left->data + len1 - longest + 1, longest - 1);
+		}
+	} else {
+		left->len = longest - 1;
+		memcpy(left->data, buf + len - longest + 1, longest - 1);
+	}
+	left->end = s->bckwrds ? from - len : from + len;
+
+	return s->nhits - old_nhits;
+}
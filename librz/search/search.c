@@ -4,18 +4,13 @@
 #include <rz_search.h>
 #include <rz_list.h>
 #include <ctype.h>
+#include "search_private.h"
 
 // Experimental search engine (fails, because stops at first hit of every block read
 #define USE_BMH 0
 
 RZ_LIB_VERSION(rz_search);
 
-typedef struct {
-	ut64 end;
-	int len;
-	ut8 data[];
-} RzSearchLeftover;
-
 RZ_API RzSearch *rz_search_new(int mode) {
 	RzSearch *s = RZ_NEW0(RzSearch);
 	if (!s) {
@@ -55,6 +50,7 @@ RZ_API RzSearch *rz_search_free(RzSearch *s) {
 	}
 	rz_list_free(s->hits);
 	rz_list_free(s->kws);
+	search_automaton_free(s->automaton);
 	// rz_io_free(s->iob.io); this is supposed to be a weak reference
 	free(s->data);
 	free(s);
@@ -79,6 +75,7 @@ RZ_API int rz_search_set_mode(RzSearch *s, int mode) {
 	s->update = NULL;
 	switch (mode) {
 	case RZ_SEARCH_KEYWORD: s->update = rz_search_mybinparse_update; break;
+	case RZ_SEARCH_MULTI: s->update = rz_search_multi_update; break;
 	case RZ_SEARCH_REGEXP: s->update = rz_search_regexp_update; break;
 	case RZ_SEARCH_AES: s->update = rz_search_aes_update; break;
 	case RZ_SEARCH_PRIV_KEY: s->update = rz_search_privkey_update; break;
@@ -298,7 +295,7 @@ static int rz_search_horspool(RzSearch *s, RzSearchKeyword *kw, ut64 from, const
 }
 #endif
 
-static bool brute_force_match(RzSearch *s, RzSearchKeyword *kw, const ut8 *buf, int i) {
+RZ_IPI bool search_keyword_match(RzSearch *s, RzSearchKeyword *kw, const ut8 *buf, int i) {
 	int j = 0;
 	if (s->distance) { // slow path, more work in the loop
 		int dist = 0;
@@ -399,7 +396,7 @@ RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, i
 			: from - kw->last < left->len         ? kw->last + left->len - from
 							      : 0;
 		for (; i + kw->keyword_length <= len1 && i < left->len; i++) {
-			if (brute_force_match(s, kw, left->data, i) != s->inverse) {
+			if (search_keyword_match(s, kw, left->data, i) != s->inverse) {
 				int t = rz_search_hit_new(s, kw, s->bckwrds ? from - kw->keyword_length - i + left->len : from + i - left->len);
 				if (!t) {
 					return -1;
@@ -416,7 +413,7 @@ RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, i
 			: from < kw->last                     ? kw->last - from
 							      : 0;
 		for (; i + kw->keyword_length <= len; i++) {
-			if (brute_force_match(s, kw, buf, i) != s->inverse) {
+			if (search_keyword_match(s, kw, buf, i) != s->inverse) {
 				int t = rz_search_hit_new(s, kw, s->bckwrds ? from - kw->keyword_length - i : from + i);
 				if (!t) {
 					return -1;
@@ -473,7 +470,12 @@ RZ_API int rz_search_update(RzSearch *s, ut64 from, const ut8 *buf, long len) {
 		if (s->maxhits && s->nhits >= s->maxhits) {
 			return 0;
 		}
-		ret = s->update(s, from, buf, len);
+		if (s->update == rz_search_mybinparse_update && rz_list_length(s->kws) >= RZ_SEARCH_MULTI_MIN_KEYWORDS) {
+			// many keywords are matched faster all together
+			ret = rz_search_multi_update(s, from, buf, len);
+		} else {
+			ret = s->update(s, from, buf, len);
+		}
 	} else {
 		eprintf("rz_search_update: No search method defined\n");
 	}
@@ -509,6 +511,7 @@ RZ_API int rz_search_kw_add(RzSearch *s, RzSearchKeyword *kw) {
 	}
 	kw->kwidx = s->n_kws++;
 	rz_list_append(s->kws, kw);
+	RZ_FREE_CUSTOM(s->automaton, search_automaton_free);
 	return true;
 }
 
@@ -516,6 +519,7 @@ RZ_API int rz_search_kw_add(RzSearch *s, RzSearchKeyword *kw) {
 RZ_API void rz_search_string_prepare_backward(RzSearch *s) {
 	RzListIter *iter;
 	RzSearchKeyword *kw;
+	RZ_FREE_CUSTOM(s->automaton, search_automaton_free);
 	// Precondition: !kw->binmask_length || kw->keyword_length % kw->binmask_length == 0
 	rz_list_foreach (s->kws, iter, kw) {
 		ut8 *i = kw->bin_keyword, *j = kw->bin_keyword + kw->keyword_length;
@@ -545,4 +549,5 @@ RZ_API void rz_search_kw_reset(RzSearch *s) {
 	rz_list_purge(s->kws);
 	rz_list_purge(s->hits);
 	RZ_FREE(s->data);
+	RZ_FREE_CUSTOM(s->automaton, search_automaton_free);
 }
@@ -0,0 +1,16 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#ifndef _SEARCH_PRIVATE_H_
+#define _SEARCH_PRIVATE_H_
+
+typedef struct {
+	ut64 end;
+	int len;
+	ut8 data[];
+} RzSearchLeftover;
+
+RZ_IPI bool search_keyword_match(RzSearch *s, RzSearchKeyword *kw, const ut8 *buf, int i);
+RZ_IPI void search_automaton_free(RzSearchAutomaton *ac);
+
+#endif
@@ -39,6 +39,8 @@ static bool buf_mmap_init(RzBuffer *b, const void *user) {
 	priv->bytes_priv.offset = 0;
 	b->priv = priv;
 	b->fd = priv->mmap->fd;
+	// the pages of a read-only mapping cannot be written
+	b->readonly = !(u->perm & (O_WRONLY | O_RDWR));
 	return true;
 }
 
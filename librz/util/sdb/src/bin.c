@@ -0,0 +1,356 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: MIT
+
+#include "sdb.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#if HAVE_HEADER_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#include <rz_endian.h>
+#include "ht_pu.h"
+#include "sdb_private.h"
+
+/**
+ * *****************
+ * Binary SDB Format
+ * *****************
+ *
+ * The same tree of namespaces and k=v entries as the plaintext format (see text.c),
+ * but laid out so it can be loaded without scanning, splitting or unescaping anything.
+ * All integers are ut32 little endian.
+ *
+ *   magic           "\0sdbbin\0"
+ *   version         1
+ *   strings_count
+ *   blob_size
+ *   offsets         strings_count offsets of the strings in blob
+ *   blob            blob_size bytes of '\0'-terminated strings
+ *   root table
+ *
+ * Every distinct string (key, value or namespace name) is stored only once in the blob
+ * and referenced by its index. A table stores the entries of one namespace by column,
+ * followed by its sub-namespaces:
+ *
+ *   count
+ *   keys            count string indices
+ *   values          count string indices
+ *   ns_count
+ *   ns_count times:
+ *     name          string index
+ *     table of the namespace
+ */
+
+#define BIN_MAGIC         "\0sdbbin\0"
+#define BIN_MAGIC_SIZE    8
+#define BIN_VERSION       1
+#define BIN_HEADER_SIZE   (BIN_MAGIC_SIZE + 3 * 4)
+#define BIN_MAX_DEPTH     256
+#define BIN_WRITE_BUFSZ   0x10000
+
+typedef struct {
+	int fd;
+	bool failed;
+	HtPU *ids; ///< string -> index
+	const char **strings; ///< borrowed from the saved Sdb
+	ut32 strings_count;
+	ut32 strings_size;
+	ut64 blob_size;
+	ut8 buf[BIN_WRITE_BUFSZ];
+	size_t buf_len;
+} BinSaveCtx;
+
+static void save_flush(BinSaveCtx *ctx) {
+	if (ctx->buf_len && write(ctx->fd, ctx->buf, ctx->buf_len) != ctx->buf_len) {
+		ctx->failed = true;
+	}
+	ctx->buf_len = 0;
+}
+
+static void save_bytes(BinSaveCtx *ctx, const void *data, size_t len) {
+	if (len > sizeof(ctx->buf) - ctx->buf_len) {
+		save_flush(ctx);
+		if (len > sizeof(ctx->buf)) {
+			if (write(ctx->fd, data, len) != len) {
+				ctx->failed = true;
+			}
+			return;
+		}
+	}
+	memcpy(ctx->buf + ctx->buf_len, data, len);
+	ctx->buf_len += len;
+}
+
+static void save_ut32(BinSaveCtx *ctx, ut32 v) {
+	ut8 b[4];
+	rz_write_le32(b, v);
+	save_bytes(ctx, b, sizeof(b));
+}
+
+static void intern(BinSaveCtx *ctx, const char *s) {
+	bool found;
+	ht_pu_find(ctx->ids, s, &found);
+	if (found) {
+		return;
+	}
+	if (ctx->strings_count == ctx->strings_size) {
+		ut32 size = ctx->strings_size ? ctx->strings_size * 2 : 1024;
+		const char **strings = realloc(ctx->strings, size * sizeof(const char *));
+		if (!strings) {
+			ctx->failed = true;
+			return;
+		}
+		ctx->strings = strings;
+		ctx->strings_size = size;
+	}
+	ht_pu_insert(ctx->ids, s, ctx->strings_count);
+	ctx->strings[ctx->strings_count++] = s;
+	ctx->blob_size += strlen(s) + 1;
+}
+
+static bool intern_kv_cb(void *user, const char *k, const char *v) {
+	BinSaveCtx *ctx = user;
+	intern(ctx, k);
+	intern(ctx, v);
+	return !ctx->failed;
+}
+
+static void intern_table(BinSaveCtx *ctx, Sdb *s) {
+	sdb_foreach(s, intern_kv_cb, ctx);
+	SdbListIter *it;
+	SdbNs *ns;
+	ls_foreach (s->ns, it, ns) {
+		intern(ctx, ns->name);
+		intern_table(ctx, ns->sdb);
+	}
+}
+
+typedef struct {
+	BinSaveCtx *ctx;
+	bool values; ///< whether to write the values or the keys column
+} BinColumnCtx;
+
+static bool save_column_cb(void *user, const char *k, const char *v) {
+	BinColumnCtx *col = user;
+	save_ut32(col->ctx, (ut32)ht_pu_find(col->ctx->ids, col->values ? v : k, NULL));
+	return true;
+}
+
+static bool count_cb(void *user, const char *k, const char *v) {
+	(*(ut32 *)user)++;
+	return true;
+}
+
+static void save_table(BinSaveCtx *ctx, Sdb *s) {
+	// sdb_foreach() skips deleted entries, so they are not counted by sdb_count()
+	ut32 count = 0;
+	sdb_foreach(s, count_cb, &count);
+	save_ut32(ctx, count);
+	BinColumnCtx col = { ctx, false };
+	sdb_foreach(s, save_column_cb, &col);
+	col.values = true;
+	sdb_foreach(s, save_column_cb, &col);
+	save_ut32(ctx, ls_length(s->ns));
+	SdbListIter *it;
+	SdbNs *ns;
+	ls_foreach (s->ns, it, ns) {
+		save_ut32(ctx, (ut32)ht_pu_find(ctx->ids, ns->name, NULL));
+		save_table(ctx, ns->sdb);
+	}
+}
+
+RZ_API bool sdb_bin_save_fd(Sdb *s, int fd) {
+	HtPUOptions opt = {
+		.cmp = (HtPUListComparator)strcmp,
+		.hashfn = (HtPUHashFunction)sdb_hash,
+		.calcsizeK = (HtPUCalcSizeK)strlen,
+		.elem_size = sizeof(HtPUKv),
+	};
+	BinSaveCtx *ctx = RZ_NEW0(BinSaveCtx);
+	if (!ctx) {
+		return false;
+	}
+	ctx->fd = fd;
+	ctx->ids = ht_pu_new_opt(&opt);
+	if (!ctx->ids) {
+		free(ctx);
+		return false;
+	}
+	intern_table(ctx, s);
+	if (!ctx->failed && ctx->blob_size <= UT32_MAX) {
+		save_bytes(ctx, BIN_MAGIC, BIN_MAGIC_SIZE);
+		save_ut32(ctx, BIN_VERSION);
+		save_ut32(ctx, ctx->strings_count);
+		save_ut32(ctx, (ut32)ctx->blob_size);
+		ut32 off = 0;
+		for (ut32 i = 0; i < ctx->strings_count; i++) {
+			save_ut32(ctx, off);
+			off += strlen(ctx->strings[i]) + 1;
+		}
+		for (ut32 i = 0; i < ctx->strings_count; i++) {
+			save_bytes(ctx, ctx->strings[i], strlen(ctx->strings[i]) + 1);
+		}
+		save_table(ctx, s);
+		save_flush(ctx);
+	} else {
+		ctx->failed = true;
+	}
+	bool r = !ctx->failed;
+	ht_pu_free(ctx->ids);
+	free(ctx->strings);
+	free(ctx);
+	return r;
+}
+
+RZ_API bool sdb_bin_save(Sdb *s, const char *file) {
+	int fd = open(file, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+	if (fd < 0) {
+		return false;
+	}
+	bool r = sdb_bin_save_fd(s, fd);
+	close(fd);
+	return r;
+}
+
+typedef struct {
+	const ut8 *buf;
+	size_t size;
+	size_t pos;
+	ut32 strings_count;
+	const ut8 *offsets;
+	const char *blob;
+	ut32 blob_size;
+} BinLoadCtx;
+
+static inline bool load_ut32(BinLoadCtx *ctx, ut32 *v) {
+	if (ctx->size - ctx->pos < 4) {
+		return false;
+	}
+	*v = rz_read_le32(ctx->buf + ctx->pos);
+	ctx->pos += 4;
+	return true;
+}
+
+static inline const char *load_string(BinLoadCtx *ctx, ut32 id) {
+	if (id >= ctx->strings_count) {
+		return NULL;
+	}
+	ut32 off = rz_read_le32(ctx->offsets + (size_t)id * 4);
+	// the blob ends with a '\0', so every string in it is terminated
+	return off < ctx->blob_size ? ctx->blob + off : NULL;
+}
+
+static bool load_table(BinLoadCtx *ctx, Sdb *s, int depth) {
+	ut32 count;
+	if (depth > BIN_MAX_DEPTH || !load_ut32(ctx, &count) || (ctx->size - ctx->pos) / 8 < count) {
+		return false;
+	}
+	const ut8 *keys = ctx->buf + ctx->pos;
+	const ut8 *values = keys + (size_t)count * 4;
+	ctx->pos += (size_t)count * 8;
+	ht_pp_reserve(s->ht, s->ht->count + count);
+	for (ut32 i = 0; i < count; i++) {
+		const char *k = load_string(ctx, rz_read_le32(keys + (size_t)i * 4));
+		const char *v = load_string(ctx, rz_read_le32(values + (size_t)i * 4));
+		if (!k || !v) {
+			return false;
+		}
+		if (*k && *v) {
+			sdb_set(s, k, v, 0);
+		}
+	}
+	ut32 ns_count;
+	if (!load_ut32(ctx, &ns_count)) {
+		return false;
+	}
+	for (ut32 i = 0; i < ns_count; i++) {
+		ut32 name_id;
+		if (!load_ut32(ctx, &name_id)) {
+			return false;
+		}
+		const char *name = load_string(ctx, name_id);
+		Sdb *sub = name ? sdb_ns(s, name, 1) : NULL;
+		if (!sub || !load_table(ctx, sub, depth + 1)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Whether \p buf of \p sz bytes starts like a binary sdb
+ */
+RZ_API bool sdb_bin_check_buf(const ut8 *buf, size_t sz) {
+	return sz >= BIN_MAGIC_SIZE && !memcmp(buf, BIN_MAGIC, BIN_MAGIC_SIZE);
+}
+
+RZ_API bool sdb_bin_load_buf(Sdb *s, const ut8 *buf, size_t sz) {
+	if (sz < BIN_HEADER_SIZE || !sdb_bin_check_buf(buf, sz)) {
+		return false;
+	}
+	BinLoadCtx ctx = { buf, sz, BIN_MAGIC_SIZE };
+	ut32 version;
+	if (!load_ut32(&ctx, &version) || version != BIN_VERSION ||
+		!load_ut32(&ctx, &ctx.strings_count) || !load_ut32(&ctx, &ctx.blob_size)) {
+		return false;
+	}
+	if ((ctx.size - ctx.pos) / 4 < ctx.strings_count) {
+		return false;
+	}
+	ctx.offsets = buf + ctx.pos;
+	ctx.pos += (size_t)ctx.strings_count * 4;
+	if (ctx.size - ctx.pos < ctx.blob_size || (ctx.blob_size && buf[ctx.pos + ctx.blob_size - 1])) {
+		return false;
+	}
+	ctx.blob = (const char *)buf + ctx.pos;
+	ctx.pos += ctx.blob_size;
+	return load_table(&ctx, s, 0);
+}
+
+RZ_API bool sdb_bin_check_file(const char *file) {
+	int fd = open(file, O_RDONLY | O_BINARY);
+	if (fd < 0) {
+		return false;
+	}
+	ut8 buf[BIN_MAGIC_SIZE];
+	bool r = read(fd, buf, sizeof(buf)) == sizeof(buf) && sdb_bin_check_buf(buf, sizeof(buf));
+	close(fd);
+	return r;
+}
+
+RZ_API bool sdb_bin_load(Sdb *s, const char *file) {
+	int fd = open(file, O_RDONLY | O_BINARY);
+	if (fd < 0) {
+		return false;
+	}
+	bool r = false;
+	struct stat st;
+	if (fstat(fd, &st) || !st.st_size) {
+		goto beach;
+	}
+#if HAVE_HEADER_SYS_MMAN_H
+	ut8 *x = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (x == MAP_FAILED) {
+		goto beach;
+	}
+#else
+	ut8 *x = calloc(1, st.st_size);
+	if (!x) {
+		goto beach;
+	}
+	if (read(fd, x, st.st_size) != st.st_size) {
+		free(x);
+		goto beach;
+	}
+#endif
+	r = sdb_bin_load_buf(s, x, st.st_size);
+#if HAVE_HEADER_SYS_MMAN_H
+	munmap(x, st.st_size);
+#else
+	free(x);
+#endif
+beach:
+	close(fd);
+	return r;
+}
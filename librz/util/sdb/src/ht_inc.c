@@ -150,12 +150,10 @@ RZ_API void Ht_(free)(HtName_(Ht) * ht) {
 	free(ht);
 }
 
-// Increases the size of the hashtable by 2.
-static void internal_ht_grow(HtName_(Ht) * ht) {
+// Moves all elements into a new table of sz buckets.
+static void internal_ht_resize(HtName_(Ht) * ht, ut32 idx, ut32 sz) {
 	HtName_(Ht) * ht2;
 	HtName_(Ht) swap;
-	ut32 idx = next_idx(ht->prime_idx);
-	ut32 sz = compute_size(idx, ht->size * 2);
 	ut32 i;
 
 	ht2 = internal_ht_new(sz, idx, &ht->opt);
@@ -183,6 +181,26 @@ static void internal_ht_grow(HtName_(Ht) * ht) {
 	Ht_(free)(ht2);
 }
 
+// Increases the size of the hashtable by 2.
+static void internal_ht_grow(HtName_(Ht) * ht) {
+	ut32 idx = next_idx(ht->prime_idx);
+	internal_ht_resize(ht, idx, compute_size(idx, ht->size * 2));
+}
+
+// Grows the hashtable at once so that it can hold count elements without growing again,
+// instead of rehashing all elements once every few inserts.
+RZ_API void Ht_(reserve)(HtName_(Ht) * ht, ut32 count) {
+	ut32 idx = ht->prime_idx;
+	ut32 sz = ht->size;
+	while (sz <= count / LOAD_FACTOR && sz < UT32_MAX / 2) {
+		idx = next_idx(idx);
+		sz = compute_size(idx, sz * 2);
+	}
+	if (sz != ht->size) {
+		internal_ht_resize(ht, idx, sz);
+	}
+}
+
 static void check_growing(HtName_(Ht) * ht) {
 	if (ht->count >= LOAD_FACTOR * ht->size) {
 		internal_ht_grow(ht);
@@ -111,6 +111,8 @@ HtName_(Ht);
 RZ_API HtName_(Ht) * Ht_(new_opt)(HT_(Options) * opt);
 // Destroy a hashtable and all of its entries.
 RZ_API void Ht_(free)(HtName_(Ht) * ht);
+// Grow the hashtable so that it can hold count elements without growing again.
+RZ_API void Ht_(reserve)(HtName_(Ht) * ht, ut32 count);
 // Insert a new Key-Value pair into the hashtable. If the key already exists, returns false.
 RZ_API bool Ht_(insert)(HtName_(Ht) * ht, const KEY_TYPE key, VALUE_TYPE value);
 // Insert a new Key-Value pair into the hashtable, or updates the value if the key already exists.
@@ -196,6 +196,14 @@ RZ_API bool sdb_text_save(Sdb *s, const char *file, bool sort);
 RZ_API bool sdb_text_load_buf(Sdb *s, char *buf, size_t sz);
 RZ_API bool sdb_text_load(Sdb *s, const char *file);
 
+/* binary sdb files */
+RZ_API bool sdb_bin_save_fd(Sdb *s, int fd);
+RZ_API bool sdb_bin_save(Sdb *s, const char *file);
+RZ_API bool sdb_bin_check_buf(const ut8 *buf, size_t sz);
+RZ_API bool sdb_bin_check_file(const char *file);
+RZ_API bool sdb_bin_load_buf(Sdb *s, const ut8 *buf, size_t sz);
+RZ_API bool sdb_bin_load(Sdb *s, const char *file);
+
 /* iterate */
 RZ_API void sdb_dump_begin(Sdb *s);
 RZ_API SdbKv *sdb_dump_next(Sdb *s);
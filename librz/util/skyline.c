@@ -57,6 +57,30 @@ RZ_API bool rz_skyline_add(RzSkyline *skyline, RzInterval itv, void *user) {
 	return true;
 }
 
+/**
+ * \brief Removes the parts of the skyline inside \p itv
+ *
+ * The parts crossing the boundaries of \p itv are shrunk or split.
+ */
+RZ_API bool rz_skyline_remove(RzSkyline *skyline, RzInterval itv) {
+	rz_return_val_if_fail(skyline, false);
+	if (!rz_itv_size(itv)) {
+		return true;
+	}
+	// chop the parts like a new one covering itv would, then drop it
+	if (!rz_skyline_add(skyline, itv, NULL)) {
+		return false;
+	}
+	size_t slot;
+	rz_vector_lower_bound(&skyline->v, itv.addr, slot, CMP_BEGIN_GTE_PART);
+	RzSkylineItem *part = slot < rz_vector_len(&skyline->v) ? rz_vector_index_ptr(&skyline->v, slot) : NULL;
+	if (!part || part->user || !rz_itv_eq(part->itv, itv)) {
+		return false;
+	}
+	rz_vector_remove_at(&skyline->v, slot, NULL);
+	return true;
+}
+
 RZ_API const RzSkylineItem *rz_skyline_get_item_intersect(RzSkyline *skyline, ut64 addr, ut64 len) {
 	if (!len) {
 		return NULL;
@@ -6,6 +6,7 @@
 #include <rz_util/rz_utf16.h>
 #include <rz_util/rz_utf32.h>
 #include <rz_util/rz_ebcdic.h>
+#include <rz_endian.h>
 
 typedef enum {
 	SKIP_STRING,
@@ -347,6 +348,79 @@ static inline bool can_be_ebcdic(const ut8 *buf, ut64 size) {
 	return buf[0] < 0x20 || buf[0] > 0x3f;
 }
 
+/**
+ * Returns true when all the 8 bytes of \p x are lower than 0x07, i.e. none of
+ * them can be part of a string (they are neither printable nor an escape sequence).
+ */
+static inline bool str_scan_word_is_blank(ut64 x) {
+	return !((x | (x + 0x7979797979797979ULL)) & 0x8080808080808080ULL);
+}
+
+/**
+ * Returns true when \p b can be (part of) a printable 8-bit/UTF-8 rune or a C escape sequence.
+ */
+static inline bool str_scan_byte_can_be_char(ut8 b) {
+	return b >= 0x80 || (b >= 0x20 && b < 0x7f) || (b >= 0x07 && b <= 0x0d) || b == 0x1b;
+}
+
+/**
+ * Returns the first address >= \p needle where a string of the explicit type \p type
+ * with at least \p min_len runes could start, or \p to when there is none.
+ *
+ * Every rune of a 8-bit/UTF-8 string is made of bytes for which str_scan_byte_can_be_char()
+ * is true, thus runs shorter than \p min_len are skipped without decoding them;
+ * for UTF-16 only the first code unit is checked. Zero-filled areas are skipped one
+ * word at a time.
+ */
+static ut64 str_scan_skip_to_candidate(const ut8 *buf, const ut64 from, ut64 needle, const ut64 to, RzStrEnc type, size_t min_len) {
+	switch (type) {
+	case RZ_STRING_ENC_8BIT:
+	case RZ_STRING_ENC_UTF8: {
+		ut64 run = 0;
+		while (needle + run < to) {
+			if (!run) {
+				while (to - needle >= 8 && str_scan_word_is_blank(rz_read_le64(buf + needle - from))) {
+					needle += 8;
+				}
+				if (needle >= to) {
+					break;
+				}
+			}
+			if (!str_scan_byte_can_be_char(buf[needle + run - from])) {
+				needle += run + 1;
+				run = 0;
+			} else if (++run >= min_len) {
+				return needle;
+			}
+		}
+		return to;
+	}
+	case RZ_STRING_ENC_UTF16LE:
+	case RZ_STRING_ENC_UTF16BE: {
+		const bool le = type == RZ_STRING_ENC_UTF16LE;
+		while (to - needle >= 2) {
+			while (to - needle >= 8 && !rz_read_le64(buf + needle - from)) {
+				// the code units starting in the first 7 bytes are all zero
+				needle += 7;
+			}
+			if (to - needle < 2) {
+				break;
+			}
+			const ut8 *p = buf + needle - from;
+			ut8 hi = le ? p[1] : p[0];
+			ut8 lo = le ? p[0] : p[1];
+			if (hi || str_scan_byte_can_be_char(lo)) {
+				return needle;
+			}
+			needle++;
+		}
+		return to;
+	}
+	default:
+		return needle;
+	}
+}
+
 /**
  * \brief Look for strings in an RzBuffer.
  * \param buf Pointer to a raw buffer to scan
@@ -383,7 +457,16 @@ RZ_API int rz_scan_strings_raw(RZ_NONNULL const ut8 *buf, RZ_NONNULL RzList /*<R
 	const ut8 *ptr = NULL;
 	ut64 size = 0;
 	int skip_ibm037 = 0;
+	// the bytes which cannot start a string are skipped only for explicit encodings,
+	// since almost every byte can start a string when guessing (i.e. ebcdic).
+	const bool prefilter = type != RZ_STRING_ENC_GUESS && opt->min_str_length > 0;
 	while (needle < to) {
+		if (prefilter) {
+			needle = str_scan_skip_to_candidate(buf, from, needle, to, type, opt->min_str_length);
+			if (needle >= to) {
+				break;
+			}
+		}
 		ptr = buf + needle - from;
 		size = to - needle;
 		--skip_ibm037;
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file bench_bin_load.c
+ * Time needed by rz_bin_open() to load a binary and list its symbols and
+ * strings, reading it through RzIO and through a mmap buffer (bin.mmap).
+ *
+ * Usage: bench_bin_load [file] [iterations]
+ */
+
+#include <rz_bin.h>
+#include <rz_io.h>
+
+static ut64 bin_load(const char *file, bool use_mmap, int iterations, size_t *n_items) {
+	ut64 start = rz_time_now_mono();
+	for (int i = 0; i < iterations; i++) {
+		RzBin *bin = rz_bin_new();
+		RzIO *io = rz_io_new();
+		rz_io_bind(io, &bin->iob);
+		bin->use_mmap = use_mmap;
+
+		RzBinOptions opt = { 0 };
+		rz_bin_options_init(&opt, 0, 0, 0, false);
+		RzBinFile *bf = rz_bin_open(bin, file, &opt);
+		if (!bf || !bf->o) {
+			rz_bin_free(bin);
+			rz_io_free(io);
+			return UT64_MAX;
+		}
+		const RzList *symbols = rz_bin_object_get_symbols(bf->o);
+		const RzList *strings = rz_bin_object_get_strings(bf->o);
+		*n_items = rz_list_length(symbols) + rz_list_length(strings);
+		rz_bin_free(bin);
+		rz_io_free(io);
+	}
+	return RZ_MAX(rz_time_now_mono() - start, 1);
+}
+
+int main(int argc, char **argv) {
+	const char *file = argc > 1 ? argv[1] : "bins/elf/ls";
+	int iterations = argc > 2 ? atoi(argv[2]) : 50;
+	if (iterations < 1) {
+		iterations = 1;
+	}
+	size_t n_items[2] = { 0 };
+	for (int use_mmap = 0; use_mmap < 2; use_mmap++) {
+		ut64 elapsed = bin_load(file, use_mmap, iterations, &n_items[use_mmap]);
+		if (elapsed == UT64_MAX) {
+			eprintf("Cannot open %s\n", file);
+			return 1;
+		}
+		printf("%s bin.mmap=%s: %" PFMT64u " us per load (%" PFMTSZu " symbols and strings)\n",
+			file, use_mmap ? "true" : "false", elapsed / iterations, n_items[use_mmap]);
+	}
+	return n_items[0] != n_items[1];
+}
@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file bench_crc.c
+ * Throughput of the crc presets computed with the slicing-by-8 tables.
+ *
+ * Usage: bench_crc [MiB] [algo ...]
+ */
+
+#include <rz_hash.h>
+
+int main(int argc, char **argv) {
+	ut64 size = (argc > 1 ? atoi(argv[1]) : 64) * 1024 * 1024;
+	const char *algos[] = { "crc16", "crc32", "crc32c", "crc64xz" };
+	const char **names = argc > 2 ? (const char **)argv + 2 : algos;
+	size_t n_names = argc > 2 ? argc - 2 : RZ_ARRAY_SIZE(algos);
+	if (!size) {
+		size = 1024 * 1024;
+	}
+	ut8 *data = malloc(size);
+	if (!data) {
+		return 1;
+	}
+	for (ut64 i = 0; i < size; i++) {
+		data[i] = i * 31;
+	}
+	RzHash *rh = rz_hash_new();
+	int ret = 0;
+	for (size_t i = 0; i < n_names; i++) {
+		ut64 start = rz_time_now_mono();
+		char *r = rz_hash_cfg_calculate_small_block_string(rh, names[i], data, size, NULL, false);
+		ut64 elapsed = RZ_MAX(rz_time_now_mono() - start, 1);
+		if (!r) {
+			eprintf("Cannot compute %s\n", names[i]);
+			ret = 1;
+			continue;
+		}
+		printf("%s: %" PFMT64u " MB/s\n", names[i], (size / 1024 / 1024) * 1000000 / elapsed);
+		free(r);
+	}
+	rz_hash_free(rh);
+	free(data);
+	return ret;
+}
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file bench_esil.c
+ * Instructions per second run by rz_analysis_esil_parse(), which parses each
+ * expression every time, and by rz_analysis_esil_parse_at(), which runs the code
+ * compiled for the address.
+ *
+ * Usage: bench_esil [iterations]
+ */
+
+#include <rz_analysis.h>
+
+static const char *profile =
+	"=PC	pc\n"
+	"=SP	sp\n"
+	"gpr	r0	.64	0	0\n"
+	"gpr	r1	.64	8	0\n"
+	"gpr	r2	.64	16	0\n"
+	"gpr	pc	.64	24	0\n"
+	"gpr	sp	.64	32	0\n"
+	"gpr	zf	.1	.320	0\n"
+	"gpr	cf	.1	.321	0\n";
+
+static const char *exprs[] = {
+	"r1,r0,+=,$z,zf,:=,$c63,cf,:=",
+	"3,r2,<<,r0,+,r1,=",
+	"r0,r0,^=,$z,zf,:=",
+	"zf,!,?{,0x1000,pc,=,}{,0x2000,pc,=,}",
+	"5,r2,=,r2,!,?{,BREAK,},1,r2,-=,1,r0,+=,3,GOTO",
+	"sp,0x30,&,?{,sp,0x10,&,?{,1,r1,+=,}{,2,r1,+=,},}{,zf,?{,4,r1,+=,},8,r1,+=,}",
+	"0x10,sp,-=,-1,r1,+=",
+};
+
+static ut64 esil_run(RzAnalysis *analysis, bool compiled, int iterations) {
+	RzAnalysisEsil *esil = rz_analysis_esil_new(32, 0, 64);
+	rz_analysis_esil_setup(esil, analysis, false, false, false);
+	rz_reg_setv(analysis->reg, "r0", 0x1234);
+	rz_reg_setv(analysis->reg, "r1", 0xffffffffffff0000ULL);
+	rz_reg_setv(analysis->reg, "r2", 7);
+	rz_reg_setv(analysis->reg, "sp", 0x8000);
+	ut64 start = rz_time_now_mono();
+	for (int it = 0; it < iterations; it++) {
+		for (size_t i = 0; i < RZ_ARRAY_SIZE(exprs); i++) {
+			if (compiled) {
+				rz_analysis_esil_parse_at(esil, 0x100 + i * 4, exprs[i]);
+			} else {
+				rz_analysis_esil_parse(esil, exprs[i]);
+			}
+			rz_analysis_esil_stack_free(esil);
+		}
+	}
+	ut64 elapsed = RZ_MAX(rz_time_now_mono() - start, 1);
+	rz_analysis_esil_free(esil);
+	return elapsed;
+}
+
+int main(int argc, char **argv) {
+	int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+	if (iterations < 1) {
+		iterations = 1;
+	}
+	RzAnalysis *analysis = rz_analysis_new();
+	if (!analysis || !rz_reg_set_profile_string(analysis->reg, profile)) {
+		rz_analysis_free(analysis);
+		return 1;
+	}
+	ut64 insns = (ut64)iterations * RZ_ARRAY_SIZE(exprs);
+	for (int compiled = 0; compiled < 2; compiled++) {
+		ut64 elapsed = esil_run(analysis, compiled, iterations);
+		printf("%s: %" PFMT64u " insn/s\n", compiled ? "rz_analysis_esil_parse_at" : "rz_analysis_esil_parse",
+			insns * 1000000 / elapsed);
+	}
+	rz_analysis_free(analysis);
+	return 0;
+}
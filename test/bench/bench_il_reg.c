@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file bench_il_reg.c
+ * Time needed to copy all the registers of an x86-64 like profile: by name with
+ * rz_reg_getv()/rz_reg_setv(), through RzRegItem handles resolved once with
+ * rz_reg_get_value()/rz_reg_set_value(), and between RzReg and RzILVM with
+ * rz_il_vm_sync_from_reg()/rz_il_vm_sync_to_reg() for all the registers or only
+ * for the ones of a type.
+ *
+ * Usage: bench_il_reg [iterations]
+ */
+
+#include <rz_il.h>
+#include <rz_reg.h>
+
+static const char *profile =
+	"=PC	rip\n"
+	"=SP	rsp\n"
+	"gpr	rax	.64	0	0\n"
+	"gpr	rbx	.64	8	0\n"
+	"gpr	rcx	.64	16	0\n"
+	"gpr	rdx	.64	24	0\n"
+	"gpr	rsi	.64	32	0\n"
+	"gpr	rdi	.64	40	0\n"
+	"gpr	rbp	.64	48	0\n"
+	"gpr	rsp	.64	56	0\n"
+	"gpr	r8	.64	64	0\n"
+	"gpr	r9	.64	72	0\n"
+	"gpr	r10	.64	80	0\n"
+	"gpr	r11	.64	88	0\n"
+	"gpr	r12	.64	96	0\n"
+	"gpr	r13	.64	104	0\n"
+	"gpr	r14	.64	112	0\n"
+	"gpr	r15	.64	120	0\n"
+	"gpr	rip	.64	128	0\n"
+	"seg	cs	.16	136	0\n"
+	"seg	ds	.16	138	0\n"
+	"seg	ss	.16	140	0\n"
+	"seg	fs	.16	142	0\n"
+	"seg	gs	.16	144	0\n"
+	"flg	cf	.1	.1216	0\n"
+	"flg	pf	.1	.1218	0\n"
+	"flg	af	.1	.1220	0\n"
+	"flg	zf	.1	.1222	0\n"
+	"flg	sf	.1	.1223	0\n"
+	"flg	df	.1	.1226	0\n"
+	"flg	of	.1	.1227	0\n";
+
+static ut64 bench_by_name(RzReg *reg, const char **names, size_t count, int iterations) {
+	ut64 start = rz_time_now_mono();
+	for (int it = 0; it < iterations; it++) {
+		for (size_t i = 0; i < count; i++) {
+			rz_reg_setv(reg, names[i], rz_reg_getv(reg, names[i]) + 1);
+		}
+	}
+	return RZ_MAX(rz_time_now_mono() - start, 1);
+}
+
+static ut64 bench_by_item(RzReg *reg, RzRegItem **items, size_t count, int iterations) {
+	ut64 start = rz_time_now_mono();
+	for (int it = 0; it < iterations; it++) {
+		for (size_t i = 0; i < count; i++) {
+			rz_reg_set_value(reg, items[i], rz_reg_get_value(reg, items[i]) + 1);
+		}
+	}
+	return RZ_MAX(rz_time_now_mono() - start, 1);
+}
+
+static ut64 bench_sync(RzILVM *vm, RzILRegBinding *rb, RzReg *reg, RzRegisterType type, int iterations) {
+	ut64 start = rz_time_now_mono();
+	for (int it = 0; it < iterations; it++) {
+		rz_il_vm_sync_from_reg_type(vm, rb, reg, type);
+		rz_il_vm_sync_to_reg_type(vm, rb, reg, type);
+	}
+	return RZ_MAX(rz_time_now_mono() - start, 1);
+}
+
+int main(int argc, char **argv) {
+	int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+	if (iterations < 1) {
+		iterations = 1;
+	}
+	RzReg *reg = rz_reg_new();
+	if (!reg || !rz_reg_set_profile_string(reg, profile)) {
+		rz_reg_free(reg);
+		return 1;
+	}
+	RzILRegBinding *rb = rz_il_reg_binding_derive(reg);
+	RzILVM *vm = rz_il_vm_new(0, 64, false);
+	if (!rb || !vm) {
+		rz_il_reg_binding_free(rb);
+		rz_il_vm_free(vm);
+		rz_reg_free(reg);
+		return 1;
+	}
+	rz_il_vm_setup_reg_binding(vm, rb);
+	const char **names = RZ_NEWS(const char *, rb->regs_count + 1);
+	RzRegItem **items = RZ_NEWS(RzRegItem *, rb->regs_count + 1);
+	if (!names || !items) {
+		free(names);
+		free(items);
+		rz_il_reg_binding_free(rb);
+		rz_il_vm_free(vm);
+		rz_reg_free(reg);
+		return 1;
+	}
+	size_t count = 0;
+	for (; count < rb->regs_count; count++) {
+		names[count] = rb->regs[count].name;
+	}
+	names[count++] = rz_reg_get_name(reg, RZ_REG_NAME_PC);
+	for (size_t i = 0; i < count; i++) {
+		items[i] = rz_reg_get(reg, names[i], RZ_REG_TYPE_ANY);
+	}
+
+	printf("%" PFMT64u " registers including pc\n", (ut64)count);
+	ut64 ops = (ut64)iterations * count;
+	printf("rz_reg_getv/rz_reg_setv: %" PFMT64u " ns per register\n",
+		bench_by_name(reg, names, count, iterations) * 1000 / ops);
+	printf("rz_reg_get_value/rz_reg_set_value: %" PFMT64u " ns per register\n",
+		bench_by_item(reg, items, count, iterations) * 1000 / ops);
+	const RzRegisterType types[] = { RZ_REG_TYPE_ANY, RZ_REG_TYPE_GPR, RZ_REG_TYPE_FLG };
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(types); i++) {
+		ut64 elapsed = bench_sync(vm, rb, reg, types[i], iterations);
+		printf("rz_il_vm_sync_from_reg/to_reg %s: %" PFMT64u " ns per round trip\n",
+			types[i] == RZ_REG_TYPE_ANY ? "all" : rz_reg_get_type(types[i]),
+			elapsed * 1000 / iterations);
+	}
+	free(names);
+	free(items);
+	rz_il_reg_binding_free(rb);
+	rz_il_vm_free(vm);
+	rz_reg_free(reg);
+	return 0;
+}
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file bench_str_search.c
+ * Throughput of the string scanners: rz_scan_strings_raw() per encoding, as used
+ * by iz/izz, and /z over the IO maps with search.threads=1 and with all the cores.
+ *
+ * Usage: bench_str_search [MiB]
+ */
+
+#include <rz_core.h>
+#include <rz_util/rz_str_search.h>
+
+static ut8 *bench_data(ut64 size) {
+	ut8 *data = malloc(size);
+	if (!data) {
+		return NULL;
+	}
+	// mostly binary data, with a short ascii string every 4K and an utf-16 one every 16K
+	ut32 seed = 0x1337;
+	for (ut64 i = 0; i < size; i++) {
+		seed = seed * 1103515245 + 12345;
+		data[i] = seed >> 16;
+	}
+	for (ut64 i = 0; i + 64 < size; i += 0x1000) {
+		const char *str = "string scanned by the benchmark";
+		if (i % 0x4000) {
+			memcpy(data + i, str, strlen(str) + 1);
+			continue;
+		}
+		for (size_t j = 0; str[j]; j++) {
+			data[i + j * 2] = str[j];
+			data[i + j * 2 + 1] = 0;
+		}
+	}
+	return data;
+}
+
+static ut64 mb_per_s(ut64 size, ut64 elapsed) {
+	return (size / 1024 / 1024) * 1000000 / RZ_MAX(elapsed, 1);
+}
+
+static bool bench_scan(const ut8 *data, ut64 size, RzStrEnc type) {
+	RzUtilStrScanOptions opt = {
+		.buf_size = 2048,
+		.max_uni_blocks = 4,
+		.min_str_length = 4,
+		.prefer_big_endian = false,
+		.check_ascii_freq = true,
+	};
+	RzList *found = rz_list_newf((RzListFree)rz_detected_string_free);
+	if (!found) {
+		return false;
+	}
+	ut64 start = rz_time_now_mono();
+	int count = rz_scan_strings_raw(data, found, &opt, 0, size, type);
+	ut64 elapsed = rz_time_now_mono() - start;
+	rz_list_free(found);
+	if (count < 0) {
+		eprintf("Cannot scan the %s strings\n", rz_str_enc_as_string(type));
+		return false;
+	}
+	printf("rz_scan_strings_raw %s: %" PFMT64u " MB/s (%d strings)\n",
+		rz_str_enc_as_string(type), mb_per_s(size, elapsed), count);
+	return true;
+}
+
+static bool bench_search(const ut8 *data, ut64 size, int n_threads) {
+	RzCore *core = rz_core_new();
+	if (!core) {
+		return false;
+	}
+	char *uri = rz_str_newf("malloc://%" PFMT64u, size);
+	RzCoreFile *cf = uri ? rz_core_file_open(core, uri, RZ_PERM_RW, 0) : NULL;
+	free(uri);
+	if (!cf || !rz_core_bin_load(core, NULL, 0) || !rz_io_write_at(core->io, 0, data, size)) {
+		rz_core_free(core);
+		return false;
+	}
+	rz_config_set_b(core->config, "scr.interactive", false);
+	rz_config_set_b(core->config, "search.flags", false);
+	rz_config_set_i(core->config, "search.threads", n_threads);
+	ut64 start = rz_time_now_mono();
+	char *out = rz_core_cmd_str(core, "/z 4 64");
+	ut64 elapsed = rz_time_now_mono() - start;
+	rz_core_free(core);
+	if (!out) {
+		return false;
+	}
+	printf("/z search.threads=%d: %" PFMT64u " MB/s (%d hits)\n",
+		n_threads, mb_per_s(size, elapsed), rz_str_char_count(out, '\n'));
+	free(out);
+	return true;
+}
+
+int main(int argc, char **argv) {
+	ut64 size = (argc > 1 ? atoi(argv[1]) : 64) * 1024 * 1024;
+	if (!size) {
+		size = 1024 * 1024;
+	}
+	ut8 *data = bench_data(size);
+	if (!data) {
+		return 1;
+	}
+	const RzStrEnc types[] = { RZ_STRING_ENC_8BIT, RZ_STRING_ENC_UTF16LE, RZ_STRING_ENC_GUESS };
+	int ret = 0;
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(types); i++) {
+		ret |= !bench_scan(data, size, types[i]);
+	}
+	ret |= !bench_search(data, size, 1);
+	ret |= !bench_search(data, size, 0);
+	free(data);
+	return ret;
+}
@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include "minunit.h"
+
+static const char *profile =
+	"=PC	pc\n"
+	"=SP	sp\n"
+	"gpr	r0	.64	0	0\n"
+	"gpr	r1	.64	8	0\n"
+	"gpr	r2	.64	16	0\n"
+	"gpr	pc	.64	24	0\n"
+	"gpr	sp	.64	32	0\n"
+	"gpr	zf	.1	.320	0\n"
+	"gpr	cf	.1	.321	0\n";
+
+static const char *exprs[] = {
+	"r1,r0,+=,$z,zf,:=,$c63,cf,:=",
+	"3,r2,<<,r0,+,r1,=",
+	"r0,r0,^=,$z,zf,:=",
+	"zf,!,?{,0x1000,pc,=,}{,0x2000,pc,=,}",
+	"5,r2,=,r2,!,?{,BREAK,},1,r2,-=,1,r0,+=,3,GOTO",
+	"sp,0x30,&,?{,sp,0x10,&,?{,1,r1,+=,}{,2,r1,+=,},}{,zf,?{,4,r1,+=,},8,r1,+=,}",
+	"0x10,sp,-=,-1,r1,+=",
+};
+
+static RzAnalysisEsil *esil_new(RzAnalysis *analysis) {
+	RzAnalysisEsil *esil = rz_analysis_esil_new(32, 0, 64);
+	rz_analysis_esil_setup(esil, analysis, false, false, false);
+	rz_reg_setv(analysis->reg, "r0", 0x1234);
+	rz_reg_setv(analysis->reg, "r1", 0xffffffffffff0000ULL);
+	rz_reg_setv(analysis->reg, "r2", 7);
+	rz_reg_setv(analysis->reg, "sp", 0x8000);
+	return esil;
+}
+
+static void esil_run(RzAnalysisEsil *esil, bool compiled, int iterations, ut64 *regs) {
+	for (int it = 0; it < iterations; it++) {
+		for (size_t i = 0; i < RZ_ARRAY_SIZE(exprs); i++) {
+			if (compiled) {
+				rz_analysis_esil_parse_at(esil, 0x100 + i * 4, exprs[i]);
+			} else {
+				rz_analysis_esil_parse(esil, exprs[i]);
+			}
+			rz_analysis_esil_stack_free(esil);
+		}
+	}
+	const char *names[] = { "r0", "r1", "r2", "pc", "sp", "zf", "cf" };
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(names); i++) {
+		regs[i] = rz_reg_getv(esil->analysis->reg, names[i]);
+	}
+}
+
+bool test_esil_parse_at_same_as_parse(void) {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_reg_set_profile_string(analysis->reg, profile);
+	ut64 expect[7], got[7];
+
+	RzAnalysisEsil *esil = esil_new(analysis);
+	esil_run(esil, false, 4, expect);
+	rz_analysis_esil_free(esil);
+
+	esil = esil_new(analysis);
+	esil_run(esil, true, 4, got);
+	rz_analysis_esil_free(esil);
+
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(got); i++) {
+		mu_assert_eq(got[i], expect[i], "compiled esil result");
+	}
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool test_esil_parse_at_invalidate(void) {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_reg_set_profile_string(analysis->reg, profile);
+	RzAnalysisEsil *esil = esil_new(analysis);
+
+	mu_assert_true(rz_analysis_esil_parse_at(esil, 0x100, "1,r0,="), "parse_at");
+	mu_assert_eq(rz_reg_getv(analysis->reg, "r0"), 1, "r0");
+	// another expression at the same address must not reuse the old code
+	mu_assert_true(rz_analysis_esil_parse_at(esil, 0x100, "2,r0,="), "parse_at");
+	mu_assert_eq(rz_reg_getv(analysis->reg, "r0"), 2, "r0 changed expression");
+
+	rz_analysis_esil_code_cache_invalidate(esil, 0x100, 1);
+	mu_assert_true(rz_analysis_esil_parse_at(esil, 0x100, "3,r0,="), "parse_at");
+	mu_assert_eq(rz_reg_getv(analysis->reg, "r0"), 3, "r0 after invalidation");
+
+	// registers resolved when compiled must follow a new profile
+	rz_reg_set_profile_string(analysis->reg,
+		"=PC	pc\n"
+		"gpr	pc	.64	0	0\n"
+		"gpr	r0	.64	8	0\n");
+	mu_assert_true(rz_analysis_esil_parse_at(esil, 0x100, "3,r0,="), "parse_at");
+	mu_assert_eq(rz_reg_getv(analysis->reg, "r0"), 3, "r0 after new profile");
+	mu_assert_eq(rz_reg_getv(analysis->reg, "pc"), 0, "pc after new profile");
+
+	rz_analysis_esil_code_cache_clear(esil);
+	rz_analysis_esil_free(esil);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool test_esil_parse_at_repeated(void) {
+	// the compiled code of every address is run again many times
+	const int iterations = 1000;
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_reg_set_profile_string(analysis->reg, profile);
+	ut64 regs[2][7];
+	for (int compiled = 0; compiled < 2; compiled++) {
+		RzAnalysisEsil *esil = esil_new(analysis);
+		esil_run(esil, compiled, iterations, regs[compiled]);
+		rz_analysis_esil_free(esil);
+	}
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(regs[0]); i++) {
+		mu_assert_eq(regs[1][i], regs[0][i], "compiled esil result");
+	}
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test(test_esil_parse_at_same_as_parse);
+	mu_run_test(test_esil_parse_at_invalidate);
+	mu_run_test(test_esil_parse_at_repeated);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
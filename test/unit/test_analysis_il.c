@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include "minunit.h"
+
+/*
+ * Tiny arch for testing the lifting:
+ * 01 xx: r0 = r0 + xx
+ * 02:    if (r0 < 10) goto 0
+ */
+static ut8 code[0x10];
+static int lifts;
+
+static bool code_read_at(RzAnalysis *analysis, ut64 addr, ut8 *buf, int len) {
+	memset(buf, 0xff, len);
+	if (addr < sizeof(code)) {
+		memcpy(buf, code + addr, RZ_MIN(len, sizeof(code) - addr));
+	}
+	return true;
+}
+
+static int tiny_op(RzAnalysis *a, RzAnalysisOp *op, ut64 addr, const ut8 *data, int len, RzAnalysisOpMask mask) {
+	switch (data[0]) {
+	case 1:
+		op->size = 2;
+		if (mask & RZ_ANALYSIS_OP_MASK_IL) {
+			op->il_op = rz_il_op_new_set("r0", false, rz_il_op_new_add(rz_il_op_new_var("r0", RZ_IL_VAR_KIND_GLOBAL), rz_il_op_new_bitv_from_ut64(16, data[1])));
+			lifts++;
+		}
+		return 2;
+	case 2:
+		op->size = 1;
+		if (mask & RZ_ANALYSIS_OP_MASK_IL) {
+			op->il_op = rz_il_op_new_branch(rz_il_op_new_ult(rz_il_op_new_var("r0", RZ_IL_VAR_KIND_GLOBAL), rz_il_op_new_bitv_from_ut64(16, 10)),
+				rz_il_op_new_jmp(rz_il_op_new_bitv_from_ut64(16, 0)), NULL);
+			lifts++;
+		}
+		return 1;
+	default:
+		return -1;
+	}
+}
+
+static char *tiny_reg_profile(RzAnalysis *a) {
+	return strdup(
+		"=PC	pc\n"
+		"gpr	pc	.16	0	0\n"
+		"gpr	r0	.16	2	0\n");
+}
+
+static RzAnalysisILConfig *tiny_il_config(RzAnalysis *a) {
+	return rz_analysis_il_config_new(16, false, 16);
+}
+
+static RzAnalysisPlugin tiny_plugin = {
+	.name = "tiny",
+	.arch = "tiny",
+	.bits = 16,
+	.op = tiny_op,
+	.get_reg_profile = tiny_reg_profile,
+	.il_config = tiny_il_config,
+	.il_cacheable = true,
+};
+
+static bool step_until_end(RzAnalysisILVM *vm, void *user) {
+	return rz_bv_to_ut64(vm->vm->pc) != 3;
+}
+
+static ut64 run_loop(RzAnalysis *analysis, RzAnalysisILVM *vm) {
+	rz_il_vm_set_global_var(vm->vm, "r0", rz_il_value_new_bitv(rz_bv_new_from_ut64(16, 0)));
+	rz_bv_set_from_ut64(vm->vm->pc, 0);
+	lifts = 0;
+	if (rz_analysis_il_vm_step_while(analysis, vm, NULL, step_until_end, NULL) != RZ_ANALYSIS_IL_STEP_RESULT_SUCCESS) {
+		return UT64_MAX;
+	}
+	RzILVal *r0 = rz_il_vm_get_var_value(vm->vm, RZ_IL_VAR_KIND_GLOBAL, "r0");
+	return rz_bv_to_ut64(r0->data.bv);
+}
+
+bool test_analysis_il_vm_cache(void) {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_add(analysis, &tiny_plugin);
+	mu_assert_true(rz_analysis_use(analysis, "tiny"), "use tiny");
+	analysis->read_at = code_read_at;
+	memcpy(code, "\x01\x01\x02", 3);
+
+	RzAnalysisILVM *vm = rz_analysis_il_vm_new(analysis, NULL);
+	mu_assert_notnull(vm, "vm");
+
+	mu_assert_eq(run_loop(analysis, vm), 10, "r0 after loop");
+	mu_assert_eq(lifts, 2, "every instruction lifted once");
+	mu_assert_eq(vm->il_cache_misses, 2, "misses");
+	mu_assert_eq(vm->il_cache_hits, 18, "hits");
+
+	// changed code must be lifted again
+	code[1] = 5;
+	mu_assert_eq(run_loop(analysis, vm), 10, "r0 after changed code");
+	mu_assert_eq(lifts, 1, "changed instruction lifted again");
+
+	// hints are applied on top of the lifted op, so these instructions are not cached
+	rz_analysis_hint_set_size(analysis, 0, 2);
+	mu_assert_eq(run_loop(analysis, vm), 10, "r0 with hint");
+	mu_assert_eq(lifts, 2, "hinted instruction always lifted");
+	rz_analysis_hint_unset_size(analysis, 0);
+
+	rz_analysis_il_vm_cache_invalidate(vm, 2, 1);
+	mu_assert_eq(run_loop(analysis, vm), 10, "r0 after invalidation");
+	mu_assert_eq(lifts, 2, "invalidated instructions lifted again");
+
+	vm->il_cache_max = 0;
+	rz_analysis_il_vm_cache_clear(vm);
+	mu_assert_eq(run_loop(analysis, vm), 10, "r0 without cache");
+	mu_assert_eq(lifts, 4, "all instructions lifted without cache");
+
+	// plugins whose lifting depends on more than the bytes are never cached
+	vm->il_cache_max = 1024;
+	tiny_plugin.il_cacheable = false;
+	mu_assert_eq(run_loop(analysis, vm), 10, "r0 with non cacheable plugin");
+	mu_assert_eq(lifts, 4, "all instructions lifted for non cacheable plugin");
+	tiny_plugin.il_cacheable = true;
+
+	rz_analysis_il_vm_free(vm);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool test_analysis_il_vm_compile(void) {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_add(analysis, &tiny_plugin);
+	mu_assert_true(rz_analysis_use(analysis, "tiny"), "use tiny");
+	analysis->read_at = code_read_at;
+	memcpy(code, "\x01\x03\x02", 3);
+
+	RzAnalysisILVM *vm = rz_analysis_il_vm_new(analysis, NULL);
+	mu_assert_notnull(vm, "vm");
+	vm->il_compile = true;
+	mu_assert_eq(run_loop(analysis, vm), 12, "r0 after compiled loop");
+	mu_assert_eq(lifts, 2, "every instruction lifted once");
+	mu_assert_eq(run_loop(analysis, vm), 12, "r0 after second compiled loop");
+	mu_assert_eq(lifts, 0, "no instruction lifted");
+
+	// compiled code must be dropped with the changed instruction
+	code[1] = 4;
+	mu_assert_eq(run_loop(analysis, vm), 12, "r0 after changed code");
+	mu_assert_eq(lifts, 1, "changed instruction lifted again");
+	code[1] = 6;
+	mu_assert_eq(run_loop(analysis, vm), 12, "r0 after changed code");
+
+	rz_analysis_il_vm_free(vm);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test(test_analysis_il_vm_cache);
+	mu_run_test(test_analysis_il_vm_compile);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
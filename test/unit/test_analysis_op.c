@@ -97,6 +97,49 @@ bool test_rz_analysis_op_val() {
 	mu_end;
 }
 
+static bool x86_decode_cached(RzAnalysis *analysis, RzAnalysisOp *op, const ut8 *buf, int len, bool hit) {
+	ut64 hits, lookups, old_hits, old_lookups;
+	rz_analysis_decode_cache_stats(analysis, &old_hits, &old_lookups);
+	rz_analysis_op(analysis, op, 0x1000, buf, len, RZ_ANALYSIS_OP_MASK_DISASM);
+	rz_analysis_decode_cache_stats(analysis, &hits, &lookups);
+	return lookups == old_lookups + 1 && hits == old_hits + hit;
+}
+
+bool test_rz_analysis_op_x86_decode_cache() {
+	RzAnalysis *analysis = rz_analysis_new();
+	RzAnalysisOp op;
+	ut64 hits, lookups;
+	SWITCH_TO_ARCH_BITS("x86", 64);
+	mu_assert_true(rz_analysis_decode_cache_stats(analysis, &hits, &lookups), "x86 has a decode cache");
+	ut8 buf[] = { 0x48, 0x89, 0xe5, 0x90 };
+
+	mu_assert_true(x86_decode_cached(analysis, &op, buf, sizeof(buf), false), "first decode misses");
+	mu_assert_streq(op.mnemonic, "mov rbp, rsp", "decoded op");
+	rz_analysis_op_fini(&op);
+	mu_assert_true(x86_decode_cached(analysis, &op, buf, sizeof(buf), true), "same bytes hit");
+	mu_assert_streq(op.mnemonic, "mov rbp, rsp", "cached op");
+	mu_assert_eq(op.size, 3, "cached op size");
+	rz_analysis_op_fini(&op);
+
+	// patched bytes at the cached address
+	buf[1] = 0x31;
+	buf[2] = 0xc0;
+	mu_assert_true(x86_decode_cached(analysis, &op, buf, sizeof(buf), false), "patched bytes miss");
+	mu_assert_streq(op.mnemonic, "xor rax, rax", "patched op");
+	mu_assert_eq(op.type, RZ_ANALYSIS_OP_TYPE_XOR, "patched op type");
+	rz_analysis_op_fini(&op);
+
+	// same bytes in another mode
+	rz_analysis_set_bits(analysis, 32);
+	mu_assert_true(x86_decode_cached(analysis, &op, buf, sizeof(buf), false), "other mode misses");
+	mu_assert_streq(op.mnemonic, "dec eax", "op in the other mode");
+	mu_assert_eq(op.size, 1, "op size in the other mode");
+	rz_analysis_op_fini(&op);
+
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
 bool test_rz_core_analysis_bytes() {
 	RzCore *core = rz_core_new();
 	rz_core_set_asm_configs(core, "x86", 64, 0);
@@ -164,6 +207,7 @@ bool test_rz_core_print_disasm() {
 
 int all_tests() {
 	mu_run_test(test_rz_analysis_op_val);
+	mu_run_test(test_rz_analysis_op_x86_decode_cache);
 	mu_run_test(test_rz_core_analysis_bytes);
 	mu_run_test(test_rz_core_print_disasm);
 	return tests_passed != tests_run;
@@ -21,8 +21,284 @@ bool test_rz_analysis_xrefs_count() {
 	mu_end;
 }
 
+static bool list_has(RzList *list, ut64 from, ut64 to, RzAnalysisXRefType type) {
+	RzListIter *it;
+	RzAnalysisXRef *xref;
+	rz_list_foreach (list, it, xref) {
+		if (xref->from == from && xref->to == to) {
+			return xref->type == type;
+		}
+	}
+	return false;
+}
+
+bool test_rz_analysis_xrefs_set_del() {
+	RzAnalysis *analysis = rz_analysis_new();
+	mu_assert_false(rz_analysis_xrefs_set(analysis, 42, 42, RZ_ANALYSIS_XREF_TYPE_CODE), "no xref to itself");
+	rz_analysis_xrefs_set(analysis, 0x30, 0x10, RZ_ANALYSIS_XREF_TYPE_CODE);
+	rz_analysis_xrefs_set(analysis, 0x20, 0x10, RZ_ANALYSIS_XREF_TYPE_CALL);
+	rz_analysis_xrefs_set(analysis, 0x20, 0x18, RZ_ANALYSIS_XREF_TYPE_DATA);
+	rz_analysis_xrefs_set(analysis, 0x30, 0x10, RZ_ANALYSIS_XREF_TYPE_STRING);
+
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 3, "same xref set twice");
+	RzList *list = rz_analysis_xrefs_get_to(analysis, 0x10);
+	mu_assert_eq(rz_list_length(list), 2, "xrefs to");
+	RzAnalysisXRef *xref = rz_list_first(list);
+	mu_assert_eq(xref->from, 0x20, "sorted by from");
+	mu_assert_true(list_has(list, 0x30, 0x10, RZ_ANALYSIS_XREF_TYPE_STRING), "type updated");
+	rz_list_free(list);
+
+	// update the type of an already merged xref
+	rz_analysis_xrefs_set(analysis, 0x20, 0x18, RZ_ANALYSIS_XREF_TYPE_CODE);
+	list = rz_analysis_xrefs_get_from(analysis, 0x20);
+	mu_assert_eq(rz_list_length(list), 2, "xrefs from");
+	mu_assert_true(list_has(list, 0x20, 0x18, RZ_ANALYSIS_XREF_TYPE_CODE), "merged type updated");
+	rz_list_free(list);
+
+	mu_assert_true(rz_analysis_xref_del(analysis, 0x20, 0x10), "deleted");
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 2, "count after delete");
+	list = rz_analysis_xrefs_get_to(analysis, 0x10);
+	mu_assert_eq(rz_list_length(list), 1, "xrefs to after delete");
+	rz_list_free(list);
+	mu_assert_null(rz_analysis_xrefs_get_from(analysis, 0x40), "no xrefs");
+
+	// set again after delete
+	rz_analysis_xrefs_set(analysis, 0x20, 0x10, RZ_ANALYSIS_XREF_TYPE_DATA);
+	list = rz_analysis_xrefs_list(analysis);
+	mu_assert_eq(rz_list_length(list), 3, "all xrefs");
+	mu_assert_true(list_has(list, 0x20, 0x10, RZ_ANALYSIS_XREF_TYPE_DATA), "set after delete");
+	rz_list_free(list);
+
+	mu_assert_true(rz_analysis_xrefs_init(analysis), "reset");
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 0, "count after reset");
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+typedef struct {
+	RzAnalysisXRef xrefs[8];
+	int count;
+	int stop;
+} Collected;
+
+static bool collect_cb(const RzAnalysisXRef *xref, void *user) {
+	Collected *c = user;
+	if (c->count < 8) {
+		c->xrefs[c->count] = *xref;
+	}
+	return ++c->count != c->stop;
+}
+
+bool test_rz_analysis_xrefs_range() {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_xrefs_set(analysis, 0x100, 0x2000, RZ_ANALYSIS_XREF_TYPE_CALL);
+	rz_analysis_xrefs_set(analysis, 0x104, 0x1ff0, RZ_ANALYSIS_XREF_TYPE_DATA);
+	rz_analysis_xrefs_set(analysis, 0x108, 0x3000, RZ_ANALYSIS_XREF_TYPE_CODE);
+	rz_analysis_xrefs_set(analysis, 0x200, 0x2008, RZ_ANALYSIS_XREF_TYPE_CALL);
+	rz_analysis_xrefs_set(analysis, UT64_MAX - 1, UT64_MAX, RZ_ANALYSIS_XREF_TYPE_DATA);
+
+	Collected c = { 0 };
+	mu_assert_true(rz_analysis_xrefs_foreach_to_in(analysis, 0x2000, 0x1000, collect_cb, &c), "iterated all");
+	mu_assert_eq(c.count, 2, "xrefs into range");
+	mu_assert_eq(c.xrefs[0].to, 0x2000, "sorted by to");
+	mu_assert_eq(c.xrefs[0].from, 0x100, "from");
+	mu_assert_eq(c.xrefs[0].type, RZ_ANALYSIS_XREF_TYPE_CALL, "type");
+	mu_assert_eq(c.xrefs[1].to, 0x2008, "sorted by to");
+
+	memset(&c, 0, sizeof(c));
+	rz_analysis_xrefs_foreach_from_in(analysis, 0x100, 0x100, collect_cb, &c);
+	mu_assert_eq(c.count, 3, "xrefs from range");
+	mu_assert_eq(c.xrefs[2].from, 0x108, "sorted by from");
+
+	memset(&c, 0, sizeof(c));
+	rz_analysis_xrefs_foreach_to_in(analysis, UT64_MAX - 8, 0x100, collect_cb, &c);
+	mu_assert_eq(c.count, 1, "range clamped at the end of the address space");
+
+	memset(&c, 0, sizeof(c));
+	c.stop = 2;
+	mu_assert_false(rz_analysis_xrefs_foreach(analysis, collect_cb, &c), "stopped");
+	mu_assert_eq(c.count, 2, "stopped by callback");
+
+	memset(&c, 0, sizeof(c));
+	rz_analysis_xrefs_foreach_to(analysis, 0x3000, collect_cb, &c);
+	mu_assert_eq(c.count, 1, "xrefs to");
+	mu_assert_eq(c.xrefs[0].from, 0x108, "xref to");
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+#define MODEL_ADDRS 97
+
+static ut8 model[MODEL_ADDRS][MODEL_ADDRS];
+
+typedef struct {
+	ut64 last_key;
+	ut64 last_val;
+	bool by_to;
+	int count;
+	bool ok;
+} ModelCheck;
+
+static bool model_check_cb(const RzAnalysisXRef *xref, void *user) {
+	ModelCheck *mc = user;
+	ut64 key = mc->by_to ? xref->to : xref->from;
+	ut64 val = mc->by_to ? xref->from : xref->to;
+	if (mc->count && (key < mc->last_key || (key == mc->last_key && val <= mc->last_val))) {
+		mc->ok = false;
+	}
+	if (xref->from >= MODEL_ADDRS || xref->to >= MODEL_ADDRS || model[xref->from][xref->to] != (ut8)xref->type + 1) {
+		mc->ok = false;
+	}
+	mc->last_key = key;
+	mc->last_val = val;
+	mc->count++;
+	return true;
+}
+
+static const RzAnalysisXRefType model_types[] = {
+	RZ_ANALYSIS_XREF_TYPE_NULL,
+	RZ_ANALYSIS_XREF_TYPE_CODE,
+	RZ_ANALYSIS_XREF_TYPE_CALL,
+	RZ_ANALYSIS_XREF_TYPE_DATA,
+	RZ_ANALYSIS_XREF_TYPE_STRING,
+};
+
+bool test_rz_analysis_xrefs_model() {
+	RzAnalysis *analysis = rz_analysis_new();
+	memset(model, 0, sizeof(model));
+	ut32 seed = 1;
+	int count = 0;
+	// enough operations to go through the pending, delta and main runs many times
+	for (int i = 0; i < 200000; i++) {
+		seed = seed * 1103515245 + 12345;
+		ut64 from = (seed >> 8) % MODEL_ADDRS;
+		ut64 to = (seed >> 16) % MODEL_ADDRS;
+		if (from == to) {
+			continue;
+		}
+		if ((seed >> 28) < 5) {
+			count -= model[from][to] ? 1 : 0;
+			model[from][to] = 0;
+			rz_analysis_xref_del(analysis, from, to);
+		} else {
+			RzAnalysisXRefType type = model_types[(seed >> 24) % 5];
+			count += model[from][to] ? 0 : 1;
+			model[from][to] = (ut8)type + 1;
+			rz_analysis_xrefs_set(analysis, from, to, type);
+		}
+		if (i % 9973) {
+			continue;
+		}
+		mu_assert_eq(rz_analysis_xrefs_count(analysis), count, "count");
+		for (int by_to = 0; by_to < 2; by_to++) {
+			ModelCheck mc = { 0, 0, by_to, 0, true };
+			if (by_to) {
+				rz_analysis_xrefs_foreach_to_in(analysis, 0, MODEL_ADDRS, model_check_cb, &mc);
+			} else {
+				rz_analysis_xrefs_foreach(analysis, model_check_cb, &mc);
+			}
+			mu_assert_true(mc.ok, "xrefs match the model");
+			mu_assert_eq(mc.count, count, "all xrefs iterated");
+		}
+		ut64 addr = i % MODEL_ADDRS;
+		ModelCheck mc = { 0, 0, true, 0, true };
+		rz_analysis_xrefs_foreach_to(analysis, addr, model_check_cb, &mc);
+		int expected = 0;
+		for (int f = 0; f < MODEL_ADDRS; f++) {
+			expected += model[f][addr] ? 1 : 0;
+		}
+		mu_assert_true(mc.ok, "xrefs to match the model");
+		mu_assert_eq(mc.count, expected, "xrefs to count");
+	}
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool test_rz_analysis_xrefs_bulk() {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_xrefs_set(analysis, 1, 2, RZ_ANALYSIS_XREF_TYPE_CODE);
+	RzAnalysisXRef xrefs[] = {
+		{ 1, 2, RZ_ANALYSIS_XREF_TYPE_CALL },
+		{ 5, 5, RZ_ANALYSIS_XREF_TYPE_CALL },
+		{ 3, 2, RZ_ANALYSIS_XREF_TYPE_DATA },
+		{ 3, 2, RZ_ANALYSIS_XREF_TYPE_STRING },
+		{ 2, 1, RZ_ANALYSIS_XREF_TYPE_CODE },
+	};
+	mu_assert_eq(rz_analysis_xrefs_set_bulk(analysis, xrefs, RZ_ARRAY_SIZE(xrefs)), 4, "xrefs set");
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 3, "count");
+	RzList *list = rz_analysis_xrefs_get_to(analysis, 2);
+	mu_assert_true(list_has(list, 1, 2, RZ_ANALYSIS_XREF_TYPE_CALL), "existing xref updated");
+	mu_assert_true(list_has(list, 3, 2, RZ_ANALYSIS_XREF_TYPE_STRING), "last duplicate wins");
+	rz_list_free(list);
+
+	RzAnalysisXRefsStats stats;
+	rz_analysis_xrefs_stats(analysis, &stats);
+	mu_assert_eq(stats.count, 3, "stats count");
+	mu_assert_eq(stats.delta, 0, "bulk merged into the main runs");
+	mu_assert_eq(stats.deleted, 0, "nothing deleted");
+	mu_assert_true(stats.bytes > 3 * 2 * 17, "memory");
+	rz_analysis_xref_del(analysis, 2, 1);
+	rz_analysis_xrefs_stats(analysis, &stats);
+	mu_assert_eq(stats.count, 2, "stats count after delete");
+	mu_assert_eq(stats.deleted, 1, "deleted xref kept until the next merge");
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+typedef struct {
+	RzAnalysis *analysis;
+	size_t count;
+	bool ok;
+} NestedQuery;
+
+static bool nested_query_cb(const RzAnalysisXRef *xref, void *user) {
+	NestedQuery *q = user;
+	RzList *list = rz_analysis_xrefs_get_from(q->analysis, xref->from);
+	q->ok &= list_has(list, xref->from, xref->to, xref->type);
+	rz_list_free(list);
+	q->count++;
+	return true;
+}
+
+bool test_rz_analysis_xrefs_pending_query() {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_xrefs_set(analysis, 0x10, 0x1000, RZ_ANALYSIS_XREF_TYPE_CODE);
+	rz_analysis_xrefs_set(analysis, 0x10, 0x1000, RZ_ANALYSIS_XREF_TYPE_CALL);
+	for (ut64 i = 0; i < 100; i++) {
+		rz_analysis_xrefs_set(analysis, 0x100 + i, 0x1000, RZ_ANALYSIS_XREF_TYPE_DATA);
+	}
+	RzAnalysisXRefsStats stats;
+	rz_analysis_xrefs_stats(analysis, &stats);
+	mu_assert_eq(stats.count, 101, "count of the pending xrefs");
+	mu_assert_eq(stats.pending, 102, "pending xrefs");
+
+	RzList *list = rz_analysis_xrefs_get_to(analysis, 0x1000);
+	mu_assert_eq(rz_list_length(list), 101, "more pending xrefs than a query keeps on the stack");
+	mu_assert_true(list_has(list, 0x10, 0x1000, RZ_ANALYSIS_XREF_TYPE_CALL), "last set wins");
+	mu_assert_true(list_has(list, 0x163, 0x1000, RZ_ANALYSIS_XREF_TYPE_DATA), "pending xref");
+	RzAnalysisXRef *first = rz_list_first(list);
+	mu_assert_eq(first->from, 0x10, "sorted by from");
+	rz_list_free(list);
+
+	NestedQuery q = { analysis, 0, true };
+	mu_assert_true(rz_analysis_xrefs_foreach(analysis, nested_query_cb, &q), "iterated all");
+	mu_assert_eq(q.count, 101, "iterated the pending xrefs");
+	mu_assert_true(q.ok, "queries from the callback");
+
+	rz_analysis_xrefs_stats(analysis, &stats);
+	mu_assert_eq(stats.pending, 102, "queries do not merge the pending xrefs");
+	mu_assert_eq(stats.delta, 0, "queries do not merge the pending xrefs");
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_rz_analysis_xrefs_count);
+	mu_run_test(test_rz_analysis_xrefs_set_del);
+	mu_run_test(test_rz_analysis_xrefs_range);
+	mu_run_test(test_rz_analysis_xrefs_model);
+	mu_run_test(test_rz_analysis_xrefs_bulk);
+	mu_run_test(test_rz_analysis_xrefs_pending_query);
 	return tests_passed != tests_run;
 }
 
@@ -196,6 +196,36 @@ bool test_rz_buf_mmap(void) {
 	mu_end;
 }
 
+bool test_rz_buf_mmap_readonly(void) {
+	char *filename = "r2-XXXXXX";
+	const char *content = "Something To\nSay Here..";
+	const int length = 23;
+
+	int fd = rz_file_mkstemp("", &filename);
+	mu_assert_neq((long long)fd, -1LL, "mkstemp failed...");
+	rz_xwrite(fd, content, length);
+	close(fd);
+
+	RzBuffer *b = rz_buf_new_mmap(filename, O_RDONLY, 0);
+	mu_assert_notnull(b, "rz_buf_new_mmap failed");
+	mu_assert_true(b->readonly, "read-only mapping");
+	mu_assert_eq(rz_buf_size(b), length, "size");
+
+	ut64 size = 0;
+	const ut8 *data = rz_buf_data(b, &size);
+	mu_assert_eq(size, length, "whole buf size");
+	mu_assert_memeq(data, (const ut8 *)content, length, "direct access to the mapped bytes");
+
+	ut8 tmp[4];
+	mu_assert_eq(rz_buf_read_at(b, 13, tmp, sizeof(tmp)), sizeof(tmp), "read");
+	mu_assert_memeq(tmp, (const ut8 *)"Say ", sizeof(tmp), "read content");
+
+	rz_buf_free(b);
+	unlink(filename);
+	free(filename);
+	mu_end;
+}
+
 bool test_rz_buf_io_fd(void) {
 	RzBuffer *b;
 	const char *content = "Something To\nSay Here..";
@@ -1384,6 +1414,7 @@ int all_tests() {
 	mu_run_test(test_rz_buf_file);
 	mu_run_test(test_rz_buf_bytes);
 	mu_run_test(test_rz_buf_mmap);
+	mu_run_test(test_rz_buf_mmap_readonly);
 	mu_run_test(test_rz_buf_with_buf);
 	mu_run_test(test_rz_buf_slice);
 	mu_run_test(test_rz_buf_io_fd);
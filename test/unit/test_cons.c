@@ -324,6 +324,73 @@ bool test_line_kill_word(void) {
 	mu_end;
 }
 
+static bool stream_lines(RzCons *cons, const char *grep, const char *last, size_t *max_len, size_t *lines) {
+	char *path = NULL;
+	int fd = rz_file_mkstemp("cons_stream", &path);
+	if (fd < 0) {
+		return false;
+	}
+	cons->fdout = fd;
+	if (grep) {
+		rz_cons_grep_process(strdup(grep));
+	}
+	*max_len = 0;
+	for (int i = 0; i < 100000; i++) {
+		rz_cons_printf("line %d %s\n", i, i % 10 ? "skip" : "keep");
+		*max_len = RZ_MAX(*max_len, cons->context->buffer_len);
+	}
+	rz_cons_flush();
+	cons->fdout = 1;
+	close(fd);
+	char *out = rz_file_slurp(path, NULL);
+	*lines = out ? rz_str_char_count(out, '\n') : 0;
+	bool ok = out && rz_str_endswith(out, last);
+	free(out);
+	rz_file_rm(path);
+	free(path);
+	return ok;
+}
+
+bool test_cons_stream(void) {
+	RzCons *cons = rz_cons_new();
+	cons->num = rz_num_new(NULL, NULL, NULL);
+	size_t max_len, lines;
+
+	mu_assert_true(stream_lines(cons, NULL, "line 99999 skip\n", &max_len, &lines), "buffered output");
+	mu_assert_eq(lines, 100000, "buffered lines");
+	mu_assert_true(max_len > 1000000, "whole output buffered");
+
+	cons->stream = true;
+	mu_assert_true(stream_lines(cons, NULL, "line 99999 skip\n", &max_len, &lines), "streamed output");
+	mu_assert_eq(lines, 100000, "streamed lines");
+	mu_assert_true(max_len < 0x20000, "bounded buffer");
+
+	mu_assert_true(stream_lines(cons, "keep", "line 99990 keep\n", &max_len, &lines), "streamed grep");
+	mu_assert_eq(lines, 10000, "grepped lines");
+	mu_assert_true(max_len < 0x20000, "bounded buffer with grep");
+
+	mu_assert_true(stream_lines(cons, "keep?", "10000\n", &max_len, &lines), "counted grep");
+	mu_assert_eq(lines, 1, "count is not streamed");
+	mu_assert_true(max_len > 1000000, "whole output buffered for counting");
+
+	// a captured output is not filtered by the grep set up for the outer one
+	rz_cons_grep_process(strdup("keep"));
+	rz_cons_push();
+	rz_cons_print("skip\n");
+	rz_cons_filter();
+	mu_assert_streq(rz_cons_get_buffer(), "skip\n", "captured output not grepped");
+	rz_cons_pop();
+	rz_cons_print("skip\nkeep\n");
+	rz_cons_filter();
+	mu_assert_streq(rz_cons_get_buffer(), "keep\n", "outer grep restored");
+	rz_cons_reset();
+
+	rz_num_free(cons->num);
+	cons->num = NULL;
+	rz_cons_free();
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_rz_cons);
 	mu_run_test(test_cons_to_html);
@@ -331,6 +398,7 @@ bool all_tests() {
 	mu_run_test(test_line_onecompletion);
 	mu_run_test(test_line_multicompletion);
 	mu_run_test(test_line_kill_word);
+	mu_run_test(test_cons_stream);
 	return tests_passed != tests_run;
 }
 
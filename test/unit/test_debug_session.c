@@ -9,14 +9,14 @@
 Sdb *ref_db() {
 	Sdb *db = sdb_new0();
 
+	sdb_num_set(db, "version", 2, 0);
 	sdb_num_set(db, "maxcnum", 1, 0);
 
 	Sdb *registers_db = sdb_ns(db, "registers", true);
 	sdb_set(registers_db, "0x100", "[{\"cnum\":0,\"data\":1094861636},{\"cnum\":1,\"data\":3735928559}]", 0);
 
 	Sdb *memory_sdb = sdb_ns(db, "memory", true);
-	sdb_set(memory_sdb, "0x7ffffffff000", "[{\"cnum\":0,\"data\":170},{\"cnum\":1,\"data\":187}]", 0);
-	sdb_set(memory_sdb, "0x7ffffffff001", "[{\"cnum\":0,\"data\":0},{\"cnum\":1,\"data\":1}]", 0);
+	sdb_set(memory_sdb, "0x7ffffffff000", "[{\"cnum\":0,\"offset\":0,\"data\":\"qgA=\"},{\"cnum\":1,\"offset\":0,\"data\":\"uwE=\"}]", 0);
 
 	Sdb *checkpoints_sdb = sdb_ns(db, "checkpoints", true);
 	sdb_set(checkpoints_sdb, "0x0", "{"
@@ -126,17 +126,20 @@ static bool compare_registers_cb(void *user, const ut64 key, const void *value)
 static bool compare_memory_cb(void *user, const ut64 key, const void *value) {
 	RzDebugChangeMem *actual_mem, *expected_mem;
 	HtUP *ref = user;
-	RzVector *actual_vmem = (RzVector *)value;
+	RzDebugChangeMemPage *actual_page = (RzDebugChangeMemPage *)value;
 
-	RzVector *expected_vmem = ht_up_find(ref, key, NULL);
-	mu_assert("vmem not found", expected_vmem);
-	mu_assert_eq(actual_vmem->len, expected_vmem->len, "vmem length");
+	RzDebugChangeMemPage *expected_page = ht_up_find(ref, key, NULL);
+	mu_assert("page not found", expected_page);
+	mu_assert_eq(rz_vector_len(&actual_page->changes), rz_vector_len(&expected_page->changes), "changes length");
 
 	size_t i;
-	rz_vector_enumerate(actual_vmem, actual_mem, i) {
-		expected_mem = rz_vector_index_ptr(expected_vmem, i);
+	rz_vector_enumerate(&actual_page->changes, actual_mem, i) {
+		expected_mem = rz_vector_index_ptr(&expected_page->changes, i);
 		mu_assert_eq(actual_mem->cnum, expected_mem->cnum, "cnum");
-		mu_assert_eq(actual_mem->data, expected_mem->data, "data");
+		mu_assert_eq(actual_mem->offset, expected_mem->offset, "offset");
+		mu_assert_eq(actual_mem->size, expected_mem->size, "size");
+		mu_assert_memeq(rz_vector_index_ptr(&actual_page->bytes, actual_mem->data),
+			rz_vector_index_ptr(&expected_page->bytes, expected_mem->data), expected_mem->size, "data");
 	}
 	return true;
 }
@@ -165,7 +168,7 @@ static bool test_session_load(void) {
 	RzDebugSession *ref = ref_session();
 	RzDebugSession *s = rz_debug_session_new();
 	Sdb *db = ref_db();
-	rz_debug_session_deserialize(s, db);
+	mu_assert_true(rz_debug_session_deserialize(s, db), "load");
 
 	mu_assert_eq(s->maxcnum, ref->maxcnum, "maxcnum");
 	// Registers
@@ -198,9 +201,92 @@ static bool test_session_load(void) {
 	mu_end;
 }
 
+static bool test_session_mem_change(void) {
+	RzDebugSession *s = rz_debug_session_new();
+	ut8 data[0x10];
+	memset(data, 0x41, sizeof(data));
+
+	// crosses the page boundary
+	rz_debug_session_add_mem_range_change(s, 0x1ff8, data, sizeof(data));
+	// follows the previous write in the same step
+	rz_debug_session_add_mem_change(s, 0x2008, 0x42);
+	s->cnum++;
+	rz_debug_session_add_mem_change(s, 0x2009, 0x43);
+
+	mu_assert_eq(s->memory->count, 2, "pages");
+	RzDebugChangeMemPage *page = ht_up_find(s->memory, 0x1000, NULL);
+	mu_assert_notnull(page, "first page");
+	mu_assert_eq(rz_vector_len(&page->changes), 1, "first page changes");
+	RzDebugChangeMem *mem = rz_vector_index_ptr(&page->changes, 0);
+	mu_assert_eq(mem->offset, 0xff8, "offset");
+	mu_assert_eq(mem->size, 8, "size");
+
+	page = ht_up_find(s->memory, 0x2000, NULL);
+	mu_assert_notnull(page, "second page");
+	mu_assert_eq(rz_vector_len(&page->changes), 2, "second page changes");
+	mem = rz_vector_index_ptr(&page->changes, 0);
+	mu_assert_eq(mem->cnum, 0, "cnum");
+	mu_assert_eq(mem->offset, 0, "offset");
+	mu_assert_eq(mem->size, 9, "merged size");
+	mu_assert_memeq(rz_vector_index_ptr(&page->bytes, mem->data), (const ut8 *)"AAAAAAAAB", 9, "data");
+	mem = rz_vector_index_ptr(&page->changes, 1);
+	mu_assert_eq(mem->cnum, 1, "cnum");
+	mu_assert_eq(mem->offset, 9, "offset");
+	mu_assert_eq(mem->size, 1, "size");
+
+	rz_debug_session_free(s);
+	mu_end;
+}
+
+static bool test_session_load_v1(void) {
+	// sessions without version have one memory entry per byte
+	Sdb *db = sdb_new0();
+	sdb_num_set(db, "maxcnum", 1, 0);
+	Sdb *registers_db = sdb_ns(db, "registers", true);
+	sdb_set(registers_db, "0x100", "[{\"cnum\":0,\"data\":1094861636},{\"cnum\":1,\"data\":3735928559}]", 0);
+	Sdb *memory_sdb = sdb_ns(db, "memory", true);
+	sdb_set(memory_sdb, "0x7ffffffff001", "[{\"cnum\":0,\"data\":0},{\"cnum\":1,\"data\":1}]", 0);
+	sdb_set(memory_sdb, "0x7ffffffff000", "[{\"cnum\":0,\"data\":170},{\"cnum\":1,\"data\":187}]", 0);
+	sdb_ns(db, "checkpoints", true);
+
+	RzDebugSession *ref = ref_session();
+	RzDebugSession *s = rz_debug_session_new();
+	mu_assert_true(rz_debug_session_deserialize(s, db), "load");
+	mu_assert_eq(s->maxcnum, ref->maxcnum, "maxcnum");
+	mu_assert_eq(s->memory->count, ref->memory->count, "pages");
+	ht_up_foreach(s->memory, compare_memory_cb, ref->memory);
+
+	// saved again in the current format
+	Sdb *actual = sdb_new0();
+	rz_debug_session_serialize(s, actual);
+	mu_assert_eq(sdb_num_get(actual, "version", 0), 2, "version");
+	mu_assert_streq(sdb_const_get(sdb_ns(actual, "memory", false), "0x7ffffffff000", 0),
+		"[{\"cnum\":0,\"offset\":0,\"data\":\"qgA=\"},{\"cnum\":1,\"offset\":0,\"data\":\"uwE=\"}]", "memory");
+
+	sdb_free(actual);
+	sdb_free(db);
+	rz_debug_session_free(s);
+	rz_debug_session_free(ref);
+	mu_end;
+}
+
+static bool test_session_load_newer(void) {
+	Sdb *db = ref_db();
+	sdb_num_set(db, "version", 3, 0);
+	RzDebugSession *s = rz_debug_session_new();
+	mu_assert_false(rz_debug_session_deserialize(s, db), "newer version");
+	mu_assert_eq(s->memory->count, 0, "nothing loaded");
+	sdb_free(db);
+	rz_debug_session_free(s);
+	mu_end;
+}
+
 int all_tests() {
+	mu_run_test(test_session_mem_change);
 	mu_run_test(test_session_save);
 	mu_run_test(test_session_load);
+	mu_run_test(test_session_load_v1);
+	mu_run_test(test_session_load_newer);
 	return tests_passed != tests_run;
 }
 
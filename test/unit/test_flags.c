@@ -131,10 +131,44 @@ bool test_rz_flag_get_at() {
 	mu_end;
 }
 
+static bool collect_flag_cb(RzFlagItem *fi, void *user) {
+	rz_list_append(user, fi);
+	return true;
+}
+
+bool test_rz_flag_foreach_range(void) {
+	RzFlag *flag = rz_flag_new();
+	RzFlagItem *a = rz_flag_set(flag, "a", 0x100, 0);
+	RzFlagItem *b = rz_flag_set(flag, "b", 0x200, 0);
+	RzFlagItem *c = rz_flag_set(flag, "c", 0x200, 0);
+	RzFlagItem *d = rz_flag_set(flag, "d", 0x300, 0);
+	rz_flag_set(flag, "e", 0x400, 0);
+
+	RzList *l = rz_list_new();
+	rz_flag_foreach_range(flag, 0x100, 0x300, collect_flag_cb, l);
+	mu_assert_eq(rz_list_length(l), 4, "inclusive range");
+	mu_assert_ptreq(rz_list_get_n(l, 0), a, "sorted by offset");
+	mu_assert_true(rz_list_contains(l, b) && rz_list_contains(l, c), "all flags at an offset");
+	mu_assert_ptreq(rz_list_get_n(l, 3), d, "sorted by offset");
+	rz_list_purge(l);
+
+	rz_flag_foreach_range(flag, 0x101, 0x2ff, collect_flag_cb, l);
+	mu_assert_eq(rz_list_length(l), 2, "inner range");
+	rz_list_purge(l);
+
+	rz_flag_foreach_range(flag, 0x401, UT64_MAX, collect_flag_cb, l);
+	mu_assert_eq(rz_list_length(l), 0, "empty range");
+
+	rz_list_free(l);
+	rz_flag_free(flag);
+	mu_end;
+}
+
 int all_tests(void) {
 	mu_run_test(test_rz_flag_get_set);
 	mu_run_test(test_rz_flag_by_spaces);
 	mu_run_test(test_rz_flag_get_at);
+	mu_run_test(test_rz_flag_foreach_range);
 	return tests_passed != tests_run;
 }
 
@@ -237,11 +237,275 @@ bool test_message_digest_small_block_stringified() {
 	mu_end;
 }
 
+static char *crc_digest(RzHash *rh, const char *algo, const ut8 *data, ut64 size, ut64 chunk) {
+	RzHashCfg *md = rz_hash_cfg_new_with_algo2(rh, algo);
+	if (!md) {
+		return NULL;
+	}
+	for (ut64 off = 0; off < size; off += chunk) {
+		rz_hash_cfg_update(md, data + off, RZ_MIN(chunk, size - off));
+	}
+	rz_hash_cfg_final(md);
+	char *r = rz_hash_cfg_get_result_string(md, algo, NULL, false);
+	rz_hash_cfg_free(md);
+	return r;
+}
+
+bool test_message_digest_crc_tables() {
+	// digests of the data below computed bit by bit by an independent implementation
+	const struct {
+		const char *algo;
+		const char *digest;
+	} expected[] = {
+	{ "crc8smbus", "17" },
+	{ "crc8cdma2000", "cf" },
+	{ "crc8darc", "fd" },
+	{ "crc8dvbs2", "e8" },
+	{ "crc8ebu", "2e" },
+	{ "crc8icode", "ef" },
+	{ "crc8itu", "42" },
+	{ "crc8maxim", "dd" },
+	{ "crc8rohc", "cf" },
+	{ "crc8wcdma", "6a" },
+	{ "crc15can", "4583" },
+	{ "crc16", "0c14" },
+	{ "crc16citt", "c161" },
+	{ "crc16usb", "7bfc" },
+	{ "crc16hdlc", "ddf0" },
+	{ "crc16augccitt", "e00b" },
+	{ "crc16buypass", "8eb2" },
+	{ "crc16cdma2000", "e1e8" },
+	{ "crc16dds110", "7edb" },
+	{ "crc16dectr", "878a" },
+	{ "crc16dectx", "878b" },
+	{ "crc16dnp", "304b" },
+	{ "crc16en13757", "4fb9" },
+	{ "crc16genibus", "3e9e" },
+	{ "crc16maxim", "f3eb" },
+	{ "crc16mcrf4xx", "220f" },
+	{ "crc16riello", "3a3a" },
+	{ "crc16t10dif", "c66f" },
+	{ "crc16teledisk", "21a0" },
+	{ "crc16tms37157", "0648" },
+	{ "crca", "dc79" },
+	{ "crc16kermit", "4b88" },
+	{ "crc16modbus", "8403" },
+	{ "crc16x25", "ddf0" },
+	{ "crc16xmodem", "20f7" },
+	{ "crc24", "00c47c0c" },
+	{ "crc32", "fe46b9ab" },
+	{ "crc32ecma267", "de27ddbb" },
+	{ "crc32c", "92faab7b" },
+	{ "crc32bzip2", "15694c1d" },
+	{ "crc32d", "bba467eb" },
+	{ "crc32mpeg2", "ea96b3e2" },
+	{ "crc32posix", "ffe614f9" },
+	{ "crc32q", "dbf0430d" },
+	{ "crc32jamcrc", "01b94654" },
+	{ "crc32xfer", "4a26fdfd" },
+	{ "crc64", "8b21e858f264aa94" },
+	{ "crc64ecma182", "8b21e858f264aa94" },
+	{ "crc64we", "f6f4e23df2c25bf4" },
+	{ "crc64xz", "67a41f8c5327ee00" },
+	{ "crc64iso", "cbc95dddad2fa501" },
+	};
+	char message[256];
+	ut8 data[5000];
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (i * 0x9e3779b1) >> 13;
+	}
+	RzHash *rh = rz_hash_new();
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(expected); i++) {
+		const char *algo = expected[i].algo;
+		// the first small updates are computed bit by bit, everything else with the tables
+		snprintf(message, sizeof(message), "%s single update", algo);
+		mu_assert_streq_free(crc_digest(rh, algo, data, sizeof(data), sizeof(data)), expected[i].digest, message);
+		snprintf(message, sizeof(message), "%s byte updates", algo);
+		mu_assert_streq_free(crc_digest(rh, algo, data, sizeof(data), 1), expected[i].digest, message);
+		snprintf(message, sizeof(message), "%s unaligned updates", algo);
+		mu_assert_streq_free(crc_digest(rh, algo, data, sizeof(data), 333), expected[i].digest, message);
+	}
+	rz_hash_free(rh);
+	mu_end;
+}
+
+static bool digest_all(RzHashCfg *md, const char **algos, size_t n_algos, const ut8 *data, ut64 size, ut64 chunk, char **results) {
+	if (!rz_hash_cfg_init(md)) {
+		return false;
+	}
+	for (ut64 off = 0; off < size; off += chunk) {
+		if (!rz_hash_cfg_update(md, data + off, RZ_MIN(chunk, size - off))) {
+			return false;
+		}
+	}
+	if (!rz_hash_cfg_final(md)) {
+		return false;
+	}
+	for (size_t i = 0; i < n_algos; i++) {
+		results[i] = rz_hash_cfg_get_result_string(md, algos[i], NULL, false);
+	}
+	return true;
+}
+
+bool test_message_digest_parallel() {
+	const char *algos[] = { "md5", "sha1", "sha256", "sha512", "crc32", "xxhash32", "entropy" };
+	char *expect[RZ_ARRAY_SIZE(algos)] = { 0 };
+	char *result[RZ_ARRAY_SIZE(algos)] = { 0 };
+	const ut64 size = 16 * 1024 * 1024;
+	ut8 *data = malloc(size);
+	mu_assert_notnull(data, "data");
+	for (ut64 i = 0; i < size; i++) {
+		data[i] = (i * 0x9e3779b1) >> 11;
+	}
+
+	RzHash *rh = rz_hash_new();
+	RzHashCfg *md = rz_hash_cfg_new(rh);
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(algos); i++) {
+		mu_assert_true(rz_hash_cfg_configure(md, algos[i]), "configure");
+	}
+	mu_assert_true(digest_all(md, algos, RZ_ARRAY_SIZE(algos), data, size, 0x10000, expect), "sequential digests");
+
+	rz_hash_cfg_set_parallel(md, true);
+	mu_assert_true(digest_all(md, algos, RZ_ARRAY_SIZE(algos), data, size, 0x10000, result), "parallel digests");
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(algos); i++) {
+		mu_assert_streq_free(result[i], expect[i], algos[i]);
+	}
+
+	// the same workers hash the data again, in chunks smaller than the ring
+	mu_assert_true(digest_all(md, algos, RZ_ARRAY_SIZE(algos), data, 4099, 7, result), "parallel small digests");
+	rz_hash_cfg_set_parallel(md, false);
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(algos); i++) {
+		free(expect[i]);
+	}
+	mu_assert_true(digest_all(md, algos, RZ_ARRAY_SIZE(algos), data, 4099, 4099, expect), "sequential small digests");
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(algos); i++) {
+		mu_assert_streq_free(result[i], expect[i], algos[i]);
+		free(expect[i]);
+	}
+
+	rz_hash_cfg_free(md);
+	rz_hash_free(rh);
+	free(data);
+	mu_end;
+}
+
+typedef struct {
+	ut8 *data;
+	ut64 size;
+	ut64 reads;
+} BlockIndexData;
+
+static ut64 block_index_read(void *user, ut64 offset, ut8 *buf, ut64 len) {
+	BlockIndexData *d = user;
+	d->reads++;
+	memcpy(buf, d->data + offset, len);
+	return len;
+}
+
+static char *block_index_root(RzHashBlockIndex *index) {
+	return rz_hex_bin2strdup(rz_hash_block_index_root(index), index->digest_size);
+}
+
+bool test_message_digest_block_index() {
+	BlockIndexData d = { .size = 1024 * 1024 + 123 };
+	d.data = malloc(d.size);
+	mu_assert_notnull(d.data, "data");
+	for (ut64 i = 0; i < d.size; i++) {
+		d.data[i] = (i * 0x9e3779b1) >> 9;
+	}
+	RzHash *rh = rz_hash_new();
+
+	// a single block is the digest of the data
+	RzHashBlockIndex *index = rz_hash_block_index_new(rh, "sha256", d.size, d.size);
+	mu_assert_eq(rz_hash_block_index_update(index, block_index_read, &d, 1), 1, "single block hashed");
+	char *expect = rz_hash_cfg_calculate_small_block_string(rh, "sha256", d.data, d.size, NULL, false);
+	mu_assert_streq_free(block_index_root(index), expect, "single block root");
+	free(expect);
+	rz_hash_block_index_free(index);
+
+	// the root is the digest of the digests of the two halves of 3 blocks, the last one copied
+	index = rz_hash_block_index_new(rh, "md5", 10, 4);
+	mu_assert_eq(index->blocks_count, 3, "blocks count");
+	mu_assert_eq(rz_hash_block_index_update(index, block_index_read, &d, 1), 3, "small blocks hashed");
+	ut8 nodes[3 * 16];
+	RzHashSize digest_size;
+	for (int i = 0; i < 3; i++) {
+		ut8 *digest = rz_hash_cfg_calculate_small_block(rh, "md5", d.data + i * 4, i == 2 ? 2 : 4, &digest_size);
+		mu_assert_memeq(rz_hash_block_index_block(index, i), digest, 16, "block digest");
+		memcpy(nodes + i * 16, digest, 16);
+		free(digest);
+	}
+	ut8 *left = rz_hash_cfg_calculate_small_block(rh, "md5", nodes, 32, &digest_size);
+	memcpy(nodes, left, 16);
+	memcpy(nodes + 16, nodes + 32, 16);
+	free(left);
+	expect = rz_hash_cfg_calculate_small_block_string(rh, "md5", nodes, 32, NULL, false);
+	mu_assert_streq_free(block_index_root(index), expect, "tree root");
+	free(expect);
+	rz_hash_block_index_free(index);
+
+	index = rz_hash_block_index_new(rh, "sha256", d.size, 0x1000);
+	mu_assert_eq(index->blocks_count, 257, "blocks count");
+	mu_assert_eq(rz_hash_block_index_update(index, block_index_read, &d, 0), 257, "all blocks hashed");
+	mu_assert_eq(rz_hash_block_index_update(index, block_index_read, &d, 0), 0, "no block hashed again");
+	char *root = block_index_root(index);
+
+	// only the patched blocks are hashed again
+	d.data[0x1fff] ^= 0xff;
+	rz_hash_block_index_invalidate(index, 0x1fff, 2);
+	rz_hash_block_index_invalidate(index, d.size - 1, 100);
+	mu_assert_eq(index->dirty_count, 3, "dirty blocks");
+	d.reads = 0;
+	mu_assert_eq(rz_hash_block_index_update(index, block_index_read, &d, 4), 3, "dirty blocks hashed");
+	mu_assert_eq(d.reads, 3, "dirty blocks read");
+	RzHashBlockIndex *fresh = rz_hash_block_index_new(rh, "sha256", d.size, 0x1000);
+	mu_assert_eq(rz_hash_block_index_update(fresh, block_index_read, &d, 1), 257, "all blocks hashed");
+	char *fresh_root = block_index_root(fresh);
+	mu_assert_streq_free(block_index_root(index), fresh_root, "root after patch");
+	mu_assert_false(!strcmp(root, fresh_root), "root changed");
+	rz_hash_block_index_free(fresh);
+	free(root);
+
+	// the restored dirty blocks are still dirty, the others are not hashed again
+	ut8 *blocks = malloc(index->blocks_count * index->digest_size);
+	ut8 *dirty = calloc(index->blocks_count, 1);
+	mu_assert_true(blocks && dirty, "blocks");
+	for (ut64 i = 0; i < index->blocks_count; i++) {
+		memcpy(blocks + i * index->digest_size, rz_hash_block_index_block(index, i), index->digest_size);
+	}
+	d.data[0] ^= 0xff;
+	dirty[0] = 1;
+	rz_hash_block_index_free(index);
+	index = rz_hash_block_index_new(rh, "sha256", d.size, 0x1000);
+	mu_assert_true(rz_hash_block_index_restore(index, blocks, dirty), "restored index");
+	mu_assert_eq(index->dirty_count, 1, "restored dirty blocks");
+	d.reads = 0;
+	mu_assert_eq(rz_hash_block_index_update(index, block_index_read, &d, 1), 1, "restored dirty block hashed");
+	mu_assert_eq(d.reads, 1, "restored dirty block read");
+	fresh = rz_hash_block_index_new(rh, "sha256", d.size, 0x1000);
+	rz_hash_block_index_update(fresh, block_index_read, &d, 1);
+	free(fresh_root);
+	fresh_root = block_index_root(fresh);
+	mu_assert_streq_free(block_index_root(index), fresh_root, "root after restore");
+	free(fresh_root);
+	rz_hash_block_index_free(fresh);
+	rz_hash_block_index_free(index);
+	free(blocks);
+	free(dirty);
+
+	rz_hash_free(rh);
+	free(d.data);
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_message_digest_configure);
 	mu_run_test(test_message_digest_api_stringified);
 	mu_run_test(test_message_digest_hmac_stringified);
 	mu_run_test(test_message_digest_small_block_stringified);
+	mu_run_test(test_message_digest_crc_tables);
+	mu_run_test(test_message_digest_parallel);
+	mu_run_test(test_message_digest_block_index);
 	return tests_passed != tests_run;
 }
 
@@ -0,0 +1,319 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_il.h>
+#include <rz_util.h>
+#include "minunit.h"
+
+/*
+ * The compiled code must behave exactly like the interpreter, so all tests here
+ * execute the same ops in two identical vms, once interpreted and once compiled,
+ * and compare the resulting state and events.
+ */
+
+typedef struct {
+	RzILVM *vm;
+	RzBuffer *buf;
+} TestVM;
+
+static void test_vm_init(TestVM *t) {
+	t->vm = rz_il_vm_new(0, 16, false);
+	rz_il_vm_create_global_var(t->vm, "r0", rz_il_sort_pure_bv(32));
+	rz_il_vm_create_global_var(t->vm, "r1", rz_il_sort_pure_bv(32));
+	rz_il_vm_create_global_var(t->vm, "r2", rz_il_sort_pure_bv(8));
+	rz_il_vm_create_global_var(t->vm, "c", rz_il_sort_pure_bv(8));
+	rz_il_vm_create_global_var(t->vm, "f", rz_il_sort_pure_bool());
+	rz_il_vm_set_global_var(t->vm, "r0", rz_il_value_new_bitv(rz_bv_new_from_ut64(32, 0x80001234)));
+	rz_il_vm_set_global_var(t->vm, "r1", rz_il_value_new_bitv(rz_bv_new_from_ut64(32, 7)));
+	rz_il_vm_set_global_var(t->vm, "r2", rz_il_value_new_bitv(rz_bv_new_from_ut64(8, 0xf0)));
+	ut8 data[0x20];
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = i * 0x11;
+	}
+	t->buf = rz_buf_new_with_bytes(data, sizeof(data));
+	rz_il_vm_add_mem(t->vm, 0, rz_il_mem_new(t->buf, 16));
+}
+
+static void test_vm_fini(TestVM *t) {
+	rz_il_vm_free(t->vm);
+	rz_buf_free(t->buf);
+}
+
+static char *test_vm_state(TestVM *t) {
+	RzStrBuf sb;
+	rz_strbuf_init(&sb);
+	rz_strbuf_appendf(&sb, "pc=0x%" PFMT64x "\n", rz_bv_to_ut64(t->vm->pc));
+	const char *names[] = { "r0", "r1", "r2", "c", "f" };
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(names); i++) {
+		RzILVal *val = rz_il_vm_get_var_value(t->vm, RZ_IL_VAR_KIND_GLOBAL, names[i]);
+		if (val->type == RZ_IL_TYPE_PURE_BOOL) {
+			rz_strbuf_appendf(&sb, "%s=%s\n", names[i], rz_str_bool(val->data.b->b));
+		} else {
+			rz_strbuf_appendf(&sb, "%s=0x%" PFMT64x "\n", names[i], rz_bv_to_ut64(val->data.bv));
+		}
+	}
+	ut8 data[0x20];
+	rz_buf_read_at(t->buf, 0, data, sizeof(data));
+	for (size_t i = 0; i < sizeof(data); i++) {
+		rz_strbuf_appendf(&sb, "%02x", data[i]);
+	}
+	rz_strbuf_append(&sb, "\n");
+	RzListIter *it;
+	RzILEvent *evt;
+	rz_list_foreach (t->vm->events, it, evt) {
+		rz_il_event_stringify(evt, &sb);
+		rz_strbuf_append(&sb, "\n");
+	}
+	return rz_strbuf_drain_nofree(&sb);
+}
+
+/**
+ * Step \p op \p steps times interpreted and compiled and check that both give the same results
+ */
+static bool check_same(RzILOpEffect *op, int steps, const char *name) {
+	TestVM interp, comp;
+	test_vm_init(&interp);
+	test_vm_init(&comp);
+	RzILCompiled *code = rz_il_compile_effect(comp.vm, op);
+	mu_assert_notnull(code, name);
+	for (int i = 0; i < steps; i++) {
+		ut64 addr = 0x100 + i * 4;
+		bool expect_succ = rz_il_vm_step(interp.vm, op, addr);
+		bool succ = rz_il_vm_step_compiled(comp.vm, code, addr);
+		mu_assert_eq(succ, expect_succ, name);
+		char *expect = test_vm_state(&interp);
+		char *got = test_vm_state(&comp);
+		mu_assert_streq_free(got, expect, name);
+		free(expect);
+	}
+	rz_il_compiled_free(code);
+	test_vm_fini(&interp);
+	test_vm_fini(&comp);
+	return true;
+}
+
+static ut32 rnd_state;
+
+static ut32 rnd(ut32 n) {
+	rnd_state = rnd_state * 1103515245 + 12345;
+	return (rnd_state >> 8) % n;
+}
+
+static ut64 rnd_const(ut32 len) {
+	switch (rnd(5)) {
+	case 0: return 0;
+	case 1: return UT64_MAX;
+	case 2: return rnd(len + 2);
+	case 3: return 1ULL << rnd(len);
+	default: return ((ut64)rnd(0x10000) << 48) | ((ut64)rnd(0x10000) << 32) | ((ut64)rnd(0x10000) << 16) | rnd(0x10000);
+	}
+}
+
+static const ut32 lens[] = { 1, 8, 16, 32, 64 };
+static const char *let_names[] = { "l0", "l1", "l2", "l3", "l4", "l5", "l6", "l7" };
+static int lets_count;
+static bool local_set;
+static bool in_repeat;
+static ut32 let_lens[RZ_ARRAY_SIZE(let_names)];
+
+static RzILOpBool *gen_bool(int depth);
+
+static RzILOpBitVector *gen_bv(int depth, ut32 len) {
+	if (depth <= 0 || !rnd(5)) {
+		switch (rnd(4)) {
+		case 0:
+			if (len == 32) {
+				return rz_il_op_new_var(rnd(2) ? "r0" : "r1", RZ_IL_VAR_KIND_GLOBAL);
+			}
+			if (len == 8) {
+				return rz_il_op_new_var("r2", RZ_IL_VAR_KIND_GLOBAL);
+			}
+			break;
+		case 1:
+			if (len == 32 && local_set) {
+				return rz_il_op_new_var("t", RZ_IL_VAR_KIND_LOCAL);
+			}
+			break;
+		case 2:
+			for (int i = lets_count - 1; i >= 0; i--) {
+				if (let_lens[i] == len) {
+					return rz_il_op_new_var(let_names[i], RZ_IL_VAR_KIND_LOCAL_PURE);
+				}
+			}
+			break;
+		default:
+			break;
+		}
+		return rz_il_op_new_bitv_from_ut64(len, rnd_const(len));
+	}
+	depth--;
+	ut32 other = lens[rnd(RZ_ARRAY_SIZE(lens))];
+	switch (rnd(22)) {
+	case 0: return rz_il_op_new_add(gen_bv(depth, len), gen_bv(depth, len));
+	case 1: return rz_il_op_new_sub(gen_bv(depth, len), gen_bv(depth, len));
+	case 2: return rz_il_op_new_mul(gen_bv(depth, len), gen_bv(depth, len));
+	case 3: return rz_il_op_new_div(gen_bv(depth, len), gen_bv(depth, len));
+	case 4: return rz_il_op_new_sdiv(gen_bv(depth, len), gen_bv(depth, len));
+	case 5: return rz_il_op_new_mod(gen_bv(depth, len), gen_bv(depth, len));
+	case 6: return rz_il_op_new_smod(gen_bv(depth, len), gen_bv(depth, len));
+	case 7: return rz_il_op_new_log_and(gen_bv(depth, len), gen_bv(depth, len));
+	case 8: return rz_il_op_new_log_or(gen_bv(depth, len), gen_bv(depth, len));
+	case 9: return rz_il_op_new_log_xor(gen_bv(depth, len), gen_bv(depth, len));
+	case 10: return rz_il_op_new_neg(gen_bv(depth, len));
+	case 11: return rz_il_op_new_log_not(gen_bv(depth, len));
+	case 12: return rz_il_op_new_shiftl(gen_bool(depth), gen_bv(depth, len), gen_bv(depth, other));
+	case 13: return rz_il_op_new_shiftr(gen_bool(depth), gen_bv(depth, len), gen_bv(depth, other));
+	case 14: return rz_il_op_new_ite(gen_bool(depth), gen_bv(depth, len), gen_bv(depth, len));
+	case 15: return rz_il_op_new_cast(len, gen_bool(depth), gen_bv(depth, other));
+	case 16:
+		if (len > 1) {
+			ut32 low = 1 + rnd(len - 1);
+			return rz_il_op_new_append(gen_bv(depth, len - low), gen_bv(depth, low));
+		}
+		return rz_il_op_new_cast(len, gen_bool(depth), gen_bv(depth, other));
+	case 17:
+		if (lets_count < RZ_ARRAY_SIZE(let_lens)) {
+			const char *name = let_names[lets_count];
+			RzILOpPure *exp = gen_bv(depth, other);
+			let_lens[lets_count++] = other;
+			RzILOpPure *body = gen_bv(depth, len);
+			lets_count--;
+			return rz_il_op_new_let(name, exp, body);
+		}
+		return gen_bv(depth, len);
+	case 18:
+		if (len == 8) {
+			return rz_il_op_new_load(0, gen_bv(depth, 16));
+		}
+		// fallthrough
+	case 19:
+		if (len % 8 == 0) {
+			return rz_il_op_new_loadw(0, gen_bv(depth, 16), len);
+		}
+		return gen_bv(depth, len);
+	default:
+		return gen_bv(0, len);
+	}
+}
+
+static RzILOpBool *gen_bool(int depth) {
+	if (depth <= 0 || !rnd(5)) {
+		switch (rnd(3)) {
+		case 0: return rz_il_op_new_var("f", RZ_IL_VAR_KIND_GLOBAL);
+		case 1: return rz_il_op_new_b0();
+		default: return rz_il_op_new_b1();
+		}
+	}
+	depth--;
+	ut32 len = lens[rnd(RZ_ARRAY_SIZE(lens))];
+	switch (rnd(11)) {
+	case 0: return rz_il_op_new_bool_inv(gen_bool(depth));
+	case 1: return rz_il_op_new_bool_and(gen_bool(depth), gen_bool(depth));
+	case 2: return rz_il_op_new_bool_or(gen_bool(depth), gen_bool(depth));
+	case 3: return rz_il_op_new_bool_xor(gen_bool(depth), gen_bool(depth));
+	case 4: return rz_il_op_new_msb(gen_bv(depth, len));
+	case 5: return rz_il_op_new_lsb(gen_bv(depth, len));
+	case 6: return rz_il_op_new_is_zero(gen_bv(depth, len));
+	case 7: return rz_il_op_new_eq(gen_bv(depth, len), gen_bv(depth, len));
+	case 8: return rz_il_op_new_ule(gen_bv(depth, len), gen_bv(depth, len));
+	case 9: return rz_il_op_new_sle(gen_bv(depth, len), gen_bv(depth, len));
+	default: return rz_il_op_new_ite(gen_bool(depth), gen_bool(depth), gen_bool(depth));
+	}
+}
+
+static RzILOpEffect *gen_effect(int depth) {
+	int d = depth - 1;
+	switch (rnd(depth > 0 ? 11 : 6)) {
+	case 0: return rz_il_op_new_set("r0", false, gen_bv(d, 32));
+	case 1: return rz_il_op_new_set("r2", false, gen_bv(d, 8));
+	case 2: return rz_il_op_new_set("f", false, gen_bool(d));
+	case 3: return rz_il_op_new_set("t", true, gen_bv(d, 32));
+	case 4: return rz_il_op_new_store(0, gen_bv(d, 16), gen_bv(d, 8));
+	case 5: return rz_il_op_new_storew(0, gen_bv(d, 16), gen_bv(d, 8 << rnd(3)));
+	case 6: return rz_il_op_new_jmp(gen_bv(d, 16));
+	case 7: return rz_il_op_new_branch(gen_bool(d), gen_effect(d), rnd(2) ? gen_effect(d) : NULL);
+	case 8: {
+		if (in_repeat) {
+			return rz_il_op_new_nop();
+		}
+		in_repeat = true;
+		RzILOpEffect *body = gen_effect(d);
+		in_repeat = false;
+		return rz_il_op_new_seq(rz_il_op_new_set("c", false, rz_il_op_new_bitv_from_ut64(8, 0)),
+			rz_il_op_new_repeat(rz_il_op_new_ult(rz_il_op_new_var("c", RZ_IL_VAR_KIND_GLOBAL), rz_il_op_new_bitv_from_ut64(8, rnd(4))),
+				rz_il_op_new_seq(rz_il_op_new_set("c", false, rz_il_op_new_add(rz_il_op_new_var("c", RZ_IL_VAR_KIND_GLOBAL), rz_il_op_new_bitv_from_ut64(8, 1))),
+					body)));
+	}
+	case 9: return rz_il_op_new_nop();
+	default: return rz_il_op_new_seq(gen_effect(d), gen_effect(d));
+	}
+}
+
+static bool test_il_compile_random(void) {
+	rnd_state = 0x1337;
+	for (int i = 0; i < 400; i++) {
+		lets_count = 0;
+		local_set = false;
+		RzILOpEffect *init = rz_il_op_new_set("t", true, gen_bv(2, 32));
+		local_set = true;
+		RzILOpEffect *op = rz_il_op_new_seqn(4,
+			init,
+			gen_effect(3),
+			gen_effect(3),
+			rz_il_op_new_set("r1", false, gen_bv(4, 32)));
+		char name[32];
+		snprintf(name, sizeof(name), "random op %d", i);
+		if (!check_same(op, 3, name)) {
+			rz_il_op_effect_free(op);
+			return false;
+		}
+		rz_il_op_effect_free(op);
+	}
+	mu_end;
+}
+
+static bool test_il_compile_special(void) {
+	// division by zero
+	RzILOpEffect *op = rz_il_op_new_seq(
+		rz_il_op_new_set("r0", false, rz_il_op_new_div(rz_il_op_new_var("r0", RZ_IL_VAR_KIND_GLOBAL), rz_il_op_new_bitv_from_ut64(32, 0))),
+		rz_il_op_new_set("r1", false, rz_il_op_new_mod(rz_il_op_new_var("r1", RZ_IL_VAR_KIND_GLOBAL), rz_il_op_new_bitv_from_ut64(32, 0))));
+	mu_assert_true(check_same(op, 2, "div by zero"), "div by zero");
+	rz_il_op_effect_free(op);
+
+	// labels and gotos are interpreted in the compiled code
+	op = rz_il_op_new_seq(
+		rz_il_op_new_blk("skip", rz_il_op_new_set("r2", false, rz_il_op_new_bitv_from_ut64(8, 0x42)), rz_il_op_new_nop()),
+		rz_il_op_new_seq(rz_il_op_new_set("t", true, rz_il_op_new_var("r0", RZ_IL_VAR_KIND_GLOBAL)),
+			rz_il_op_new_seq(rz_il_op_new_goto("skip"), rz_il_op_new_set("r1", false, rz_il_op_new_var("t", RZ_IL_VAR_KIND_LOCAL)))));
+	mu_assert_true(check_same(op, 2, "goto"), "goto");
+	rz_il_op_effect_free(op);
+
+	// local variable only set in one branch
+	op = rz_il_op_new_seqn(3,
+		rz_il_op_new_set("f", false, rz_il_op_new_bool_inv(rz_il_op_new_var("f", RZ_IL_VAR_KIND_GLOBAL))),
+		rz_il_op_new_branch(rz_il_op_new_var("f", RZ_IL_VAR_KIND_GLOBAL), rz_il_op_new_set("t", true, rz_il_op_new_var("r0", RZ_IL_VAR_KIND_GLOBAL)), NULL),
+		rz_il_op_new_set("r1", false, rz_il_op_new_add(rz_il_op_new_var("r1", RZ_IL_VAR_KIND_GLOBAL), rz_il_op_new_var("t", RZ_IL_VAR_KIND_LOCAL))));
+	mu_assert_true(check_same(op, 4, "unset local"), "unset local");
+	rz_il_op_effect_free(op);
+
+	// big bitvectors are not compiled
+	TestVM t;
+	test_vm_init(&t);
+	op = rz_il_op_new_set("r0", false, rz_il_op_new_cast(32, rz_il_op_new_b0(), rz_il_op_new_bitv_from_ut64(128, 1)));
+	mu_assert_null(rz_il_compile_effect(t.vm, op), "128 bits not compiled");
+	rz_il_op_effect_free(op);
+	// neither are unknown variables
+	op = rz_il_op_new_set("r0", false, rz_il_op_new_var("nope", RZ_IL_VAR_KIND_GLOBAL));
+	mu_assert_null(rz_il_compile_effect(t.vm, op), "unknown var not compiled");
+	rz_il_op_effect_free(op);
+	test_vm_fini(&t);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test(test_il_compile_random);
+	mu_run_test(test_il_compile_special);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
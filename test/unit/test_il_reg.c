@@ -394,11 +394,127 @@ static bool test_il_vm_sync_from_reg() {
 	mu_end;
 }
 
+static bool test_il_vm_sync_profile_change() {
+	const char *profile =
+		"=PC	pc\n"
+		"gpr	r0	.32	0	0\n"
+		"gpr	r1	.32	4	0\n"
+		"gpr	pc	.32	8	0\n"
+		"gpr	zf	.1	12.3	0\n";
+	const char *bind[] = { "r0", "r1", "zf" };
+
+	RzReg *reg = rz_reg_new();
+	rz_reg_set_profile_string(reg, profile);
+	RzILVM *vm = rz_il_vm_new(0, 32, false);
+	RzILRegBinding *rb = rz_il_reg_binding_exactly(reg, RZ_ARRAY_SIZE(bind), bind);
+	rz_il_vm_setup_reg_binding(vm, rb);
+
+	for (ut64 i = 0; i < 3; i++) {
+		rz_reg_setv(reg, "r0", 0x100 + i);
+		rz_reg_setv(reg, "r1", 0x200 + i);
+		rz_reg_setv(reg, "pc", 0x300 + i);
+		rz_reg_setv(reg, "zf", i & 1);
+		rz_il_vm_sync_from_reg(vm, rb, reg);
+		RzILVal *val = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "r0");
+		mu_assert_eq(rz_bv_to_ut64(val->data.bv), 0x100 + i, "r0 from reg");
+		val = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "r1");
+		mu_assert_eq(rz_bv_to_ut64(val->data.bv), 0x200 + i, "r1 from reg");
+		val = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "zf");
+		mu_assert_eq(val->data.b->b, i & 1, "zf from reg");
+		mu_assert_eq(rz_bv_to_ut64(vm->pc), 0x300 + i, "pc from reg");
+
+		rz_il_vm_set_global_var(vm, "r1", rz_il_value_new_bitv(rz_bv_new_from_ut64(32, 0x400 + i)));
+		rz_bv_set_from_ut64(vm->pc, 0x500 + i);
+		mu_assert_true(rz_il_vm_sync_to_reg(vm, rb, reg), "sync to reg");
+		mu_assert_eq(rz_reg_getv(reg, "r0"), 0x100 + i, "r0 to reg");
+		mu_assert_eq(rz_reg_getv(reg, "r1"), 0x400 + i, "r1 to reg");
+		mu_assert_eq(rz_reg_getv(reg, "pc"), 0x500 + i, "pc to reg");
+	}
+
+	// the items resolved for the same RzReg must not be used after its profile changed
+	const char *profile2 =
+		"=PC	pc\n"
+		"gpr	pc	.32	0	0\n"
+		"gpr	r1	.32	4	0\n"
+		"gpr	r0	.32	8	0\n";
+	rz_reg_set_profile_string(reg, profile2);
+	rz_reg_setv(reg, "r0", 0x1234);
+	rz_reg_setv(reg, "r1", 0x5678);
+	rz_reg_setv(reg, "pc", 0x9abc);
+	rz_il_vm_sync_from_reg(vm, rb, reg);
+	RzILVal *val = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "r0");
+	mu_assert_eq(rz_bv_to_ut64(val->data.bv), 0x1234, "r0 after profile change");
+	val = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "r1");
+	mu_assert_eq(rz_bv_to_ut64(val->data.bv), 0x5678, "r1 after profile change");
+	val = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "zf");
+	mu_assert_false(val->data.b->b, "unbound zf after profile change");
+	mu_assert_eq(rz_bv_to_ut64(vm->pc), 0x9abc, "pc after profile change");
+	mu_assert_false(rz_il_vm_sync_to_reg(vm, rb, reg), "zf is missing");
+	mu_assert_eq(rz_reg_getv(reg, "r0"), 0x1234, "r0 after profile change");
+
+	rz_reg_free(reg);
+	rz_il_reg_binding_free(rb);
+	rz_il_vm_free(vm);
+	mu_end;
+}
+
+static bool test_il_vm_sync_reg_type() {
+	const char *profile =
+		"=PC	pc\n"
+		"gpr	r0	.32	0	0\n"
+		"gpr	pc	.32	4	0\n"
+		"flg	zf	.1	8.0	0\n"
+		"flg	cf	.1	8.1	0\n";
+	const char *bind[] = { "r0", "zf", "cf" };
+
+	RzReg *reg = rz_reg_new();
+	rz_reg_set_profile_string(reg, profile);
+	RzILVM *vm = rz_il_vm_new(0, 32, false);
+	RzILRegBinding *rb = rz_il_reg_binding_exactly(reg, RZ_ARRAY_SIZE(bind), bind);
+	rz_il_vm_setup_reg_binding(vm, rb);
+
+	rz_reg_setv(reg, "r0", 0x1234);
+	rz_reg_setv(reg, "pc", 0x100);
+	rz_reg_setv(reg, "zf", 1);
+	rz_reg_setv(reg, "cf", 1);
+	rz_il_vm_sync_from_reg_type(vm, rb, reg, RZ_REG_TYPE_GPR);
+	RzILVal *val = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "r0");
+	mu_assert_eq(rz_bv_to_ut64(val->data.bv), 0x1234, "gpr r0 from reg");
+	mu_assert_eq(rz_bv_to_ut64(vm->pc), 0x100, "gpr pc from reg");
+	val = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "zf");
+	mu_assert_false(val->data.b->b, "flag zf not synced with gpr");
+
+	rz_il_vm_sync_from_reg_type(vm, rb, reg, RZ_REG_TYPE_FLG);
+	val = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "zf");
+	mu_assert_true(val->data.b->b, "flag zf from reg");
+	val = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "cf");
+	mu_assert_true(val->data.b->b, "flag cf from reg");
+
+	rz_il_vm_set_global_var(vm, "r0", rz_il_value_new_bitv(rz_bv_new_from_ut64(32, 0x5678)));
+	rz_il_vm_set_global_var(vm, "cf", rz_il_value_new_bool(rz_il_bool_new(false)));
+	rz_bv_set_from_ut64(vm->pc, 0x200);
+	mu_assert_true(rz_il_vm_sync_to_reg_type(vm, rb, reg, RZ_REG_TYPE_FLG), "flg sync to reg");
+	mu_assert_eq(rz_reg_getv(reg, "cf"), 0, "flag cf to reg");
+	mu_assert_eq(rz_reg_getv(reg, "zf"), 1, "flag zf to reg");
+	mu_assert_eq(rz_reg_getv(reg, "r0"), 0x1234, "gpr r0 not synced with flg");
+	mu_assert_eq(rz_reg_getv(reg, "pc"), 0x100, "gpr pc not synced with flg");
+	mu_assert_true(rz_il_vm_sync_to_reg_type(vm, rb, reg, RZ_REG_TYPE_GPR), "gpr sync to reg");
+	mu_assert_eq(rz_reg_getv(reg, "r0"), 0x5678, "gpr r0 to reg");
+	mu_assert_eq(rz_reg_getv(reg, "pc"), 0x200, "gpr pc to reg");
+
+	rz_reg_free(reg);
+	rz_il_reg_binding_free(rb);
+	rz_il_vm_free(vm);
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_il_reg_binding_derive);
 	mu_run_test(test_il_reg_binding_exactly);
 	mu_run_test(test_il_vm_sync_to_reg);
 	mu_run_test(test_il_vm_sync_from_reg);
+	mu_run_test(test_il_vm_sync_profile_change);
+	mu_run_test(test_il_vm_sync_reg_type);
 	return tests_passed != tests_run;
 }
 
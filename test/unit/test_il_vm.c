@@ -868,6 +868,40 @@ static bool test_rzil_vm_op_compare() {
 	mu_end;
 }
 
+static bool test_rzil_vm_pools() {
+	RzILVM *vm = rz_il_vm_new(0, 32, false);
+	rz_il_vm_create_global_var(vm, "r1", rz_il_sort_pure_bv(32));
+	rz_il_vm_create_global_var(vm, "zf", rz_il_sort_pure_bool());
+
+	// lift and execute the same instruction repeatedly, like the analysis vm does
+	RzILOpPool *prev = rz_il_op_pool_use(vm->op_pool);
+	for (ut64 i = 0; i < 100; i++) {
+		RzILOpEffect *op = rz_il_op_new_seq(
+			rz_il_op_new_set("r1", false, rz_il_op_new_add(rz_il_op_new_var("r1", RZ_IL_VAR_KIND_GLOBAL), rz_il_op_new_bitv_from_ut64(32, 3))),
+			rz_il_op_new_set("zf", false, rz_il_op_new_is_zero(rz_il_op_new_var("r1", RZ_IL_VAR_KIND_GLOBAL))));
+		mu_assert_true(rz_il_vm_step(vm, op, i * 4 + 4), "step");
+		rz_il_op_effect_free(op);
+	}
+	rz_il_op_pool_use(prev);
+
+	RzILVal *r1 = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "r1");
+	mu_assert_eq(rz_bv_to_ut64(r1->data.bv), 300, "r1");
+	mu_assert_eq(rz_bv_len(r1->data.bv), 32, "r1 len");
+	RzILVal *zf = rz_il_vm_get_var_value(vm, RZ_IL_VAR_KIND_GLOBAL, "zf");
+	mu_assert_false(zf->data.b->b, "zf");
+	mu_assert_eq(rz_bv_to_ut64(vm->pc), 400, "pc");
+
+	RzILVMStats stats;
+	rz_il_vm_get_stats(vm, &stats);
+	mu_assert_eq(stats.steps, 100, "steps");
+	mu_assert_true(stats.op_reuses > stats.op_allocs, "op nodes reused");
+	mu_assert_true(stats.bv_reuses > stats.bv_allocs, "bitvectors reused");
+	mu_assert_true(stats.bool_reuses > stats.bool_allocs, "bools reused");
+
+	rz_il_vm_free(vm);
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_rzil_vm_init);
 	mu_run_test(test_rzil_vm_global_vars);
@@ -894,6 +928,7 @@ bool all_tests() {
 	mu_run_test(test_rzil_vm_op_shiftr);
 	mu_run_test(test_rzil_vm_op_shiftl);
 	mu_run_test(test_rzil_vm_op_compare);
+	mu_run_test(test_rzil_vm_pools);
 	return tests_passed != tests_run;
 }
 
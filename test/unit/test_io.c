@@ -58,6 +58,67 @@ bool test_rz_io_cache(void) {
 	mu_end;
 }
 
+bool test_rz_io_cache_layers(void) {
+	RzIO *io = rz_io_new();
+	rz_io_open(io, "malloc://16", RZ_PERM_RW, 0);
+	rz_io_write(io, (ut8 *)"ZZZZZZZZZZZZZZZZ", 16);
+	io->cached = RZ_PERM_R;
+	mu_assert_true(rz_io_cache_write(io, 0, (ut8 *)"AAAA", 4), "Cache write at 0 failed");
+	mu_assert_true(rz_io_cache_write(io, 2, (ut8 *)"BBBB", 4), "Cache write at 2 failed");
+	mu_assert_true(rz_io_cache_write(io, 3, (ut8 *)"C", 1), "Cache write at 3 failed");
+	mu_assert_true(rz_io_cache_write(io, 8, (ut8 *)"DD", 2), "Cache write at 8 failed");
+	ut8 buf[16];
+	rz_io_read_at(io, 0, buf, sizeof(buf));
+	mu_assert_memeq(buf, (ut8 *)"AABCBBZZDDZZZZZZ", sizeof(buf), "IO read with cache doesn't match expected output");
+
+	// only the writes overlapping the range are dropped, the older ones show up again
+	mu_assert_eq(rz_io_cache_invalidate(io, 4, 5), 1, "invalidated writes");
+	mu_assert_eq(rz_pvector_len(&io->cache), 3, "writes left");
+	rz_io_read_at(io, 0, buf, sizeof(buf));
+	mu_assert_memeq(buf, (ut8 *)"AAACZZZZDDZZZZZZ", sizeof(buf), "IO read after cache invalidate doesn't match expected output");
+	mu_assert_true(rz_io_cache_at(io, 2), "Cache should exist at 2 (older write)");
+	mu_assert_false(rz_io_cache_at(io, 4), "Cache shouldn't exist at 4 (invalidated write)");
+
+	mu_assert_eq(rz_io_cache_invalidate(io, 4, 8), 0, "nothing in the range");
+	mu_assert_true(rz_io_cache_commit(io, 8, 9), "commit");
+	RzIOCache *c = rz_pvector_at(&io->cache, 2);
+	mu_assert_true(c->written, "the write in the range should be committed");
+	c = rz_pvector_at(&io->cache, 0);
+	mu_assert_false(c->written, "the write out of the range should not be committed");
+	mu_assert_eq(rz_io_cache_invalidate(io, 0, 16), 3, "invalidated writes");
+	mu_assert_false(rz_io_cache_at(io, 0), "Cache shouldn't exist at 0");
+	rz_io_read_at(io, 0, buf, sizeof(buf));
+	mu_assert_memeq(buf, (ut8 *)"ZZZZZZZZZZZZZZZZ", sizeof(buf), "IO read after invalidating committed writes doesn't match expected output");
+	rz_io_free(io);
+	mu_end;
+}
+
+bool test_rz_io_cache_push_pop(void) {
+	RzIO *io = rz_io_new();
+	rz_io_open(io, "malloc://8", RZ_PERM_RW, 0);
+	io->cached = RZ_PERM_RW;
+	ut8 buf[8];
+	for (int i = 0; i < 4; i++) {
+		mu_assert_true(rz_io_cache_write(io, i, (ut8 *)"A", 1), "Cache write failed");
+	}
+	RzIOCacheStats stats;
+	rz_io_cache_stats(io, &stats);
+	mu_assert_eq(stats.writes, 4, "writes");
+	mu_assert_eq(stats.bytes, 4, "cached bytes");
+	mu_assert_true(rz_io_cache_push(io), "push");
+	mu_assert_true(rz_io_cache_write(io, 2, (ut8 *)"BBBB", 4), "Cache write failed");
+	rz_io_read_at(io, 0, buf, sizeof(buf));
+	mu_assert_memeq(buf, (ut8 *)"AABBBB\x00\x00", sizeof(buf), "read after push");
+	rz_io_cache_stats(io, &stats);
+	mu_assert_eq(stats.saved, 1, "saved caches");
+	mu_assert_true(rz_io_cache_pop(io), "pop");
+	mu_assert_false(rz_io_cache_pop(io), "pop without push");
+	rz_io_read_at(io, 0, buf, sizeof(buf));
+	mu_assert_memeq(buf, (ut8 *)"AAAA\x00\x00\x00\x00", sizeof(buf), "read after pop");
+	rz_io_free(io);
+	mu_end;
+}
+
 bool test_rz_io_mapsplit(void) {
 	RzIO *io = rz_io_new();
 	io->va = true;
@@ -630,8 +691,140 @@ bool test_rz_io_map_del_on_close_all(void) {
 	mu_end;
 }
 
+bool test_rz_io_snapshot(void) {
+	RzIO *io = rz_io_new();
+	io->va = true;
+	io->ff = true;
+	io->Oxff = 0xff;
+	rz_io_open_at(io, "malloc://8", RZ_PERM_RW, 0644, 0x0, NULL);
+	rz_io_write_at(io, 0, (ut8 *)"\x90\x90\x90\x90\x90\x90\x90\x90", 8);
+	rz_io_open_at(io, "malloc://2", RZ_PERM_RW, 0644, 0x4, NULL);
+	rz_io_open_at(io, "malloc://4", RZ_PERM_RW, 0644, 0x10, NULL);
+	rz_io_write_at(io, 0x10, (ut8 *)"ABCD", 4);
+	io->cached = RZ_PERM_R;
+	rz_io_cache_write(io, 1, (ut8 *)"XY", 2);
+
+	RzIOSnapshot *snap = rz_io_snapshot_new(io);
+	mu_assert_notnull(snap, "snapshot");
+	mu_assert_true(rz_io_snapshot_is_valid(snap), "fresh snapshot is valid");
+
+	ut8 buf[0x14];
+	ut8 expect[0x14];
+	mu_assert_true(rz_io_snapshot_read_at(snap, 0, buf, 8), "read mapped");
+	mu_assert_memeq(buf, (ut8 *)"\x90XY\x90\x00\x00\x90\x90", 8, "maps and cache in snapshot");
+	mu_assert_true(rz_io_snapshot_read_at(snap, 0, buf, sizeof(buf)), "read over a gap");
+	mu_assert_true(rz_io_read_at_mapped(io, 0, expect, sizeof(expect)), "io read over a gap");
+	mu_assert_memeq(buf, expect, sizeof(buf), "snapshot read equals io read");
+	mu_assert_true(rz_io_snapshot_read_at(snap, 0x11, buf, 3), "read last map");
+	mu_assert_memeq(buf, (ut8 *)"BCD", 3, "last map");
+
+	rz_io_write_at(io, 0x10, (ut8 *)"Z", 1);
+	mu_assert_false(rz_io_snapshot_is_valid(snap), "snapshot invalid after write");
+	rz_io_snapshot_free(snap);
+
+	snap = rz_io_snapshot_new(io);
+	mu_assert_true(rz_io_snapshot_read_at(snap, 0x10, buf, 1), "read new snapshot");
+	mu_assert_eq(buf[0], 'Z', "new snapshot sees the write");
+	rz_io_open_at(io, "malloc://4", RZ_PERM_RW, 0644, 0x8, NULL);
+	mu_assert_false(rz_io_snapshot_is_valid(snap), "snapshot invalid after map change");
+	rz_io_snapshot_free(snap);
+
+	rz_io_free(io);
+	mu_end;
+}
+
+bool test_rz_io_page_cache(void) {
+	RzIO *io = rz_io_new();
+	io->va = true;
+	rz_io_open_at(io, "malloc://0x100", RZ_PERM_RW, 0644, 0x0, NULL);
+	ut8 data[0x100];
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = i;
+	}
+	rz_io_write_at(io, 0, data, sizeof(data));
+	mu_assert_true(rz_io_page_cache_set(io, 0x20, 4), "enable page cache");
+
+	RzIOPageCacheStats stats;
+	ut8 buf[0x10];
+	mu_assert_true(rz_io_read_at(io, 0x18, buf, sizeof(buf)), "read across two pages");
+	mu_assert_memeq(buf, data + 0x18, sizeof(buf), "read across two pages");
+	mu_assert_true(rz_io_read_at(io, 0x20, buf, 4), "read cached page");
+	mu_assert_memeq(buf, data + 0x20, 4, "read cached page");
+	mu_assert_true(rz_io_page_cache_stats(io, &stats), "stats");
+	mu_assert_eq(stats.page_size, 0x20, "page size");
+	mu_assert_eq(stats.misses, 2, "misses");
+	mu_assert_eq(stats.hits, 1, "hits");
+	mu_assert_eq(stats.used, 2, "used pages");
+
+	rz_io_write_at(io, 0x21, (ut8 *)"\x42", 1);
+	mu_assert_true(rz_io_read_at(io, 0x20, buf, 4), "read after write");
+	mu_assert_memeq(buf, (ut8 *)"\x20\x42\x22\x23", 4, "write invalidates the page");
+	rz_io_page_cache_stats(io, &stats);
+	mu_assert_eq(stats.misses, 3, "misses after write");
+
+	for (ut64 at = 0; at < sizeof(data); at += 0x20) {
+		rz_io_read_at(io, at, buf, 1);
+	}
+	rz_io_page_cache_stats(io, &stats);
+	mu_assert_eq(stats.used, 4, "cache is full");
+	mu_assert_true(stats.evictions > 0, "pages have been evicted");
+
+	mu_assert_true(rz_io_read_at(io, 0xf8, buf, sizeof(buf)), "read at the end of the desc");
+	mu_assert_memeq(buf, data + 0xf8, 8, "read at the end of the desc");
+
+	rz_io_page_cache_invalidate(io, -1);
+	rz_io_page_cache_stats(io, &stats);
+	mu_assert_eq(stats.used, 0, "invalidated cache");
+	mu_assert_true(rz_io_page_cache_set(io, 0, 0), "disable page cache");
+	mu_assert_false(rz_io_page_cache_stats(io, &stats), "disabled page cache");
+	rz_io_free(io);
+	mu_end;
+}
+
+bool test_rz_io_page_cache_small_file(void) {
+	char *filename = rz_file_temp(NULL);
+	mu_assert_true(rz_file_dump(filename, (ut8 *)"1234567890", 10, false), "temp file");
+	RzIO *io = rz_io_new();
+	RzIODesc *desc = rz_io_open_at(io, filename, RZ_PERM_R, 0, 0, NULL);
+	mu_assert_notnull(desc, "temp file has been opened");
+
+	const struct {
+		ut64 addr;
+		int len;
+	} reads[] = { { 0, 10 }, { 6, 4 }, { 8, 4 }, { 9, 1 }, { 10, 2 }, { 0x20, 4 } };
+	int expect_ret[RZ_ARRAY_SIZE(reads)];
+	ut8 expect[RZ_ARRAY_SIZE(reads)][4];
+	ut8 buf[10];
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(reads); i++) {
+		memset(expect[i], 0xff, sizeof(expect[i]));
+		expect_ret[i] = rz_io_desc_read_at(desc, reads[i].addr, expect[i], RZ_MIN(reads[i].len, 4));
+	}
+
+	// the file is smaller than a single page
+	mu_assert_true(rz_io_page_cache_set(io, 0x1000, 8), "enable page cache");
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t i = 0; i < RZ_ARRAY_SIZE(reads); i++) {
+			memset(buf, 0xff, sizeof(buf));
+			int ret = rz_io_desc_read_at(desc, reads[i].addr, buf, RZ_MIN(reads[i].len, 4));
+			mu_assert_eq(ret, expect_ret[i], "same read size as without the page cache");
+			mu_assert_memeq(buf, expect[i], 4, "same bytes as without the page cache");
+		}
+	}
+	mu_assert_true(rz_io_pread_at(io, 6, buf, 4), "read the last bytes of the file");
+	mu_assert_memeq(buf, (ut8 *)"7890", 4, "last bytes of the file");
+	mu_assert_true(rz_io_pread_at(io, 0, buf, 10), "read the whole file");
+	mu_assert_memeq(buf, (ut8 *)"1234567890", 10, "whole file");
+
+	rz_io_free(io);
+	rz_file_rm(filename);
+	free(filename);
+	mu_end;
+}
+
 bool all_tests(void) {
 	mu_run_test(test_rz_io_cache);
+	mu_run_test(test_rz_io_cache_layers);
+	mu_run_test(test_rz_io_cache_push_pop);
 	mu_run_test(test_rz_io_mapsplit);
 	mu_run_test(test_rz_io_mapsplit2);
 	mu_run_test(test_rz_io_mapsplit3);
@@ -647,6 +840,9 @@ bool all_tests(void) {
 	mu_run_test(test_rz_io_map_del_for_fd);
 	mu_run_test(test_rz_io_map_del_on_close);
 	mu_run_test(test_rz_io_map_del_on_close_all);
+	mu_run_test(test_rz_io_snapshot);
+	mu_run_test(test_rz_io_page_cache);
+	mu_run_test(test_rz_io_page_cache_small_file);
 	return tests_passed != tests_run;
 }
 
@@ -368,6 +368,66 @@ bool test_rz_reg_set_bv(void) {
 	mu_end;
 }
 
+bool test_rz_reg_set_value(void) {
+	RzReg *reg = rz_reg_new();
+	mu_assert_notnull(reg, "rz_reg_new () failed");
+
+	rz_reg_set_profile_string(reg,
+		"gpr	rax	.64	0	0\n"
+		"gpr	eax	.32	0	0\n"
+		"gpr	ax	.16	0	0\n"
+		"gpr	ah	.8	1	0\n"
+		"gpr	cf	.1	9	0\n"
+		"gpr	zf	.1	9.3	0");
+	RzRegArena *gpr = reg->regset[RZ_REG_TYPE_GPR].arena;
+
+	mu_assert_true(rz_reg_set_value(reg, rz_reg_get(reg, "rax", RZ_REG_TYPE_ANY), 0x1122334455667788), "set");
+	mu_assert_true(rz_reg_set_value(reg, rz_reg_get(reg, "ah", RZ_REG_TYPE_ANY), 0xab), "set");
+	mu_assert_true(rz_reg_set_value(reg, rz_reg_get(reg, "zf", RZ_REG_TYPE_ANY), 1), "set");
+	const ut8 expect_le[10] = { 0x88, 0xab, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0x08 };
+	mu_assert_memeq(gpr->bytes, expect_le, 10, "little endian bytes");
+	mu_assert_eq(rz_reg_getv(reg, "eax"), 0x5566ab88, "get eax");
+	mu_assert_eq(rz_reg_getv(reg, "ax"), 0xab88, "get ax");
+	mu_assert_eq(rz_reg_getv(reg, "cf"), 0, "get cf");
+	mu_assert_eq(rz_reg_getv(reg, "zf"), 1, "get zf");
+	mu_assert_true(rz_reg_set_value(reg, rz_reg_get(reg, "zf", RZ_REG_TYPE_ANY), 0), "set");
+	mu_assert_eq(gpr->bytes[9], 0, "zf cleared");
+
+	memset(gpr->bytes, 0, gpr->size);
+	reg->big_endian = true;
+	mu_assert_true(rz_reg_set_value(reg, rz_reg_get(reg, "eax", RZ_REG_TYPE_ANY), 0x12345678), "set");
+	const ut8 expect_be[10] = { 0x12, 0x34, 0x56, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	mu_assert_memeq(gpr->bytes, expect_be, 10, "big endian bytes");
+	mu_assert_eq(rz_reg_getv(reg, "rax"), 0x1234567800000000, "get rax");
+	mu_assert_eq(rz_reg_getv(reg, "ax"), 0x1234, "get ax");
+	mu_assert_eq(rz_reg_getv(reg, "ah"), 0x34, "get ah");
+
+	rz_reg_free(reg);
+	mu_end;
+}
+
+bool test_rz_reg_profile_gen(void) {
+	RzReg *a = rz_reg_new();
+	RzReg *b = rz_reg_new();
+	mu_assert_notnull(a, "rz_reg_new () failed");
+	mu_assert_notnull(b, "rz_reg_new () failed");
+
+	rz_reg_set_profile_string(a, "gpr	eax	.32	0	0");
+	rz_reg_set_profile_string(b, "gpr	eax	.32	0	0");
+	ut32 gen = a->profile_gen;
+	mu_assert_neq(gen, b->profile_gen, "generations are unique across RzRegs");
+	rz_reg_set_name(a, RZ_REG_NAME_PC, "eax");
+	mu_assert_neq(a->profile_gen, gen, "alias changes the generation");
+	gen = a->profile_gen;
+	rz_reg_set_profile_string(a, "gpr	ebx	.32	0	0");
+	mu_assert_neq(a->profile_gen, gen, "profile changes the generation");
+	mu_assert_neq(a->profile_gen, b->profile_gen, "generations are unique across RzRegs");
+
+	rz_reg_free(a);
+	rz_reg_free(b);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_rz_reg_set_name);
 	mu_run_test(test_rz_reg_set_profile_string);
@@ -377,6 +437,8 @@ int all_tests() {
 	mu_run_test(test_rz_reg_get_list);
 	mu_run_test(test_rz_reg_get_bv);
 	mu_run_test(test_rz_reg_set_bv);
+	mu_run_test(test_rz_reg_set_value);
+	mu_run_test(test_rz_reg_profile_gen);
 	return tests_passed != tests_run;
 }
 
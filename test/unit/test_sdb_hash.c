@@ -536,6 +536,28 @@ bool test_ht_pu_ops(void) {
 	mu_end;
 }
 
+bool test_reserve(void) {
+	HtPP *ht = ht_pp_new(NULL, (HtPPKvFreeFunc)free_key_value, NULL);
+	ht_pp_insert(ht, "before", strdup("reserve"));
+	ht_pp_reserve(ht, 3000);
+	ut32 size = ht->size;
+	mu_assert("reserved size", size > 3000);
+	for (int i = 0; i < 3000; ++i) {
+		char buf[20], *buf2;
+		snprintf(buf, 20, "key%d", i);
+		buf2 = malloc(20);
+		snprintf(buf2, 20, "value%d", i);
+		ht_pp_insert(ht, buf, buf2);
+	}
+	mu_assert_eq(ht->size, size, "no growing after reserve");
+	mu_assert_streq(ht_pp_find(ht, "before", NULL), "reserve", "element kept by reserve");
+	mu_assert_streq(ht_pp_find(ht, "key2999", NULL), "value2999", "element inserted after reserve");
+	ht_pp_reserve(ht, 10);
+	mu_assert_eq(ht->size, size, "reserve never shrinks");
+	ht_pp_free(ht);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_ht_insert_lookup);
 	mu_run_test(test_ht_update_lookup);
@@ -553,6 +575,7 @@ int all_tests() {
 	mu_run_test(test_grow_2);
 	mu_run_test(test_grow_3);
 	mu_run_test(test_grow_4);
+	mu_run_test(test_reserve);
 	mu_run_test(test_foreach_delete);
 	mu_run_test(test_update_key);
 	mu_run_test(test_ht_pu_ops);
@@ -6,6 +6,8 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <rz_util/rz_file.h>
+#include <rz_endian.h>
+#include <sys/stat.h>
 
 static bool foreach_delete_cb(void *user, const char *key, const char *val) {
 	if (strcmp(key, "bar")) {
@@ -549,6 +551,106 @@ bool test_sdb_text_load_file() {
 	mu_end;
 }
 
+bool test_sdb_bin_save_load() {
+	Sdb *db = text_ref_db();
+	sdb_set(db, "aaa", "shared value", 0);
+	sdb_set(db, "bbb", "shared value", 0);
+	sdb_set(db, "deleted", "value", 0);
+	sdb_unset(db, "deleted", 0);
+	sdb_ns(db, "empty", true);
+
+	bool succ = sdb_bin_save(db, ".bin_save_load");
+	mu_assert_true(succ, "save success");
+	mu_assert_true(sdb_bin_check_file(".bin_save_load"), "binary file detected");
+	Sdb *loaded = sdb_new0();
+	succ = sdb_bin_load(loaded, ".bin_save_load");
+	unlink(".bin_save_load");
+	mu_assert_true(succ, "load success");
+
+	bool eq = sdb_diff(db, loaded, diff_cb, NULL);
+	mu_assert_true(eq, "load correct");
+	mu_assert_null(sdb_const_get(loaded, "deleted", NULL), "deleted key not saved");
+	mu_assert_notnull(sdb_ns(loaded, "empty", false), "empty namespace saved");
+	sdb_free(loaded);
+	sdb_free(db);
+	mu_end;
+}
+
+bool test_sdb_bin_text_roundtrip() {
+	char *buf = strdup(text_ref);
+	Sdb *db = sdb_new0();
+	sdb_text_load_buf(db, buf, strlen(buf));
+	free(buf);
+
+	int fd = tmpfile_new(".bin_text_roundtrip", NULL, 0);
+	bool succ = sdb_bin_save_fd(db, fd);
+	sdb_free(db);
+	mu_assert_true(succ, "save success");
+	struct stat st;
+	fstat(fd, &st);
+	ut8 *bin = malloc(st.st_size);
+	lseek(fd, 0, SEEK_SET);
+	mu_assert_eq(read(fd, bin, st.st_size), st.st_size, "read succeed");
+	close(fd);
+	unlink(".bin_text_roundtrip");
+
+	mu_assert_false(sdb_bin_check_buf((const ut8 *)text_ref, strlen(text_ref)), "text is not binary");
+	mu_assert_true(sdb_bin_check_buf(bin, st.st_size), "binary detected");
+	db = sdb_new0();
+	succ = sdb_bin_load_buf(db, bin, st.st_size);
+	free(bin);
+	mu_assert_true(succ, "load success");
+
+	fd = tmpfile_new(".bin_text_roundtrip", NULL, 0);
+	sdb_text_save_fd(db, fd, true);
+	lseek(fd, 0, SEEK_SET);
+	char text[TEST_BUF_SZ] = { 0 };
+	mu_assert_neq(-1, read(fd, text, sizeof(text) - 1), "read succeed");
+	close(fd);
+	unlink(".bin_text_roundtrip");
+	sdb_free(db);
+	mu_assert_streq(text, text_ref, "text save of the binary load");
+	mu_end;
+}
+
+bool test_sdb_bin_load_broken() {
+	Sdb *db = text_ref_simple_db();
+	int fd = tmpfile_new(".bin_load_broken", NULL, 0);
+	sdb_bin_save_fd(db, fd);
+	sdb_free(db);
+	ut8 bin[TEST_BUF_SZ];
+	lseek(fd, 0, SEEK_SET);
+	int sz = read(fd, bin, sizeof(bin));
+	close(fd);
+	unlink(".bin_load_broken");
+	mu_assert_true(sz > 20, "saved");
+
+	// truncated anywhere
+	for (int i = 0; i < sz; i++) {
+		db = sdb_new0();
+		mu_assert_false(sdb_bin_load_buf(db, bin, i), "truncated load fails");
+		sdb_free(db);
+	}
+
+	// unterminated strings blob: strings_count at 12, then offsets and blob
+	ut32 strings_count = rz_read_le32(bin + 12);
+	ut32 blob_size = rz_read_le32(bin + 16);
+	ut8 *blob_end = bin + 20 + strings_count * 4 + blob_size - 1;
+	*blob_end = 'x';
+	db = sdb_new0();
+	mu_assert_false(sdb_bin_load_buf(db, bin, sz), "unterminated blob fails");
+	sdb_free(db);
+	*blob_end = 0;
+
+	// string index out of range in the first key
+	ut8 *key = bin + 20 + strings_count * 4 + blob_size + 4;
+	rz_write_le32(key, strings_count);
+	db = sdb_new0();
+	mu_assert_false(sdb_bin_load_buf(db, bin, sz), "invalid string index fails");
+	sdb_free(db);
+	mu_end;
+}
+
 int all_tests() {
 	// XXX two bugs found with crash
 	mu_run_test(test_sdb_namespace);
@@ -571,6 +673,9 @@ int all_tests() {
 	mu_run_test(test_sdb_text_load_broken);
 	mu_run_test(test_sdb_text_load_path_last_line);
 	mu_run_test(test_sdb_text_load_file);
+	mu_run_test(test_sdb_bin_save_load);
+	mu_run_test(test_sdb_bin_text_roundtrip);
+	mu_run_test(test_sdb_bin_load_broken);
 	return tests_passed != tests_run;
 }
 
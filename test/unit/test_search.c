@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2022 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_search.h>
+#include "minunit.h"
+
+#define SEARCH_BLOCK_SIZE 0x1000
+
+static int collect_hit(RzSearchKeyword *kw, void *user, ut64 addr) {
+	RzVector *hits = user;
+	ut64 hit[2] = { kw->kwidx, addr };
+	rz_vector_push(hits, hit);
+	return 1;
+}
+
+static RzSearchKeyword *keyword_new(int i) {
+	switch (i % 6) {
+	case 0:
+		return rz_search_keyword_new_str("rizin", NULL, NULL, false);
+	case 1:
+		return rz_search_keyword_new_str("RiZin", NULL, NULL, true);
+	case 2:
+		return rz_search_keyword_new_hexmask("7f454c46..01", NULL);
+	case 3:
+		return rz_search_keyword_new_hex("c0ffee", "f0ffff", NULL);
+	case 4:
+		// no unmasked byte, checked at every position
+		return rz_search_keyword_new_hex("4142", "f0f0", NULL);
+	default: {
+		char *str = rz_str_newf("kw%dtail", i);
+		RzSearchKeyword *kw = rz_search_keyword_new_str(str, NULL, NULL, false);
+		free(str);
+		return kw;
+	}
+	}
+}
+
+static void search_blocks(RzSearch *s, const ut8 *data, size_t size, RzVector *hits, bool brute_force) {
+	ut8 block[SEARCH_BLOCK_SIZE];
+	rz_search_set_callback(s, collect_hit, hits);
+	rz_search_begin(s);
+	for (size_t at = 0; at < size; at += SEARCH_BLOCK_SIZE) {
+		size_t len = RZ_MIN(SEARCH_BLOCK_SIZE, size - at);
+		memcpy(block, data + at, len);
+		if (brute_force) {
+			rz_search_mybinparse_update(s, at, block, len);
+		} else {
+			rz_search_update(s, at, block, len);
+		}
+	}
+}
+
+static ut8 *make_data(size_t size) {
+	static const char *words[] = { "rizin", "RIZIN", "rIzIn", "\x7f" "ELF\x02\x01", "\xc0\xff\xee", "\x30\xff\xee", "AB", "Ab", "kw5tail", "kw11tail", "kw17tai" };
+	ut8 *data = malloc(size);
+	if (!data) {
+		return NULL;
+	}
+	ut32 seed = 42;
+	for (size_t i = 0; i < size;) {
+		seed = seed * 1103515245 + 12345;
+		if ((seed >> 16) % 8) {
+			data[i++] = (seed >> 8) & 0xff;
+			continue;
+		}
+		const char *w = words[(seed >> 20) % RZ_ARRAY_SIZE(words)];
+		for (size_t j = 0; w[j] && i < size; j++) {
+			data[i++] = w[j];
+		}
+	}
+	return data;
+}
+
+static RzSearch *search_new(bool overlap, int n_kws) {
+	RzSearch *s = rz_search_new(RZ_SEARCH_KEYWORD);
+	s->overlap = overlap;
+	s->contiguous = true;
+	for (int i = 0; i < n_kws; i++) {
+		rz_search_kw_add(s, keyword_new(i));
+	}
+	return s;
+}
+
+static bool check_multi_search(bool overlap, int n_kws, size_t size) {
+	ut8 *data = make_data(size);
+	mu_assert_notnull(data, "data");
+
+	RzVector hits, expected;
+	rz_vector_init(&hits, sizeof(ut64) * 2, NULL, NULL);
+	rz_vector_init(&expected, sizeof(ut64) * 2, NULL, NULL);
+
+	RzSearch *multi = search_new(overlap, n_kws);
+	search_blocks(multi, data, size, &hits, false);
+	mu_assert_notnull(multi->automaton, "keywords matched by the automaton");
+	// every keyword is checked at every position
+	RzSearch *brute = search_new(overlap, n_kws);
+	search_blocks(brute, data, size, &expected, true);
+	mu_assert_null(brute->automaton, "keywords matched one by one");
+
+	mu_assert_true(rz_vector_len(&expected) > 100, "hits found");
+	mu_assert_eq(rz_vector_len(&hits), rz_vector_len(&expected), "number of hits");
+	ut64 *a, *b = rz_vector_index_ptr(&expected, 0);
+	rz_vector_foreach(&hits, a) {
+		mu_assert_eq(a[0], b[0], "hit keyword");
+		mu_assert_eq(a[1], b[1], "hit address");
+		b += 2;
+	}
+
+	rz_vector_fini(&hits);
+	rz_vector_fini(&expected);
+	rz_search_free(multi);
+	rz_search_free(brute);
+	free(data);
+	mu_end;
+}
+
+bool test_search_multi(void) {
+	return check_multi_search(false, 18, 0x10000);
+}
+
+bool test_search_multi_overlap(void) {
+	return check_multi_search(true, 18, 0x10000);
+}
+
+bool test_search_multi_many(void) {
+	// thousands of keywords sharing their prefixes
+	return check_multi_search(false, 3000, 0x2000);
+}
+
+bool all_tests() {
+	mu_run_test(test_search_multi);
+	mu_run_test(test_search_multi_overlap);
+	mu_run_test(test_search_multi_many);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
@@ -96,9 +96,40 @@ bool test_rz_skyline_overlaps(void) {
 	mu_end;
 }
 
+bool test_rz_skyline_remove(void) {
+	RzSkyline sky;
+	rz_skyline_init(&sky);
+	rz_skyline_add(&sky, (RzInterval){ 0, 10 }, (void *)1);
+	rz_skyline_add(&sky, (RzInterval){ 10, 10 }, (void *)2);
+	rz_skyline_add(&sky, (RzInterval){ 20, 10 }, (void *)3);
+
+	mu_assert_true(rz_skyline_remove(&sky, (RzInterval){ 5, 20 }), "remove");
+	mu_assert_eq(rz_vector_len(&sky.v), 2, "the head of the 1st map and the tail of the 3rd one should be left");
+	const RzSkylineItem *item = rz_skyline_get_item(&sky, 0);
+	mu_assert_eq((size_t)item->user, 1, "1st map head");
+	mu_assert_eq(rz_itv_end(item->itv), 5, "1st map head should end at 5");
+	mu_assert_false(rz_skyline_contains(&sky, 5), "Skyline shouldn't contain 5");
+	mu_assert_false(rz_skyline_contains(&sky, 24), "Skyline shouldn't contain 24");
+	item = rz_skyline_get_item(&sky, 25);
+	mu_assert_eq((size_t)item->user, 3, "3rd map tail");
+	mu_assert_eq(rz_itv_begin(item->itv), 25, "3rd map tail should start at 25");
+
+	mu_assert_true(rz_skyline_remove(&sky, (RzInterval){ 1, 2 }), "remove inside a part");
+	mu_assert_eq(rz_vector_len(&sky.v), 3, "the 1st map head should be split");
+	mu_assert_true(rz_skyline_contains(&sky, 0), "Skyline should contain 0");
+	mu_assert_false(rz_skyline_contains(&sky, 2), "Skyline shouldn't contain 2");
+	mu_assert_true(rz_skyline_contains(&sky, 3), "Skyline should contain 3");
+
+	mu_assert_true(rz_skyline_remove(&sky, (RzInterval){ 100, 10 }), "remove outside of the parts");
+	mu_assert_eq(rz_vector_len(&sky.v), 3, "nothing should be removed");
+	rz_skyline_fini(&sky);
+	mu_end;
+}
+
 static int all_tests(void) {
 	mu_run_test(test_rz_skyline);
 	mu_run_test(test_rz_skyline_overlaps);
+	mu_run_test(test_rz_skyline_remove);
 	return tests_passed != tests_run;
 }
 
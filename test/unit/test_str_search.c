@@ -343,6 +343,25 @@ bool test_rz_scan_strings_extended_ascii(void) {
 	mu_end;
 }
 
+bool test_rz_scan_strings_explicit_8bit(void) {
+	static const unsigned char str[] =
+		"\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01\x02" "abc\x03\x04\x05\x06"
+		"Hello\tWorld\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x7f" "xyz\x7f" "wxyz";
+	RzList *str_list = rz_list_newf((RzListFree)rz_detected_string_free);
+	int n = rz_scan_strings_raw(str, str_list, &g_opt, 0, sizeof(str) - 1, RZ_STRING_ENC_8BIT);
+	mu_assert_eq(n, 2, "rz_scan_strings 8bit, number of strings");
+
+	RzDetectedString *s = rz_list_get_n(str_list, 0);
+	mu_assert_streq(s->string, "Hello\tWorld", "rz_scan_strings 8bit, first string");
+	mu_assert_eq(s->addr, 19, "rz_scan_strings 8bit, first address");
+	s = rz_list_get_n(str_list, 1);
+	mu_assert_streq(s->string, "wxyz", "rz_scan_strings 8bit, second string");
+	mu_assert_eq(s->addr, sizeof(str) - 5, "rz_scan_strings 8bit, second address");
+
+	rz_list_free(str_list);
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_rz_scan_strings_detect_ascii);
 	mu_run_test(test_rz_scan_strings_detect_ibm037);
@@ -354,6 +373,7 @@ bool all_tests() {
 	mu_run_test(test_rz_scan_strings_detect_utf32_be);
 	mu_run_test(test_rz_scan_strings_utf16_be);
 	mu_run_test(test_rz_scan_strings_extended_ascii);
+	mu_run_test(test_rz_scan_strings_explicit_8bit);
 
 	return tests_passed != tests_run;
 }